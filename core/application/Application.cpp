@@ -25,6 +25,7 @@
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
+#include "collection_pipeline/queue/ExtraBufferSpillStore.h"
 #include "collection_pipeline/queue/SenderQueueManager.h"
 #include "common/CrashBackTraceUtil.h"
 #include "common/Flags.h"
@@ -381,6 +382,7 @@ void Application::Exit() {
     FlusherSLS::RecycleResourceIfNotUsed();
 
     CollectionPipelineManager::GetInstance()->ClearAllPipelines();
+    ExtraBufferSpillStore::GetInstance()->Stop();
     TimeKeeper::GetInstance()->Stop();
 #if defined(__ENTERPRISE__) && defined(_MSC_VER)
     ReleaseWindowsSignalObject();
@@ -25,6 +25,7 @@
 #include "json/value.h"
 
 #include "app_config/AppConfig.h"
+#include "collection_pipeline/ParallelProcessExecutor.h"
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 #include "collection_pipeline/plugin/PluginRegistry.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
@@ -40,6 +41,7 @@
 #include "plugin/processor/inner/ProcessorTagNative.h"
 
 DECLARE_FLAG_INT32(default_plugin_log_queue_size);
+DECLARE_FLAG_BOOL(enable_parallel_process);
 
 using namespace std;
 
@@ -414,8 +416,27 @@ void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_
     for (auto& p : mPipelineInnerProcessorLine) {
         p->Process(logGroupList);
     }
-    for (auto& p : mProcessorLine) {
-        p->Process(logGroupList);
+    if (BOOL_FLAG(enable_parallel_process)) {
+        // consecutive parallel-safe processors are run together so that groups are split and merged only once
+        vector<ProcessorInstance*> parallelProcessors;
+        for (auto& p : mProcessorLine) {
+            if (p->IsParallelSupported()) {
+                parallelProcessors.emplace_back(p.get());
+                continue;
+            }
+            ParallelProcessExecutor::GetInstance()->Process(logGroupList, parallelProcessors);
+            parallelProcessors.clear();
+            p->Process(logGroupList);
+        }
+        ParallelProcessExecutor::GetInstance()->Process(logGroupList, parallelProcessors);
+    } else {
+        for (auto& p : mProcessorLine) {
+            p->Process(logGroupList);
+        }
+    }
+    // columnar mode is only used inside the processor chain, batchers and flushers always see ordinary events
+    for (auto& logGroup : logGroupList) {
+        logGroup.MaterializeColumnarLogs();
     }
     ADD_COUNTER(mProcessorsTotalProcessTimeMs, chrono::system_clock::now() - before);
 }
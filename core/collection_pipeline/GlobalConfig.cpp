@@ -29,6 +29,7 @@ const unordered_set<string> GlobalConfig::sNativeParam = {"TopicType",
                                                           "Priority",
                                                           "EnableTimestampNanosecond",
                                                           "UsingOldContentTag",
+                                                          "EnableColumnarEvents",
                                                           "PipelineMetaTagKey",
                                                           "AgentMetaTagKey"};
 
@@ -153,6 +154,19 @@ bool GlobalConfig::Init(const Json::Value& config, const CollectionPipelineConte
                               ctx.GetRegion());
     }
 
+    // EnableColumnarEvents
+    if (!GetOptionalBoolParam(config, "EnableColumnarEvents", mEnableColumnarEvents, errorMsg)) {
+        PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                              ctx.GetAlarm(),
+                              errorMsg,
+                              mEnableColumnarEvents,
+                              moduleName,
+                              ctx.GetConfigName(),
+                              ctx.GetProjectName(),
+                              ctx.GetLogstoreName(),
+                              ctx.GetRegion());
+    }
+
     for (auto itr = config.begin(); itr != config.end(); ++itr) {
         if (sNativeParam.find(itr.name()) == sNativeParam.end()) {
             extendedParams[itr.name()] = *itr;
@@ -39,6 +39,7 @@ struct GlobalConfig {
     uint32_t mPriority = 1U;
     bool mEnableTimestampNanosecond = false;
     bool mUsingOldContentTag = false;
+    bool mEnableColumnarEvents = false;
 };
 
 } // namespace logtail
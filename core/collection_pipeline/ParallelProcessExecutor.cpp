@@ -0,0 +1,200 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/ParallelProcessExecutor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+
+#include "common/Flags.h"
+#include "models/EventPool.h"
+
+DEFINE_FLAG_BOOL(enable_parallel_process,
+                 "whether to process large event groups with several threads, only parallel-safe processors are used",
+                 false);
+DEFINE_FLAG_INT32(parallel_process_thread_num, "number of helper threads used to process one event group in parallel", 4);
+DEFINE_FLAG_INT32(parallel_process_min_events_per_task,
+                  "min number of events in a sub group when an event group is processed in parallel",
+                  512);
+
+using namespace std;
+
+namespace logtail {
+
+struct ParallelProcessExecutor::Task {
+    vector<ProcessorInstance*> mProcessors;
+    // each unit is processed by one thread from the beginning to the end of the processors
+    vector<vector<PipelineEventGroup>> mUnits;
+    atomic_size_t mNextUnit = 0;
+
+    mutex mMux;
+    condition_variable mCond;
+    size_t mFinishedUnitCnt = 0;
+};
+
+void ParallelProcessExecutor::Process(vector<PipelineEventGroup>& logGroupList,
+                                      const vector<ProcessorInstance*>& processors) {
+    if (processors.empty()) {
+        return;
+    }
+
+    size_t maxSubGroupCnt = static_cast<size_t>(max(INT32_FLAG(parallel_process_thread_num), 0)) + 1;
+    size_t minEventsCnt = static_cast<size_t>(max(INT32_FLAG(parallel_process_min_events_per_task), 1));
+    // number of sub groups each group is split into, 0 if the group is processed as a whole
+    vector<size_t> subGroupCnts(logGroupList.size(), 0);
+    bool needSplit = false;
+    for (size_t i = 0; i < logGroupList.size(); ++i) {
+        const auto& group = logGroupList[i];
+        if (group.IsColumnar()) {
+            continue;
+        }
+        size_t cnt = min(maxSubGroupCnt, group.GetEvents().size() / minEventsCnt);
+        if (cnt > 1) {
+            subGroupCnts[i] = cnt;
+            needSplit = true;
+        }
+    }
+    if (!needSplit) {
+        for (auto& p : processors) {
+            p->Process(logGroupList);
+        }
+        return;
+    }
+
+    auto task = make_shared<Task>();
+    task->mProcessors = processors;
+    for (size_t i = 0; i < logGroupList.size(); ++i) {
+        if (subGroupCnts[i] == 0) {
+            task->mUnits.emplace_back();
+            task->mUnits.back().emplace_back(std::move(logGroupList[i]));
+            continue;
+        }
+        for (auto& subGroup : Split(logGroupList[i], subGroupCnts[i])) {
+            task->mUnits.emplace_back();
+            task->mUnits.back().emplace_back(std::move(subGroup));
+        }
+    }
+
+    StartIfNeeded();
+    {
+        lock_guard<mutex> lock(mMux);
+        if (mThreadPool) {
+            size_t helperCnt = min(task->mUnits.size() - 1, maxSubGroupCnt - 1);
+            for (size_t i = 0; i < helperCnt; ++i) {
+                mThreadPool->Add([task]() {
+                    RunTask(*task);
+                    gThreadedEventPool.CheckGC();
+                });
+            }
+        }
+    }
+    RunTask(*task);
+    {
+        unique_lock<mutex> lock(task->mMux);
+        task->mCond.wait(lock, [&task]() { return task->mFinishedUnitCnt == task->mUnits.size(); });
+    }
+
+    size_t unitIdx = 0;
+    for (size_t i = 0; i < logGroupList.size(); ++i) {
+        if (subGroupCnts[i] == 0) {
+            logGroupList[i] = std::move(task->mUnits[unitIdx++][0]);
+            continue;
+        }
+        vector<PipelineEventGroup> subGroups;
+        subGroups.reserve(subGroupCnts[i]);
+        for (size_t j = 0; j < subGroupCnts[i]; ++j) {
+            subGroups.emplace_back(std::move(task->mUnits[unitIdx++][0]));
+        }
+        Merge(logGroupList[i], subGroups);
+    }
+}
+
+void ParallelProcessExecutor::Stop() {
+    unique_ptr<ThreadPool> threadPool;
+    {
+        lock_guard<mutex> lock(mMux);
+        mStopped = true;
+        threadPool = std::move(mThreadPool);
+    }
+    if (threadPool) {
+        threadPool->Stop();
+    }
+}
+
+void ParallelProcessExecutor::StartIfNeeded() {
+    lock_guard<mutex> lock(mMux);
+    if (mThreadPool || mStopped || INT32_FLAG(parallel_process_thread_num) <= 0) {
+        return;
+    }
+    mThreadPool = make_unique<ThreadPool>(INT32_FLAG(parallel_process_thread_num));
+    mThreadPool->Start();
+}
+
+void ParallelProcessExecutor::RunTask(Task& task) {
+    size_t idx = 0;
+    while ((idx = task.mNextUnit.fetch_add(1)) < task.mUnits.size()) {
+        for (auto& p : task.mProcessors) {
+            p->Process(task.mUnits[idx]);
+        }
+        lock_guard<mutex> lock(task.mMux);
+        if (++task.mFinishedUnitCnt == task.mUnits.size()) {
+            task.mCond.notify_all();
+        }
+    }
+}
+
+vector<PipelineEventGroup> ParallelProcessExecutor::Split(PipelineEventGroup& group, size_t subGroupCnt) {
+    auto& events = group.MutableEvents();
+    size_t totalCnt = events.size();
+    vector<PipelineEventGroup> subGroups;
+    subGroups.reserve(subGroupCnt);
+    for (size_t i = 0; i < subGroupCnt; ++i) {
+        // each sub group owns a separate source buffer, since strings may be allocated during processing
+        subGroups.emplace_back(make_shared<SourceBuffer>());
+        auto& subGroup = subGroups.back();
+        subGroup.SetAllMetadata(group.GetAllMetadata());
+        subGroup.GetSizedTags() = group.GetSizedTags();
+        subGroup.SetExactlyOnceCheckpoint(group.GetExactlyOnceCheckpoint());
+        auto& subEvents = subGroup.MutableEvents();
+        size_t begin = totalCnt * i / subGroupCnt;
+        size_t end = totalCnt * (i + 1) / subGroupCnt;
+        subEvents.reserve(end - begin);
+        for (size_t j = begin; j < end; ++j) {
+            subEvents.emplace_back(std::move(events[j]));
+            subEvents.back()->ResetPipelineEventGroup(&subGroup);
+        }
+    }
+    events.clear();
+    return subGroups;
+}
+
+void ParallelProcessExecutor::Merge(PipelineEventGroup& group, vector<PipelineEventGroup>& subGroups) {
+    size_t totalCnt = 0;
+    for (const auto& subGroup : subGroups) {
+        totalCnt += subGroup.GetEvents().size();
+    }
+    auto& events = group.MutableEvents();
+    events.reserve(totalCnt);
+    for (auto& subGroup : subGroups) {
+        for (auto& e : subGroup.MutableEvents()) {
+            events.emplace_back(std::move(e));
+            events.back()->ResetPipelineEventGroup(&group);
+        }
+        subGroup.MutableEvents().clear();
+        group.GetSourceBuffer()->AddDependency(subGroup.GetSourceBuffer());
+    }
+}
+
+} // namespace logtail
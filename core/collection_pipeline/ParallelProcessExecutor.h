@@ -0,0 +1,69 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/ThreadPool.h"
+#include "models/PipelineEventGroup.h"
+
+namespace logtail {
+
+// ParallelProcessExecutor runs a sequence of parallel-safe processors (see Processor::IsParallelSupported) on large
+// event groups with several threads. Each large group is split into sub groups of consecutive events, the sub groups
+// are processed concurrently by the helper threads and the calling thread, and then merged back into the original
+// group in the original order.
+//
+// The calling thread takes part in the processing and never waits for a task which has not started yet, so
+// processing always completes even if all helper threads are busy or stopped.
+class ParallelProcessExecutor {
+public:
+    ParallelProcessExecutor(const ParallelProcessExecutor&) = delete;
+    ParallelProcessExecutor& operator=(const ParallelProcessExecutor&) = delete;
+
+    static ParallelProcessExecutor* GetInstance() {
+        static ParallelProcessExecutor instance;
+        return &instance;
+    }
+
+    void Process(std::vector<PipelineEventGroup>& logGroupList, const std::vector<ProcessorInstance*>& processors);
+    void Stop();
+
+private:
+    struct Task;
+
+    ParallelProcessExecutor() = default;
+    ~ParallelProcessExecutor() = default;
+
+    void StartIfNeeded();
+    static void RunTask(Task& task);
+    static std::vector<PipelineEventGroup> Split(PipelineEventGroup& group, size_t subGroupCnt);
+    static void Merge(PipelineEventGroup& group, std::vector<PipelineEventGroup>& subGroups);
+
+    std::mutex mMux;
+    std::unique_ptr<ThreadPool> mThreadPool;
+    bool mStopped = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ParallelProcessExecutorUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <algorithm>
 #include <map>
 #include <mutex>
 #include <optional>
@@ -41,10 +42,14 @@ namespace logtail {
 template <typename T = EventBatchStatus>
 class Batcher {
 public:
+    // With shardCnt > 1, event batch items are spread over shards by the tags hash, each guarded by its own lock, so
+    // that processor threads sending groups of different tags to the same flusher do not serialize on one lock. Each
+    // key still lives in exactly one shard, so the flush strategy is the same as without sharding.
     bool Init(const Json::Value& config,
               Flusher* flusher,
               const DefaultFlushStrategyOptions& strategy,
-              bool enableGroupBatch = false) {
+              bool enableGroupBatch = false,
+              size_t shardCnt = 1) {
         std::string errorMsg;
         CollectionPipelineContext& ctx = flusher->GetContext();
 
@@ -100,6 +105,7 @@ public:
         mEventFlushStrategy.SetMinCnt(minCnt);
 
         mFlusher = flusher;
+        mShards = std::vector<EventQueueShard>(std::max<size_t>(shardCnt, 1));
 
         std::vector<std::pair<std::string, std::string>> labels{
             {METRIC_LABEL_KEY_PROJECT, ctx.GetProjectName()},
@@ -130,12 +136,16 @@ public:
     // when group level batch is disabled, there should be only 1 element in BatchedEventsList
     void Add(PipelineEventGroup&& g, std::vector<BatchedEventsList>& res) {
         auto before = std::chrono::system_clock::now();
-        std::lock_guard<std::mutex> lock(mMux);
         size_t key = g.GetTagsHash();
-        EventBatchItem<T>& item = mEventQueueMap[key];
         ADD_COUNTER(mInEventsTotal, g.GetEvents().size());
         ADD_COUNTER(mInGroupDataSizeBytes, g.DataSize());
-        SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
+        EventQueueShard& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mMux);
+        auto inserted = shard.mEventQueueMap.try_emplace(key);
+        if (inserted.second) {
+            ADD_GAUGE(mEventBatchItemsTotal, 1);
+        }
+        EventBatchItem<T>& item = inserted.first->second;
 
         if (g.DataSize() > mEventFlushStrategy.GetMinSizeBytes()) {
             // for group size larger than min batch size, separate group only if size is larger than max batch size
@@ -172,22 +182,8 @@ public:
                         UpdateMetricsOnFlushingEventQueue(item);
                         item.Flush(res);
                     } else {
-                        if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-                            UpdateMetricsOnFlushingGroupQueue();
-                            mGroupQueue->Flush(res);
-                        }
-                        if (mGroupQueue->IsEmpty()) {
-                            TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
-                                                                             mFlusher->GetFlusherIndex(),
-                                                                             0,
-                                                                             mGroupFlushStrategy->GetTimeoutSecs(),
-                                                                             mFlusher);
-                        }
-                        item.Flush(mGroupQueue.value());
-                        if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-                            UpdateMetricsOnFlushingGroupQueue();
-                            mGroupQueue->Flush(res);
-                        }
+                        std::lock_guard<std::mutex> groupLock(mGroupMux);
+                        FlushToGroupQueue(item, res);
                     }
                 }
                 if (item.IsEmpty()) {
@@ -221,72 +217,61 @@ public:
     // key != 0: event level queue
     // key = 0: group level queue
     void FlushQueue(size_t key, BatchedEventsList& res) {
-        std::lock_guard<std::mutex> lock(mMux);
         if (key == 0) {
             if (!mGroupQueue) {
                 return;
             }
+            std::lock_guard<std::mutex> groupLock(mGroupMux);
             UpdateMetricsOnFlushingGroupQueue();
             return mGroupQueue->Flush(res);
         }
 
-        auto iter = mEventQueueMap.find(key);
-        if (iter == mEventQueueMap.end()) {
+        EventQueueShard& shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mMux);
+        auto iter = shard.mEventQueueMap.find(key);
+        if (iter == shard.mEventQueueMap.end()) {
             return;
         }
 
         if (!mGroupQueue) {
             UpdateMetricsOnFlushingEventQueue(iter->second);
             iter->second.Flush(res);
-            mEventQueueMap.erase(iter);
-            SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
-            return;
-        }
-
-        if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-            UpdateMetricsOnFlushingGroupQueue();
-            mGroupQueue->Flush(res);
-        }
-        if (mGroupQueue->IsEmpty()) {
-            TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
-                                                             mFlusher->GetFlusherIndex(),
-                                                             0,
-                                                             mGroupFlushStrategy->GetTimeoutSecs(),
-                                                             mFlusher);
-        }
-        iter->second.Flush(mGroupQueue.value());
-        mEventQueueMap.erase(iter);
-        SET_GAUGE(mEventBatchItemsTotal, mEventQueueMap.size());
-        if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-            UpdateMetricsOnFlushingGroupQueue();
-            mGroupQueue->Flush(res);
+        } else {
+            std::lock_guard<std::mutex> groupLock(mGroupMux);
+            FlushToGroupQueue(iter->second, res);
         }
+        shard.mEventQueueMap.erase(iter);
+        SUB_GAUGE(mEventBatchItemsTotal, 1);
     }
 
     void FlushAll(std::vector<BatchedEventsList>& res) {
-        std::lock_guard<std::mutex> lock(mMux);
-        for (auto& item : mEventQueueMap) {
-            if (!mGroupQueue) {
-                UpdateMetricsOnFlushingEventQueue(item.second);
-                item.second.Flush(res);
-            } else {
-                if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
-                }
-                item.second.Flush(mGroupQueue.value());
-                if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
-                    UpdateMetricsOnFlushingGroupQueue();
-                    mGroupQueue->Flush(res);
+        for (auto& shard : mShards) {
+            std::lock_guard<std::mutex> lock(shard.mMux);
+            for (auto& item : shard.mEventQueueMap) {
+                if (!mGroupQueue) {
+                    UpdateMetricsOnFlushingEventQueue(item.second);
+                    item.second.Flush(res);
+                } else {
+                    std::lock_guard<std::mutex> groupLock(mGroupMux);
+                    if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
+                    item.second.Flush(mGroupQueue.value());
+                    if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
+                        UpdateMetricsOnFlushingGroupQueue();
+                        mGroupQueue->Flush(res);
+                    }
                 }
             }
+            SUB_GAUGE(mEventBatchItemsTotal, shard.mEventQueueMap.size());
+            shard.mEventQueueMap.clear();
         }
         if (mGroupQueue) {
+            std::lock_guard<std::mutex> groupLock(mGroupMux);
             UpdateMetricsOnFlushingGroupQueue();
             mGroupQueue->Flush(res);
         }
-        SET_GAUGE(mEventBatchItemsTotal, 0);
-        mEventQueueMap.clear();
     }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -295,6 +280,34 @@ public:
 #endif
 
 private:
+    struct EventQueueShard {
+        std::mutex mMux;
+        std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+    };
+
+    EventQueueShard& GetShard(size_t key) { return mShards[key % mShards.size()]; }
+
+    // should be called with mGroupMux held
+    template <typename R>
+    void FlushToGroupQueue(EventBatchItem<T>& item, R& res) {
+        if (!mGroupQueue->IsEmpty() && mGroupFlushStrategy->NeedFlushByTime(mGroupQueue->GetStatus())) {
+            UpdateMetricsOnFlushingGroupQueue();
+            mGroupQueue->Flush(res);
+        }
+        if (mGroupQueue->IsEmpty()) {
+            TimeoutFlushManager::GetInstance()->UpdateRecord(mFlusher->GetContext().GetConfigName(),
+                                                             mFlusher->GetFlusherIndex(),
+                                                             0,
+                                                             mGroupFlushStrategy->GetTimeoutSecs(),
+                                                             mFlusher);
+        }
+        item.Flush(mGroupQueue.value());
+        if (mGroupFlushStrategy->NeedFlushBySize(mGroupQueue->GetStatus())) {
+            UpdateMetricsOnFlushingGroupQueue();
+            mGroupQueue->Flush(res);
+        }
+    }
+
     void UpdateMetricsOnFlushingEventQueue(const EventBatchItem<T>& item) {
         ADD_COUNTER(mOutEventsTotal, item.EventSize());
         // ADD_COUNTER(mTotalDelayMs,
@@ -321,10 +334,11 @@ private:
         SUB_GAUGE(mBufferedDataSizeByte, mGroupQueue->DataSize());
     }
 
-    std::mutex mMux;
-    std::map<size_t, EventBatchItem<T>> mEventQueueMap;
+    std::vector<EventQueueShard> mShards = std::vector<EventQueueShard>(1);
     EventFlushStrategy<T> mEventFlushStrategy;
 
+    // lock order: the lock of a shard first, then mGroupMux
+    std::mutex mGroupMux;
     std::optional<GroupBatchItem> mGroupQueue;
     std::optional<GroupFlushStrategy> mGroupFlushStrategy;
 
@@ -14,17 +14,27 @@
 
 #include "collection_pipeline/batch/TimeoutFlushManager.h"
 
+#include <chrono>
+
 using namespace std;
 
 namespace logtail {
 
+static uint64_t GetSteadySeconds() {
+    return chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+TimeoutFlushManager::TimeoutFlushManager() : mTimeoutWheel(GetSteadySeconds()) {
+}
+
 void TimeoutFlushManager::UpdateRecord(
     const string& config, size_t index, size_t key, uint32_t timeoutSecs, Flusher* f) {
     lock_guard<mutex> lock(mTimeoutRecordsMux);
     auto& item = mTimeoutRecords[config];
     auto it = item.find({index, key});
     if (it == item.end()) {
-        item.try_emplace({index, key}, f, key, timeoutSecs);
+        auto& record = item.try_emplace({index, key}, f, key, timeoutSecs).first->second;
+        record.mTimerId = mTimeoutWheel.Schedule(GetSteadySeconds() + timeoutSecs, {config, index, key});
     } else {
         it->second.Update();
     }
@@ -34,18 +44,30 @@ void TimeoutFlushManager::FlushTimeoutBatch() {
     multimap<string, pair<Flusher*, size_t>> records;
     {
         lock_guard<mutex> lock(mTimeoutRecordsMux);
-        for (auto& item : mTimeoutRecords) {
-            for (auto it = item.second.begin(); it != item.second.end();) {
-                if (time(nullptr) - it->second.mUpdateTime >= it->second.mTimeoutSecs) {
-                    // cannot flush here, since flush may also update record, which might invalidate map iterator and
-                    // lead to deadlock
-                    records.emplace(item.first, make_pair(it->second.mFlusher, it->second.mKey));
-                    it = item.second.erase(it);
-                } else {
-                    ++it;
-                }
+        time_t now = time(nullptr);
+        uint64_t nowTick = GetSteadySeconds();
+        mTimeoutWheel.Advance(nowTick, [&](TimerId id, TimeoutRecordKey&& recordKey) {
+            auto item = mTimeoutRecords.find(recordKey.mConfig);
+            if (item == mTimeoutRecords.end()) {
+                return;
             }
-        }
+            auto it = item->second.find({recordKey.mIndex, recordKey.mKey});
+            // the record has been removed, or removed and then recreated with another timer
+            if (it == item->second.end() || it->second.mTimerId != id) {
+                return;
+            }
+            auto& record = it->second;
+            time_t elapsed = now - record.mUpdateTime;
+            if (elapsed < static_cast<time_t>(record.mTimeoutSecs)) {
+                uint64_t remaining = elapsed < 0 ? record.mTimeoutSecs : record.mTimeoutSecs - elapsed;
+                record.mTimerId = mTimeoutWheel.Schedule(nowTick + remaining, std::move(recordKey));
+                return;
+            }
+            // cannot flush here, since flush may also update record, which might invalidate map iterator and lead to
+            // deadlock
+            records.emplace(item->first, make_pair(record.mFlusher, record.mKey));
+            item->second.erase(it);
+        });
     }
     {
         lock_guard<mutex> lock(mDeletedFlushersMux);
@@ -62,7 +84,13 @@ void TimeoutFlushManager::UnregisterFlushers(const string& config,
                                              const vector<unique_ptr<FlusherInstance>>& flushers) {
     {
         lock_guard<mutex> lock(mTimeoutRecordsMux);
-        mTimeoutRecords.erase(config);
+        auto item = mTimeoutRecords.find(config);
+        if (item != mTimeoutRecords.end()) {
+            for (const auto& record : item->second) {
+                mTimeoutWheel.Cancel(record.second.mTimerId);
+            }
+            mTimeoutRecords.erase(item);
+        }
     }
     {
         lock_guard<mutex> lock(mDeletedFlushersMux);
@@ -27,6 +27,7 @@
 
 #include "collection_pipeline/plugin/instance/FlusherInstance.h"
 #include "collection_pipeline/plugin/interface/Flusher.h"
+#include "common/timer/TimingWheel.h"
 
 namespace logtail {
 
@@ -35,6 +36,7 @@ struct TimeoutRecord {
     size_t mKey;
     time_t mUpdateTime = 0;
     uint32_t mTimeoutSecs = 0;
+    TimerId mTimerId = kInvalidTimerId;
 
     TimeoutRecord(Flusher* flusher, size_t key, uint32_t timeoutSecs)
         : mFlusher(flusher), mKey(key), mUpdateTime(time(nullptr)), mTimeoutSecs(timeoutSecs) {}
@@ -42,6 +44,12 @@ struct TimeoutRecord {
     void Update() { mUpdateTime = time(nullptr); }
 };
 
+struct TimeoutRecordKey {
+    std::string mConfig;
+    size_t mIndex = 0;
+    size_t mKey = 0;
+};
+
 class TimeoutFlushManager {
 public:
     TimeoutFlushManager(const TimeoutFlushManager&) = delete;
@@ -58,12 +66,15 @@ public:
     void RegisterFlushers(const std::string& config, const std::vector<std::unique_ptr<FlusherInstance>>& flushers);
 
 private:
-    TimeoutFlushManager() = default;
+    TimeoutFlushManager();
     ~TimeoutFlushManager() = default;
 
     // visited by all processor runner threads
     mutable std::mutex mTimeoutRecordsMux;
     std::map<std::string, std::map<std::pair<size_t, size_t>, TimeoutRecord>> mTimeoutRecords;
+    // each record is scheduled once with its timeout in steady seconds. Updating a record only refreshes its update
+    // time, and the record is rescheduled for the rest of its timeout when it turns out to be updated on expiry.
+    TimingWheel<TimeoutRecordKey> mTimeoutWheel;
 
     // visited by main thread and num 0 processor runner thread
     mutable std::mutex mDeletedFlushersMux;
@@ -47,8 +47,11 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
     if (eventGroupList.empty()) {
         return;
     }
-    for (const auto& eventGroup : eventGroupList) {
-        ADD_COUNTER(mInEventsTotal, eventGroup.GetEvents().size());
+    for (auto& eventGroup : eventGroupList) {
+        if (!mPlugin->IsColumnarSupported()) {
+            eventGroup.MaterializeColumnarLogs();
+        }
+        ADD_COUNTER(mInEventsTotal, eventGroup.GetEventsCount());
         ADD_COUNTER(mInSizeBytes, eventGroup.DataSize());
     }
 
@@ -57,7 +60,7 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
     ADD_COUNTER(mTotalProcessTimeMs, chrono::system_clock::now() - before);
 
     for (const auto& eventGroup : eventGroupList) {
-        ADD_COUNTER(mOutEventsTotal, eventGroup.GetEvents().size());
+        ADD_COUNTER(mOutEventsTotal, eventGroup.GetEventsCount());
         ADD_COUNTER(mOutSizeBytes, eventGroup.DataSize());
     }
 }
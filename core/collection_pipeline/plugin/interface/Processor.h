@@ -30,6 +30,12 @@ public:
 
     virtual bool Init(const Json::Value& config) = 0;
     virtual void Process(std::vector<PipelineEventGroup>& logGroupList);
+    // whether the processor can work on groups in columnar mode, see ColumnarLogEvents.
+    // Columnar groups are materialized before being passed to processors which return false.
+    virtual bool IsColumnarSupported() const { return false; }
+    // whether the processor can work on different parts of one group concurrently, see ParallelProcessExecutor.
+    // Processors returning true must keep no state across events and must not add events to the group.
+    virtual bool IsParallelSupported() const { return false; }
 
 protected:
     virtual bool IsSupportedEvent(const PipelineEventPtr& e) const = 0;
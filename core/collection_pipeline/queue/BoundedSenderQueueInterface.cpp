@@ -14,12 +14,27 @@
 
 #include "collection_pipeline/queue/BoundedSenderQueueInterface.h"
 
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/Flags.h"
+#include "logger/Logger.h"
+#include "monitor/AlarmManager.h"
+
+DEFINE_FLAG_BOOL(enable_sender_queue_spill,
+                 "spill data in extra buffers of sender queues to disk when their memory budget is used up",
+                 true);
+DEFINE_FLAG_INT32(sender_queue_extra_buffer_memory_limit_mb,
+                  "max size of data kept in memory by the extra buffer of a sender queue",
+                  64);
+DEFINE_FLAG_INT32(sender_queue_extra_buffer_total_memory_limit_mb,
+                  "max size of data kept in memory by the extra buffers of all sender queues",
+                  256);
 
 using namespace std;
 
 namespace logtail {
 
 FeedbackInterface* BoundedSenderQueueInterface::sFeedback = nullptr;
+atomic_size_t BoundedSenderQueueInterface::sExtraBufferTotalMemoryBytes = 0;
 
 BoundedSenderQueueInterface::BoundedSenderQueueInterface(
     size_t cap, size_t low, size_t high, QueueKey key, const string& flusherId, const CollectionPipelineContext& ctx)
@@ -30,6 +45,12 @@ BoundedSenderQueueInterface::BoundedSenderQueueInterface(
     mFetchRejectedByRateLimiterTimesCnt
         = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL);
     mExtraBufferDataSizeBytes = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES);
+    mExtraBufferSpilledDataSizeBytes
+        = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SPILLED_SIZE_BYTES);
+}
+
+BoundedSenderQueueInterface::~BoundedSenderQueueInterface() {
+    ClearExtraBuffer();
 }
 
 void BoundedSenderQueueInterface::SetFeedback(FeedbackInterface* feedback) {
@@ -73,8 +94,84 @@ void BoundedSenderQueueInterface::GiveFeedback() const {
     sFeedback->Feedback(0);
 }
 
-void BoundedSenderQueueInterface::Reset(size_t cap, size_t low, size_t high) {
+void BoundedSenderQueueInterface::PushToExtraBuffer(unique_ptr<SenderQueueItem>&& item) {
+    auto size = item->mData.size();
+    // the memory budget is charged by what the payload actually holds, i.e., the size class of its pooled block
+    auto memory = item->mData.capacity();
+    bool spilled = false;
+    if (BOOL_FLAG(enable_sender_queue_spill) && size > 0
+        && (mExtraBufferMemoryBytes + memory
+                > static_cast<size_t>(INT32_FLAG(sender_queue_extra_buffer_memory_limit_mb)) * 1024 * 1024
+            || sExtraBufferTotalMemoryBytes.load() + memory
+                > static_cast<size_t>(INT32_FLAG(sender_queue_extra_buffer_total_memory_limit_mb)) * 1024 * 1024)) {
+        // the payload is written to disk synchronously while the caller holds the queue lock, which is acceptable
+        // since spilling only happens when the extra buffer is already over budget
+        SpilledPayload payload;
+        if (ExtraBufferSpillStore::GetInstance()->Spill(item->mData, payload)) {
+            item->mData = PayloadBuffer();
+            mSpilledPayloads.emplace(item.get(), payload);
+            spilled = true;
+        }
+    }
+    if (spilled) {
+        ADD_GAUGE(mExtraBufferSpilledDataSizeBytes, size);
+    } else {
+        mExtraBufferMemoryBytes += memory;
+        sExtraBufferTotalMemoryBytes += memory;
+    }
+    mExtraBuffer.push_back(std::move(item));
+
+    SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
+    ADD_GAUGE(mExtraBufferDataSizeBytes, size);
+}
+
+unique_ptr<SenderQueueItem> BoundedSenderQueueInterface::PopFromExtraBuffer() {
+    while (!mExtraBuffer.empty()) {
+        auto item = std::move(mExtraBuffer.front());
+        mExtraBuffer.pop_front();
+        SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
+
+        auto it = mSpilledPayloads.find(item.get());
+        if (it == mSpilledPayloads.end()) {
+            auto memory = item->mData.capacity();
+            mExtraBufferMemoryBytes -= memory;
+            sExtraBufferTotalMemoryBytes -= memory;
+            SUB_GAUGE(mExtraBufferDataSizeBytes, item->mData.size());
+            return item;
+        }
+        auto payload = it->second;
+        mSpilledPayloads.erase(it);
+        SUB_GAUGE(mExtraBufferDataSizeBytes, payload.mSize);
+        SUB_GAUGE(mExtraBufferSpilledDataSizeBytes, payload.mSize);
+
+        string data;
+        if (ExtraBufferSpillStore::GetInstance()->Load(payload, data)) {
+            item->mData = PayloadBuffer(std::move(data));
+            return item;
+        }
+        LOG_ERROR(sLogger,
+                  ("failed to load spilled data of sender queue item", "discard data")(
+                      "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(mKey)));
+        AlarmManager::GetInstance()->SendAlarm(DISCARD_DATA_ALARM,
+                                               "failed to load spilled data of sender queue item\taction: discard data"
+                                               "\tconfig-flusher-dst: "
+                                                   + QueueKeyManager::GetInstance()->GetName(mKey));
+    }
+    return nullptr;
+}
+
+void BoundedSenderQueueInterface::ClearExtraBuffer() {
+    for (const auto& item : mSpilledPayloads) {
+        ExtraBufferSpillStore::GetInstance()->Release(item.second);
+    }
+    mSpilledPayloads.clear();
+    sExtraBufferTotalMemoryBytes -= mExtraBufferMemoryBytes;
+    mExtraBufferMemoryBytes = 0;
     deque<unique_ptr<SenderQueueItem>>().swap(mExtraBuffer);
+}
+
+void BoundedSenderQueueInterface::Reset(size_t cap, size_t low, size_t high) {
+    ClearExtraBuffer();
     mRateLimiter.reset();
     mConcurrencyLimiters.clear();
     BoundedQueueInterface::Reset(low, high);
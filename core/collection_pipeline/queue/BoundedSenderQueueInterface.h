@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <optional>
 #include <queue>
@@ -25,6 +26,7 @@
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
 #include "collection_pipeline/limiter/RateLimiter.h"
 #include "collection_pipeline/queue/BoundedQueueInterface.h"
+#include "collection_pipeline/queue/ExtraBufferSpillStore.h"
 #include "collection_pipeline/queue/QueueKey.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
 #include "common/FeedbackInterface.h"
@@ -44,6 +46,7 @@ public:
                                 QueueKey key,
                                 const std::string& flusherId,
                                 const CollectionPipelineContext& ctx);
+    ~BoundedSenderQueueInterface() override;
 
     bool Pop(std::unique_ptr<SenderQueueItem>& item) override { return false; }
 
@@ -70,18 +73,31 @@ protected:
     void GiveFeedback() const override;
     void Reset(size_t cap, size_t low, size_t high);
 
+    // the payload of the item is spilled to disk if the memory budget of extra buffers is used up
+    void PushToExtraBuffer(std::unique_ptr<SenderQueueItem>&& item);
+    // returns the first item in extra buffer with its payload loaded back, or nullptr if there is none
+    std::unique_ptr<SenderQueueItem> PopFromExtraBuffer();
+
     std::optional<RateLimiter> mRateLimiter;
     std::vector<std::pair<std::shared_ptr<ConcurrencyLimiter>, CounterPtr>> mConcurrencyLimiters;
 
     std::deque<std::unique_ptr<SenderQueueItem>> mExtraBuffer;
+    // payloads of items in extra buffer which are spilled to disk
+    std::unordered_map<const SenderQueueItem*, SpilledPayload> mSpilledPayloads;
+    size_t mExtraBufferMemoryBytes = 0;
 
     IntGaugePtr mExtraBufferSize;
     IntGaugePtr mExtraBufferDataSizeBytes;
+    IntGaugePtr mExtraBufferSpilledDataSizeBytes;
     CounterPtr mFetchRejectedByRateLimiterTimesCnt;
 
 private:
+    static std::atomic_size_t sExtraBufferTotalMemoryBytes;
+
     virtual void PushFromExtraBuffer(std::unique_ptr<SenderQueueItem>&& item) = 0;
 
+    void ClearExtraBuffer();
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class FlusherUnittest;
 #endif
@@ -85,7 +85,7 @@ bool ExactlyOnceSenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
         }
         if (!eo->IsComplete()) {
             item->mFirstEnqueTime = chrono::system_clock::now();
-            mExtraBuffer.push_back(std::move(item));
+            PushToExtraBuffer(std::move(item));
             return true;
         }
     }
@@ -107,9 +107,9 @@ bool ExactlyOnceSenderQueue::Remove(SenderQueueItem* item) {
     mQueue[eo->index].reset();
     --mSize;
 
-    if (!mExtraBuffer.empty()) {
-        PushFromExtraBuffer(std::move(mExtraBuffer.front()));
-        mExtraBuffer.pop_front();
+    auto extraItem = PopFromExtraBuffer();
+    if (extraItem) {
+        PushFromExtraBuffer(std::move(extraItem));
         return true;
     }
     if (ChangeStateIfNeededAfterPop()) {
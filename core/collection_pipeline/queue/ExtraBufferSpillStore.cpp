@@ -0,0 +1,176 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/queue/ExtraBufferSpillStore.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#include "app_config/AppConfig.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_INT32(sender_queue_spill_segment_size_mb,
+                  "size of each disk segment holding spilled data of sender queues",
+                  32);
+
+using namespace std;
+
+namespace logtail {
+
+#ifdef __linux__
+void ExtraBufferSpillStore::Stop() {
+    lock_guard<mutex> lock(mMux);
+    mIsStopped = true;
+    if (!mIsInited) {
+        return;
+    }
+    mSegments.clear();
+    if (mWriter.IsOpen()) {
+        mWriter.Seal();
+    }
+    error_code ec;
+    filesystem::remove_all(mDir, ec);
+    mIsInited = false;
+}
+
+bool ExtraBufferSpillStore::Spill(const PayloadBuffer& payload, SpilledPayload& spilled) {
+    lock_guard<mutex> lock(mMux);
+    if (mIsStopped || !Init()) {
+        return false;
+    }
+    if (mWriter.IsOpen() && !mWriter.Append({StringView(payload.data(), payload.size())})) {
+        // the segment is full
+        SealWritingSegment();
+    }
+    if (!mWriter.IsOpen()) {
+        size_t capacity = max(static_cast<size_t>(INT32_FLAG(sender_queue_spill_segment_size_mb)) * 1024 * 1024,
+                              DiskSegmentWriter::GetRecordSize(payload.size()));
+        if (!mWriter.Open(GetSegmentPath(mNextSegmentId), capacity)) {
+            return false;
+        }
+        mWritingSegmentId = mNextSegmentId++;
+        mSegments.emplace(mWritingSegmentId, Segment());
+        if (!mWriter.Append({StringView(payload.data(), payload.size())})) {
+            return false;
+        }
+    }
+    spilled.mSegmentId = mWritingSegmentId;
+    spilled.mIdx = mWriter.GetRecordCnt() - 1;
+    spilled.mOffset = mWriter.GetLastRecordOffset();
+    spilled.mSize = payload.size();
+    ++mSegments[mWritingSegmentId].mPendingCnt;
+    return true;
+}
+
+bool ExtraBufferSpillStore::Load(const SpilledPayload& spilled, string& payload) {
+    lock_guard<mutex> lock(mMux);
+    auto it = mSegments.find(spilled.mSegmentId);
+    if (it == mSegments.end()) {
+        // stopped already
+        return false;
+    }
+    StringView record;
+    if (mWriter.IsOpen() && spilled.mSegmentId == mWritingSegmentId) {
+        // the queue has caught up with the spilled data, which is still being written
+        record = mWriter.GetRecord(spilled.mOffset);
+    } else {
+        auto& segment = it->second;
+        if (!segment.mReader) {
+            segment.mReader = make_unique<DiskSegmentReader>();
+            if (!segment.mReader->Open(GetSegmentPath(spilled.mSegmentId))) {
+                segment.mReader.reset();
+                ReleaseSegment(it);
+                return false;
+            }
+        }
+        if (spilled.mIdx < segment.mReader->GetRecordCnt()) {
+            record = segment.mReader->GetRecord(spilled.mIdx);
+        }
+    }
+    bool res = record.size() == spilled.mSize;
+    if (res) {
+        payload.assign(record.data(), record.size());
+    }
+    ReleaseSegment(it);
+    return res;
+}
+
+void ExtraBufferSpillStore::Release(const SpilledPayload& spilled) {
+    lock_guard<mutex> lock(mMux);
+    auto it = mSegments.find(spilled.mSegmentId);
+    if (it != mSegments.end()) {
+        ReleaseSegment(it);
+    }
+}
+
+bool ExtraBufferSpillStore::Init() {
+    if (mIsInited) {
+        return true;
+    }
+    mDir = GetAgentDataDir() + "sender_queue_spill";
+    // spilled data left by the last run is useless
+    error_code ec;
+    filesystem::remove_all(mDir, ec);
+    if (!filesystem::create_directories(mDir, ec)) {
+        LOG_ERROR(sLogger, ("failed to create sender queue spill dir", mDir)("error", ec.message()));
+        return false;
+    }
+    mIsInited = true;
+    return true;
+}
+
+string ExtraBufferSpillStore::GetSegmentPath(uint64_t id) const {
+    return mDir + PATH_SEPARATOR + "segment_" + to_string(id);
+}
+
+void ExtraBufferSpillStore::SealWritingSegment() {
+    mWriter.Seal();
+    auto it = mSegments.find(mWritingSegmentId);
+    if (it != mSegments.end() && it->second.mPendingCnt == 0) {
+        DiskSegmentReader::Remove(GetSegmentPath(mWritingSegmentId));
+        mSegments.erase(it);
+    }
+}
+
+void ExtraBufferSpillStore::ReleaseSegment(map<uint64_t, Segment>::iterator it) {
+    if (it->second.mPendingCnt > 0) {
+        --it->second.mPendingCnt;
+    }
+    // the segment being written is reused by later spills until it is full
+    if (it->second.mPendingCnt > 0 || (mWriter.IsOpen() && it->first == mWritingSegmentId)) {
+        return;
+    }
+    it->second.mReader.reset();
+    DiskSegmentReader::Remove(GetSegmentPath(it->first));
+    mSegments.erase(it);
+}
+#else
+void ExtraBufferSpillStore::Stop() {
+}
+
+bool ExtraBufferSpillStore::Spill(const PayloadBuffer& payload, SpilledPayload& spilled) {
+    return false;
+}
+
+bool ExtraBufferSpillStore::Load(const SpilledPayload& spilled, string& payload) {
+    return false;
+}
+
+void ExtraBufferSpillStore::Release(const SpilledPayload& spilled) {
+}
+#endif
+
+} // namespace logtail
@@ -0,0 +1,96 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "common/memory/PayloadBuffer.h"
+#ifdef __linux__
+#include "common/DiskSegment.h"
+#endif
+
+namespace logtail {
+
+// where a spilled payload is stored
+struct SpilledPayload {
+    uint64_t mSegmentId = 0;
+    size_t mIdx = 0;
+    size_t mOffset = 0;
+    size_t mSize = 0;
+};
+
+// Payloads of sender queue items in extra buffers are spilled here once the memory budget of extra buffers is used up.
+// They are appended to disk segments shared by all queues. The segment being written is kept open until it is full,
+// with its payloads read back through the mapping, and a sealed segment is removed when all its payloads are loaded
+// back or released. Spilled payloads are dropped on restart along with the items they belong to. Only works on linux.
+class ExtraBufferSpillStore {
+public:
+    ExtraBufferSpillStore(const ExtraBufferSpillStore&) = delete;
+    ExtraBufferSpillStore& operator=(const ExtraBufferSpillStore&) = delete;
+
+    static ExtraBufferSpillStore* GetInstance() {
+        // never destructed, since spilled payloads are released by sender queues during exit
+        static ExtraBufferSpillStore* instance = new ExtraBufferSpillStore();
+        return instance;
+    }
+
+    // removes all spilled payloads, after which nothing is spilled any more
+    void Stop();
+
+    bool Spill(const PayloadBuffer& payload, SpilledPayload& spilled);
+    // loads the payload back, after which it is released
+    bool Load(const SpilledPayload& spilled, std::string& payload);
+    void Release(const SpilledPayload& spilled);
+
+private:
+#ifdef __linux__
+    struct Segment {
+        std::unique_ptr<DiskSegmentReader> mReader;
+        size_t mPendingCnt = 0;
+    };
+#endif
+
+    ExtraBufferSpillStore() = default;
+    ~ExtraBufferSpillStore() = default;
+
+#ifdef __linux__
+    bool Init();
+    std::string GetSegmentPath(uint64_t id) const;
+    void SealWritingSegment();
+    void ReleaseSegment(std::map<uint64_t, Segment>::iterator it);
+
+    std::mutex mMux;
+    bool mIsInited = false;
+    bool mIsStopped = false;
+    std::string mDir;
+    DiskSegmentWriter mWriter;
+    uint64_t mWritingSegmentId = 0;
+    uint64_t mNextSegmentId = 0;
+    std::map<uint64_t, Segment> mSegments;
+#endif
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class SenderQueueUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -19,6 +19,7 @@
 #include <cstdint>
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -48,6 +49,12 @@ public:
 
     void Reset() { mDownStreamQueues.clear(); }
 
+    // used by ProcessQueueManager to guard each queue separately, see ProcessQueueManager::mQueueMux
+    std::mutex& GetMutex() const { return mMux; }
+    // whether the queue key is waiting in some thread deque in work stealing mode, guarded by the queue lock
+    void SetScheduled(bool scheduled) { mScheduled = scheduled; }
+    bool IsScheduled() const { return mScheduled; }
+
 protected:
     bool IsValidToPop() const;
 
@@ -63,6 +70,9 @@ private:
     std::vector<BoundedSenderQueueInterface*> mDownStreamQueues;
     bool mValidToPop = false;
 
+    mutable std::mutex mMux;
+    bool mScheduled = false;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class BoundedProcessQueueUnittest;
     friend class CircularProcessQueueUnittest;
@@ -32,10 +32,17 @@ ProcessQueueManager::ProcessQueueManager() : mBoundedQueueParam(INT32_FLAG(bound
     ResetCurrentQueueIndex();
 }
 
+void ProcessQueueManager::Feedback(QueueKey key) {
+    if (mWorkStealing) {
+        mRescheduleNeeded = true;
+    }
+    Trigger();
+}
+
 bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key,
                                                      uint32_t priority,
                                                      const CollectionPipelineContext& ctx) {
-    lock_guard<mutex> lock(mQueueMux);
+    unique_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::BOUNDED) {
@@ -62,7 +69,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
                                                       uint32_t priority,
                                                       size_t capacity,
                                                       const CollectionPipelineContext& ctx) {
-    lock_guard<mutex> lock(mQueueMux);
+    unique_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second != QueueType::CIRCULAR) {
@@ -87,7 +94,7 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
 }
 
 bool ProcessQueueManager::DeleteQueue(QueueKey key) {
-    lock_guard<mutex> lock(mQueueMux);
+    unique_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -99,10 +106,11 @@ bool ProcessQueueManager::DeleteQueue(QueueKey key) {
 }
 
 bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
-    lock_guard<mutex> lock(mQueueMux);
+    shared_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
         if (iter->second.second == QueueType::BOUNDED) {
+            lock_guard<mutex> queLock((*iter->second.first)->GetMutex());
             return static_cast<BoundedProcessQueue*>(iter->second.first->get())->IsValidToPush();
         } else {
             return true;
@@ -113,12 +121,18 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
 
 QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&& item) {
     {
-        lock_guard<mutex> lock(mQueueMux);
+        // pushes to different queues only share the registry lock in shared mode
+        shared_lock<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
-            if (!(*iter->second.first)->Push(std::move(item))) {
+            auto& que = **iter->second.first;
+            lock_guard<mutex> queLock(que.GetMutex());
+            if (!que.Push(std::move(item))) {
                 return QueueStatus::QUEUE_FULL;
             }
+            if (mWorkStealing) {
+                ScheduleQueueIfNeeded(que);
+            }
         } else {
             auto res = ExactlyOnceQueueManager::GetInstance()->PushProcessQueue(key, std::move(item));
             if (res != QueueStatus::OK) {
@@ -132,12 +146,43 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
 
 bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
     configName.clear();
-    lock_guard<mutex> lock(mQueueMux);
+    // the state is cleared before the scan, so that a trigger by some push during the scan is never overwritten. It is
+    // triggered again once an item is popped, so that threads woken up by a burst of pushes get to pop instead of going
+    // back to sleep.
+    bool validToPop = mValidToPop.exchange(false);
+    if (ScanQueues(threadNo, item, configName)) {
+        if (validToPop) {
+            Trigger();
+        }
+        return true;
+    }
+    // rescan once if some item is pushed during the scan, and leave the state to the next Wait if it happens again
+    if (!mValidToPop.exchange(false)) {
+        return false;
+    }
+    if (ScanQueues(threadNo, item, configName)) {
+        Trigger();
+        return true;
+    }
+    return false;
+}
+
+bool ProcessQueueManager::ScanQueues(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
+    if (mWorkStealing) {
+        return PopItemByWorkStealing(threadNo, item, configName);
+    }
+    shared_lock<shared_mutex> lock(mQueueMux);
+    // processor threads still scan the queues one at a time, but pushes are not blocked during the scan
+    lock_guard<mutex> indexLock(mCurrentQueueIndexMux);
+    auto popItem = [&item](ProcessQueueInterface& que) {
+        lock_guard<mutex> queLock(que.GetMutex());
+        return que.Pop(item);
+    };
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         ProcessQueueIterator iter;
         if (mCurrentQueueIndex.first == i) {
             for (iter = mCurrentQueueIndex.second; iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
+                if (!popItem(**iter)) {
                     continue;
                 }
                 configName = (*iter)->GetConfigName();
@@ -145,7 +190,7 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             }
             if (configName.empty()) {
                 for (iter = mPriorityQueue[i].begin(); iter != mCurrentQueueIndex.second; ++iter) {
-                    if (!(*iter)->Pop(item)) {
+                    if (!popItem(**iter)) {
                         continue;
                     }
                     configName = (*iter)->GetConfigName();
@@ -154,7 +199,7 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             }
         } else {
             for (iter = mPriorityQueue[i].begin(); iter != mPriorityQueue[i].end(); ++iter) {
-                if (!(*iter)->Pop(item)) {
+                if (!popItem(**iter)) {
                     continue;
                 }
                 configName = (*iter)->GetConfigName();
@@ -170,36 +215,132 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             return true;
         }
         // find exactly once queues next
-        {
-            lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
-            for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].begin();
-                 iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].end();
-                 ++iter) {
-                // process queue for exactly once can only be assgined to one specific thread
-                if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
-                    continue;
-                }
-                if (!iter->Pop(item)) {
-                    continue;
-                }
-                configName = iter->GetConfigName();
-                ResetCurrentQueueIndex();
-                return true;
-            }
+        if (PopExactlyOnceItem(i, threadNo, item, configName)) {
+            ResetCurrentQueueIndex();
+            return true;
         }
     }
     ResetCurrentQueueIndex();
+    return false;
+}
+
+bool ProcessQueueManager::PopExactlyOnceItem(uint32_t priority,
+                                             int64_t threadNo,
+                                             unique_ptr<ProcessQueueItem>& item,
+                                             string& configName) {
+    lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
+    for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[priority].begin();
+         iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[priority].end();
+         ++iter) {
+        // process queue for exactly once can only be assgined to one specific thread
+        if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
+            continue;
+        }
+        if (!iter->Pop(item)) {
+            continue;
+        }
+        configName = iter->GetConfigName();
+        return true;
+    }
+    return false;
+}
+
+bool ProcessQueueManager::PopItemByWorkStealing(int64_t threadNo,
+                                                unique_ptr<ProcessQueueItem>& item,
+                                                string& configName) {
+    if (mRescheduleNeeded.exchange(false)) {
+        shared_lock<shared_mutex> lock(mQueueMux);
+        ScheduleAllQueues();
+    }
+    uint32_t curThreadNo = threadNo % mThreadQueueKeys.size();
+    for (uint32_t i = 0; i <= sMaxPriority; ++i) {
+        QueueKey key = 0;
+        while (TakeQueueKey(curThreadNo, i, key)) {
+            shared_lock<shared_mutex> lock(mQueueMux);
+            auto iter = mQueues.find(key);
+            if (iter == mQueues.end()) {
+                continue;
+            }
+            auto& que = **iter->second.first;
+            lock_guard<mutex> queLock(que.GetMutex());
+            if (!que.IsScheduled()) {
+                // stale key left by a queue recreated with the same key
+                continue;
+            }
+            if (!que.Pop(item)) {
+                // the queue is either empty or invalid to pop, it will be scheduled again on push, EnablePop or
+                // feedback from downstream queues
+                que.SetScheduled(false);
+                continue;
+            }
+            configName = que.GetConfigName();
+            if (que.Empty()) {
+                que.SetScheduled(false);
+            } else {
+                // put the key back before processing the item, so that idle threads can steal the rest of the queue
+                ScheduleQueue(key, que.GetPriority(), curThreadNo);
+                Trigger();
+            }
+            return true;
+        }
+        // find exactly once queues next
+        if (PopExactlyOnceItem(i, threadNo, item, configName)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ProcessQueueManager::TakeQueueKey(uint32_t threadNo, uint32_t priority, QueueKey& key) {
     {
-        unique_lock<mutex> lock(mStateMux);
-        mValidToPop = false;
+        auto& keys = *mThreadQueueKeys[threadNo];
+        lock_guard<mutex> lock(keys.mMux);
+        if (!keys.mKeys[priority].empty()) {
+            key = keys.mKeys[priority].front();
+            keys.mKeys[priority].pop_front();
+            return true;
+        }
+    }
+    for (size_t i = 1; i < mThreadQueueKeys.size(); ++i) {
+        auto& keys = *mThreadQueueKeys[(threadNo + i) % mThreadQueueKeys.size()];
+        lock_guard<mutex> lock(keys.mMux);
+        if (!keys.mKeys[priority].empty()) {
+            key = keys.mKeys[priority].back();
+            keys.mKeys[priority].pop_back();
+            return true;
+        }
     }
     return false;
 }
 
+void ProcessQueueManager::ScheduleQueue(QueueKey key, uint32_t priority, uint32_t threadNo) {
+    auto& keys = *mThreadQueueKeys[threadNo];
+    lock_guard<mutex> lock(keys.mMux);
+    keys.mKeys[priority].push_back(key);
+}
+
+void ProcessQueueManager::ScheduleQueueIfNeeded(ProcessQueueInterface& que) {
+    if (que.IsScheduled() || que.Empty()) {
+        return;
+    }
+    que.SetScheduled(true);
+    // queues of the same key always start from the same thread for better cache locality
+    ScheduleQueue(que.GetKey(), que.GetPriority(), que.GetKey() % mThreadQueueKeys.size());
+}
+
+void ProcessQueueManager::ScheduleAllQueues() {
+    for (const auto& q : mQueues) {
+        auto& que = **q.second.first;
+        lock_guard<mutex> queLock(que.GetMutex());
+        ScheduleQueueIfNeeded(que);
+    }
+}
+
 bool ProcessQueueManager::IsAllQueueEmpty() const {
     {
-        lock_guard<mutex> lock(mQueueMux);
+        shared_lock<shared_mutex> lock(mQueueMux);
         for (const auto& q : mQueues) {
+            lock_guard<mutex> queLock((*q.second.first)->GetMutex());
             if (!(*q.second.first)->Empty()) {
                 return false;
             }
@@ -209,17 +350,22 @@ bool ProcessQueueManager::IsAllQueueEmpty() const {
 }
 
 bool ProcessQueueManager::SetDownStreamQueues(QueueKey key, vector<BoundedSenderQueueInterface*>&& ques) {
-    lock_guard<mutex> lock(mQueueMux);
+    shared_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
     }
-    (*iter->second.first)->SetDownStreamQueues(std::move(ques));
+    auto& que = **iter->second.first;
+    lock_guard<mutex> queLock(que.GetMutex());
+    que.SetDownStreamQueues(std::move(ques));
+    if (mWorkStealing) {
+        ScheduleQueueIfNeeded(que);
+    }
     return true;
 }
 
 bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInterface*>&& feedback) {
-    lock_guard<mutex> lock(mQueueMux);
+    shared_lock<shared_mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter == mQueues.end()) {
         return false;
@@ -227,6 +373,7 @@ bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInte
     if (iter->second.second == QueueType::CIRCULAR) {
         return false;
     }
+    lock_guard<mutex> queLock((*iter->second.first)->GetMutex());
     static_cast<BoundedProcessQueue*>(iter->second.first->get())->SetUpStreamFeedbacks(std::move(feedback));
     return true;
 }
@@ -234,9 +381,10 @@ bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInte
 void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRemoving) {
     if (QueueKeyManager::GetInstance()->HasKey(configName)) {
         auto key = QueueKeyManager::GetInstance()->GetKey(configName);
-        lock_guard<mutex> lock(mQueueMux);
+        shared_lock<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            lock_guard<mutex> queLock((*iter->second.first)->GetMutex());
             (*iter->second.first)->DisablePop();
         }
     } else {
@@ -247,10 +395,15 @@ void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRe
 void ProcessQueueManager::EnablePop(const string& configName) {
     if (QueueKeyManager::GetInstance()->HasKey(configName)) {
         auto key = QueueKeyManager::GetInstance()->GetKey(configName);
-        lock_guard<mutex> lock(mQueueMux);
+        shared_lock<shared_mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
-            (*iter->second.first)->EnablePop();
+            auto& que = **iter->second.first;
+            lock_guard<mutex> queLock(que.GetMutex());
+            que.EnablePop();
+            if (mWorkStealing) {
+                ScheduleQueueIfNeeded(que);
+            }
         }
     } else {
         ExactlyOnceQueueManager::GetInstance()->EnablePopProcessQueue(configName);
@@ -260,22 +413,46 @@ void ProcessQueueManager::EnablePop(const string& configName) {
 bool ProcessQueueManager::Wait(uint64_t ms) {
     // TODO: use semaphore instead
     unique_lock<mutex> lock(mStateMux);
-    mCond.wait_for(lock, chrono::milliseconds(ms), [this] { return mValidToPop; });
-    if (mValidToPop) {
-        mValidToPop = false;
+    ++mWaitingThreadCnt;
+    bool res = mCond.wait_for(lock, chrono::milliseconds(ms), [this] { return mValidToPop.load(); });
+    --mWaitingThreadCnt;
+    if (res) {
+        // the state is left to PopItem to clear
         return true;
     }
+    if (mWorkStealing) {
+        // rescan all queues when idle in case some wakeup is missed
+        mRescheduleNeeded = true;
+    }
     return false;
 }
 
 void ProcessQueueManager::Trigger() {
+    // busy pushes do not contend on mStateMux when there is no idle thread to wake up, otherwise each push wakes up
+    // one more idle thread
+    if (mValidToPop.exchange(true) && mWaitingThreadCnt.load() == 0) {
+        return;
+    }
     {
+        // make sure the waiting thread either sees the new state or is already blocked before notification
         lock_guard<mutex> lock(mStateMux);
-        mValidToPop = true;
     }
     mCond.notify_one();
 }
 
+void ProcessQueueManager::EnableWorkStealing(uint32_t threadCnt) {
+    unique_lock<shared_mutex> lock(mQueueMux);
+    mThreadQueueKeys.clear();
+    for (uint32_t i = 0; i < max(threadCnt, 1U); ++i) {
+        mThreadQueueKeys.emplace_back(make_unique<ThreadQueueKeys>());
+    }
+    for (const auto& q : mQueues) {
+        (*q.second.first)->SetScheduled(false);
+    }
+    mWorkStealing = true;
+    ScheduleAllQueues();
+}
+
 void ProcessQueueManager::CreateBoundedQueue(QueueKey key, uint32_t priority, const CollectionPipelineContext& ctx) {
     mPriorityQueue[priority].emplace_back(make_unique<BoundedProcessQueue>(mBoundedQueueParam.GetCapacity(),
                                                                            mBoundedQueueParam.GetLowWatermark(),
@@ -327,12 +504,18 @@ void ProcessQueueManager::ResetCurrentQueueIndex() {
 
 #ifdef APSARA_UNIT_TEST_MAIN
 void ProcessQueueManager::Clear() {
-    lock_guard<mutex> lock(mQueueMux);
+    unique_lock<shared_mutex> lock(mQueueMux);
     mQueues.clear();
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         mPriorityQueue[i].clear();
     }
     ResetCurrentQueueIndex();
+    for (auto& keys : mThreadQueueKeys) {
+        lock_guard<mutex> keysLock(keys->mMux);
+        for (size_t i = 0; i <= sMaxPriority; ++i) {
+            keys->mKeys[i].clear();
+        }
+    }
 }
 #endif
 
@@ -18,10 +18,13 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -53,7 +56,7 @@ public:
         return &instance;
     }
 
-    void Feedback(QueueKey key) override { Trigger(); }
+    void Feedback(QueueKey key) override;
 
     bool CreateOrUpdateBoundedQueue(QueueKey key, uint32_t priority, const CollectionPipelineContext& ctx);
     bool
@@ -72,7 +75,17 @@ public:
     bool Wait(uint64_t ms);
     void Trigger();
 
+    // In work stealing mode, each processor thread owns deques of keys of queues ready to pop, one per priority, and
+    // steals keys from other threads when its own deques are used up. This keeps the critical section of PopItem
+    // constant regardless of the number of queues. Should be called before any processor thread starts.
+    void EnableWorkStealing(uint32_t threadCnt);
+
 private:
+    struct ThreadQueueKeys {
+        std::mutex mMux;
+        std::deque<QueueKey> mKeys[sMaxPriority + 1];
+    };
+
     ProcessQueueManager();
     ~ProcessQueueManager() = default;
 
@@ -81,17 +94,40 @@ private:
     void AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority);
     void DeleteQueueEntity(const ProcessQueueIterator& iter);
     void ResetCurrentQueueIndex();
+    bool PopExactlyOnceItem(uint32_t priority,
+                            int64_t threadNo,
+                            std::unique_ptr<ProcessQueueItem>& item,
+                            std::string& configName);
+
+    bool ScanQueues(int64_t threadNo, std::unique_ptr<ProcessQueueItem>& item, std::string& configName);
+    bool PopItemByWorkStealing(int64_t threadNo, std::unique_ptr<ProcessQueueItem>& item, std::string& configName);
+    bool TakeQueueKey(uint32_t threadNo, uint32_t priority, QueueKey& key);
+    void ScheduleQueue(QueueKey key, uint32_t priority, uint32_t threadNo);
+    // should be called with mQueueMux and the lock of que held
+    void ScheduleQueueIfNeeded(ProcessQueueInterface& que);
+    // should be called with mQueueMux held
+    void ScheduleAllQueues();
 
     BoundedQueueParam mBoundedQueueParam;
 
-    mutable std::mutex mQueueMux;
+    // mQueueMux guards the registry of queues below. It is held exclusively only when queues are created, deleted or
+    // change priority, and in shared mode otherwise, with the lock of the accessed queue held as well. Thus pushes to
+    // different queues never block each other.
+    mutable std::shared_mutex mQueueMux;
     std::unordered_map<QueueKey, std::pair<ProcessQueueIterator, QueueType>> mQueues;
     std::list<std::unique_ptr<ProcessQueueInterface>> mPriorityQueue[sMaxPriority + 1];
+    std::mutex mCurrentQueueIndexMux;
     std::pair<uint32_t, ProcessQueueIterator> mCurrentQueueIndex;
 
+    std::atomic_bool mWorkStealing = false;
+    std::vector<std::unique_ptr<ThreadQueueKeys>> mThreadQueueKeys;
+    // set when queues which failed to pop may become valid to pop again, e.g. downstream queues get space
+    std::atomic_bool mRescheduleNeeded = false;
+
     mutable std::mutex mStateMux;
     mutable std::condition_variable mCond;
-    bool mValidToPop = false;
+    std::atomic_bool mValidToPop = false;
+    std::atomic_uint32_t mWaitingThreadCnt = 0;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
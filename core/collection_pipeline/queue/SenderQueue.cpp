@@ -38,10 +38,7 @@ bool SenderQueue::Push(unique_ptr<SenderQueueItem>&& item) {
     ADD_COUNTER(mInItemDataSizeBytes, size);
 
     if (Full()) {
-        mExtraBuffer.push_back(std::move(item));
-
-        SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
-        ADD_GAUGE(mExtraBufferDataSizeBytes, size);
+        PushToExtraBuffer(std::move(item));
         return true;
     }
 
@@ -92,13 +89,9 @@ bool SenderQueue::Remove(SenderQueueItem* item) {
     ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - enQueuTime);
     SUB_GAUGE(mQueueDataSizeByte, size);
 
-    if (!mExtraBuffer.empty()) {
-        auto newSize = mExtraBuffer.front()->mData.size();
-        PushFromExtraBuffer(std::move(mExtraBuffer.front()));
-        mExtraBuffer.pop_front();
-
-        SET_GAUGE(mExtraBufferSize, mExtraBuffer.size());
-        SUB_GAUGE(mExtraBufferDataSizeBytes, newSize);
+    auto extraItem = PopFromExtraBuffer();
+    if (extraItem) {
+        PushFromExtraBuffer(std::move(extraItem));
         return true;
     }
     if (ChangeStateIfNeededAfterPop()) {
@@ -24,6 +24,7 @@
 #include <string>
 
 #include "collection_pipeline/queue/QueueKey.h"
+#include "common/memory/PayloadBuffer.h"
 
 namespace logtail {
 
@@ -34,7 +35,8 @@ enum class SendingStatus { IDLE, SENDING };
 enum class RawDataType { EVENT_GROUP_LIST, EVENT_GROUP }; // the order must not be changed for backward compatibility
 
 struct SenderQueueItem {
-    std::string mData;
+    // shared by clones and http requests of the item
+    PayloadBuffer mData;
     size_t mRawSize = 0;
     RawDataType mType = RawDataType::EVENT_GROUP;
     bool mBufferOrNot = true;
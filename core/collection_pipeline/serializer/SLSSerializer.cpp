@@ -15,6 +15,9 @@
 #include "collection_pipeline/serializer/SLSSerializer.h"
 
 #include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
 #include <vector>
 
 #include "json/json.h"
@@ -35,6 +38,17 @@ using namespace std;
 
 namespace logtail {
 
+// keys of span contents cached in SLSEventContentCache, in the order of caching
+static const array<const string*, 6> kSpanCachedKeys = {&DEFAULT_TRACE_TAG_ATTRIBUTES,
+                                                        &DEFAULT_TRACE_TAG_LINKS,
+                                                        &DEFAULT_TRACE_TAG_EVENTS,
+                                                        &DEFAULT_TRACE_TAG_START_TIME_NANO,
+                                                        &DEFAULT_TRACE_TAG_END_TIME_NANO,
+                                                        &DEFAULT_TRACE_TAG_DURATION};
+
+// size of the chunks passed to the compressor in stream mode, small enough to stay in cache
+static const size_t kStreamChunkSize = 64 * 1024;
+
 std::string SerializeSpanLinksToString(const SpanEvent& event) {
     if (event.GetLinks().empty()) {
         return "";
@@ -58,7 +72,115 @@ std::string SerializeSpanEventsToString(const SpanEvent& event) {
     return Json::writeString(writer, jsonEvents);
 }
 
+void SLSEventContentCache::Reset(size_t eventCnt) {
+    mBuffer.clear();
+    mContents.clear();
+    mEvents.assign(eventCnt, EventItem());
+    mCurrentEvent = nullptr;
+}
+
+void SLSEventContentCache::Append(StringView content) {
+    AddContent(mBuffer.size(), content.size());
+    mBuffer.append(content.data(), content.size());
+}
+
+void SLSEventContentCache::AppendDouble(double value) {
+    // same format as std::to_string, which is kept for compatibility
+    static const size_t kInitialSize = 32;
+    size_t offset = mBuffer.size();
+    mBuffer.resize(offset + kInitialSize);
+    int len = snprintf(&mBuffer[offset], kInitialSize, "%f", value);
+    if (len < 0) {
+        len = 0;
+    } else if (static_cast<size_t>(len) >= kInitialSize) {
+        mBuffer.resize(offset + len + 1);
+        snprintf(&mBuffer[offset], len + 1, "%f", value);
+    }
+    mBuffer.resize(offset + len);
+    AddContent(offset, len);
+}
+
+void SLSEventContentCache::AppendUInt(uint64_t value) {
+    static const size_t kMaxUInt64Digits = 20;
+    size_t offset = mBuffer.size();
+    mBuffer.resize(offset + kMaxUInt64Digits);
+    char* end = to_chars(&mBuffer[offset], &mBuffer[offset] + kMaxUInt64Digits, value).ptr;
+    size_t len = end - &mBuffer[offset];
+    mBuffer.resize(offset + len);
+    AddContent(offset, len);
+}
+
 bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, string& errorMsg) {
+    // caculate serialized logGroup size first, where some critical results can be cached
+    vector<size_t> logSZ(group.mEvents.size());
+    thread_local SLSEventContentCache contentCache;
+    size_t logGroupSZ = 0;
+    if (!CalculateLogGroupSize(group, contentCache, logSZ, logGroupSZ, errorMsg)) {
+        return false;
+    }
+
+    // write directly into res, whose capacity is reused if the caller reuses it across groups
+    thread_local LogGroupSerializer serializer;
+    serializer.Prepare(res, logGroupSZ);
+    SerializeLogGroup(serializer, group, contentCache, logSZ);
+    serializer.GetResult();
+
+    // when function stablize, remove the following logic
+    if (BOOL_FLAG(debug_sls_serializer)) {
+        sls_logs::LogGroup logGroup;
+        if (!logGroup.ParseFromString(res)) {
+            JsonEventGroupSerializer ser(const_cast<Flusher*>(mFlusher));
+            string jsonStr;
+            ser.DoSerialize(std::move(group), jsonStr, errorMsg);
+            LOG_ERROR(sLogger,
+                      ("failed to parse log group", jsonStr)("config", mFlusher->GetContext().GetConfigName()));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SLSEventGroupSerializer::DoSerializeAndCompress(
+    BatchedEvents&& group, Compressor& compressor, string& output, size_t& rawSize, string& errorMsg) {
+    auto inputSize = GetInputSize(group);
+    ADD_COUNTER(mInItemsTotal, 1);
+    ADD_COUNTER(mInItemSizeBytes, inputSize);
+
+    // serialization time includes compression, which can not be separated in stream mode
+    auto before = chrono::system_clock::now();
+    vector<size_t> logSZ(group.mEvents.size());
+    thread_local SLSEventContentCache contentCache;
+    rawSize = 0;
+    bool res = CalculateLogGroupSize(group, contentCache, logSZ, rawSize, errorMsg);
+    if (res) {
+        res = compressor.DoStreamCompress(
+            rawSize,
+            [&](const CompressStreamInput& input) {
+                thread_local LogGroupSerializer serializer;
+                serializer.PrepareStream(kStreamChunkSize, input);
+                SerializeLogGroup(serializer, group, contentCache, logSZ);
+                return serializer.FinishStream();
+            },
+            output,
+            errorMsg);
+    }
+    ADD_COUNTER(mTotalProcessMs, chrono::system_clock::now() - before);
+
+    if (res) {
+        ADD_COUNTER(mOutItemsTotal, 1);
+        ADD_COUNTER(mOutItemSizeBytes, rawSize);
+    } else {
+        ADD_COUNTER(mDiscardedItemsTotal, 1);
+        ADD_COUNTER(mDiscardedItemSizeBytes, inputSize);
+    }
+    return res;
+}
+
+bool SLSEventGroupSerializer::CalculateLogGroupSize(const BatchedEvents& group,
+                                                    SLSEventContentCache& contentCache,
+                                                    vector<size_t>& logSZ,
+                                                    size_t& logGroupSZ,
+                                                    string& errorMsg) const {
     if (group.mEvents.empty()) {
         errorMsg = "empty event group";
         return false;
@@ -72,23 +194,19 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
     }
 
     bool enableNs = mFlusher->GetContext().GetGlobalConfig().mEnableTimestampNanosecond;
-
-    // caculate serialized logGroup size first, where some critical results can be cached
-    vector<size_t> logSZ(group.mEvents.size());
-    vector<MetricEventContentCacheItem> metricEventContentCache(group.mEvents.size());
-    vector<array<string, 6>> spanEventContentCache(group.mEvents.size());
-    size_t logGroupSZ = 0;
+    contentCache.Reset(group.mEvents.size());
+    logGroupSZ = 0;
     switch (eventType) {
         case PipelineEvent::Type::LOG: {
             CalculateLogEventSize(group, logGroupSZ, logSZ, enableNs);
             break;
         }
         case PipelineEvent::Type::METRIC: {
-            CalculateMetricEventSize(group, logGroupSZ, metricEventContentCache, logSZ);
+            CalculateMetricEventSize(group, logGroupSZ, contentCache, logSZ);
             break;
         }
         case PipelineEvent::Type::SPAN:
-            CalculateSpanEventSize(group, logGroupSZ, spanEventContentCache, logSZ);
+            CalculateSpanEventSize(group, logGroupSZ, contentCache, logSZ);
             break;
         case PipelineEvent::Type::RAW:
             CalculateRawEventSize(group, logGroupSZ, logSZ, enableNs);
@@ -116,18 +234,23 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             + "\tsize limit: " + ToString(INT32_FLAG(max_send_log_group_size));
         return false;
     }
+    return true;
+}
 
-    thread_local LogGroupSerializer serializer;
-    serializer.Prepare(logGroupSZ);
-    switch (eventType) {
+void SLSEventGroupSerializer::SerializeLogGroup(LogGroupSerializer& serializer,
+                                                BatchedEvents& group,
+                                                const SLSEventContentCache& contentCache,
+                                                vector<size_t>& logSZ) const {
+    bool enableNs = mFlusher->GetContext().GetGlobalConfig().mEnableTimestampNanosecond;
+    switch (group.mEvents[0]->GetType()) {
         case PipelineEvent::Type::LOG:
             SerializeLogEvent(serializer, group, logSZ, enableNs);
             break;
         case PipelineEvent::Type::METRIC:
-            SerializeMetricEvent(serializer, group, metricEventContentCache, logSZ);
+            SerializeMetricEvent(serializer, group, contentCache, logSZ);
             break;
         case PipelineEvent::Type::SPAN:
-            SerializeSpanEvent(serializer, group, spanEventContentCache, logSZ);
+            SerializeSpanEvent(serializer, group, contentCache, logSZ);
             break;
         case PipelineEvent::Type::RAW:
             SerializeRawEvent(serializer, group, logSZ, enableNs);
@@ -146,21 +269,6 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             serializer.AddLogTag(tag.first, tag.second);
         }
     }
-    res = std::move(serializer.GetResult());
-
-    // when function stablize, remove the following logic
-    if (BOOL_FLAG(debug_sls_serializer)) {
-        sls_logs::LogGroup logGroup;
-        if (!logGroup.ParseFromString(res)) {
-            JsonEventGroupSerializer ser(const_cast<Flusher*>(mFlusher));
-            string jsonStr;
-            ser.DoSerialize(std::move(group), jsonStr, errorMsg);
-            LOG_ERROR(sLogger,
-                      ("failed to parse log group", jsonStr)("config", mFlusher->GetContext().GetConfigName()));
-            return false;
-        }
-    }
-    return true;
 }
 
 void SLSEventGroupSerializer::CalculateLogEventSize(const BatchedEvents& group,
@@ -183,7 +291,7 @@ void SLSEventGroupSerializer::CalculateLogEventSize(const BatchedEvents& group,
 void SLSEventGroupSerializer::CalculateMetricEventSize(
     const BatchedEvents& group,
     size_t& logGroupSZ,
-    std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+    SLSEventContentCache& contentCache,
     std::vector<size_t>& logSZ) const {
     for (size_t i = 0; i < group.mEvents.size(); ++i) {
         const auto& e = group.mEvents[i].Cast<MetricEvent>();
@@ -193,17 +301,16 @@ void SLSEventGroupSerializer::CalculateMetricEventSize(
                             "config", mFlusher->GetContext().GetConfigName()));
             continue;
         }
+        contentCache.StartEvent(i);
         if (e.Is<UntypedSingleValue>()) {
-            metricEventContentCache[i].mMetricEventContentCache.push_back(
-                to_string(e.GetValue<UntypedSingleValue>()->mValue));
-            metricEventContentCache[i].mLabelSize = GetMetricLabelSize(e);
+            contentCache.AppendDouble(e.GetValue<UntypedSingleValue>()->mValue);
+            contentCache.SetMetricLabelSize(i, GetMetricLabelSize(e));
             size_t contentSZ = 0;
             contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_NAME.size(), e.GetName().size());
-            contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_VALUE.size(),
-                                           metricEventContentCache[i].mMetricEventContentCache[0].size());
+            contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_VALUE.size(), contentCache.GetContent(i, 0).size());
             contentSZ
                 += GetLogContentSize(METRIC_RESERVED_KEY_TIME_NANO.size(), e.GetTimestampNanosecond() ? 19U : 10U);
-            contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), metricEventContentCache[i].mLabelSize);
+            contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), contentCache.GetMetricLabelSize(i));
             logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
         } else if (e.Is<UntypedMultiDoubleValues>()) {
             if (e.GetValue<UntypedMultiDoubleValues>()->ValuesSize() == 0) {
@@ -220,10 +327,10 @@ void SLSEventGroupSerializer::CalculateMetricEventSize(
                 contentSZ += GetLogContentSize(it->first.size(), it->second.size());
             }
             const auto* const multiValue = e.GetValue<UntypedMultiDoubleValues>();
+            size_t valueIdx = 0;
             for (auto it = multiValue->ValuesBegin(); it != multiValue->ValuesEnd(); ++it) {
-                string valueStr = to_string(it->second.Value);
-                metricEventContentCache[i].mMetricEventContentCache.push_back(valueStr); // value
-                contentSZ += GetLogContentSize(it->first.size(), valueStr.size());
+                contentCache.AppendDouble(it->second.Value);
+                contentSZ += GetLogContentSize(it->first.size(), contentCache.GetContent(i, valueIdx++).size());
             }
             logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
         } else {
@@ -237,10 +344,11 @@ void SLSEventGroupSerializer::CalculateMetricEventSize(
 
 void SLSEventGroupSerializer::CalculateSpanEventSize(const BatchedEvents& group,
                                                      size_t& logGroupSZ,
-                                                     std::vector<std::array<std::string, 6>>& spanEventContentCache,
+                                                     SLSEventContentCache& contentCache,
                                                      std::vector<size_t>& logSZ) const {
     for (size_t i = 0; i < group.mEvents.size(); ++i) {
         const auto& e = group.mEvents[i].Cast<SpanEvent>();
+        contentCache.StartEvent(i);
         size_t contentSZ = 0;
         contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_TRACE_ID.size(), e.GetTraceId().size());
         contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_SPAN_ID.size(), e.GetSpanId().size());
@@ -259,26 +367,18 @@ void SLSEventGroupSerializer::CalculateSpanEventSize(const BatchedEvents& group,
             jsonVal[it->first.to_string()] = it->second.to_string();
         }
         Json::StreamWriterBuilder writer;
-        std::string attrString = Json::writeString(writer, jsonVal);
-        contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_ATTRIBUTES.size(), attrString.size());
-        spanEventContentCache[i][0] = std::move(attrString);
-        auto linkString = SerializeSpanLinksToString(e);
-        contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_LINKS.size(), linkString.size());
-        spanEventContentCache[i][1] = std::move(linkString);
-        auto eventString = SerializeSpanEventsToString(e);
-        contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_EVENTS.size(), eventString.size());
-        spanEventContentCache[i][2] = std::move(eventString);
+        contentCache.Append(Json::writeString(writer, jsonVal));
+        contentCache.Append(SerializeSpanLinksToString(e));
+        contentCache.Append(SerializeSpanEventsToString(e));
 
         // time related
-        auto startTsNs = std::to_string(e.GetStartTimeNs());
-        contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_START_TIME_NANO.size(), startTsNs.size());
-        spanEventContentCache[i][3] = std::move(startTsNs);
-        auto endTsNs = std::to_string(e.GetEndTimeNs());
-        contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_END_TIME_NANO.size(), endTsNs.size());
-        spanEventContentCache[i][4] = std::move(endTsNs);
-        auto durationNs = std::to_string(e.GetEndTimeNs() - e.GetStartTimeNs());
-        contentSZ += GetLogContentSize(DEFAULT_TRACE_TAG_DURATION.size(), durationNs.size());
-        spanEventContentCache[i][5] = std::move(durationNs);
+        contentCache.AppendUInt(e.GetStartTimeNs());
+        contentCache.AppendUInt(e.GetEndTimeNs());
+        contentCache.AppendUInt(e.GetEndTimeNs() - e.GetStartTimeNs());
+
+        for (size_t j = 0; j < kSpanCachedKeys.size(); ++j) {
+            contentSZ += GetLogContentSize(kSpanCachedKeys[j]->size(), contentCache.GetContent(i, j).size());
+        }
         logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
     }
 }
@@ -335,7 +435,7 @@ void SLSEventGroupSerializer::SerializeLogEvent(LogGroupSerializer& serializer,
 //      value2: 456
 void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serializer,
                                                    BatchedEvents& group,
-                                                   std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+                                                   const SLSEventContentCache& contentCache,
                                                    std::vector<size_t>& logSZ) const {
     for (size_t i = 0; i < group.mEvents.size(); ++i) {
         auto& e = group.mEvents[i].Cast<MetricEvent>();
@@ -343,7 +443,7 @@ void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serialize
             continue;
         }
         if (e.Is<UntypedSingleValue>()) {
-            if (metricEventContentCache[i].mMetricEventContentCache.empty()) {
+            if (contentCache.GetContentCount(i) == 0) {
                 LOG_ERROR(sLogger,
                           ("metric event single value size mismatch", "should never happen")(
                               "config", mFlusher->GetContext().GetConfigName())("expected", 1)("actual", 0));
@@ -352,17 +452,17 @@ void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serialize
             serializer.StartToAddLog(logSZ[i]);
             serializer.AddLogTime(e.GetTimestamp());
             e.SortTags();
-            serializer.AddLogContentMetricLabel(e, metricEventContentCache[i].mLabelSize);
+            serializer.AddLogContentMetricLabel(e, contentCache.GetMetricLabelSize(i));
             serializer.AddLogContentMetricTimeNano(e);
-            serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, metricEventContentCache[i].mMetricEventContentCache[0]);
+            serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, contentCache.GetContent(i, 0));
             serializer.AddLogContent(METRIC_RESERVED_KEY_NAME, e.GetName());
         } else if (e.Is<UntypedMultiDoubleValues>()) {
             const auto* const multiValue = e.GetValue<UntypedMultiDoubleValues>();
-            if (metricEventContentCache[i].mMetricEventContentCache.size() != multiValue->ValuesSize()) {
+            if (contentCache.GetContentCount(i) != multiValue->ValuesSize()) {
                 LOG_ERROR(sLogger,
                           ("metric event multi value size mismatch", "should never happen")(
                               "config", mFlusher->GetContext().GetConfigName())("expected", multiValue->ValuesSize())(
-                              "actual", metricEventContentCache[i].mMetricEventContentCache.size()));
+                              "actual", contentCache.GetContentCount(i)));
                 continue;
             }
             serializer.StartToAddLog(logSZ[i]);
@@ -373,8 +473,7 @@ void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serialize
             }
             size_t currentValueIdx = 0;
             for (auto it = multiValue->ValuesBegin(); it != multiValue->ValuesEnd(); ++it) {
-                serializer.AddLogContent(it->first,
-                                         metricEventContentCache[i].mMetricEventContentCache[currentValueIdx]);
+                serializer.AddLogContent(it->first, contentCache.GetContent(i, currentValueIdx));
                 ++currentValueIdx;
             }
         } else {
@@ -385,7 +484,7 @@ void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serialize
 
 void SLSEventGroupSerializer::SerializeSpanEvent(LogGroupSerializer& serializer,
                                                  const BatchedEvents& group,
-                                                 std::vector<std::array<std::string, 6>>& spanEventContentCache,
+                                                 const SLSEventContentCache& contentCache,
                                                  std::vector<size_t>& logSZ) const {
     for (size_t i = 0; i < group.mEvents.size(); ++i) {
         const auto& spanEvent = group.mEvents[i].Cast<SpanEvent>();
@@ -405,17 +504,10 @@ void SLSEventGroupSerializer::SerializeSpanEvent(LogGroupSerializer& serializer,
         // trace state
         serializer.AddLogContent(DEFAULT_TRACE_TAG_TRACE_STATE, spanEvent.GetTraceState());
 
-        serializer.AddLogContent(DEFAULT_TRACE_TAG_ATTRIBUTES, spanEventContentCache[i][0]);
-
-        serializer.AddLogContent(DEFAULT_TRACE_TAG_LINKS, spanEventContentCache[i][1]);
-        serializer.AddLogContent(DEFAULT_TRACE_TAG_EVENTS, spanEventContentCache[i][2]);
-
-        // start_time
-        serializer.AddLogContent(DEFAULT_TRACE_TAG_START_TIME_NANO, spanEventContentCache[i][3]);
-        // end_time
-        serializer.AddLogContent(DEFAULT_TRACE_TAG_END_TIME_NANO, spanEventContentCache[i][4]);
-        // duration
-        serializer.AddLogContent(DEFAULT_TRACE_TAG_DURATION, spanEventContentCache[i][5]);
+        // attributes, links, events, start_time, end_time and duration
+        for (size_t j = 0; j < kSpanCachedKeys.size(); ++j) {
+            serializer.AddLogContent(*kSpanCachedKeys[j], contentCache.GetContent(i, j));
+        }
     }
 }
 
@@ -450,7 +542,8 @@ bool SLSEventGroupListSerializer::Serialize(vector<CompressedLogGroup>&& v, stri
         }
         package->set_compress_type(slsCompressType);
     }
-    res = logPackageList.SerializeAsString();
+    // written into res to keep the capacity reserved by the caller
+    logPackageList.SerializeToString(&res);
     return true;
 }
 
@@ -17,36 +17,93 @@
 #pragma once
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "collection_pipeline/serializer/Serializer.h"
+#include "common/compression/Compressor.h"
 #include "protobuf/sls/LogGroupSerializer.h"
 
 namespace logtail {
 
-struct MetricEventContentCacheItem {
-    std::vector<std::string> mMetricEventContentCache;
-    size_t mLabelSize = 0;
+// Contents rendered while calculating the log group size, e.g. metric values and span attributes, so that they are
+// not rendered twice. All contents are stored back to back in one buffer, which is reused across log groups.
+class SLSEventContentCache {
+public:
+    void Reset(size_t eventCnt);
+    // following calls of Append* add contents to event idx
+    void StartEvent(size_t idx) {
+        mCurrentEvent = &mEvents[idx];
+        mCurrentEvent->mFirstContent = mContents.size();
+    }
+    void Append(StringView content);
+    void AppendDouble(double value);
+    void AppendUInt(uint64_t value);
+
+    size_t GetContentCount(size_t idx) const { return mEvents[idx].mContentCnt; }
+    StringView GetContent(size_t idx, size_t contentIdx) const {
+        const auto& content = mContents[mEvents[idx].mFirstContent + contentIdx];
+        return StringView(mBuffer.data() + content.first, content.second);
+    }
+    // only used for single value metric events
+    void SetMetricLabelSize(size_t idx, size_t size) { mEvents[idx].mMetricLabelSize = size; }
+    size_t GetMetricLabelSize(size_t idx) const { return mEvents[idx].mMetricLabelSize; }
+
+private:
+    struct EventItem {
+        size_t mFirstContent = 0;
+        size_t mContentCnt = 0;
+        size_t mMetricLabelSize = 0;
+    };
+
+    void AddContent(size_t offset, size_t size) {
+        mContents.emplace_back(offset, size);
+        ++mCurrentEvent->mContentCnt;
+    }
+
+    std::string mBuffer;
+    // offset and size in mBuffer
+    std::vector<std::pair<size_t, size_t>> mContents;
+    std::vector<EventItem> mEvents;
+    EventItem* mCurrentEvent = nullptr;
 };
 
 class SLSEventGroupSerializer : public Serializer<BatchedEvents> {
 public:
     SLSEventGroupSerializer(Flusher* f) : Serializer<BatchedEvents>(f) {}
 
+    // serialize the log group chunk by chunk into the compressor, which must support streaming, so that the
+    // uncompressed log group is never materialized. rawSize is set to the size of the uncompressed log group.
+    bool DoSerializeAndCompress(BatchedEvents&& p,
+                                Compressor& compressor,
+                                std::string& output,
+                                size_t& rawSize,
+                                std::string& errorMsg);
+
 private:
     bool Serialize(BatchedEvents&& p, std::string& res, std::string& errorMsg) override;
 
+    bool CalculateLogGroupSize(const BatchedEvents& group,
+                               SLSEventContentCache& contentCache,
+                               std::vector<size_t>& logSZ,
+                               size_t& logGroupSZ,
+                               std::string& errorMsg) const;
+    void SerializeLogGroup(LogGroupSerializer& serializer,
+                           BatchedEvents& group,
+                           const SLSEventContentCache& contentCache,
+                           std::vector<size_t>& logSZ) const;
+
     void CalculateLogEventSize(const BatchedEvents& group,
                                size_t& logGroupSZ,
                                std::vector<size_t>& logSZ,
                                bool enableNs) const;
     void CalculateMetricEventSize(const BatchedEvents& group,
                                   size_t& logGroupSZ,
-                                  std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+                                  SLSEventContentCache& contentCache,
                                   std::vector<size_t>& logSZ) const;
     void CalculateSpanEventSize(const BatchedEvents& group,
                                 size_t& logGroupSZ,
-                                std::vector<std::array<std::string, 6>>& spanEventContentCache,
+                                SLSEventContentCache& contentCache,
                                 std::vector<size_t>& logSZ) const;
     void CalculateRawEventSize(const BatchedEvents& group,
                                size_t& logGroupSZ,
@@ -59,11 +116,11 @@ private:
                            bool enableNs) const;
     void SerializeMetricEvent(LogGroupSerializer& serializer,
                               BatchedEvents& group,
-                              std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+                              const SLSEventContentCache& contentCache,
                               std::vector<size_t>& logSZ) const;
     void SerializeSpanEvent(LogGroupSerializer& serializer,
                             const BatchedEvents& group,
-                            std::vector<std::array<std::string, 6>>& spanEventContentCache,
+                            const SLSEventContentCache& contentCache,
                             std::vector<size_t>& logSZ) const;
     void SerializeRawEvent(LogGroupSerializer& serializer,
                            const BatchedEvents& group,
@@ -0,0 +1,382 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/CompiledTimeFormat.h"
+
+#include <cctype>
+#include <cstring>
+
+namespace logtail {
+
+static const int kYearBase = 1900;
+
+struct Name {
+    const char* mName;
+    size_t mLength;
+};
+
+// full names are checked before abbreviations, the same as Strptime
+static const Name kMonthNames[] = {
+    {"January", 7}, {"February", 8}, {"March", 5},     {"April", 5},   {"May", 3},      {"June", 4},
+    {"July", 4},    {"August", 6},   {"September", 9}, {"October", 7}, {"November", 8}, {"December", 8},
+    {"Jan", 3},     {"Feb", 3},      {"Mar", 3},       {"Apr", 3},     {"May", 3},      {"Jun", 3},
+    {"Jul", 3},     {"Aug", 3},      {"Sep", 3},       {"Oct", 3},     {"Nov", 3},      {"Dec", 3},
+};
+static const Name kWeekdayNames[] = {
+    {"Sunday", 6},
+    {"Monday", 6},
+    {"Tuesday", 7},
+    {"Wednesday", 9},
+    {"Thursday", 8},
+    {"Friday", 6},
+    {"Saturday", 8},
+    {"Sun", 3},
+    {"Mon", 3},
+    {"Tue", 3},
+    {"Wed", 3},
+    {"Thu", 3},
+    {"Fri", 3},
+    {"Sat", 3},
+};
+static const Name kAmPmNames[] = {{"AM", 2}, {"PM", 2}};
+
+static inline char ToLowerAscii(char c) {
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+// the same as the case insensitive comparison of Strptime in the C locale
+template <size_t N>
+static const char* FindName(const char* bp, const Name (&names)[N], size_t count, int& index) {
+    for (size_t i = 0; i < N; ++i) {
+        const char* name = names[i].mName;
+        size_t j = 0;
+        while (j < names[i].mLength && ToLowerAscii(bp[j]) == ToLowerAscii(name[j])) {
+            ++j;
+        }
+        if (j == names[i].mLength) {
+            index = static_cast<int>(i % count);
+            return bp + names[i].mLength;
+        }
+    }
+    return nullptr;
+}
+
+// the same as conv_num of Strptime, where the maximum also limits the number of digits
+static inline const char* ParseNumber(const char* bp, int& dest, unsigned int min, unsigned int max) {
+    unsigned char ch = *bp;
+    if (ch < '0' || ch > '9') {
+        return nullptr;
+    }
+    unsigned int result = 0;
+    unsigned int digitsLimit = max;
+    do {
+        result = result * 10 + (ch - '0');
+        digitsLimit /= 10;
+        ch = *++bp;
+    } while (result * 10 <= max && digitsLimit != 0 && ch >= '0' && ch <= '9');
+    if (result < min || result > max) {
+        return nullptr;
+    }
+    dest = static_cast<int>(result);
+    return bp;
+}
+
+// the same as conv_nanosecond of Strptime
+static inline const char* ParseNanosecond(const char* bp, long& nanosecond, int& nanosecondLength) {
+    unsigned char ch = *bp;
+    if (ch < '0' || ch > '9') {
+        return nullptr;
+    }
+    const char* start = bp;
+    unsigned int result = 0;
+    int digitNum = 0;
+    do {
+        result = result * 10 + (ch - '0');
+        ++digitNum;
+        ch = *++bp;
+    } while (ch >= '0' && ch <= '9');
+    for (int i = 0; i < 9 - digitNum; ++i) {
+        result *= 10;
+    }
+    nanosecond = result;
+    nanosecondLength = static_cast<int>(bp - start);
+    return bp;
+}
+
+void CompiledTimeFormat::AddNumber(Field field, uint16_t min, uint16_t max) {
+    Step step;
+    step.mType = StepType::NUMBER;
+    step.mField = field;
+    step.mMin = min;
+    step.mMax = max;
+    mSteps.push_back(step);
+}
+
+bool CompiledTimeFormat::CompileSteps(const char* fmt) {
+    for (char c = *fmt++; c != '\0'; c = *fmt++) {
+        Step step;
+        if (isspace(static_cast<unsigned char>(c))) {
+            step.mType = StepType::SPACE;
+            mSteps.push_back(step);
+            continue;
+        }
+        if (c != '%') {
+            step.mType = StepType::LITERAL;
+            step.mLiteral = c;
+            mSteps.push_back(step);
+            continue;
+        }
+        const char* expanded = nullptr;
+        switch (c = *fmt++) {
+            case '%':
+                step.mType = StepType::LITERAL;
+                step.mLiteral = '%';
+                mSteps.push_back(step);
+                break;
+            case 'c':
+                expanded = "%a %b %d %H:%M:%S %Y";
+                break;
+            case 'D':
+            case 'x':
+                expanded = "%m/%d/%y";
+                break;
+            case 'F':
+                expanded = "%Y-%m-%d";
+                break;
+            case 'R':
+                expanded = "%H:%M";
+                break;
+            case 'r':
+                expanded = "%I:%M:%S %p";
+                break;
+            case 'T':
+            case 'X':
+                expanded = "%H:%M:%S";
+                break;
+            case 'n':
+            case 't':
+                step.mType = StepType::SPACE;
+                mSteps.push_back(step);
+                break;
+            case 'A':
+            case 'a':
+                step.mType = StepType::WEEKDAY_NAME;
+                mSteps.push_back(step);
+                break;
+            case 'B':
+            case 'b':
+            case 'h':
+                step.mType = StepType::MONTH_NAME;
+                mSteps.push_back(step);
+                break;
+            case 'd':
+            case 'e':
+                AddNumber(Field::DAY, 1, 31);
+                break;
+            case 'f':
+                step.mType = StepType::NANOSECOND;
+                mSteps.push_back(step);
+                break;
+            case 'k':
+            case 'H':
+                AddNumber(Field::HOUR, 0, 23);
+                break;
+            case 'l':
+            case 'I':
+                AddNumber(Field::HOUR_12, 1, 12);
+                break;
+            case 'j':
+                AddNumber(Field::NONE, 1, 366);
+                break;
+            case 'M':
+                AddNumber(Field::MINUTE, 0, 59);
+                break;
+            case 'm':
+                AddNumber(Field::MONTH, 1, 12);
+                break;
+            case 'p':
+                step.mType = StepType::AM_PM;
+                mSteps.push_back(step);
+                break;
+            case 'S':
+                AddNumber(Field::SECOND, 0, 61);
+                break;
+            case 'U':
+            case 'W':
+            case 'V':
+                AddNumber(Field::NONE, 0, 53);
+                break;
+            case 'w':
+                AddNumber(Field::NONE, 0, 6);
+                break;
+            case 'u':
+                AddNumber(Field::NONE, 1, 7);
+                break;
+            case 'g':
+                AddNumber(Field::NONE, 0, 99);
+                break;
+            case 'Y':
+                AddNumber(Field::YEAR, 0, 9999);
+                break;
+            case 'y':
+                AddNumber(Field::YEAR_IN_CENTURY, 0, 99);
+                break;
+            default:
+                // %C, %G, %s, %Z, %z, %E?, %O? and unknown conversions
+                return false;
+        }
+        if (expanded != nullptr) {
+            // Strptime parses the expansion recursively, which resets the nanoseconds parsed before
+            for (const auto& prev : mSteps) {
+                if (prev.mType == StepType::NANOSECOND) {
+                    return false;
+                }
+            }
+            if (!CompileSteps(expanded)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool CompiledTimeFormat::Compile(const std::string& fmt, int32_t specifiedYear) {
+    mSteps.clear();
+    // Strptime does not compute seconds for %f alone
+    if (fmt == "%f" || !CompileSteps(fmt.c_str())) {
+        mSteps.clear();
+        return false;
+    }
+    int yearsInCentury = 0;
+    mHasYear = false;
+    for (const auto& step : mSteps) {
+        if (step.mType == StepType::NUMBER && (step.mField == Field::YEAR || step.mField == Field::YEAR_IN_CENTURY)) {
+            mHasYear = true;
+            yearsInCentury += step.mField == Field::YEAR_IN_CENTURY ? 1 : 0;
+        }
+    }
+    // the century of the first %y is kept by the following ones, and the year is either deduced from the current time
+    // or left invalid without a year or a specified one
+    if (yearsInCentury > 1 || (!mHasYear && specifiedYear <= 0)) {
+        mSteps.clear();
+        return false;
+    }
+    mFixedYear = specifiedYear - kYearBase;
+    return true;
+}
+
+const char* CompiledTimeFormat::Parse(const char* buf, LogtailTime* ts, int& nanosecondLength) const {
+    struct tm tm = {};
+    tm.tm_year = mFixedYear;
+    long nanosecond = 0;
+    int value = 0;
+    const char* bp = buf;
+    for (const auto& step : mSteps) {
+        switch (step.mType) {
+            case StepType::LITERAL:
+                if (*bp++ != step.mLiteral) {
+                    return nullptr;
+                }
+                break;
+            case StepType::SPACE:
+                while (isspace(static_cast<unsigned char>(*bp))) {
+                    ++bp;
+                }
+                break;
+            case StepType::NUMBER:
+                bp = ParseNumber(bp, value, step.mMin, step.mMax);
+                if (bp == nullptr) {
+                    return nullptr;
+                }
+                switch (step.mField) {
+                    case Field::YEAR:
+                        tm.tm_year = value - kYearBase;
+                        break;
+                    case Field::YEAR_IN_CENTURY:
+                        tm.tm_year = value <= 68 ? value + 2000 - kYearBase : value + 1900 - kYearBase;
+                        break;
+                    case Field::MONTH:
+                        tm.tm_mon = value - 1;
+                        break;
+                    case Field::DAY:
+                        tm.tm_mday = value;
+                        break;
+                    case Field::HOUR:
+                        tm.tm_hour = value;
+                        break;
+                    case Field::HOUR_12:
+                        tm.tm_hour = value == 12 ? 0 : value;
+                        break;
+                    case Field::MINUTE:
+                        tm.tm_min = value;
+                        break;
+                    case Field::SECOND:
+                        tm.tm_sec = value;
+                        break;
+                    default:
+                        break;
+                }
+                break;
+            case StepType::NANOSECOND:
+                bp = ParseNanosecond(bp, nanosecond, nanosecondLength);
+                if (bp == nullptr) {
+                    return nullptr;
+                }
+                break;
+            case StepType::MONTH_NAME:
+                bp = FindName(bp, kMonthNames, 12, tm.tm_mon);
+                if (bp == nullptr) {
+                    return nullptr;
+                }
+                break;
+            case StepType::WEEKDAY_NAME:
+                bp = FindName(bp, kWeekdayNames, 7, value);
+                if (bp == nullptr) {
+                    return nullptr;
+                }
+                break;
+            case StepType::AM_PM:
+                bp = FindName(bp, kAmPmNames, 2, value);
+                if (bp == nullptr || tm.tm_hour > 11) {
+                    return nullptr;
+                }
+                tm.tm_hour += value * 12;
+                break;
+        }
+    }
+
+    // The result of mktime is linear in seconds within a minute, as offsets of time zones only change at whole minutes.
+    // It depends on nothing but the fields and the local time zone, so the cache is shared by all formats in a thread.
+    struct MinuteCache {
+        int64_t mKey = -1;
+        time_t mSeconds = 0;
+    };
+    static thread_local MinuteCache sCache;
+    int64_t key = static_cast<int64_t>(tm.tm_year) + 2 * kYearBase;
+    key = (key * 12 + tm.tm_mon) * 32 + tm.tm_mday;
+    key = (key * 24 + tm.tm_hour) * 60 + tm.tm_min;
+    if (key != sCache.mKey) {
+        struct tm minute = tm;
+        minute.tm_sec = 0;
+        sCache.mSeconds = mktime(&minute);
+        sCache.mKey = key;
+    }
+    ts->tv_sec = sCache.mSeconds == static_cast<time_t>(-1) ? sCache.mSeconds : sCache.mSeconds + tm.tm_sec;
+    ts->tv_nsec = nanosecond;
+    return bp;
+}
+
+} // namespace logtail
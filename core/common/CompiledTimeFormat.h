@@ -0,0 +1,86 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "common/TimeUtil.h"
+
+namespace logtail {
+
+// A time format compiled into a list of steps, which parses texts the same way as Strptime without interpreting the
+// format again. Besides, mktime is called at most once for each minute of local time, and the seconds are added to its
+// result.
+//
+// Formats with conversions of time zones, epoch seconds, centuries or alternative representations, and formats without
+// year unless a fixed year is specified, are not compiled, and Strptime should be used for them instead.
+class CompiledTimeFormat {
+public:
+    // @return false if the format is not supported
+    bool Compile(const std::string& fmt, int32_t specifiedYear = -1);
+    bool IsCompiled() const { return !mSteps.empty(); }
+
+    // same as Strptime(buf, fmt, ts, nanosecondLength, specifiedYear), except that ts is left unchanged on failure
+    const char* Parse(const char* buf, LogtailTime* ts, int& nanosecondLength) const;
+
+private:
+    enum class StepType : uint8_t {
+        LITERAL,
+        SPACE,
+        NUMBER,
+        NANOSECOND,
+        MONTH_NAME,
+        WEEKDAY_NAME,
+        AM_PM,
+    };
+    // fields of struct tm set by numbers
+    enum class Field : uint8_t {
+        YEAR,
+        YEAR_IN_CENTURY,
+        MONTH,
+        DAY,
+        HOUR,
+        HOUR_12,
+        MINUTE,
+        SECOND,
+        // parsed, but not used by mktime
+        NONE,
+    };
+    struct Step {
+        StepType mType;
+        Field mField = Field::NONE;
+        char mLiteral = '\0';
+        uint16_t mMin = 0;
+        uint16_t mMax = 0;
+    };
+
+    bool CompileSteps(const char* fmt);
+    void AddNumber(Field field, uint16_t min, uint16_t max);
+
+    std::vector<Step> mSteps;
+    // used if there is no year in the format
+    int32_t mFixedYear = 0;
+    bool mHasYear = false;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CompiledTimeFormatUnittest;
+#endif
+};
+
+} // namespace logtail
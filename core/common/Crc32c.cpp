@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/Crc32c.h"
+
+#include <cstring>
+
+#include <array>
+
+#if (defined(__x86_64__) || defined(_M_X64)) && !defined(_MSC_VER)
+#define LOGTAIL_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#endif
+
+namespace logtail {
+
+// reflected polynomial of CRC-32C
+static const uint32_t kPoly = 0x82F63B78;
+
+static std::array<uint32_t, 256> MakeTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int j = 0; j < 8; ++j) {
+            crc = (crc >> 1) ^ ((crc & 1) ? kPoly : 0);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+static uint32_t Crc32cScalar(const char* data, size_t size, uint32_t crc) {
+    static const std::array<uint32_t, 256> sTable = MakeTable();
+    const auto* p = reinterpret_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        crc = sTable[(crc ^ p[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+#ifdef LOGTAIL_CRC32C_SSE42
+__attribute__((target("sse4.2"))) static uint32_t Crc32cSSE42(const char* data, size_t size, uint32_t crc) {
+    uint64_t crc64 = crc;
+    for (; size >= 8; size -= 8, data += 8) {
+        uint64_t word = 0;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+    }
+    crc = static_cast<uint32_t>(crc64);
+    for (; size > 0; --size, ++data) {
+        crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*data));
+    }
+    return crc;
+}
+
+static bool CpuSupportsSSE42() {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+#endif
+
+uint32_t Crc32c(const char* data, size_t size, uint32_t crc) {
+#ifdef LOGTAIL_CRC32C_SSE42
+    static const bool sSSE42 = CpuSupportsSSE42();
+    if (sSSE42) {
+        return ~Crc32cSSE42(data, size, ~crc);
+    }
+#endif
+    return ~Crc32cScalar(data, size, ~crc);
+}
+
+} // namespace logtail
@@ -0,0 +1,28 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace logtail {
+
+// CRC-32C (Castagnoli) of data, continuing from crc returned by a previous call on the preceding data.
+// The sse4.2 crc32 instruction is used when the cpu supports it.
+uint32_t Crc32c(const char* data, size_t size, uint32_t crc = 0);
+
+} // namespace logtail
@@ -0,0 +1,214 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/DelimiterScanner.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LOGTAIL_DELIMITER_SCANNER_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace logtail {
+
+#ifdef LOGTAIL_DELIMITER_SCANNER_X86
+
+#if defined(_MSC_VER)
+#define LOGTAIL_TARGET_AVX2
+static inline uint32_t CountTrailingZeros(uint32_t mask) {
+    unsigned long idx = 0;
+    _BitScanForward(&idx, mask);
+    return static_cast<uint32_t>(idx);
+}
+#else
+#define LOGTAIL_TARGET_AVX2 __attribute__((target("avx2")))
+static inline uint32_t CountTrailingZeros(uint32_t mask) {
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+}
+#endif
+
+static bool CpuSupportsAVX2() {
+#if defined(_MSC_VER)
+    int abcd[4] = {0, 0, 0, 0};
+    __cpuidex(abcd, 0, 0);
+    if (abcd[0] < 7) {
+        return false;
+    }
+    __cpuidex(abcd, 1, 0);
+    // OSXSAVE and AVX are required before XCR0 can be trusted
+    if ((abcd[2] & (1 << 27)) == 0 || (abcd[2] & (1 << 28)) == 0) {
+        return false;
+    }
+    if ((_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(abcd, 7, 0);
+    return (abcd[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+static inline void AppendMaskPositions(uint32_t mask, size_t base, std::vector<size_t>& positions) {
+    while (mask != 0) {
+        positions.push_back(base + CountTrailingZeros(mask));
+        mask &= mask - 1;
+    }
+}
+
+#endif
+
+void FindAllDelimitersScalar(const char* data, size_t size, char delim, std::vector<size_t>& positions) {
+    const char* cur = data;
+    const char* end = data + size;
+    while (cur < end) {
+        const void* hit = memchr(cur, delim, end - cur);
+        if (hit == nullptr) {
+            break;
+        }
+        const char* p = static_cast<const char*>(hit);
+        positions.push_back(p - data);
+        cur = p + 1;
+    }
+}
+
+void FindAllDelimitersSSE2(const char* data, size_t size, char delim, std::vector<size_t>& positions) {
+#ifdef LOGTAIL_DELIMITER_SCANNER_X86
+    const __m128i needle = _mm_set1_epi8(delim);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        AppendMaskPositions(mask, i, positions);
+    }
+    for (; i < size; ++i) {
+        if (data[i] == delim) {
+            positions.push_back(i);
+        }
+    }
+#else
+    FindAllDelimitersScalar(data, size, delim, positions);
+#endif
+}
+
+#ifdef LOGTAIL_DELIMITER_SCANNER_X86
+LOGTAIL_TARGET_AVX2 static void
+FindAllDelimitersAVX2Impl(const char* data, size_t size, char delim, std::vector<size_t>& positions) {
+    const __m256i needle = _mm256_set1_epi8(delim);
+    size_t i = 0;
+    // two 32-byte lanes per iteration, most chunks of single line logs contain no delimiter at all
+    for (; i + 64 <= size; i += 64) {
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        uint32_t loMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)));
+        uint32_t hiMask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle)));
+        if ((loMask | hiMask) == 0) {
+            continue;
+        }
+        AppendMaskPositions(loMask, i, positions);
+        AppendMaskPositions(hiMask, i + 32, positions);
+    }
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        AppendMaskPositions(
+            static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle))), i, positions);
+    }
+    for (; i < size; ++i) {
+        if (data[i] == delim) {
+            positions.push_back(i);
+        }
+    }
+}
+#endif
+
+bool IsDelimiterScannerImplSupported(DelimiterScannerImpl impl) {
+    switch (impl) {
+        case DelimiterScannerImpl::SCALAR:
+            return true;
+#ifdef LOGTAIL_DELIMITER_SCANNER_X86
+        case DelimiterScannerImpl::SSE2:
+            // SSE2 is part of the x86-64 baseline
+            return true;
+        case DelimiterScannerImpl::AVX2: {
+            static const bool sSupported = CpuSupportsAVX2();
+            return sSupported;
+        }
+#endif
+        default:
+            return false;
+    }
+}
+
+void FindAllDelimitersAVX2(const char* data, size_t size, char delim, std::vector<size_t>& positions) {
+#ifdef LOGTAIL_DELIMITER_SCANNER_X86
+    if (IsDelimiterScannerImplSupported(DelimiterScannerImpl::AVX2)) {
+        FindAllDelimitersAVX2Impl(data, size, delim, positions);
+        return;
+    }
+#endif
+    FindAllDelimitersScalar(data, size, delim, positions);
+}
+
+static DelimiterScannerImpl SelectDelimiterScannerImpl() {
+    if (IsDelimiterScannerImplSupported(DelimiterScannerImpl::AVX2)) {
+        return DelimiterScannerImpl::AVX2;
+    }
+    if (IsDelimiterScannerImplSupported(DelimiterScannerImpl::SSE2)) {
+        return DelimiterScannerImpl::SSE2;
+    }
+    return DelimiterScannerImpl::SCALAR;
+}
+
+DelimiterScannerImpl GetDelimiterScannerImpl() {
+    static const DelimiterScannerImpl sImpl = SelectDelimiterScannerImpl();
+    return sImpl;
+}
+
+const char* DelimiterScannerImplToString(DelimiterScannerImpl impl) {
+    switch (impl) {
+        case DelimiterScannerImpl::AVX2:
+            return "avx2";
+        case DelimiterScannerImpl::SSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+void FindAllDelimiters(const char* data, size_t size, char delim, std::vector<size_t>& positions) {
+    using ScanFunc = void (*)(const char*, size_t, char, std::vector<size_t>&);
+    static const ScanFunc sScan = []() -> ScanFunc {
+        switch (GetDelimiterScannerImpl()) {
+#ifdef LOGTAIL_DELIMITER_SCANNER_X86
+            case DelimiterScannerImpl::AVX2:
+                return FindAllDelimitersAVX2Impl;
+            case DelimiterScannerImpl::SSE2:
+                return FindAllDelimitersSSE2;
+#endif
+            default:
+                return FindAllDelimitersScalar;
+        }
+    }();
+    sScan(data, size, delim, positions);
+}
+
+} // namespace logtail
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <vector>
+
+namespace logtail {
+
+enum class DelimiterScannerImpl { SCALAR, SSE2, AVX2 };
+
+// Appends the offset of every occurrence of delim in [data, data + size) to positions in ascending order. The
+// implementation is chosen once at runtime according to the instruction sets supported by the current CPU.
+void FindAllDelimiters(const char* data, size_t size, char delim, std::vector<size_t>& positions);
+
+DelimiterScannerImpl GetDelimiterScannerImpl();
+const char* DelimiterScannerImplToString(DelimiterScannerImpl impl);
+
+// Explicit implementations, exposed for tests and benchmarks. Calling an implementation not supported by the
+// current CPU falls back to the scalar one.
+void FindAllDelimitersScalar(const char* data, size_t size, char delim, std::vector<size_t>& positions);
+void FindAllDelimitersSSE2(const char* data, size_t size, char delim, std::vector<size_t>& positions);
+void FindAllDelimitersAVX2(const char* data, size_t size, char delim, std::vector<size_t>& positions);
+bool IsDelimiterScannerImplSupported(DelimiterScannerImpl impl);
+
+} // namespace logtail
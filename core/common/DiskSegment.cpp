@@ -0,0 +1,384 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/DiskSegment.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include <algorithm>
+
+#include "common/Crc32c.h"
+#include "common/ErrorUtil.h"
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+static const char kSegmentMagic[8] = {'L', 'C', 'D', 'S', 'E', 'G', '0', '1'};
+static const uint32_t kSegmentVersion = 1;
+static const size_t kHeaderSize = 64;
+static const size_t kRecordHeaderSize = 8;
+// blocks are allocated by chunks ahead of writes instead of all at once, which would cost as much as writing the file
+static const size_t kAllocChunkSize = 4 * 1024 * 1024;
+
+static size_t AlignTo8(size_t size) {
+    return (size + 7) & ~static_cast<size_t>(7);
+}
+
+// returns the end of the last intact record
+static size_t ScanRecords(const char* data, size_t size, vector<pair<size_t, uint32_t>>* records, bool& truncated) {
+    truncated = false;
+    size_t offset = kHeaderSize;
+    while (offset + kRecordHeaderSize <= size) {
+        uint32_t bodySize = 0;
+        uint32_t crc = 0;
+        memcpy(&bodySize, data + offset, sizeof(bodySize));
+        memcpy(&crc, data + offset + sizeof(bodySize), sizeof(crc));
+        if (bodySize == 0) {
+            break;
+        }
+        if (bodySize > size - offset - kRecordHeaderSize
+            || Crc32c(data + offset + kRecordHeaderSize, bodySize) != crc) {
+            truncated = true;
+            break;
+        }
+        if (records != nullptr) {
+            records->emplace_back(offset + kRecordHeaderSize, bodySize);
+        }
+        offset += AlignTo8(kRecordHeaderSize + bodySize);
+    }
+    return offset < size ? offset : size;
+}
+
+static bool IsHeaderValid(const char* data, size_t size) {
+    if (size < kHeaderSize || memcmp(data, kSegmentMagic, sizeof(kSegmentMagic)) != 0) {
+        return false;
+    }
+    uint32_t version = 0;
+    memcpy(&version, data + sizeof(kSegmentMagic), sizeof(version));
+    return version == kSegmentVersion;
+}
+
+DiskSegmentWriter::~DiskSegmentWriter() {
+    if (IsOpen()) {
+        Seal();
+    }
+}
+
+bool DiskSegmentWriter::Open(const string& path, size_t capacity) {
+    if (IsOpen()) {
+        Seal();
+    }
+    const string writingPath = GetWritingPath(path);
+    int fd = open(writingPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG_WARNING(sLogger, ("failed to create disk segment", writingPath)("errno", ErrnoToString(GetErrno())));
+        return false;
+    }
+    size_t fileSize = kHeaderSize + AlignTo8(capacity);
+    // the file is sparse until blocks are allocated by Allocate()
+    if (ftruncate(fd, fileSize) != 0) {
+        LOG_WARNING(sLogger,
+                    ("failed to resize disk segment", writingPath)("size", fileSize)(
+                        "errno", ErrnoToString(GetErrno())));
+        close(fd);
+        unlink(writingPath.c_str());
+        return false;
+    }
+    void* data = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        LOG_WARNING(sLogger, ("failed to map disk segment", writingPath)("errno", ErrnoToString(GetErrno())));
+        close(fd);
+        unlink(writingPath.c_str());
+        return false;
+    }
+
+    mPath = path;
+    mFd = fd;
+    mData = static_cast<char*>(data);
+    mCapacity = fileSize;
+    mAllocatedSize = 0;
+    mSize = kHeaderSize;
+    mRecordCnt = 0;
+    if (!Allocate(kHeaderSize)) {
+        Unmap();
+        close(mFd);
+        mFd = -1;
+        unlink(writingPath.c_str());
+        return false;
+    }
+    memcpy(mData, kSegmentMagic, sizeof(kSegmentMagic));
+    memcpy(mData + sizeof(kSegmentMagic), &kSegmentVersion, sizeof(kSegmentVersion));
+    return true;
+}
+
+bool DiskSegmentWriter::Append(initializer_list<StringView> parts) {
+    if (!IsOpen()) {
+        return false;
+    }
+    size_t bodySize = 0;
+    for (const auto& part : parts) {
+        bodySize += part.size();
+    }
+    if (bodySize == 0 || bodySize > UINT32_MAX || GetRecordSize(bodySize) > mCapacity - mSize) {
+        return false;
+    }
+    if (mSize + GetRecordSize(bodySize) > mAllocatedSize && !Allocate(mSize + GetRecordSize(bodySize))) {
+        return false;
+    }
+
+    char* record = mData + mSize;
+    char* body = record + kRecordHeaderSize;
+    uint32_t crc = 0;
+    for (const auto& part : parts) {
+        memcpy(body, part.data(), part.size());
+        crc = Crc32c(body, part.size(), crc);
+        body += part.size();
+    }
+    uint32_t size32 = static_cast<uint32_t>(bodySize);
+    memcpy(record + sizeof(size32), &crc, sizeof(crc));
+    memcpy(record, &size32, sizeof(size32));
+    mLastRecordOffset = mSize;
+    mSize += GetRecordSize(bodySize);
+    ++mRecordCnt;
+    return true;
+}
+
+StringView DiskSegmentWriter::GetRecord(size_t offset) const {
+    if (!IsOpen() || offset < kHeaderSize || offset + kRecordHeaderSize > mSize) {
+        return StringView();
+    }
+    uint32_t bodySize = 0;
+    memcpy(&bodySize, mData + offset, sizeof(bodySize));
+    if (bodySize > mSize - offset - kRecordHeaderSize) {
+        return StringView();
+    }
+    return StringView(mData + offset + kRecordHeaderSize, bodySize);
+}
+
+bool DiskSegmentWriter::Seal() {
+    if (!IsOpen()) {
+        return false;
+    }
+    Unmap();
+    const string writingPath = GetWritingPath(mPath);
+    bool res = true;
+    if (ftruncate(mFd, mSize) != 0) {
+        LOG_WARNING(sLogger, ("failed to truncate disk segment", writingPath)("errno", ErrnoToString(GetErrno())));
+        res = false;
+    }
+    close(mFd);
+    mFd = -1;
+    if (res && rename(writingPath.c_str(), mPath.c_str()) != 0) {
+        LOG_WARNING(sLogger, ("failed to seal disk segment", writingPath)("errno", ErrnoToString(GetErrno())));
+        res = false;
+    }
+    return res;
+}
+
+bool DiskSegmentWriter::Allocate(size_t end) {
+    // blocks must be allocated before written through the mapping, otherwise SIGBUS is raised when the disk is full
+    size_t newSize = min(mCapacity, max(end, mAllocatedSize + kAllocChunkSize));
+    int err = posix_fallocate(mFd, mAllocatedSize, newSize - mAllocatedSize);
+    if (err != 0) {
+        LOG_WARNING(sLogger,
+                    ("failed to allocate disk segment", GetWritingPath(mPath))("size", newSize)(
+                        "errno", ErrnoToString(err)));
+        return false;
+    }
+    mAllocatedSize = newSize;
+    return true;
+}
+
+void DiskSegmentWriter::Unmap() {
+    munmap(mData, mCapacity);
+    mData = nullptr;
+    mCapacity = 0;
+}
+
+size_t DiskSegmentWriter::GetRecordSize(size_t bodySize) {
+    return AlignTo8(kRecordHeaderSize + bodySize);
+}
+
+bool DiskSegmentWriter::Recover(const string& path) {
+    const string writingPath = GetWritingPath(path);
+    int fd = open(writingPath.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        unlink(writingPath.c_str());
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        LOG_WARNING(sLogger, ("failed to map disk segment", writingPath)("errno", ErrnoToString(GetErrno())));
+        close(fd);
+        return false;
+    }
+    size_t end = 0;
+    bool truncated = false;
+    if (IsHeaderValid(static_cast<const char*>(data), fileSize)) {
+        end = ScanRecords(static_cast<const char*>(data), fileSize, nullptr, truncated);
+    }
+    munmap(data, fileSize);
+    if (end <= kHeaderSize) {
+        close(fd);
+        unlink(writingPath.c_str());
+        return false;
+    }
+    if (truncated) {
+        LOG_WARNING(sLogger,
+                    ("disk segment is corrupted, records after the offset are dropped", writingPath)("offset", end));
+    }
+    bool res = ftruncate(fd, end) == 0;
+    close(fd);
+    if (!res || rename(writingPath.c_str(), path.c_str()) != 0) {
+        LOG_WARNING(sLogger, ("failed to recover disk segment", writingPath)("errno", ErrnoToString(GetErrno())));
+        return false;
+    }
+    return true;
+}
+
+DiskSegmentReader::~DiskSegmentReader() {
+    Close();
+}
+
+bool DiskSegmentReader::Open(const string& path) {
+    Close();
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        LOG_WARNING(sLogger, ("failed to open disk segment", path)("errno", ErrnoToString(GetErrno())));
+        return false;
+    }
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < kHeaderSize) {
+        LOG_WARNING(sLogger, ("invalid disk segment", path)("size", st.st_size));
+        close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(st.st_size);
+    void* data = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        LOG_WARNING(sLogger, ("failed to map disk segment", path)("errno", ErrnoToString(GetErrno())));
+        return false;
+    }
+    madvise(data, fileSize, MADV_SEQUENTIAL);
+
+    mPath = path;
+    mData = static_cast<const char*>(data);
+    mSize = fileSize;
+    if (!IsHeaderValid(mData, mSize)) {
+        LOG_WARNING(sLogger, ("invalid disk segment", path)("reason", "bad header"));
+        Close();
+        return false;
+    }
+    ScanRecords(mData, mSize, &mRecords, mTruncated);
+    if (mTruncated) {
+        LOG_WARNING(sLogger, ("disk segment is corrupted, records after the last intact one are dropped", path)(
+                                 "intact records", mRecords.size()));
+    }
+    if (!OpenAckBitmap()) {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+bool DiskSegmentReader::OpenAckBitmap() {
+    const string ackPath = GetAckPath(mPath);
+    int fd = open(ackPath.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        LOG_WARNING(sLogger, ("failed to open disk segment ack bitmap", ackPath)("errno", ErrnoToString(GetErrno())));
+        return false;
+    }
+    size_t bitmapSize = max<size_t>(1, (mRecords.size() + 7) / 8);
+    int err = posix_fallocate(fd, 0, bitmapSize);
+    if (err != 0) {
+        LOG_WARNING(sLogger, ("failed to allocate disk segment ack bitmap", ackPath)("errno", ErrnoToString(err)));
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, bitmapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        LOG_WARNING(sLogger, ("failed to map disk segment ack bitmap", ackPath)("errno", ErrnoToString(GetErrno())));
+        return false;
+    }
+    mAckBitmap = static_cast<uint8_t*>(data);
+    mAckBitmapSize = bitmapSize;
+
+    size_t ackedCnt = 0;
+    for (size_t i = 0; i < mRecords.size(); ++i) {
+        if (IsAcked(i)) {
+            ++ackedCnt;
+        }
+    }
+    mAckedCnt = ackedCnt;
+    return true;
+}
+
+void DiskSegmentReader::Close() {
+    if (mData != nullptr) {
+        munmap(const_cast<char*>(mData), mSize);
+        mData = nullptr;
+    }
+    if (mAckBitmap != nullptr) {
+        munmap(mAckBitmap, mAckBitmapSize);
+        mAckBitmap = nullptr;
+    }
+    mSize = 0;
+    mAckBitmapSize = 0;
+    mRecords.clear();
+    mTruncated = false;
+    mAckedCnt = 0;
+}
+
+StringView DiskSegmentReader::GetRecord(size_t idx) const {
+    const auto& record = mRecords[idx];
+    return StringView(mData + record.first, record.second);
+}
+
+bool DiskSegmentReader::IsAcked(size_t idx) const {
+    uint8_t bits = __atomic_load_n(&mAckBitmap[idx >> 3], __ATOMIC_RELAXED);
+    return (bits & (1U << (idx & 7))) != 0;
+}
+
+void DiskSegmentReader::Ack(size_t idx) {
+    uint8_t bit = static_cast<uint8_t>(1U << (idx & 7));
+    uint8_t old = __atomic_fetch_or(&mAckBitmap[idx >> 3], bit, __ATOMIC_RELAXED);
+    if ((old & bit) == 0) {
+        ++mAckedCnt;
+    }
+}
+
+void DiskSegmentReader::Remove(const string& path) {
+    unlink(path.c_str());
+    unlink(GetAckPath(path).c_str());
+}
+
+} // namespace logtail
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <atomic>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include "common/StringView.h"
+
+namespace logtail {
+
+// A disk segment is an append-only file of records, which is written and read through memory mapping.
+//
+// Layout: a 64-byte header, then records aligned to 8 bytes, each of which is a 4-byte body size, the 4-byte CRC-32C
+// of the body, and the body. Bytes not written yet read as zeros, so a zero size marks the end of records.
+// Records after a torn or corrupted one are not readable.
+//
+// The writer writes to "<path>.writing" and renames it to path when sealed, so that only complete segments are read.
+// Records are acked in a separate bitmap file "<path>.ack" instead of rewriting the segment.
+class DiskSegmentWriter {
+public:
+    DiskSegmentWriter() = default;
+    DiskSegmentWriter(const DiskSegmentWriter&) = delete;
+    DiskSegmentWriter& operator=(const DiskSegmentWriter&) = delete;
+    ~DiskSegmentWriter();
+
+    // creates the segment with room for records of capacity bytes in total
+    bool Open(const std::string& path, size_t capacity);
+    // appends a record whose body is the concatenation of parts. Returns false if there is no room left.
+    bool Append(std::initializer_list<StringView> parts);
+    // shrinks the file to its records and renames it to path
+    bool Seal();
+
+    bool IsOpen() const { return mData != nullptr; }
+    const std::string& GetPath() const { return mPath; }
+    size_t GetRecordCnt() const { return mRecordCnt; }
+    size_t GetLastRecordOffset() const { return mLastRecordOffset; }
+    // the body of the record at offset, which is read back through the mapping before the segment is sealed
+    StringView GetRecord(size_t offset) const;
+    // size of the whole file if sealed now
+    size_t GetSize() const { return mSize; }
+
+    static std::string GetWritingPath(const std::string& path) { return path + ".writing"; }
+    // bytes taken by a record of bodySize bytes in the segment
+    static size_t GetRecordSize(size_t bodySize);
+    // seals the segment left unsealed by a crash with its intact records
+    static bool Recover(const std::string& path);
+
+private:
+    // allocates blocks of the file up to at least end
+    bool Allocate(size_t end);
+    void Unmap();
+
+    std::string mPath;
+    int mFd = -1;
+    char* mData = nullptr;
+    size_t mCapacity = 0;
+    size_t mAllocatedSize = 0;
+    size_t mSize = 0;
+    size_t mRecordCnt = 0;
+    size_t mLastRecordOffset = 0;
+};
+
+class DiskSegmentReader {
+public:
+    DiskSegmentReader() = default;
+    DiskSegmentReader(const DiskSegmentReader&) = delete;
+    DiskSegmentReader& operator=(const DiskSegmentReader&) = delete;
+    ~DiskSegmentReader();
+
+    // maps a sealed segment and its ack bitmap, which is created if not exists
+    bool Open(const std::string& path);
+    void Close();
+
+    size_t GetRecordCnt() const { return mRecords.size(); }
+    // the body of the idx-th record, valid until the reader is closed
+    StringView GetRecord(size_t idx) const;
+    // whether some bytes after the last readable record are not records
+    bool IsTruncated() const { return mTruncated; }
+
+    bool IsAcked(size_t idx) const;
+    // thread-safe
+    void Ack(size_t idx);
+    bool IsAllAcked() const { return mAckedCnt.load() == mRecords.size(); }
+
+    // removes the segment along with its ack bitmap
+    static void Remove(const std::string& path);
+    static std::string GetAckPath(const std::string& path) { return path + ".ack"; }
+
+private:
+    bool OpenAckBitmap();
+
+    std::string mPath;
+    const char* mData = nullptr;
+    size_t mSize = 0;
+    std::vector<std::pair<size_t, uint32_t>> mRecords;
+    bool mTruncated = false;
+
+    uint8_t* mAckBitmap = nullptr;
+    size_t mAckBitmapSize = 0;
+    std::atomic_size_t mAckedCnt = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class DiskSegmentUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,397 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/OnDemandJsonParser.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LOGTAIL_JSON_PARSER_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace logtail {
+
+// integers with more digits may not fit in int64 or uint64, and are parsed as doubles by rapidjson
+static const size_t kMaxIntegerDigits = 18;
+// nested values deeper than this are left to rapidjson
+static const int kMaxDepth = 64;
+
+static inline bool IsWhitespace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static inline void SkipWhitespace(const char*& p, const char* end) {
+    while (p < end && IsWhitespace(*p)) {
+        ++p;
+    }
+}
+
+static inline bool IsStringSpecial(char c) {
+    return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+#ifdef LOGTAIL_JSON_PARSER_X86
+static inline uint32_t CountTrailingZeros(uint32_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx = 0;
+    _BitScanForward(&idx, mask);
+    return static_cast<uint32_t>(idx);
+#else
+    return static_cast<uint32_t>(__builtin_ctz(mask));
+#endif
+}
+#endif
+
+// Return the first quote, backslash or control character in [p, end), or end if there is none. Strings take most of
+// the bytes of json logs, so 16 bytes are checked at a time.
+static inline const char* FindStringSpecial(const char* p, const char* end) {
+#ifdef LOGTAIL_JSON_PARSER_X86
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i maxControl = _mm_set1_epi8(0x1F);
+    for (; end - p >= 16; p += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        // unsigned chunk <= 0x1F
+        __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(chunk, maxControl), chunk);
+        __m128i special
+            = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)), control);
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+        if (mask != 0) {
+            return p + CountTrailingZeros(mask);
+        }
+    }
+#endif
+    while (p < end && !IsStringSpecial(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+static inline int HexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+// parse the 4 hex digits after \u at p, and return -1 if they are invalid
+static int ParseHex4(const char* p, const char* end) {
+    if (end - p < 4) {
+        return -1;
+    }
+    int res = 0;
+    for (int i = 0; i < 4; ++i) {
+        int v = HexValue(p[i]);
+        if (v < 0) {
+            return -1;
+        }
+        res = (res << 4) | v;
+    }
+    return res;
+}
+
+// Scan the string starting with the quote at p, and move p after the closing quote. In canonical mode, only escapes
+// written back the same by rapidjson::Writer are supported. Surrogates not in pairs are not supported, since rapidjson
+// versions differ on them.
+static bool ScanString(const char*& p, const char* end, bool canonical, bool& escaped) {
+    ++p;
+    while (true) {
+        p = FindStringSpecial(p, end);
+        if (p == end) {
+            return false;
+        }
+        if (*p == '"') {
+            ++p;
+            return true;
+        }
+        if (*p != '\\') {
+            // control characters must be escaped
+            return false;
+        }
+        escaped = true;
+        if (end - p < 2) {
+            return false;
+        }
+        char c = p[1];
+        if (c == '"' || c == '\\' || c == 'b' || c == 'f' || c == 'n' || c == 'r' || c == 't') {
+            p += 2;
+            continue;
+        }
+        if (canonical || (c != '/' && c != 'u')) {
+            return false;
+        }
+        if (c == '/') {
+            p += 2;
+            continue;
+        }
+        int codepoint = ParseHex4(p + 2, end);
+        if (codepoint < 0 || (codepoint >= 0xDC00 && codepoint <= 0xDFFF)) {
+            return false;
+        }
+        p += 6;
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+            if (end - p < 2 || p[0] != '\\' || p[1] != 'u') {
+                return false;
+            }
+            int low = ParseHex4(p + 2, end);
+            if (low < 0xDC00 || low > 0xDFFF) {
+                return false;
+            }
+            p += 6;
+        }
+    }
+}
+
+// Scan an integer which is written back the same by rapidjson, i.e. neither a double nor -0.
+static bool ScanInteger(const char*& p, const char* end) {
+    const char* begin = p;
+    if (*p == '-') {
+        ++p;
+    }
+    const char* digits = p;
+    if (p < end && *p == '0') {
+        ++p;
+    } else {
+        while (p < end && *p >= '0' && *p <= '9') {
+            ++p;
+        }
+    }
+    if (p == digits || static_cast<size_t>(p - digits) > kMaxIntegerDigits || (*begin == '-' && *digits == '0')) {
+        return false;
+    }
+    // fractions, exponents and leading zeros
+    return p == end || (*p != '.' && *p != 'e' && *p != 'E' && !(*p >= '0' && *p <= '9'));
+}
+
+static bool ScanLiteral(const char*& p, const char* end) {
+    for (const char* literal : {"true", "false", "null"}) {
+        size_t len = strlen(literal);
+        if (static_cast<size_t>(end - p) >= len && memcmp(p, literal, len) == 0) {
+            p += len;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Scan a value which is written back the same by rapidjson::Writer, i.e. without spaces, and with only supported
+// strings and numbers.
+static bool ScanCanonicalValue(const char*& p, const char* end, int depth) {
+    if (p == end) {
+        return false;
+    }
+    bool escaped = false;
+    switch (*p) {
+        case '"':
+            return ScanString(p, end, true, escaped);
+        case '{':
+        case '[': {
+            if (depth >= kMaxDepth) {
+                return false;
+            }
+            char close = *p == '{' ? '}' : ']';
+            ++p;
+            if (p < end && *p == close) {
+                ++p;
+                return true;
+            }
+            while (true) {
+                if (close == '}') {
+                    if (p == end || *p != '"' || !ScanString(p, end, true, escaped) || p == end || *p != ':') {
+                        return false;
+                    }
+                    ++p;
+                }
+                if (!ScanCanonicalValue(p, end, depth + 1) || p == end) {
+                    return false;
+                }
+                if (*p == close) {
+                    ++p;
+                    return true;
+                }
+                if (*p != ',') {
+                    return false;
+                }
+                ++p;
+            }
+        }
+        case 't':
+        case 'f':
+        case 'n':
+            return ScanLiteral(p, end);
+        default:
+            return (*p == '-' || (*p >= '0' && *p <= '9')) && ScanInteger(p, end);
+    }
+}
+
+bool OnDemandJsonParser::Parse(StringView text) {
+    mMembers.clear();
+    const char* p = text.data();
+    const char* end = text.data() + text.size();
+    SkipWhitespace(p, end);
+    if (p == end || *p != '{') {
+        return false;
+    }
+    ++p;
+    SkipWhitespace(p, end);
+    if (p < end && *p == '}') {
+        ++p;
+    } else {
+        while (true) {
+            Member member;
+            if (p == end || *p != '"') {
+                return false;
+            }
+            const char* keyBegin = p;
+            if (!ScanString(p, end, false, member.mKeyEscaped)) {
+                return false;
+            }
+            member.mKey = StringView(keyBegin + 1, p - keyBegin - 2);
+            SkipWhitespace(p, end);
+            if (p == end || *p != ':') {
+                return false;
+            }
+            ++p;
+            SkipWhitespace(p, end);
+            if (p == end) {
+                return false;
+            }
+            const char* valueBegin = p;
+            if (*p == '"') {
+                if (!ScanString(p, end, false, member.mValueEscaped)) {
+                    return false;
+                }
+                member.mValue = StringView(valueBegin + 1, p - valueBegin - 2);
+            } else if (*p == 'n') {
+                if (!ScanLiteral(p, end) || p - valueBegin != 4) {
+                    return false;
+                }
+                // null is empty
+                member.mValue = StringView(valueBegin, 0);
+            } else {
+                if (!ScanCanonicalValue(p, end, 0)) {
+                    return false;
+                }
+                member.mValue = StringView(valueBegin, p - valueBegin);
+            }
+            mMembers.push_back(member);
+            SkipWhitespace(p, end);
+            if (p == end) {
+                return false;
+            }
+            if (*p == '}') {
+                ++p;
+                break;
+            }
+            if (*p != ',') {
+                return false;
+            }
+            ++p;
+            SkipWhitespace(p, end);
+        }
+    }
+    SkipWhitespace(p, end);
+    return p == end;
+}
+
+static char* EncodeUtf8(uint32_t codepoint, char* out) {
+    if (codepoint < 0x80) {
+        *out++ = static_cast<char>(codepoint);
+    } else if (codepoint < 0x800) {
+        *out++ = static_cast<char>(0xC0 | (codepoint >> 6));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else if (codepoint < 0x10000) {
+        *out++ = static_cast<char>(0xE0 | (codepoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (codepoint >> 18));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codepoint & 0x3F));
+    }
+    return out;
+}
+
+// the escapes have been validated by Parse(), and the unescaped string is never longer than the escaped one
+StringView OnDemandJsonParser::Unescape(StringView escaped, SourceBuffer& sourceBuffer) {
+    StringBuffer buffer = sourceBuffer.AllocateStringBuffer(escaped.size());
+    char* out = buffer.data;
+    const char* p = escaped.data();
+    const char* end = escaped.data() + escaped.size();
+    while (p < end) {
+        const char* special = static_cast<const char*>(memchr(p, '\\', end - p));
+        if (special == nullptr) {
+            special = end;
+        }
+        memcpy(out, p, special - p);
+        out += special - p;
+        p = special;
+        if (p == end) {
+            break;
+        }
+        char c = p[1];
+        p += 2;
+        switch (c) {
+            case 'b':
+                *out++ = '\b';
+                break;
+            case 'f':
+                *out++ = '\f';
+                break;
+            case 'n':
+                *out++ = '\n';
+                break;
+            case 'r':
+                *out++ = '\r';
+                break;
+            case 't':
+                *out++ = '\t';
+                break;
+            case 'u': {
+                uint32_t codepoint = static_cast<uint32_t>(ParseHex4(p, end));
+                p += 4;
+                if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                    uint32_t low = static_cast<uint32_t>(ParseHex4(p + 2, end));
+                    p += 6;
+                    codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+                out = EncodeUtf8(codepoint, out);
+                break;
+            }
+            default:
+                // quote, backslash and slash
+                *out++ = c;
+                break;
+        }
+    }
+    buffer.size = out - buffer.data;
+    buffer.data[buffer.size] = '\0';
+    return StringView(buffer.data, buffer.size);
+}
+
+} // namespace logtail
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "common/StringView.h"
+#include "common/memory/SourceBuffer.h"
+
+namespace logtail {
+
+// Splits a json object into its members without building a document. Keys and string values without escapes, as well
+// as the text of other values, are returned as views of the parsed text, so that nothing is copied for most members.
+//
+// The members are the same as those given by rapidjson, where strings are unescaped, null is empty, and numbers,
+// booleans, objects and arrays are serialized by rapidjson::Writer. Texts for which the latter differs from the
+// original text, e.g. doubles, nested values with spaces or unicode escapes, are not supported, and neither are invalid
+// texts. Parse() returns false for them, and rapidjson should be used instead, which also reports the errors.
+class OnDemandJsonParser {
+public:
+    bool Parse(StringView text);
+
+    // onMember(key, value) is called for each member of the object last parsed, escaped strings are unescaped into
+    // sourceBuffer, and other views point to the parsed text
+    template <class F>
+    void ForEachMember(SourceBuffer& sourceBuffer, F&& onMember) const {
+        for (const auto& member : mMembers) {
+            onMember(member.mKeyEscaped ? Unescape(member.mKey, sourceBuffer) : member.mKey,
+                     member.mValueEscaped ? Unescape(member.mValue, sourceBuffer) : member.mValue);
+        }
+    }
+
+    size_t GetMemberCount() const { return mMembers.size(); }
+
+private:
+    struct Member {
+        StringView mKey;
+        StringView mValue;
+        // the view is the text between quotes, which is yet to be unescaped
+        bool mKeyEscaped = false;
+        bool mValueEscaped = false;
+    };
+
+    static StringView Unescape(StringView escaped, SourceBuffer& sourceBuffer);
+
+    std::vector<Member> mMembers;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class OnDemandJsonParserUnittest;
+#endif
+};
+
+} // namespace logtail
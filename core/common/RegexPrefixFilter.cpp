@@ -0,0 +1,414 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/RegexPrefixFilter.h"
+
+#include <cctype>
+#include <cstring>
+
+using namespace std;
+
+namespace logtail {
+
+using ByteSet = bitset<256>;
+
+// long enough for timestamps and log levels, while keeping the check cheap
+static const size_t kMaxPrefixLength = 64;
+
+static void AddRange(ByteSet& set, unsigned char from, unsigned char to) {
+    for (unsigned int c = from; c <= to; ++c) {
+        set.set(c);
+    }
+}
+
+// Whether a byte not in ascii belongs to a named class depends on the locale, so they are always accepted, which
+// keeps the filter from rejecting texts matched by the regex.
+static void AddNonAscii(ByteSet& set) {
+    AddRange(set, 0x80, 0xFF);
+}
+
+// \d, \w, \s and their negations
+static bool AddEscapedClass(char c, ByteSet& set) {
+    ByteSet res;
+    switch (c) {
+        case 'd':
+        case 'D':
+            AddRange(res, '0', '9');
+            break;
+        case 'w':
+        case 'W':
+            AddRange(res, '0', '9');
+            AddRange(res, 'a', 'z');
+            AddRange(res, 'A', 'Z');
+            res.set('_');
+            break;
+        case 's':
+        case 'S':
+            AddRange(res, '\t', '\r');
+            res.set(' ');
+            break;
+        default:
+            return false;
+    }
+    if (isupper(static_cast<unsigned char>(c))) {
+        res.flip();
+    }
+    AddNonAscii(res);
+    set |= res;
+    return true;
+}
+
+// escaped characters which stand for a single byte
+static bool GetEscapedLiteral(char c, char& literal) {
+    if (!isalnum(static_cast<unsigned char>(c))) {
+        // word boundaries and buffer boundaries
+        if (strchr("<>`'", c) != nullptr) {
+            return false;
+        }
+        literal = c;
+        return true;
+    }
+    switch (c) {
+        case 'n':
+            literal = '\n';
+            return true;
+        case 't':
+            literal = '\t';
+            return true;
+        case 'r':
+            literal = '\r';
+            return true;
+        case 'f':
+            literal = '\f';
+            return true;
+        case 'a':
+            literal = '\a';
+            return true;
+        case 'e':
+            literal = '\x1B';
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool AddNamedClass(const string& name, ByteSet& set) {
+    int (*pred)(int) = nullptr;
+    if (name == "alpha") {
+        pred = isalpha;
+    } else if (name == "digit") {
+        pred = isdigit;
+    } else if (name == "alnum") {
+        pred = isalnum;
+    } else if (name == "space") {
+        pred = isspace;
+    } else if (name == "upper") {
+        pred = isupper;
+    } else if (name == "lower") {
+        pred = islower;
+    } else if (name == "punct") {
+        pred = ispunct;
+    } else if (name == "xdigit") {
+        pred = isxdigit;
+    } else if (name == "blank") {
+        pred = isblank;
+    } else if (name == "cntrl") {
+        pred = iscntrl;
+    } else if (name == "print") {
+        pred = isprint;
+    } else if (name == "graph") {
+        pred = isgraph;
+    } else if (name == "word") {
+        return AddEscapedClass('w', set);
+    } else {
+        return false;
+    }
+    for (int c = 0; c < 0x80; ++c) {
+        if (pred(c)) {
+            set.set(c);
+        }
+    }
+    AddNonAscii(set);
+    return true;
+}
+
+// Parse the bracket expression at regex[pos], and return the position after it, or npos if it is not supported.
+static size_t ParseClass(const string& regex, size_t pos, ByteSet& set) {
+    size_t i = pos + 1;
+    bool negated = false;
+    if (i < regex.size() && regex[i] == '^') {
+        negated = true;
+        ++i;
+    }
+    ByteSet res;
+    // ] right after [ or [^ is a plain character
+    for (bool first = true; i < regex.size(); first = false) {
+        char c = regex[i];
+        if (c == ']' && !first) {
+            if (negated) {
+                res.flip();
+                AddNonAscii(res);
+            }
+            set = res;
+            return i + 1;
+        }
+        if (c == '[' && i + 1 < regex.size() && strchr(":=.", regex[i + 1]) != nullptr) {
+            if (regex[i + 1] != ':') {
+                // collating elements and equivalence classes
+                return string::npos;
+            }
+            size_t end = regex.find(":]", i + 2);
+            if (end == string::npos || !AddNamedClass(regex.substr(i + 2, end - i - 2), res)) {
+                return string::npos;
+            }
+            i = end + 2;
+            continue;
+        }
+        unsigned char from = c;
+        if (c == '\\') {
+            if (i + 1 >= regex.size()) {
+                return string::npos;
+            }
+            char literal;
+            if (AddEscapedClass(regex[i + 1], res)) {
+                i += 2;
+                continue;
+            }
+            if (!GetEscapedLiteral(regex[i + 1], literal)) {
+                return string::npos;
+            }
+            from = literal;
+            i += 2;
+        } else {
+            ++i;
+        }
+        if (i + 1 < regex.size() && regex[i] == '-' && regex[i + 1] != ']') {
+            unsigned char to = regex[i + 1];
+            if (to == '\\' || to == '[' || to < from) {
+                return string::npos;
+            }
+            AddRange(res, from, to);
+            i += 2;
+        } else {
+            res.set(from);
+        }
+    }
+    return string::npos;
+}
+
+// Return the position after the token at regex[pos], where an escape, a quoted sequence or a bracket expression is
+// one token, or npos if the bracket expression is not supported.
+static size_t NextToken(const string& regex, size_t pos) {
+    if (regex[pos] == '\\') {
+        if (pos + 1 < regex.size() && regex[pos + 1] == 'Q') {
+            size_t end = regex.find("\\E", pos + 2);
+            return end == string::npos ? regex.size() : end + 2;
+        }
+        return min(pos + 2, regex.size());
+    }
+    if (regex[pos] == '[') {
+        ByteSet unused;
+        return ParseClass(regex, pos, unused);
+    }
+    return pos + 1;
+}
+
+static bool IsQuantifier(const string& regex, size_t pos) {
+    return pos < regex.size() && strchr("*+?{", regex[pos]) != nullptr;
+}
+
+// Parse the quantifier at regex[pos] if any, and return the position after it, or npos if it is not supported.
+static size_t ParseQuantifier(const string& regex, size_t pos, size_t& minCount, bool& fixed) {
+    minCount = 1;
+    fixed = true;
+    if (!IsQuantifier(regex, pos)) {
+        return pos;
+    }
+    char c = regex[pos++];
+    if (c == '{') {
+        size_t end = pos;
+        while (end < regex.size() && isdigit(static_cast<unsigned char>(regex[end]))) {
+            ++end;
+        }
+        if (end == pos || end - pos > 4 || end >= regex.size() || (regex[end] != '}' && regex[end] != ',')) {
+            return string::npos;
+        }
+        minCount = stoul(regex.substr(pos, end - pos));
+        fixed = regex[end] == '}';
+        pos = regex.find('}', end);
+        if (pos == string::npos) {
+            return string::npos;
+        }
+        ++pos;
+    } else {
+        minCount = c == '+' ? 1 : 0;
+        fixed = false;
+    }
+    // lazy or possessive
+    if (pos < regex.size() && (regex[pos] == '?' || regex[pos] == '+')) {
+        ++pos;
+    }
+    return pos;
+}
+
+RegexPrefixFilter::RegexPrefixFilter(const string& regex) {
+    // alternatives at the top level may start with anything
+    int depth = 0;
+    for (size_t i = 0; i < regex.size();) {
+        if (regex[i] == '(') {
+            ++depth;
+        } else if (regex[i] == ')') {
+            --depth;
+        } else if (regex[i] == '|' && depth == 0) {
+            return;
+        }
+        i = NextToken(regex, i);
+        if (i == string::npos) {
+            return;
+        }
+    }
+
+    vector<ByteSet> shape;
+    size_t i = !regex.empty() && regex[0] == '^' ? 1 : 0;
+    while (i < regex.size() && shape.size() < kMaxPrefixLength) {
+        char c = regex[i];
+        if (c == ')') {
+            ++i;
+            continue;
+        }
+        if (c == '(') {
+            // a group matched exactly once without alternatives is the same as its content
+            size_t end = i;
+            bool hasAlternation = false;
+            for (int groupDepth = 0; end < regex.size(); end = NextToken(regex, end)) {
+                if (regex[end] == '(') {
+                    ++groupDepth;
+                } else if (regex[end] == ')' && --groupDepth == 0) {
+                    break;
+                } else if (regex[end] == '|') {
+                    hasAlternation = true;
+                }
+            }
+            if (end >= regex.size() || hasAlternation || IsQuantifier(regex, end + 1)) {
+                break;
+            }
+            if (i + 1 < regex.size() && regex[i + 1] == '?') {
+                if (regex.compare(i + 2, 1, ":") == 0) {
+                    i += 3;
+                } else if ((regex.compare(i + 2, 1, "<") == 0 && regex.compare(i + 3, 1, "=") != 0
+                            && regex.compare(i + 3, 1, "!") != 0)
+                           || regex.compare(i + 2, 2, "P<") == 0) {
+                    // named group
+                    i = regex.find('>', i) + 1;
+                } else {
+                    // lookaround, flags and others
+                    break;
+                }
+            } else {
+                ++i;
+            }
+            continue;
+        }
+        if (c == '\\' && regex.compare(i + 1, 1, "Q") == 0) {
+            size_t end = regex.find("\\E", i + 2);
+            size_t next = end == string::npos ? regex.size() : end + 2;
+            size_t quoteEnd = end == string::npos ? regex.size() : end;
+            size_t j = i + 2;
+            for (; j < quoteEnd && shape.size() < kMaxPrefixLength; ++j) {
+                shape.emplace_back();
+                shape.back().set(static_cast<unsigned char>(regex[j]));
+            }
+            if (IsQuantifier(regex, next)) {
+                // the quantifier applies to the last quoted character
+                if (j == quoteEnd && quoteEnd > i + 2) {
+                    shape.pop_back();
+                }
+                break;
+            }
+            i = next;
+            continue;
+        }
+
+        ByteSet set;
+        size_t next = i + 1;
+        if (c == '.') {
+            set.set();
+        } else if (c == '[') {
+            next = ParseClass(regex, i, set);
+            if (next == string::npos) {
+                break;
+            }
+        } else if (c == '\\') {
+            char literal;
+            if (i + 1 >= regex.size()) {
+                break;
+            }
+            if (GetEscapedLiteral(regex[i + 1], literal)) {
+                set.set(static_cast<unsigned char>(literal));
+            } else if (!AddEscapedClass(regex[i + 1], set)) {
+                break;
+            }
+            next = i + 2;
+        } else if (strchr("*+?{}|^$", c) != nullptr) {
+            break;
+        } else {
+            set.set(static_cast<unsigned char>(c));
+        }
+
+        size_t minCount = 1;
+        bool fixed = true;
+        next = ParseQuantifier(regex, next, minCount, fixed);
+        if (next == string::npos) {
+            break;
+        }
+        for (size_t n = 0; n < minCount && shape.size() < kMaxPrefixLength; ++n) {
+            shape.push_back(set);
+        }
+        if (!fixed) {
+            break;
+        }
+        i = next;
+    }
+
+    size_t literalSize = 0;
+    for (; literalSize < shape.size() && shape[literalSize].count() == 1; ++literalSize) {
+        for (size_t c = 0; c < shape[literalSize].size(); ++c) {
+            if (shape[literalSize].test(c)) {
+                mLiteralPrefix += static_cast<char>(c);
+                break;
+            }
+        }
+    }
+    mShape.assign(shape.begin() + literalSize, shape.end());
+}
+
+bool RegexPrefixFilter::MayMatch(const char* data, size_t size) const {
+    if (size < GetMinLength()) {
+        return false;
+    }
+    if (memcmp(data, mLiteralPrefix.data(), mLiteralPrefix.size()) != 0) {
+        return false;
+    }
+    const char* shapeBegin = data + mLiteralPrefix.size();
+    for (size_t i = 0; i < mShape.size(); ++i) {
+        if (!mShape[i].test(static_cast<unsigned char>(shapeBegin[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace logtail
@@ -0,0 +1,54 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace logtail {
+
+// A cheap check on the beginning of a text, derived from a boost regex which is matched from the beginning of the
+// text, i.e. with boost::match_continuous. The regex is analyzed up to its first element of variable length, and each
+// element before it must match exactly one byte, e.g. \d{4}-\d{2} requires 4 digits, a '-' and 2 more digits. A text
+// rejected by the filter never matches the regex, while a text passing it still has to be matched by the regex.
+class RegexPrefixFilter {
+public:
+    RegexPrefixFilter() = default;
+    explicit RegexPrefixFilter(const std::string& regex);
+
+    // false only if the regex cannot match from the beginning of [data, data + size)
+    bool MayMatch(const char* data, size_t size) const;
+    // true if every text passes the filter
+    bool Empty() const { return mLiteralPrefix.empty() && mShape.empty(); }
+    const std::string& GetLiteralPrefix() const { return mLiteralPrefix; }
+    // the minimum length of texts passing the filter
+    size_t GetMinLength() const { return mLiteralPrefix.size() + mShape.size(); }
+
+private:
+    // the leading bytes which must be the same
+    std::string mLiteralPrefix;
+    // bytes accepted at each position after the literal prefix
+    std::vector<std::bitset<256>> mShape;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RegexPrefixFilterUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -269,6 +269,177 @@ bool BoostRegexSearch(const char* buffer, const boost::regex& reg, string& excep
     }
 }
 
+bool TranslateBoostRegexToRe2(const string& regex, string& re2Regex) {
+    re2Regex.clear();
+    bool inClass = false;
+    for (size_t i = 0; i < regex.size(); ++i) {
+        char c = regex[i];
+        if (c == '\\' && i + 1 < regex.size()) {
+            char next = regex[++i];
+            switch (next) {
+                case 's':
+                    // \s of boost includes \v, while that of re2 does not
+                    re2Regex += inClass ? "[:space:]" : "[[:space:]]";
+                    break;
+                case 'S':
+                    if (inClass) {
+                        return false;
+                    }
+                    re2Regex += "[^[:space:]]";
+                    break;
+                case 'Q': {
+                    // quoted characters are copied as they are
+                    size_t end = regex.find("\\E", i + 1);
+                    end = end == string::npos ? regex.size() : end + 2;
+                    re2Regex.append(regex, i - 1, end - i + 1);
+                    i = end - 1;
+                    break;
+                }
+                // vertical spaces, word boundaries and buffer boundaries in boost, which are plain characters in re2
+                case 'v':
+                case '<':
+                case '>':
+                case '`':
+                case '\'':
+                    return false;
+                default:
+                    re2Regex += c;
+                    re2Regex += next;
+                    break;
+            }
+            continue;
+        }
+        if (!inClass && ((c == '^' && i != 0) || (c == '$' && i != regex.size() - 1))) {
+            // boost matches ^ and $ at line breaks including \r and \f, which only make a difference in the middle
+            return false;
+        }
+        re2Regex += c;
+        if (inClass) {
+            if (c == ']') {
+                inClass = false;
+            } else if (c == '[' && i + 1 < regex.size() && regex[i + 1] == ':') {
+                // character class name like [:alpha:]
+                size_t end = regex.find(":]", i + 2);
+                if (end == string::npos) {
+                    return false;
+                }
+                re2Regex.append(regex, i + 1, end + 1 - i);
+                i = end + 1;
+            }
+        } else if (c == '[') {
+            inClass = true;
+            // ] right after [ or [^ is a plain character
+            if (i + 1 < regex.size() && regex[i + 1] == '^') {
+                re2Regex += regex[++i];
+            }
+            if (i + 1 < regex.size() && regex[i + 1] == ']') {
+                re2Regex += regex[++i];
+            }
+        }
+    }
+    return true;
+}
+
+string ExtractRegexRequiredLiteral(const string& regex) {
+    // flags like (?i) and (?x) change the meaning of literals
+    for (size_t pos = regex.find("(?"); pos != string::npos; pos = regex.find("(?", pos + 2)) {
+        if (pos + 2 < regex.size() && strchr("imsx-", regex[pos + 2]) != nullptr) {
+            return "";
+        }
+    }
+    string longest, current;
+    auto endRun = [&]() {
+        if (current.size() > longest.size()) {
+            longest = current;
+        }
+        current.clear();
+    };
+    int depth = 0;
+    for (size_t i = 0; i < regex.size(); ++i) {
+        char c = regex[i];
+        bool isLiteral = false;
+        char literal = c;
+        if (c == '\\') {
+            if (i + 1 >= regex.size()) {
+                return "";
+            }
+            char next = regex[++i];
+            if (next == 'Q') {
+                // quoted characters are not parsed
+                size_t end = regex.find("\\E", i + 1);
+                i = end == string::npos ? regex.size() : end + 1;
+                endRun();
+                continue;
+            }
+            if (strchr("<>`'", next) != nullptr) {
+                // word boundaries and buffer boundaries
+            } else if (!isalnum(static_cast<unsigned char>(next))) {
+                isLiteral = depth == 0;
+                literal = next;
+            } else if (next == 'n' || next == 't' || next == 'r') {
+                isLiteral = depth == 0;
+                literal = next == 'n' ? '\n' : (next == 't' ? '\t' : '\r');
+            } else if (strchr("dDwWsSbBAzZG", next) == nullptr) {
+                // escapes like \x41 and \p{L} are followed by arguments, which are not literals
+                return "";
+            }
+        } else if (c == '[') {
+            // skip the character class, ] right after [ or [^ is a plain character
+            size_t j = i + 1;
+            if (j < regex.size() && regex[j] == '^') {
+                ++j;
+            }
+            if (j < regex.size() && regex[j] == ']') {
+                ++j;
+            }
+            for (; j < regex.size() && regex[j] != ']'; ++j) {
+                if (regex[j] == '\\') {
+                    ++j;
+                } else if (regex[j] == '[' && j + 1 < regex.size() && regex[j + 1] == ':') {
+                    size_t end = regex.find(":]", j + 2);
+                    if (end == string::npos) {
+                        return "";
+                    }
+                    j = end + 1;
+                }
+            }
+            i = j;
+        } else if (c == '{') {
+            // skip the counts of the quantifier
+            size_t end = regex.find('}', i + 1);
+            i = end == string::npos ? regex.size() : end;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (c == '|') {
+            if (depth == 0) {
+                // no literal is required by all alternatives
+                return "";
+            }
+        } else if (depth == 0 && strchr(".^$*+?{}", c) == nullptr) {
+            isLiteral = true;
+        }
+
+        if (!isLiteral) {
+            endRun();
+            continue;
+        }
+        // a quantifier may make the literal optional or repeat it
+        char quantifier = i + 1 < regex.size() ? regex[i + 1] : '\0';
+        if (quantifier == '*' || quantifier == '?' || quantifier == '{') {
+            endRun();
+        } else if (quantifier == '+') {
+            current += literal;
+            endRun();
+        } else {
+            current += literal;
+        }
+    }
+    endRun();
+    return longest;
+}
+
 uint32_t GetLittelEndianValue32(const uint8_t* buffer) {
     return buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
 }
@@ -135,6 +135,14 @@ bool BoostRegexMatch(const char* buffer, size_t size, const boost::regex& reg, s
 bool BoostRegexMatch(const char* buffer, const boost::regex& reg, std::string& exception);
 bool BoostRegexSearch(const char* buffer, size_t size, const boost::regex& reg, std::string& exception);
 bool BoostRegexSearch(const char* buffer, const boost::regex& reg, std::string& exception);
+// Translate a boost regex to re2 syntax with the same meaning when the whole text is matched. Features not supported
+// by re2 at all are left to be rejected by re2, which should be compiled with latin1 encoding and dot_nl to match bytes
+// as boost does.
+// @return false if the regex uses features which are accepted by re2 with a different meaning
+bool TranslateBoostRegexToRe2(const std::string& regex, std::string& re2Regex);
+// Extract the longest substring which must be contained by any text matching the whole regex, so that texts without it
+// can be rejected without running the regex. Empty if there is no such substring or it cannot be told.
+std::string ExtractRegexRequiredLiteral(const std::string& regex);
 
 // GetLittelEndianValue32 converts @buffer in little endian to uint32_t.
 uint32_t GetLittelEndianValue32(const uint8_t* buffer);
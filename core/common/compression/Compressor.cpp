@@ -57,4 +57,29 @@ bool Compressor::DoCompress(const string& input, string& output, string& errorMs
     return res;
 }
 
+bool Compressor::DoStreamCompress(size_t inputSize,
+                                  const CompressStreamWriter& writer,
+                                  string& output,
+                                  string& errorMsg) {
+    if (mMetricsRecordRef != nullptr) {
+        ADD_COUNTER(mInItemsTotal, 1);
+        ADD_COUNTER(mInItemSizeBytes, inputSize);
+    }
+
+    auto before = chrono::system_clock::now();
+    auto res = StreamCompress(inputSize, writer, output, errorMsg);
+
+    if (mMetricsRecordRef != nullptr) {
+        ADD_COUNTER(mTotalProcessMs, chrono::system_clock::now() - before);
+        if (res) {
+            ADD_COUNTER(mOutItemsTotal, 1);
+            ADD_COUNTER(mOutItemSizeBytes, output.size());
+        } else {
+            ADD_COUNTER(mDiscardedItemsTotal, 1);
+            ADD_COUNTER(mDiscardedItemSizeBytes, inputSize);
+        }
+    }
+    return res;
+}
+
 } // namespace logtail
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <functional>
 #include <string>
 
 #include "common/compression/CompressType.h"
@@ -23,12 +24,24 @@
 
 namespace logtail {
 
+// consumes one chunk of input of streaming compression
+using CompressStreamInput = std::function<bool(const char* data, size_t size)>;
+// produces all input of streaming compression by passing it chunk by chunk to the given input in order
+using CompressStreamWriter = std::function<bool(const CompressStreamInput& input)>;
+
 class Compressor {
 public:
     Compressor(CompressType type) : mType(type) {}
     virtual ~Compressor() = default;
 
     bool DoCompress(const std::string& input, std::string& output, std::string& errorMsg);
+    // compress input produced by writer in chunks, so that the whole input never has to be held in memory. inputSize
+    // must be the total size of all chunks. The output can be decompressed in the same way as that of DoCompress.
+    bool DoStreamCompress(size_t inputSize,
+                          const CompressStreamWriter& writer,
+                          std::string& output,
+                          std::string& errorMsg);
+    virtual bool IsStreamSupported() const { return false; }
 
 #ifdef APSARA_UNIT_TEST_MAIN
     // buffer shoudl be reserved for output before calling this function
@@ -50,6 +63,13 @@ protected:
 
 private:
     virtual bool Compress(const std::string& input, std::string& output, std::string& errorMsg) = 0;
+    virtual bool StreamCompress(size_t inputSize,
+                                const CompressStreamWriter& writer,
+                                std::string& output,
+                                std::string& errorMsg) {
+        errorMsg = "streaming compression is not supported";
+        return false;
+    }
 
     CompressType mType = CompressType::NONE;
 
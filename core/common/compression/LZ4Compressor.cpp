@@ -14,6 +14,8 @@
 
 #include "common/compression/LZ4Compressor.h"
 
+// for LZ4_compress_fast_extState_fastReset, which is stable though not exported from dynamic libraries
+#define LZ4_STATIC_LINKING_ONLY
 #include "lz4/lz4.h"
 
 #include "common/StringTools.h"
@@ -22,6 +24,14 @@ using namespace std;
 
 namespace logtail {
 
+// LZ4_compress_default fully initializes a 16KB state on every call, while a state kept in each thread only needs a
+// fast reset
+static LZ4_stream_t* GetThreadState() {
+    thread_local LZ4_stream_t state;
+    thread_local LZ4_stream_t* initializedState = LZ4_initStream(&state, sizeof(state));
+    return initializedState;
+}
+
 bool LZ4Compressor::Compress(const string& input, string& output, string& errorMsg) {
     int encodingSize = LZ4_compressBound(input.size());
     if (encodingSize <= 0) {
@@ -31,7 +41,8 @@ bool LZ4Compressor::Compress(const string& input, string& output, string& errorM
     output.resize(static_cast<size_t>(encodingSize));
     try {
         encodingSize = static_cast<size_t>(
-            LZ4_compress_default(input.c_str(), const_cast<char*>(output.c_str()), input.size(), encodingSize));
+            LZ4_compress_fast_extState_fastReset(
+                GetThreadState(), input.c_str(), const_cast<char*>(output.c_str()), input.size(), encodingSize, 1));
         if (encodingSize <= 0) {
             errorMsg = "error code: " + ToString(encodingSize);
             return false;
@@ -14,18 +14,31 @@
 
 #include "common/compression/ZstdCompressor.h"
 
+#include <memory>
+
 #include "zstd/zstd.h"
 
 using namespace std;
 
 namespace logtail {
 
+// compression contexts are expensive to create, so one is kept in each thread and reused across calls
+static ZSTD_CCtx* GetThreadCCtx() {
+    thread_local unique_ptr<ZSTD_CCtx, size_t (*)(ZSTD_CCtx*)> ctx(ZSTD_createCCtx(), ZSTD_freeCCtx);
+    return ctx.get();
+}
+
 bool ZstdCompressor::Compress(const string& input, string& output, string& errorMsg) {
     size_t encodingSize = ZSTD_compressBound(input.size());
     output.resize(encodingSize);
     try {
-        encodingSize = ZSTD_compress(
-            const_cast<char*>(output.c_str()), encodingSize, input.c_str(), input.size(), mCompressionLevel);
+        ZSTD_CCtx* ctx = GetThreadCCtx();
+        if (ctx == nullptr) {
+            errorMsg = "failed to create compression context";
+            return false;
+        }
+        encodingSize = ZSTD_compressCCtx(
+            ctx, const_cast<char*>(output.c_str()), encodingSize, input.c_str(), input.size(), mCompressionLevel);
         if (ZSTD_isError(encodingSize)) {
             errorMsg = ZSTD_getErrorName(encodingSize);
             return false;
@@ -37,6 +50,69 @@ bool ZstdCompressor::Compress(const string& input, string& output, string& error
     return false;
 }
 
+bool ZstdCompressor::StreamCompress(size_t inputSize,
+                                    const CompressStreamWriter& writer,
+                                    string& output,
+                                    string& errorMsg) {
+    ZSTD_CCtx* ctx = GetThreadCCtx();
+    if (ctx == nullptr) {
+        errorMsg = "failed to create compression context";
+        return false;
+    }
+    size_t ret = ZSTD_CCtx_reset(ctx, ZSTD_reset_session_and_parameters);
+    if (!ZSTD_isError(ret)) {
+        ret = ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, mCompressionLevel);
+    }
+    if (!ZSTD_isError(ret)) {
+        // content size is written to the frame header as ZSTD_compress does, and checked when the stream ends
+        ret = ZSTD_CCtx_setPledgedSrcSize(ctx, inputSize);
+    }
+    if (ZSTD_isError(ret)) {
+        errorMsg = ZSTD_getErrorName(ret);
+        return false;
+    }
+
+    // the bound is large enough for the whole frame, so the output never has to grow
+    output.resize(ZSTD_compressBound(inputSize));
+    ZSTD_outBuffer out = {const_cast<char*>(output.data()), output.size(), 0};
+    auto compressChunk = [&](const char* data, size_t size) {
+        ZSTD_inBuffer in = {data, size, 0};
+        while (in.pos < in.size) {
+            size_t res = ZSTD_compressStream2(ctx, &out, &in, ZSTD_e_continue);
+            if (ZSTD_isError(res)) {
+                errorMsg = ZSTD_getErrorName(res);
+                return false;
+            }
+            if (out.pos == out.size && in.pos < in.size) {
+                errorMsg = "input size is incorrect";
+                return false;
+            }
+        }
+        return true;
+    };
+    if (!writer(compressChunk)) {
+        if (errorMsg.empty()) {
+            errorMsg = "failed to produce input";
+        }
+        return false;
+    }
+    ZSTD_inBuffer in = {nullptr, 0, 0};
+    size_t remaining = 0;
+    do {
+        remaining = ZSTD_compressStream2(ctx, &out, &in, ZSTD_e_end);
+        if (ZSTD_isError(remaining)) {
+            errorMsg = ZSTD_getErrorName(remaining);
+            return false;
+        }
+        if (remaining != 0 && out.pos == out.size) {
+            errorMsg = "input size is incorrect";
+            return false;
+        }
+    } while (remaining != 0);
+    output.resize(out.pos);
+    return true;
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 bool ZstdCompressor::UnCompress(const string& input, string& output, string& errorMsg) {
     try {
@@ -24,12 +24,18 @@ class ZstdCompressor : public Compressor {
 public:
     explicit ZstdCompressor(CompressType type, int32_t level = 1) : Compressor(type), mCompressionLevel(level) {}
 
+    bool IsStreamSupported() const override { return true; }
+
 #ifdef APSARA_UNIT_TEST_MAIN
     bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) override;
 #endif
 
 private:
     bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override;
+    bool StreamCompress(size_t inputSize,
+                        const CompressStreamWriter& writer,
+                        std::string& output,
+                        std::string& errorMsg) override;
 
     int32_t mCompressionLevel = 1;
 };
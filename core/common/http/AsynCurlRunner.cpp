@@ -35,6 +35,10 @@ bool AsynCurlRunner::Init() {
         LOG_ERROR(sLogger, ("failed to init async curl runner", "failed to init curl client"));
         return false;
     }
+    if (!mLoop.Init(mClient)) {
+        LOG_ERROR(sLogger, ("failed to init async curl runner", "failed to init curl socket loop"));
+        return false;
+    }
     mThreadRes = async(launch::async, &AsynCurlRunner::Run, this);
     mInited = true;
     return true;
@@ -59,6 +63,7 @@ void AsynCurlRunner::Stop() {
 
 bool AsynCurlRunner::AddRequest(unique_ptr<AsynHttpRequest>&& request) {
     mQueue.Push(std::move(request));
+    mLoop.Wakeup();
     return true;
 }
 
@@ -79,27 +84,17 @@ void AsynCurlRunner::Run() {
         }
         DoRun();
     }
-    auto mc = curl_multi_cleanup(mClient);
-    if (mc != CURLM_OK) {
-        LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
-    }
+    mLoop.Cleanup();
 }
 
 void AsynCurlRunner::DoRun() {
-    CURLMcode mc;
     int runningHandlers = 1;
     while (runningHandlers) {
-        if ((mc = curl_multi_perform(mClient, &runningHandlers)) != CURLM_OK) {
-            LOG_ERROR(
-                sLogger,
-                ("failed to call curl_multi_perform", "sleep 100ms and retry")("errMsg", curl_multi_strerror(mc)));
-            this_thread::sleep_for(chrono::milliseconds(100));
-            continue;
-        }
+        mLoop.Run(runningHandlers, 1000);
         HandleCompletedAsynRequests(mClient, runningHandlers);
 
         unique_ptr<AsynHttpRequest> request;
-        if (mQueue.TryPop(request)) {
+        while (mQueue.TryPop(request)) {
             LOG_DEBUG(sLogger,
                       ("got item from flusher runner, request address", request.get())("try cnt",
                                                                                        ToString(request->mTryCnt)));
@@ -107,42 +102,6 @@ void AsynCurlRunner::DoRun() {
                 ++runningHandlers;
             }
         }
-
-        struct timeval timeout {
-            1, 0
-        };
-        long curlTimeout = -1;
-        if ((mc = curl_multi_timeout(mClient, &curlTimeout)) != CURLM_OK) {
-            LOG_WARNING(
-                sLogger,
-                ("failed to call curl_multi_timeout", "use default timeout 1s")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (curlTimeout >= 0) {
-            auto sec = curlTimeout / 1000;
-            // special treatment, do not know why
-            if (sec <= 1) {
-                timeout.tv_sec = sec;
-                timeout.tv_usec = (curlTimeout % 1000) * 1000;
-            }
-        }
-
-        int maxfd = -1;
-        fd_set fdread;
-        fd_set fdwrite;
-        fd_set fdexcep;
-        FD_ZERO(&fdread);
-        FD_ZERO(&fdwrite);
-        FD_ZERO(&fdexcep);
-        if ((mc = curl_multi_fdset(mClient, &fdread, &fdwrite, &fdexcep, &maxfd)) != CURLM_OK) {
-            LOG_ERROR(sLogger, ("failed to call curl_multi_fdset", "sleep 100ms")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (maxfd == -1) {
-            // sleep min(timeout, 100ms) according to libcurl
-            int64_t sleepMs = (curlTimeout >= 0 && curlTimeout < 100) ? curlTimeout : 100;
-            this_thread::sleep_for(chrono::milliseconds(sleepMs));
-        } else {
-            select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
-        }
     }
 }
 
@@ -25,6 +25,7 @@
 #include "curl/multi.h"
 
 #include "common/SafeQueue.h"
+#include "common/http/CurlSocketLoop.h"
 #include "common/http/HttpRequest.h"
 
 namespace logtail {
@@ -51,6 +52,7 @@ private:
     void DoRun();
 
     CURLM* mClient = nullptr;
+    CurlSocketLoop mLoop;
     SafeQueue<std::unique_ptr<AsynHttpRequest>> mQueue;
 
     std::future<void> mThreadRes;
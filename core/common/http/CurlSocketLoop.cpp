@@ -0,0 +1,238 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/http/CurlSocketLoop.h"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <thread>
+
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+#if defined(__linux__)
+// events are level triggered, so those not returned in one round are returned in the next one
+static const int kMaxEventsPerRound = 256;
+#endif
+
+CurlSocketLoop::~CurlSocketLoop() {
+#if defined(__linux__)
+    if (mEpollFd >= 0) {
+        close(mEpollFd);
+    }
+    if (mWakeupFd >= 0) {
+        close(mWakeupFd);
+    }
+#endif
+}
+
+bool CurlSocketLoop::Init(CURLM* client) {
+    mClient = client;
+#if defined(__linux__)
+    mTimerDeadline.reset();
+    // fds are kept when the loop is restarted, so that Wakeup never writes to a closed fd
+    if (mEpollFd < 0) {
+        mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (mEpollFd < 0) {
+            LOG_ERROR(sLogger, ("failed to create epoll fd", "")("errno", errno));
+            return false;
+        }
+    }
+    if (mWakeupFd < 0) {
+        int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd < 0) {
+            LOG_ERROR(sLogger, ("failed to create eventfd", "")("errno", errno));
+            return false;
+        }
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = fd;
+        if (epoll_ctl(mEpollFd, EPOLL_CTL_ADD, fd, &ev) != 0) {
+            LOG_ERROR(sLogger, ("failed to add eventfd to epoll", "")("errno", errno));
+            close(fd);
+            return false;
+        }
+        mWakeupFd = fd;
+    }
+    curl_multi_setopt(mClient, CURLMOPT_SOCKETFUNCTION, OnSocket);
+    curl_multi_setopt(mClient, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(mClient, CURLMOPT_TIMERFUNCTION, OnTimer);
+    curl_multi_setopt(mClient, CURLMOPT_TIMERDATA, this);
+#endif
+    return true;
+}
+
+void CurlSocketLoop::Cleanup() {
+    // sockets are removed from epoll by the socket callback during cleanup
+    auto mc = curl_multi_cleanup(mClient);
+    if (mc != CURLM_OK) {
+        LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
+    }
+    mClient = nullptr;
+}
+
+#if defined(__linux__)
+void CurlSocketLoop::Run(int& runningHandlers, long maxWaitMs) {
+    long waitMs = maxWaitMs;
+    if (mTimerDeadline) {
+        auto left = chrono::duration_cast<chrono::milliseconds>(*mTimerDeadline - chrono::steady_clock::now()).count();
+        waitMs = max(0L, min(static_cast<long>(left), maxWaitMs));
+    }
+
+    epoll_event events[kMaxEventsPerRound];
+    int n = epoll_wait(mEpollFd, events, kMaxEventsPerRound, static_cast<int>(waitMs));
+    if (n < 0 && errno != EINTR) {
+        LOG_ERROR(sLogger, ("failed to call epoll_wait", "sleep 100ms")("errno", errno));
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+    for (int i = 0; i < n; ++i) {
+        if (events[i].data.fd == mWakeupFd) {
+            uint64_t cnt = 0;
+            while (read(mWakeupFd, &cnt, sizeof(cnt)) > 0) {
+            }
+            // cleared only after draining, otherwise a write in between would be drained with the state left set,
+            // and no later wakeup would ever be written. Requests added before clearing are picked up by the caller
+            // after this round.
+            mWakeupPending = false;
+            continue;
+        }
+        int flags = 0;
+        if (events[i].events & EPOLLIN) {
+            flags |= CURL_CSELECT_IN;
+        }
+        if (events[i].events & EPOLLOUT) {
+            flags |= CURL_CSELECT_OUT;
+        }
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            flags |= CURL_CSELECT_ERR;
+        }
+        SocketAction(events[i].data.fd, flags, runningHandlers);
+    }
+    if (mTimerDeadline && chrono::steady_clock::now() >= *mTimerDeadline) {
+        // the timer may be set again by curl during the action
+        mTimerDeadline.reset();
+        SocketAction(CURL_SOCKET_TIMEOUT, 0, runningHandlers);
+    }
+}
+
+void CurlSocketLoop::Wakeup() {
+    int fd = mWakeupFd;
+    if (fd < 0 || mWakeupPending.exchange(true)) {
+        return;
+    }
+    uint64_t cnt = 1;
+    if (write(fd, &cnt, sizeof(cnt)) < 0) {
+        mWakeupPending = false;
+    }
+}
+
+void CurlSocketLoop::SocketAction(curl_socket_t s, int events, int& runningHandlers) {
+    CURLMcode mc = curl_multi_socket_action(mClient, s, events, &runningHandlers);
+    if (mc != CURLM_OK) {
+        LOG_ERROR(sLogger, ("failed to call curl_multi_socket_action", "")("errMsg", curl_multi_strerror(mc)));
+    }
+}
+
+int CurlSocketLoop::OnSocket(CURL* easy, curl_socket_t s, int what, void* userp, void* socketp) {
+    auto* loop = static_cast<CurlSocketLoop*>(userp);
+    if (what == CURL_POLL_REMOVE) {
+        // the socket may have been closed already, in which case it is removed from epoll automatically
+        epoll_ctl(loop->mEpollFd, EPOLL_CTL_DEL, s, nullptr);
+        return 0;
+    }
+    epoll_event ev{};
+    ev.events = ((what & CURL_POLL_IN) ? EPOLLIN : 0) | ((what & CURL_POLL_OUT) ? EPOLLOUT : 0);
+    ev.data.fd = s;
+    // socketp is set by curl_multi_assign once the socket is added to epoll, and cleared by curl when it is removed
+    if (socketp != nullptr) {
+        if (epoll_ctl(loop->mEpollFd, EPOLL_CTL_MOD, s, &ev) == 0) {
+            return 0;
+        }
+        // the fd may be closed and reused without being removed first
+        if (errno != ENOENT) {
+            LOG_WARNING(sLogger, ("failed to modify socket in epoll", s)("errno", errno));
+            return -1;
+        }
+    }
+    if (epoll_ctl(loop->mEpollFd, EPOLL_CTL_ADD, s, &ev) != 0) {
+        LOG_WARNING(sLogger, ("failed to add socket to epoll", s)("errno", errno));
+        return -1;
+    }
+    curl_multi_assign(loop->mClient, s, loop);
+    return 0;
+}
+
+int CurlSocketLoop::OnTimer(CURLM* client, long timeoutMs, void* userp) {
+    auto* loop = static_cast<CurlSocketLoop*>(userp);
+    if (timeoutMs < 0) {
+        loop->mTimerDeadline.reset();
+    } else {
+        loop->mTimerDeadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    }
+    return 0;
+}
+#else
+void CurlSocketLoop::Run(int& runningHandlers, long maxWaitMs) {
+    CURLMcode mc;
+    struct timeval timeout {
+        maxWaitMs / 1000, (maxWaitMs % 1000) * 1000
+    };
+    long curlTimeout = -1;
+    if ((mc = curl_multi_timeout(mClient, &curlTimeout)) != CURLM_OK) {
+        LOG_WARNING(sLogger,
+                    ("failed to call curl_multi_timeout", "use default timeout")("errMsg", curl_multi_strerror(mc)));
+    }
+    if (curlTimeout >= 0 && curlTimeout < maxWaitMs) {
+        timeout.tv_sec = curlTimeout / 1000;
+        timeout.tv_usec = (curlTimeout % 1000) * 1000;
+    }
+
+    int maxfd = -1;
+    fd_set fdread;
+    fd_set fdwrite;
+    fd_set fdexcep;
+    FD_ZERO(&fdread);
+    FD_ZERO(&fdwrite);
+    FD_ZERO(&fdexcep);
+    if ((mc = curl_multi_fdset(mClient, &fdread, &fdwrite, &fdexcep, &maxfd)) != CURLM_OK) {
+        LOG_ERROR(sLogger, ("failed to call curl_multi_fdset", "sleep 100ms")("errMsg", curl_multi_strerror(mc)));
+    }
+    if (maxfd == -1) {
+        // sleep min(timeout, 100ms) according to libcurl
+        int64_t sleepMs = (curlTimeout >= 0 && curlTimeout < 100) ? curlTimeout : 100;
+        this_thread::sleep_for(chrono::milliseconds(sleepMs));
+    } else {
+        select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
+    }
+
+    if ((mc = curl_multi_perform(mClient, &runningHandlers)) != CURLM_OK) {
+        LOG_ERROR(sLogger,
+                  ("failed to call curl_multi_perform", "sleep 100ms and retry")("errMsg", curl_multi_strerror(mc)));
+        this_thread::sleep_for(chrono::milliseconds(100));
+    }
+}
+
+void CurlSocketLoop::Wakeup() {
+}
+#endif
+
+} // namespace logtail
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+
+#include "curl/multi.h"
+
+namespace logtail {
+
+// Drives a curl multi handle in one thread.
+//
+// On linux, curl reports the sockets it cares about through CURLMOPT_SOCKETFUNCTION and they are watched by epoll, so
+// that only sockets with events are handled by curl_multi_socket_action. This removes the FD_SETSIZE limit of select
+// and keeps the cost of each round independent of the number of requests in flight. On other platforms, the multi
+// handle is driven by curl_multi_perform and select.
+class CurlSocketLoop {
+public:
+    CurlSocketLoop() = default;
+    CurlSocketLoop(const CurlSocketLoop&) = delete;
+    CurlSocketLoop& operator=(const CurlSocketLoop&) = delete;
+    ~CurlSocketLoop();
+
+    bool Init(CURLM* client);
+    // clean up the multi handle given to Init
+    void Cleanup();
+
+    // wait for socket events or the timeout requested by curl, at most maxWaitMs, and let curl handle them
+    void Run(int& runningHandlers, long maxWaitMs);
+    // make the current or next Run return immediately, can be called from any thread
+    void Wakeup();
+
+private:
+#if defined(__linux__)
+    static int OnSocket(CURL* easy, curl_socket_t s, int what, void* userp, void* socketp);
+    static int OnTimer(CURLM* client, long timeoutMs, void* userp);
+
+    void SocketAction(curl_socket_t s, int events, int& runningHandlers);
+
+    int mEpollFd = -1;
+    std::atomic_int mWakeupFd = -1;
+    std::atomic_bool mWakeupPending = false;
+    std::optional<std::chrono::steady_clock::time_point> mTimerDeadline;
+#endif
+
+    CURLM* mClient = nullptr;
+};
+
+} // namespace logtail
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "common/memory/PayloadBuffer.h"
+
+#include "common/Flags.h"
+#include "monitor/metric_constants/MetricConstants.h"
+
+DEFINE_FLAG_INT32(payload_buffer_pool_max_cached_size_mb, "max size of released payload memory kept for reuse", 64);
+
+using namespace std;
+
+namespace logtail {
+
+const string PayloadBuffer::sEmpty;
+
+PayloadBuffer::PayloadBuffer(string&& data)
+    : mData(new string(std::move(data)), [](const string* p) {
+          PayloadBufferPool::GetInstance()->Release(std::move(*const_cast<string*>(p)));
+          delete p;
+      }) {
+}
+
+PayloadBufferPool::PayloadBufferPool() {
+    WriteMetrics::GetInstance()->CreateMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_PAYLOAD_BUFFER_POOL}});
+    mHitsTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_POOL_HITS_TOTAL);
+    mMissesTotal = mMetricsRecordRef.CreateCounter(METRIC_COMPONENT_POOL_MISSES_TOTAL);
+    mCachedSizeBytesGauge = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_POOL_CACHED_SIZE_BYTES);
+    WriteMetrics::GetInstance()->CommitMetricsRecordRef(mMetricsRecordRef);
+}
+
+string PayloadBufferPool::Acquire(size_t size) {
+    size_t bits = kMinClassBits;
+    while (bits <= kMaxClassBits && (static_cast<size_t>(1) << bits) < size) {
+        ++bits;
+    }
+    string res;
+    if (bits > kMaxClassBits) {
+        ADD_COUNTER(mMissesTotal, 1);
+        res.reserve(size);
+        return res;
+    }
+    {
+        lock_guard<mutex> lock(mMux);
+        auto& freeList = mFreeLists[bits - kMinClassBits];
+        if (!freeList.empty()) {
+            res = std::move(freeList.back());
+            freeList.pop_back();
+            mCachedSizeBytes -= res.capacity();
+            SET_GAUGE(mCachedSizeBytesGauge, mCachedSizeBytes);
+            ADD_COUNTER(mHitsTotal, 1);
+            return res;
+        }
+    }
+    ADD_COUNTER(mMissesTotal, 1);
+    res.reserve(static_cast<size_t>(1) << bits);
+    return res;
+}
+
+void PayloadBufferPool::Release(string&& data) {
+    // memory is kept in the largest class it can serve
+    size_t capacity = data.capacity();
+    if (capacity < (static_cast<size_t>(1) << kMinClassBits) || capacity >= (static_cast<size_t>(2) << kMaxClassBits)) {
+        return;
+    }
+    size_t bits = kMinClassBits;
+    while (bits < kMaxClassBits && (static_cast<size_t>(2) << bits) <= capacity) {
+        ++bits;
+    }
+    lock_guard<mutex> lock(mMux);
+    if (mCachedSizeBytes + capacity
+        > static_cast<size_t>(INT32_FLAG(payload_buffer_pool_max_cached_size_mb)) * 1024 * 1024) {
+        return;
+    }
+    data.clear();
+    mFreeLists[bits - kMinClassBits].emplace_back(std::move(data));
+    mCachedSizeBytes += capacity;
+    SET_GAUGE(mCachedSizeBytesGauge, mCachedSizeBytes);
+}
+
+} // namespace logtail
@@ -0,0 +1,89 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "monitor/MetricManager.h"
+
+namespace logtail {
+
+// Immutable payload shared by reference counting, so that sender queue items, their clones and http requests refer to
+// the same memory. The memory is given back to PayloadBufferPool when the last copy is destructed.
+class PayloadBuffer {
+public:
+    PayloadBuffer() = default;
+    explicit PayloadBuffer(std::string&& data);
+
+    const std::string& str() const { return mData ? *mData : sEmpty; }
+    const char* data() const { return str().data(); }
+    size_t size() const { return mData ? mData->size() : 0; }
+    // memory held by the payload, which may be much larger than its size when taken from the pool
+    size_t capacity() const { return mData ? mData->capacity() : 0; }
+    bool empty() const { return size() == 0; }
+
+private:
+    static const std::string sEmpty;
+
+    std::shared_ptr<const std::string> mData;
+};
+
+// Cache of released payload memory in power-of-two size classes. Payload producers, e.g. serializers and compressors,
+// write into strings acquired from the pool, whose capacity is kept when they are turned into PayloadBuffer.
+class PayloadBufferPool {
+public:
+    PayloadBufferPool(const PayloadBufferPool&) = delete;
+    PayloadBufferPool& operator=(const PayloadBufferPool&) = delete;
+
+    static PayloadBufferPool* GetInstance() {
+        // never destructed, since payloads held by other singletons may be released during exit
+        static PayloadBufferPool* instance = new PayloadBufferPool();
+        return instance;
+    }
+
+    // returns an empty string with capacity of at least size, which reuses released memory if possible
+    std::string Acquire(size_t size);
+    void Release(std::string&& data);
+
+private:
+    static constexpr size_t kMinClassBits = 12; // 4KB
+    static constexpr size_t kMaxClassBits = 25; // 32MB
+    static constexpr size_t kClassCnt = kMaxClassBits - kMinClassBits + 1;
+
+    PayloadBufferPool();
+
+    std::mutex mMux;
+    std::array<std::vector<std::string>, kClassCnt> mFreeLists;
+    size_t mCachedSizeBytes = 0;
+
+    MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mHitsTotal;
+    CounterPtr mMissesTotal;
+    IntGaugePtr mCachedSizeBytesGauge;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class PayloadBufferUnittest;
+#endif
+};
+
+} // namespace logtail
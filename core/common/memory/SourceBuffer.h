@@ -168,8 +168,13 @@ public:
     StringBuffer CopyString(const std::string& s) { return CopyString(s.data(), s.length()); }
     StringBuffer CopyString(StringView s) { return CopyString(s.data(), s.length()); }
 
+    // keep other buffer alive as long as this one, used when events referencing other buffer are moved to the group
+    // owning this buffer, or when events reference memory owned by others, e.g. the protobuf arena of a request
+    void AddDependency(std::shared_ptr<void> other) { mDependencies.push_back(std::move(other)); }
+
 private:
     BufferAllocator mAllocator;
+    std::vector<std::shared_ptr<void>> mDependencies;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class LogEventUnittest;
@@ -14,6 +14,8 @@
 
 #include "common/timer/Timer.h"
 
+#include <vector>
+
 #include "logger/Logger.h"
 
 using namespace std;
@@ -55,55 +57,75 @@ void Timer::Stop() {
     }
 }
 
-void Timer::PushEvent(unique_ptr<TimerEvent>&& e) {
+TimerId Timer::PushEvent(unique_ptr<TimerEvent>&& e) {
     lock_guard<mutex> lock(mQueueMux);
-    if (mQueue.empty() || e->GetExecTime() < mQueue.top()->GetExecTime()) {
-        mQueue.push(std::move(e));
+    uint64_t tick = ToTick(e->GetExecTime(), true);
+    TimerId id = mWheel.Schedule(tick, std::move(e));
+    if (tick < mNextCheckTick) {
+        mNextCheckTick = tick;
         mCV.notify_one();
-    } else {
-        mQueue.push(std::move(e));
     }
+    return id;
+}
+
+bool Timer::CancelEvent(TimerId id) {
+    lock_guard<mutex> lock(mQueueMux);
+    return mWheel.Cancel(id);
 }
 
 void Timer::Run() {
     LOG_INFO(sLogger, ("timer", "started"));
+    vector<unique_ptr<TimerEvent>> events;
     unique_lock<mutex> threadLock(mThreadRunningMux);
     while (mIsThreadRunning) {
-        unique_lock<mutex> queueLock(mQueueMux);
-        if (mQueue.empty()) {
-            queueLock.unlock();
-            mCV.wait(threadLock, [this]() { return !mIsThreadRunning || !mQueue.empty(); });
-        } else {
-            auto now = chrono::steady_clock::now();
-            while (!mQueue.empty()) {
-                auto& e = mQueue.top();
-                if (now < e->GetExecTime()) {
-                    auto timeout = e->GetExecTime() - now + chrono::milliseconds(1);
-                    queueLock.unlock();
-                    mCV.wait_for(threadLock, timeout);
-                    break;
+        uint64_t nextCheckTick = 0;
+        {
+            lock_guard<mutex> queueLock(mQueueMux);
+            mWheel.Advance(ToTick(chrono::steady_clock::now(), false),
+                           [&events](TimerId, unique_ptr<TimerEvent>&& e) { events.emplace_back(std::move(e)); });
+            nextCheckTick = mNextCheckTick = mWheel.GetNextCheckTick();
+        }
+        if (!events.empty()) {
+            for (auto& e : events) {
+                if (!e->IsValid()) {
+                    LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
                 } else {
-                    auto e = std::move(const_cast<unique_ptr<TimerEvent>&>(mQueue.top()));
-                    mQueue.pop();
-                    queueLock.unlock();
-                    if (!e->IsValid()) {
-                        LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
-                    } else {
-                        e->Execute();
-                    }
-                    queueLock.lock();
+                    e->Execute();
                 }
             }
+            events.clear();
+            continue;
+        }
+        // woken up when an event earlier than the next check tick is pushed
+        auto hasEarlierEvent = [this, nextCheckTick]() {
+            lock_guard<mutex> queueLock(mQueueMux);
+            return !mIsThreadRunning || mNextCheckTick < nextCheckTick;
+        };
+        if (nextCheckTick == numeric_limits<uint64_t>::max()) {
+            mCV.wait(threadLock, hasEarlierEvent);
+        } else {
+            mCV.wait_until(threadLock, mStartTime + nextCheckTick * kTickDuration, hasEarlierEvent);
         }
     }
 }
 
+uint64_t Timer::ToTick(chrono::steady_clock::time_point time, bool roundUp) const {
+    if (time <= mStartTime) {
+        return 0;
+    }
+    auto duration = time - mStartTime;
+    uint64_t tick = chrono::duration_cast<chrono::milliseconds>(duration).count() / kTickDuration.count();
+    if (roundUp && duration > tick * kTickDuration) {
+        ++tick;
+    }
+    return tick;
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void Timer::Clear() {
     lock_guard<mutex> lock(mQueueMux);
-    while (!mQueue.empty()) {
-        mQueue.pop();
-    }
+    // tests may have advanced the wheel ahead of now
+    mWheel = TimingWheel<unique_ptr<TimerEvent>>(ToTick(chrono::steady_clock::now(), false));
 }
 #endif
 
@@ -16,22 +16,18 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <future>
+#include <limits>
 #include <memory>
 #include <mutex>
-#include <queue>
 
 #include "common/timer/TimerEvent.h"
+#include "common/timer/TimingWheel.h"
 
 namespace logtail {
 
-struct TimerEventCompare {
-    bool operator()(const std::unique_ptr<TimerEvent>& lhs, const std::unique_ptr<TimerEvent>& rhs) const {
-        return lhs->GetExecTime() > rhs->GetExecTime();
-    }
-};
-
 class Timer {
 public:
     ~Timer();
@@ -45,18 +41,27 @@ public:
     }
     void Init();
     void Stop();
-    void PushEvent(std::unique_ptr<TimerEvent>&& e);
+    // the returned id can be used to cancel the event before it is executed
+    TimerId PushEvent(std::unique_ptr<TimerEvent>&& e);
+    bool CancelEvent(TimerId id);
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
 #endif
 
 private:
+    // an event is executed no earlier than its exec time, and no later than one tick after it
+    static constexpr std::chrono::milliseconds kTickDuration{1};
+
     Timer() = default;
     void Run();
+    uint64_t ToTick(std::chrono::steady_clock::time_point time, bool roundUp) const;
+
+    const std::chrono::steady_clock::time_point mStartTime = std::chrono::steady_clock::now();
 
     mutable std::mutex mQueueMux;
-    std::priority_queue<std::unique_ptr<TimerEvent>, std::vector<std::unique_ptr<TimerEvent>>, TimerEventCompare>
-        mQueue;
+    TimingWheel<std::unique_ptr<TimerEvent>> mWheel;
+    // the tick the running thread is going to wake up at, so that only events earlier than it need to notify the thread
+    uint64_t mNextCheckTick = std::numeric_limits<uint64_t>::max();
 
     std::future<void> mThreadRes;
     mutable std::mutex mThreadRunningMux;
@@ -0,0 +1,260 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace logtail {
+
+using TimerId = uint64_t;
+constexpr TimerId kInvalidTimerId = 0;
+
+// Hierarchical timing wheel in the manner of the linux kernel timer wheel, with kLevels levels of kSlotCnt slots each.
+// Level 0 holds entries expiring within kSlotCnt ticks, and entries of upper levels are cascaded into lower levels when
+// the current tick reaches their range. Schedule and Cancel are O(1), and Advance costs O(ticks passed + expired).
+//
+// Entries live in a node pool and are linked into slot lists by index. A TimerId carries the node index and a
+// generation, so that the id of an expired or cancelled entry never refers to a reused node.
+//
+// Not thread-safe.
+template <typename T>
+class TimingWheel {
+public:
+    explicit TimingWheel(uint64_t startTick = 0) : mCurrentTick(startTick), mSlots(kLevels * kSlotCnt + 1, kNil) {}
+
+    // entries expiring before the current tick, i.e. already passed by Advance, are fired by the next Advance
+    TimerId Schedule(uint64_t expireTick, T&& value) {
+        uint32_t idx = AllocateNode();
+        Node& node = mNodes[idx];
+        node.mValue = std::move(value);
+        node.mExpireTick = expireTick;
+        Link(idx);
+        ++mSize;
+        return MakeId(idx);
+    }
+
+    bool Cancel(TimerId id) {
+        uint32_t idx = 0;
+        if (!Resolve(id, idx)) {
+            return false;
+        }
+        Unlink(idx);
+        mNodes[idx].mValue = T();
+        FreeNode(idx);
+        --mSize;
+        return true;
+    }
+
+    // fires all entries expiring no later than nowTick tick by tick, by calling callback(id, value).
+    // The callback may schedule or cancel entries of the wheel.
+    template <typename F>
+    void Advance(uint64_t nowTick, F&& callback) {
+        if (mSlots[kDueSlot] != kNil) {
+            FireSlot(kDueSlot, callback);
+        }
+        while (mCurrentTick <= nowTick) {
+            if (mSize == 0) {
+                mCurrentTick = nowTick + 1;
+                return;
+            }
+            uint64_t tick = mCurrentTick;
+            if ((tick & kSlotMask) == 0) {
+                for (size_t level = 1; level < kLevels; ++level) {
+                    Cascade(level, (tick >> (level * kSlotBits)) & kSlotMask);
+                    if (((tick >> (level * kSlotBits)) & kSlotMask) != 0) {
+                        break;
+                    }
+                }
+            }
+            // entries scheduled by the callback for this tick are due ones fired by the next Advance
+            mCurrentTick = tick + 1;
+            FireSlot(tick & kSlotMask, callback);
+        }
+    }
+
+    // the tick before which Advance is known to fire nothing, which is either the tick of the first non-empty slot or
+    // the next cascade. Returns 0 if some entries are already due, and UINT64_MAX if the wheel is empty.
+    uint64_t GetNextCheckTick() const {
+        if (mSize == 0) {
+            return std::numeric_limits<uint64_t>::max();
+        }
+        if (mSlots[kDueSlot] != kNil) {
+            return 0;
+        }
+        // cascade happens at the first tick of each round of level 0
+        if ((mCurrentTick & kSlotMask) == 0) {
+            return mCurrentTick;
+        }
+        for (uint64_t tick = mCurrentTick; (tick & kSlotMask) != 0; ++tick) {
+            if (mSlots[tick & kSlotMask] != kNil) {
+                return tick;
+            }
+        }
+        return (mCurrentTick | kSlotMask) + 1;
+    }
+
+    uint64_t GetCurrentTick() const { return mCurrentTick; }
+    size_t Size() const { return mSize; }
+    bool Empty() const { return mSize == 0; }
+
+private:
+    static constexpr size_t kSlotBits = 8;
+    static constexpr size_t kSlotCnt = 1 << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlotCnt - 1;
+    static constexpr size_t kLevels = 4;
+    static constexpr uint64_t kMaxDelta = (static_cast<uint64_t>(1) << (kLevels * kSlotBits)) - 1;
+    // the extra slot after all levels for entries already due
+    static constexpr size_t kDueSlot = kLevels * kSlotCnt;
+    static constexpr uint32_t kNil = std::numeric_limits<uint32_t>::max();
+
+    struct Node {
+        T mValue;
+        uint64_t mExpireTick = 0;
+        uint32_t mPrev = kNil;
+        uint32_t mNext = kNil;
+        // kNil if the node is free or fired
+        uint32_t mSlot = kNil;
+        uint32_t mGeneration = 1;
+    };
+
+    uint32_t AllocateNode() {
+        if (!mFreeNodes.empty()) {
+            uint32_t idx = mFreeNodes.back();
+            mFreeNodes.pop_back();
+            return idx;
+        }
+        mNodes.emplace_back();
+        return static_cast<uint32_t>(mNodes.size() - 1);
+    }
+
+    void FreeNode(uint32_t idx) {
+        Node& node = mNodes[idx];
+        node.mSlot = kNil;
+        node.mPrev = kNil;
+        node.mNext = kNil;
+        ++node.mGeneration;
+        if (node.mGeneration == 0) {
+            node.mGeneration = 1;
+        }
+        mFreeNodes.push_back(idx);
+    }
+
+    TimerId MakeId(uint32_t idx) const {
+        return (static_cast<TimerId>(mNodes[idx].mGeneration) << 32) | (static_cast<TimerId>(idx) + 1);
+    }
+
+    bool Resolve(TimerId id, uint32_t& idx) const {
+        uint64_t low = id & 0xFFFFFFFFULL;
+        if (low == 0 || low > mNodes.size()) {
+            return false;
+        }
+        idx = static_cast<uint32_t>(low - 1);
+        const Node& node = mNodes[idx];
+        return node.mSlot != kNil && node.mGeneration == static_cast<uint32_t>(id >> 32);
+    }
+
+    void Link(uint32_t idx) {
+        Node& node = mNodes[idx];
+        if (node.mExpireTick < mCurrentTick) {
+            LinkToSlot(idx, kDueSlot);
+            return;
+        }
+        uint64_t delta = node.mExpireTick - mCurrentTick;
+        if (delta > kMaxDelta) {
+            // too far away, will be cascaded again until it is in range
+            delta = kMaxDelta;
+        }
+        uint64_t expire = mCurrentTick + delta;
+        size_t level = 0;
+        while (level + 1 < kLevels && delta >= (static_cast<uint64_t>(1) << ((level + 1) * kSlotBits))) {
+            ++level;
+        }
+        LinkToSlot(idx, level * kSlotCnt + ((expire >> (level * kSlotBits)) & kSlotMask));
+    }
+
+    void LinkToSlot(uint32_t idx, size_t slot) {
+        Node& node = mNodes[idx];
+        node.mSlot = static_cast<uint32_t>(slot);
+        node.mPrev = kNil;
+        node.mNext = mSlots[slot];
+        if (node.mNext != kNil) {
+            mNodes[node.mNext].mPrev = idx;
+        }
+        mSlots[slot] = idx;
+    }
+
+    void Unlink(uint32_t idx) {
+        Node& node = mNodes[idx];
+        if (node.mPrev != kNil) {
+            mNodes[node.mPrev].mNext = node.mNext;
+        } else {
+            mSlots[node.mSlot] = node.mNext;
+        }
+        if (node.mNext != kNil) {
+            mNodes[node.mNext].mPrev = node.mPrev;
+        }
+        node.mPrev = kNil;
+        node.mNext = kNil;
+    }
+
+    template <typename F>
+    void FireSlot(size_t slot, F& callback) {
+        uint32_t idx = mSlots[slot];
+        mSlots[slot] = kNil;
+        if (idx == kNil) {
+            return;
+        }
+        // all entries of the slot are released before any callback, which may cancel or reuse them
+        std::vector<std::pair<TimerId, T>> expired;
+        while (idx != kNil) {
+            Node& node = mNodes[idx];
+            uint32_t next = node.mNext;
+            expired.emplace_back(MakeId(idx), std::move(node.mValue));
+            node.mValue = T();
+            FreeNode(idx);
+            --mSize;
+            idx = next;
+        }
+        for (auto& item : expired) {
+            callback(item.first, std::move(item.second));
+        }
+    }
+
+    void Cascade(size_t level, uint64_t slotIdx) {
+        uint32_t& head = mSlots[level * kSlotCnt + slotIdx];
+        uint32_t idx = head;
+        head = kNil;
+        while (idx != kNil) {
+            uint32_t next = mNodes[idx].mNext;
+            Link(idx);
+            idx = next;
+        }
+    }
+
+    uint64_t mCurrentTick = 0;
+    size_t mSize = 0;
+    std::vector<uint32_t> mSlots;
+    std::vector<Node> mNodes;
+    std::vector<uint32_t> mFreeNodes;
+};
+
+} // namespace logtail
@@ -61,7 +61,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mStartPatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mStartPatternRegPtr, mStartPatternPrefixFilter)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.StartPattern is not a valid regex",
@@ -85,7 +85,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mContinuePatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mContinuePatternRegPtr, mContinuePatternPrefixFilter)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.ContinuePattern is not a valid regex",
@@ -109,7 +109,7 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
                                  ctx.GetProjectName(),
                                  ctx.GetLogstoreName(),
                                  ctx.GetRegion());
-        } else if (!ParseRegex(pattern, mEndPatternRegPtr)) {
+        } else if (!ParseRegex(pattern, mEndPatternRegPtr, mEndPatternPrefixFilter)) {
             PARAM_WARNING_IGNORE(ctx.GetLogger(),
                                  ctx.GetAlarm(),
                                  "string param Multiline.EndPattern is not a valid regex",
@@ -201,7 +201,9 @@ bool MultilineOptions::Init(const Json::Value& config, const CollectionPipelineC
     return true;
 }
 
-bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex>& reg) {
+bool MultilineOptions::ParseRegex(const string& pattern,
+                                  shared_ptr<boost::regex>& reg,
+                                  RegexPrefixFilter& prefixFilter) {
     string regexPattern = pattern;
     if (!regexPattern.empty() && EndWith(regexPattern, "$")) {
         regexPattern = regexPattern.substr(0, regexPattern.size() - 1);
@@ -217,6 +219,7 @@ bool MultilineOptions::ParseRegex(const string& pattern, shared_ptr<boost::regex
     } catch (...) {
         return false;
     }
+    prefixFilter = RegexPrefixFilter(regexPattern);
     return true;
 }
 
@@ -23,6 +23,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/RegexPrefixFilter.h"
 
 namespace logtail {
 
@@ -35,6 +36,10 @@ public:
     const std::shared_ptr<boost::regex>& GetStartPatternReg() const { return mStartPatternRegPtr; }
     const std::shared_ptr<boost::regex>& GetContinuePatternReg() const { return mContinuePatternRegPtr; }
     const std::shared_ptr<boost::regex>& GetEndPatternReg() const { return mEndPatternRegPtr; }
+    // lines rejected by the prefix filter of a pattern never match the pattern, which is much cheaper than the regex
+    const RegexPrefixFilter& GetStartPatternPrefixFilter() const { return mStartPatternPrefixFilter; }
+    const RegexPrefixFilter& GetContinuePatternPrefixFilter() const { return mContinuePatternPrefixFilter; }
+    const RegexPrefixFilter& GetEndPatternPrefixFilter() const { return mEndPatternPrefixFilter; }
     bool IsMultiline() const { return mIsMultiline; }
 
     Mode mMode = Mode::CUSTOM;
@@ -45,11 +50,14 @@ public:
     bool mIgnoringUnmatchWarning = false;
 
 private:
-    bool ParseRegex(const std::string& pattern, std::shared_ptr<boost::regex>& reg);
+    bool ParseRegex(const std::string& pattern, std::shared_ptr<boost::regex>& reg, RegexPrefixFilter& prefixFilter);
 
     std::shared_ptr<boost::regex> mStartPatternRegPtr;
     std::shared_ptr<boost::regex> mContinuePatternRegPtr;
     std::shared_ptr<boost::regex> mEndPatternRegPtr;
+    RegexPrefixFilter mStartPatternPrefixFilter;
+    RegexPrefixFilter mContinuePatternPrefixFilter;
+    RegexPrefixFilter mEndPatternPrefixFilter;
     bool mIsMultiline = false;
 };
 
@@ -201,6 +201,16 @@ bool CreateModifyHandler::IsAllFileRead() {
     return true;
 }
 
+void CreateModifyHandler::CollectReadersToRead(const Event& event, std::vector<LogFileReaderPtr>& readers) {
+    if (!event.IsModify() || event.IsDir()) {
+        return;
+    }
+    // handlers of configs not matching the file have no reader for it
+    for (auto& item : mModifyHandlerPtrMap) {
+        item.second->CollectReadersToRead(event, readers);
+    }
+}
+
 ModifyHandler* CreateModifyHandler::GetOrCreateModifyHandler(const std::string& configName,
                                                              const FileDiscoveryConfig& pConfig) {
     ModifyHandlerMap::iterator iter = mModifyHandlerPtrMap.find(configName);
@@ -1028,6 +1038,18 @@ bool ModifyHandler::DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) {
     return true;
 }
 
+void ModifyHandler::CollectReadersToRead(const Event& event, std::vector<LogFileReaderPtr>& readers) {
+    auto iter = mNameReaderMap.find(event.GetEventObject());
+    if (iter == mNameReaderMap.end() || iter->second.empty()) {
+        return;
+    }
+    // only the head of the reader array is read by Handle, unless it cannot be opened
+    const auto& reader = iter->second[0];
+    if (reader->IsFileOpened()) {
+        readers.push_back(reader);
+    }
+}
+
 bool ModifyHandler::IsAllFileRead() {
     for (auto it = mNameReaderMap.begin(); it != mNameReaderMap.end(); ++it) {
         if (it->second.size() > 1 || (!it->second.empty() && !it->second[0]->IsReadToEnd())) {
@@ -20,6 +20,7 @@
 #include <deque>
 #include <map>
 #include <unordered_map>
+#include <vector>
 
 #include "file_server/reader/LogFileReader.h"
 
@@ -40,6 +41,8 @@ public:
     virtual void HandleTimeOut() = 0;
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) = 0;
     virtual bool IsAllFileRead() { return true; }
+    // collect the readers that will be read when the event is handled, so that their files can be read in batch
+    virtual void CollectReadersToRead(const Event& event, std::vector<LogFileReaderPtr>& readers) {}
     virtual ~EventHandler() {}
 };
 
@@ -113,6 +116,7 @@ public:
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
+    void CollectReadersToRead(const Event& event, std::vector<LogFileReaderPtr>& readers) override;
     const std::string& GetConfigName() const { return mConfigName; }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -170,6 +174,7 @@ public:
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
+    void CollectReadersToRead(const Event& event, std::vector<LogFileReaderPtr>& readers) override;
 
     ModifyHandler* GetOrCreateModifyHandler(const std::string& configName, const FileDiscoveryConfig& pConfig);
 
@@ -56,6 +56,11 @@ DEFINE_FLAG_INT32(read_local_event_interval, "seconds", 60);
 DEFINE_FLAG_BOOL(force_close_file_on_container_stopped,
                  "whether close file handler immediately when associate container stopped",
                  false);
+DEFINE_FLAG_BOOL(enable_io_uring_file_read,
+                 "read files of modify events in batch with io_uring, pread is used if io_uring is not supported",
+                 false);
+DEFINE_FLAG_INT32(file_read_batch_size, "max modify events whose files are read in one batch", 64);
+DEFINE_FLAG_INT32(file_read_batch_prefetch_size, "bytes", 64 * 1024);
 
 
 namespace logtail {
@@ -344,6 +349,37 @@ void LogInput::ProcessEvent(EventDispatcher* dispatcher, Event* ev) {
     delete ev;
 }
 
+void LogInput::ProcessEvents(EventDispatcher* dispatcher, vector<Event*>& events) {
+    vector<LogFileReaderPtr> readers;
+    for (auto* ev : events) {
+        EventHandler* handler = dispatcher->GetHandler(ev->GetSource().c_str());
+        if (handler) {
+            handler->CollectReadersToRead(*ev, readers);
+        }
+    }
+    vector<FileReadRequest> requests;
+    vector<LogFileReaderPtr> preparedReaders;
+    for (auto& reader : readers) {
+        FileReadRequest request;
+        if (reader->PrepareRead(INT32_FLAG(file_read_batch_prefetch_size), request)) {
+            requests.push_back(request);
+            preparedReaders.push_back(reader);
+        }
+    }
+    mBatchFileReader.Read(requests);
+    for (size_t i = 0; i < preparedReaders.size(); ++i) {
+        preparedReaders[i]->SetPrefetchResult(requests[i].result);
+    }
+
+    for (auto* ev : events) {
+        ProcessEvent(dispatcher, ev);
+    }
+    // data not read by the events, e.g. when the process queue is full, may be outdated before the next read
+    for (auto& reader : preparedReaders) {
+        reader->DropPrefetchedData();
+    }
+}
+
 void LogInput::UpdateCriticalMetric(int32_t curTime) {
     SET_GAUGE(mLastRunTime, mLastReadEventTime.load());
     LoongCollectorMonitor::GetInstance()->SetAgentOpenFdTotal(
@@ -373,17 +409,33 @@ void LogInput::ProcessLoop() {
     int32_t lastReadLocalEventTime = prevTime;
     mEventProcessCount = 0;
     BlockedEventManager* pBlockedEventManager = BlockedEventManager::GetInstance();
+    mBatchFileReader.Init(BOOL_FLAG(enable_io_uring_file_read), INT32_FLAG(file_read_batch_size));
+    vector<Event*> events;
     string path;
     while (true) {
         ReadLock lock(mAccessMainThreadRWL);
         TryReadEvents(false);
-        Event* ev = PopEventQueue();
-        if (ev != NULL) {
-            ++mEventProcessCount;
+        if (mBatchFileReader.IsIoUringEnabled()) {
+            Event* ev = NULL;
+            while (events.size() < static_cast<size_t>(INT32_FLAG(file_read_batch_size))
+                   && (ev = PopEventQueue()) != NULL) {
+                events.push_back(ev);
+            }
+        } else if (Event* ev = PopEventQueue()) {
+            events.push_back(ev);
+        }
+        if (!events.empty()) {
+            mEventProcessCount += static_cast<int32_t>(events.size());
             if (mIdleFlag) {
-                delete ev;
-            } else
-                ProcessEvent(dispatcher, ev);
+                for (auto* ev : events) {
+                    delete ev;
+                }
+            } else if (events.size() == 1) {
+                ProcessEvent(dispatcher, events[0]);
+            } else {
+                ProcessEvents(dispatcher, events);
+            }
+            events.clear();
         } else {
             unique_lock<mutex> lock(mFeedbackMux);
             mFeedbackCV.wait_for(lock, chrono::microseconds(INT32_FLAG(log_input_thread_wait_interval)));
@@ -25,6 +25,7 @@
 
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
+#include "file_server/reader/BatchFileReader.h"
 #include "monitor/Monitor.h"
 
 namespace logtail {
@@ -67,6 +68,8 @@ private:
     ~LogInput();
     void ProcessLoop();
     void ProcessEvent(EventDispatcher* dispatcher, Event* ev);
+    // process events whose files are read in one batch before they are handled
+    void ProcessEvents(EventDispatcher* dispatcher, std::vector<Event*>& events);
     Event* PopEventQueue();
     void UpdateCriticalMetric(int32_t curTime);
 
@@ -81,6 +84,7 @@ private:
     volatile bool mIdleFlag;
     int32_t mEventProcessCount;
     int32_t mLastUpdateMetricTime;
+    BatchFileReader mBatchFileReader;
 
     IntGaugePtr mLastRunTime;
     IntGaugePtr mRegisterdHandlersTotal;
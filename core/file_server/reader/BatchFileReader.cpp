@@ -0,0 +1,278 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/reader/BatchFileReader.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+
+#include <cerrno>
+#include <cstring>
+#include <limits>
+
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+// IORING_OP_READ, which is used to read into a plain buffer, comes with IORING_FEAT_RW_CUR_POS in linux 5.6
+#if defined(__linux__) && defined(IORING_FEAT_RW_CUR_POS) && defined(__NR_io_uring_setup)
+#define LOGTAIL_IO_URING_SUPPORTED
+#endif
+
+#ifdef LOGTAIL_IO_URING_SUPPORTED
+static const int64_t kReadNotDone = numeric_limits<int64_t>::min();
+
+struct BatchFileReader::IoUring {
+    ~IoUring() {
+        if (mSqes != nullptr) {
+            munmap(mSqes, mSqesSize);
+        }
+        if (mCqRing != nullptr && mCqRing != mSqRing) {
+            munmap(mCqRing, mCqRingSize);
+        }
+        if (mSqRing != nullptr) {
+            munmap(mSqRing, mSqRingSize);
+        }
+        if (mFd >= 0) {
+            close(mFd);
+        }
+    }
+
+    bool Setup(uint32_t entries) {
+        io_uring_params params{};
+#ifdef IORING_SETUP_DEFER_TASKRUN
+        // the ring is only used by the thread creating it, and completions are only needed when waiting for them,
+        // which saves interrupting the thread for each completion, supported since linux 6.1
+        params.flags = IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_DEFER_TASKRUN;
+        mFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        if (mFd < 0 && errno == EINVAL) {
+            params = io_uring_params{};
+            mFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+        }
+#else
+        mFd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+#endif
+        if (mFd < 0) {
+            // ENOSYS if the kernel is too old, EPERM if io_uring is disabled by sysctl or seccomp
+            LOG_WARNING(sLogger, ("failed to setup io_uring", "use pread instead")("errno", errno));
+            return false;
+        }
+        if (!(params.features & IORING_FEAT_RW_CUR_POS)) {
+            LOG_WARNING(sLogger, ("io_uring read is not supported by the kernel", "use pread instead"));
+            return false;
+        }
+        mEntries = params.sq_entries;
+        mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+        mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (singleMmap) {
+            mSqRingSize = mCqRingSize = max(mSqRingSize, mCqRingSize);
+        }
+        mSqRing = Map(mSqRingSize, IORING_OFF_SQ_RING);
+        if (mSqRing == nullptr) {
+            return false;
+        }
+        mCqRing = singleMmap ? mSqRing : Map(mCqRingSize, IORING_OFF_CQ_RING);
+        if (mCqRing == nullptr) {
+            return false;
+        }
+        mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        mSqes = static_cast<io_uring_sqe*>(Map(mSqesSize, IORING_OFF_SQES));
+        if (mSqes == nullptr) {
+            return false;
+        }
+
+        auto* sq = static_cast<char*>(mSqRing);
+        mSqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+        mSqMask = *reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+        mSqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+        auto* cq = static_cast<char*>(mCqRing);
+        mCqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+        mCqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+        mCqMask = *reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+        mCqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    void* Map(size_t size, off_t offset) {
+        void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, mFd, offset);
+        if (ptr == MAP_FAILED) {
+            LOG_WARNING(sLogger, ("failed to map io_uring", "use pread instead")("errno", errno));
+            return nullptr;
+        }
+        return ptr;
+    }
+
+    int Enter(uint32_t toSubmit, uint32_t minComplete) {
+        return static_cast<int>(
+            syscall(__NR_io_uring_enter, mFd, toSubmit, minComplete, IORING_ENTER_GETEVENTS, nullptr, 0));
+    }
+
+    int mFd = -1;
+    uint32_t mEntries = 0;
+    void* mSqRing = nullptr;
+    size_t mSqRingSize = 0;
+    void* mCqRing = nullptr;
+    size_t mCqRingSize = 0;
+    io_uring_sqe* mSqes = nullptr;
+    size_t mSqesSize = 0;
+    // the submission queue is only written by this process, so its head is not needed
+    uint32_t* mSqTail = nullptr;
+    uint32_t mSqMask = 0;
+    uint32_t* mSqArray = nullptr;
+    uint32_t* mCqHead = nullptr;
+    uint32_t* mCqTail = nullptr;
+    uint32_t mCqMask = 0;
+    io_uring_cqe* mCqes = nullptr;
+};
+#else
+struct BatchFileReader::IoUring {};
+#endif
+
+BatchFileReader::BatchFileReader() = default;
+
+BatchFileReader::~BatchFileReader() = default;
+
+bool BatchFileReader::Init(bool enableIoUring, uint32_t queueDepth) {
+    mRing.reset();
+    if (!enableIoUring) {
+        return false;
+    }
+#ifdef LOGTAIL_IO_URING_SUPPORTED
+    auto ring = make_unique<IoUring>();
+    if (!ring->Setup(max(queueDepth, 1U))) {
+        return false;
+    }
+    mRing = std::move(ring);
+    LOG_INFO(sLogger, ("read files with io_uring, queue depth", mRing->mEntries));
+    return true;
+#else
+    LOG_WARNING(sLogger, ("io_uring is not supported on this platform", "use pread instead"));
+    return false;
+#endif
+}
+
+void BatchFileReader::Read(vector<FileReadRequest>& requests) {
+#ifdef LOGTAIL_IO_URING_SUPPORTED
+    if (mRing) {
+        for (size_t begin = 0; begin < requests.size(); begin += mRing->mEntries) {
+            size_t end = min(requests.size(), begin + mRing->mEntries);
+            if (!ReadWithIoUring(requests, begin, end)) {
+                LOG_ERROR(sLogger, ("failed to read files with io_uring", "use pread instead"));
+                // no read is in flight now, and those not submitted are still marked as not done
+                mRing.reset();
+                for (size_t i = begin; i < requests.size(); ++i) {
+                    if (i >= end || requests[i].result == kReadNotDone) {
+                        Pread(requests[i]);
+                    }
+                }
+                return;
+            }
+        }
+        return;
+    }
+#endif
+    for (auto& request : requests) {
+        Pread(request);
+    }
+}
+
+void BatchFileReader::Pread(FileReadRequest& request) {
+#if defined(__linux__)
+    ssize_t res = pread(request.fd, request.buf, request.size, request.offset);
+    request.result = res < 0 ? -errno : res;
+#else
+    request.result = -ENOSYS;
+#endif
+}
+
+#if defined(__linux__)
+bool BatchFileReader::ReadWithIoUring(vector<FileReadRequest>& requests, size_t begin, size_t end) {
+#ifdef LOGTAIL_IO_URING_SUPPORTED
+    // no request is in flight between calls, so the whole submission queue is free
+    uint32_t tail = *mRing->mSqTail;
+    for (size_t i = begin; i < end; ++i) {
+        auto& request = requests[i];
+        request.result = kReadNotDone;
+        uint32_t idx = tail & mRing->mSqMask;
+        io_uring_sqe* sqe = &mRing->mSqes[idx];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = IORING_OP_READ;
+        sqe->fd = request.fd;
+        sqe->addr = reinterpret_cast<uint64_t>(request.buf);
+        sqe->len = static_cast<uint32_t>(request.size);
+        sqe->off = static_cast<uint64_t>(request.offset);
+        sqe->user_data = i;
+        mRing->mSqArray[idx] = idx;
+        ++tail;
+    }
+    __atomic_store_n(mRing->mSqTail, tail, __ATOMIC_RELEASE);
+
+    uint32_t total = static_cast<uint32_t>(end - begin);
+    uint32_t submitted = 0;
+    uint32_t completed = 0;
+    // once io_uring_enter fails, reads already submitted may still write into their buffers, so they must be waited
+    // for before the caller reads the rest in another way
+    bool failed = false;
+    while (completed < (failed ? submitted : total)) {
+        uint32_t toSubmit = failed ? 0 : total - submitted;
+        uint32_t minComplete = (failed ? submitted : total) - completed;
+        int res = 0;
+#ifdef APSARA_UNIT_TEST_MAIN
+        if (mFailAfterSubmission && submitted > 0) {
+            mFailAfterSubmission = false;
+            errno = EINVAL;
+            res = -1;
+        } else {
+            res = mFailAfterSubmission ? mRing->Enter(toSubmit / 2, 0) : mRing->Enter(toSubmit, minComplete);
+        }
+#else
+        res = mRing->Enter(toSubmit, minComplete);
+#endif
+        if (res < 0) {
+            // waiting alone only fails temporarily, so it is simply retried
+            if (!failed && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                LOG_ERROR(sLogger,
+                          ("failed to call io_uring_enter", "wait for submitted reads")("errno", errno)(
+                              "submitted", submitted)("completed", completed));
+                failed = true;
+            }
+        } else {
+            submitted += res;
+        }
+        uint32_t head = *mRing->mCqHead;
+        uint32_t cqTail = __atomic_load_n(mRing->mCqTail, __ATOMIC_ACQUIRE);
+        for (; head != cqTail; ++head) {
+            const io_uring_cqe& cqe = mRing->mCqes[head & mRing->mCqMask];
+            requests[cqe.user_data].result = cqe.res;
+            ++completed;
+        }
+        __atomic_store_n(mRing->mCqHead, head, __ATOMIC_RELEASE);
+    }
+    return !failed;
+#else
+    return false;
+#endif
+}
+#endif
+
+} // namespace logtail
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace logtail {
+
+struct FileReadRequest {
+    int fd = -1;
+    char* buf = nullptr;
+    size_t size = 0;
+    int64_t offset = 0;
+    // bytes read, or -errno if the read fails
+    int64_t result = 0;
+};
+
+// Reads a batch of file ranges.
+//
+// On linux with io_uring supported by the kernel, all reads of a batch are submitted with one system call and waited
+// together, so that reading many files costs a few system calls rather than one per file. Otherwise, or when io_uring
+// is not enabled, the ranges are read one by one with pread.
+class BatchFileReader {
+public:
+    BatchFileReader();
+    BatchFileReader(const BatchFileReader&) = delete;
+    BatchFileReader& operator=(const BatchFileReader&) = delete;
+    ~BatchFileReader();
+
+    // @return true if io_uring is used
+    bool Init(bool enableIoUring, uint32_t queueDepth);
+    // read all requests, and return when all of them are done
+    void Read(std::vector<FileReadRequest>& requests);
+    bool IsIoUringEnabled() const { return mRing != nullptr; }
+
+private:
+    struct IoUring;
+
+    static void Pread(FileReadRequest& request);
+
+#if defined(__linux__)
+    bool ReadWithIoUring(std::vector<FileReadRequest>& requests, size_t begin, size_t end);
+#endif
+
+    std::unique_ptr<IoUring> mRing;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    // only half of the next batch is submitted without waiting, and then io_uring_enter fails
+    bool mFailAfterSubmission = false;
+
+    friend class BatchFileReaderUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_server/reader/FileReadCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace logtail {
+
+// A segment allocated while there is cached data leaves room for several more reads, so that a record spanning
+// reads is copied once every few reads at most. Segments allocated without cached data are sized exactly, since most
+// reads end at the end of a record, and the segment is released as soon as nothing is cached.
+static const size_t kMinSegmentSize = 16 * 1024;
+static const size_t kMaxSegmentSize = 1024 * 1024;
+static const size_t kSegmentSizeFactor = 4;
+
+void FileReadCache::Clear() {
+    mSegment.reset();
+    mSegmentData = nullptr;
+    mCapacity = 0;
+    mBegin = 0;
+    mSize = 0;
+}
+
+void FileReadCache::Assign(const char* data, size_t size) {
+    if (size == 0) {
+        Clear();
+        return;
+    }
+    // data may be in the current segment, which is kept alive until the copy is done
+    shared_ptr<SourceBuffer> old = std::move(mSegment);
+    NewSegment(size + 1);
+    memcpy(mSegmentData, data, size);
+    mSize = size;
+    ADD_COUNTER(mCopiedBytes, size);
+}
+
+void FileReadCache::ShrinkToFit() {
+    if (mSize == 0) {
+        Clear();
+    } else if (mCapacity > mSize + 1) {
+        Assign(Data(), mSize);
+    }
+}
+
+char* FileReadCache::PrepareBuffer(size_t size) {
+    size = max(size, mSize);
+    if (mSegment && mBegin + size + 1 <= mCapacity) {
+        return mSegmentData + mBegin;
+    }
+    if (mSize == 0) {
+        NewSegment(size + 1);
+        return mSegmentData;
+    }
+    shared_ptr<SourceBuffer> old = std::move(mSegment);
+    const char* data = Data();
+    const size_t cacheSize = mSize;
+    NewSegment(max(size + 1, min(max(size * kSegmentSizeFactor, kMinSegmentSize), kMaxSegmentSize)));
+    memcpy(mSegmentData, data, cacheSize);
+    mSize = cacheSize;
+    ADD_COUNTER(mCopiedBytes, cacheSize);
+    return mSegmentData;
+}
+
+void FileReadCache::Keep(const char* data, size_t size) {
+    if (size == 0) {
+        Clear();
+        return;
+    }
+    if (mSegment && data >= mSegmentData && data + size < mSegmentData + mCapacity) {
+        mBegin = data - mSegmentData;
+        mSize = size;
+        return;
+    }
+    Assign(data, size);
+}
+
+void FileReadCache::NewSegment(size_t capacity) {
+    mSegment = make_shared<SourceBuffer>();
+    mSegmentData = mSegment->AllocateStringBuffer(capacity).data;
+    mCapacity = capacity;
+    mBegin = 0;
+    mSize = 0;
+}
+
+} // namespace logtail
@@ -0,0 +1,74 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include "common/memory/SourceBuffer.h"
+#include "monitor/metric_models/MetricTypes.h"
+
+namespace logtail {
+
+// Data read from a file but not consumed yet, i.e. the beginning of a record whose end has not been read.
+//
+// Files are read into segments, and the cached data stays in the segment it is read into. The next read is appended
+// right after it, so that a partial record is not copied back to the front of every read buffer. It is only copied
+// when the segment has no room for the next read, in which case a larger segment is used. Bytes before the cached
+// data in a segment have been handed out and are never written again, and log buffers referencing a segment keep it
+// alive by depending on it.
+class FileReadCache {
+public:
+    size_t Size() const { return mSize; }
+    bool Empty() const { return mSize == 0; }
+    const char* Data() const { return mSegmentData + mBegin; }
+    std::string ToString() const { return std::string(Data(), mSize); }
+
+    // release the segment as well
+    void Clear();
+    // copy data into a new segment, data may be the cached data
+    void Assign(const char* data, size_t size);
+    // move the cached data to a segment of its own size, so that a large segment is not held by the cache alone
+    void ShrinkToFit();
+
+    // Return a buffer of size bytes, plus one for the terminating '\0', whose first Size() bytes are the cached data.
+    // The buffer is in the segment returned by GetSegment, and stays valid until the next call or Clear.
+    char* PrepareBuffer(size_t size);
+    // Keep [data, data + size) as the cached data. If data is in the buffer returned by the last PrepareBuffer, it is
+    // kept in place, and the caller must not write to it or the bytes after it any more.
+    void Keep(const char* data, size_t size);
+    const std::shared_ptr<SourceBuffer>& GetSegment() const { return mSegment; }
+
+    void SetCopiedBytesCounter(const CounterPtr& counter) { mCopiedBytes = counter; }
+
+private:
+    void NewSegment(size_t capacity);
+
+    std::shared_ptr<SourceBuffer> mSegment;
+    char* mSegmentData = nullptr;
+    size_t mCapacity = 0;
+    size_t mBegin = 0;
+    size_t mSize = 0;
+    CounterPtr mCopiedBytes;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FileReadCacheUnittest;
+#endif
+};
+
+} // namespace logtail
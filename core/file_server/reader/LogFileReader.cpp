@@ -229,6 +229,8 @@ void LogFileReader::SetMetrics() {
     mOutSizeBytes = mMetricsRecordRef->GetCounter(METRIC_PLUGIN_OUT_SIZE_BYTES);
     mSourceSizeBytes = mMetricsRecordRef->GetIntGauge(METRIC_PLUGIN_SOURCE_SIZE_BYTES);
     mSourceReadOffsetBytes = mMetricsRecordRef->GetIntGauge(METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES);
+    mCacheCopiedBytes = mMetricsRecordRef->GetCounter(METRIC_PLUGIN_SOURCE_CACHE_COPIED_BYTES);
+    mCache.SetCopiedBytesCounter(mCacheCopiedBytes);
 }
 
 void LogFileReader::DumpMetaToMem(bool checkConfigFlag, int32_t idxInReaderArray) {
@@ -273,7 +275,7 @@ void LogFileReader::DumpMetaToMem(bool checkConfigFlag, int32_t idxInReaderArray
                                                mLastForceRead);
     // use last event time as checkpoint's last update time
     checkPointPtr->mLastUpdateTime = mLastEventTime;
-    checkPointPtr->mCache = mCache;
+    checkPointPtr->mCache = mCache.ToString();
     checkPointPtr->mIdxInReaderArray = idxInReaderArray;
     CheckPointManager::Instance()->AddCheckPoint(checkPointPtr);
 }
@@ -312,7 +314,7 @@ void LogFileReader::InitReader(bool tailExisted, FileReadPolicy policy, uint32_t
             CheckPoint* checkPointPtr = checkPointSharePtr.get();
             mLastFilePos = checkPointPtr->mOffset;
             mLastForceRead = checkPointPtr->mLastForceRead;
-            mCache = checkPointPtr->mCache;
+            mCache.Assign(checkPointPtr->mCache.data(), checkPointPtr->mCache.size());
             mLastFileSignatureHash = checkPointPtr->mSignatureHash;
             mLastFileSignatureSize = checkPointPtr->mSignatureSize;
             mRealLogPath = checkPointPtr->mRealFileName;
@@ -548,7 +550,7 @@ void LogFileReader::adjustParametersByRangeCheckpoints() {
                   });
         auto& firstCpt = uncommittedCheckpoints.front()->data;
         mLastFilePos = firstCpt.read_offset();
-        mCache.clear();
+        mCache.Clear();
         mFirstWatched = false;
 
         // Set skip position if there are comitted checkpoints.
@@ -568,7 +570,7 @@ void LogFileReader::adjustParametersByRangeCheckpoints() {
     else if (maxOffsetIndex != mEOOption->concurrency) {
         auto& cpt = mEOOption->rangeCheckpointPtrs[maxOffsetIndex]->data;
         mLastFilePos = cpt.read_offset() + cpt.read_length();
-        mCache.clear();
+        mCache.Clear();
         mFirstWatched = false;
         LOG_INFO(sLogger,
                  ("initialize reader", "checkpoint with max offset")COMMON_READER_INFO("max index", maxOffsetIndex)(
@@ -606,7 +608,7 @@ void LogFileReader::SetDockerPath(const std::string& dockerBasePath, size_t dock
 
 void LogFileReader::SetReadFromBeginning() {
     mLastFilePos = 0;
-    mCache.clear();
+    mCache.Clear();
     LOG_INFO(
         sLogger,
         ("force reading file from the beginning, project", GetProject())("logstore", GetLogstore())(
@@ -642,7 +644,7 @@ bool LogFileReader::CheckForFirstOpen(FileReadPolicy policy) {
     op.Open(mHostLogPath.c_str());
     if (op.IsOpen() == false) {
         mLastFilePos = 0;
-        mCache.clear();
+        mCache.Clear();
         LOG_INFO(sLogger,
                  ("force reading file from the beginning",
                   "open file failed when trying to find the start position for reading")("project", GetProject())(
@@ -675,7 +677,7 @@ bool LogFileReader::CheckForFirstOpen(FileReadPolicy policy) {
         //     }
     } else if (policy == BACKWARD_TO_BEGINNING) {
         mLastFilePos = 0;
-        mCache.clear();
+        mCache.Clear();
     } else {
         LOG_ERROR(sLogger, ("invalid file read policy for file", mHostLogPath));
         return false;
@@ -694,7 +696,7 @@ void LogFileReader::SetFilePosBackwardToFixedPos(LogFileOperator& op) {
     mLastFilePos = endOffset <= ((int64_t)mReaderConfig.first->mTailSizeKB * 1024)
         ? 0
         : (endOffset - ((int64_t)mReaderConfig.first->mTailSizeKB * 1024));
-    mCache.clear();
+    mCache.Clear();
     FixLastFilePos(op, endOffset);
 }
 
@@ -739,7 +741,7 @@ void LogFileReader::FixLastFilePos(LogFileOperator& op, int64_t endOffset) {
         for (size_t i = 0; i < readSizeReal - 1; ++i) {
             if (readBuf[i] == '\n') {
                 mLastFilePos += i + 1;
-                mCache.clear();
+                mCache.Clear();
                 free(readBuf);
                 return;
             }
@@ -749,10 +751,13 @@ void LogFileReader::FixLastFilePos(LogFileOperator& op, int64_t endOffset) {
         for (size_t endPs = 0; endPs < readSizeReal - 1; ++endPs) {
             if (readBuf[endPs] == '\n') {
                 LineInfo line = GetLastLine(StringView(readBuf, readSizeReal - 1), endPs, true);
-                if (BoostRegexSearch(
-                        line.data.data(), line.data.size(), *mMultilineConfig.first->GetStartPatternReg(), exception)) {
+                if (mMultilineConfig.first->GetStartPatternPrefixFilter().MayMatch(line.data.data(), line.data.size())
+                    && BoostRegexSearch(line.data.data(),
+                                        line.data.size(),
+                                        *mMultilineConfig.first->GetStartPatternReg(),
+                                        exception)) {
                     mLastFilePos += line.lineBegin;
-                    mCache.clear();
+                    mCache.Clear();
                     free(readBuf);
                     return;
                 }
@@ -1172,8 +1177,9 @@ bool LogFileReader::CloseTimeoutFilePtr(int32_t curTime) {
 }
 
 void LogFileReader::CloseFilePtr() {
+    mPrefetchedData.reset();
     if (mLogFileOp.IsOpen()) {
-        mCache.shrink_to_fit();
+        mCache.ShrinkToFit();
         LOG_DEBUG(sLogger, ("start close LogFileReader", mHostLogPath));
 
         // if mHostLogPath is symbolic link, then we should not update it accrding to /dev/fd/xx
@@ -1452,7 +1458,7 @@ bool LogFileReader::GetRawData(LogBuffer& logBuffer, int64_t fileSize, bool tryR
             GetConfigName(),
             GetLogstore());
         mLastFilePos = fileSize;
-        mCache.clear();
+        mCache.Clear();
     }
 
     if (mContainerStopped) {
@@ -1511,10 +1517,9 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
     logBuffer.readOffset = mLastFilePos;
     if (!mLogFileOp.IsOpen()) {
         // read flush timeout
-        nbytes = mCache.size();
-        StringBuffer stringMemory = logBuffer.sourcebuffer->AllocateStringBuffer(nbytes);
-        stringBuffer = stringMemory.data;
-        memcpy(stringBuffer, mCache.data(), nbytes);
+        nbytes = mCache.Size();
+        stringBuffer = mCache.PrepareBuffer(nbytes);
+        logBuffer.sourcebuffer->AddDependency(mCache.GetSegment());
         // Ignore \n if last is force read
         if (stringBuffer[0] == '\n' && mLastForceRead) {
             ++stringBuffer;
@@ -1523,7 +1528,7 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
             --nbytes;
         }
         mLastForceRead = true;
-        mCache.clear();
+        mCache.Clear();
         moreData = false;
     } else {
         bool fromCpt = false;
@@ -1535,21 +1540,26 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
             && !mHasReadContainerBom) {
             checkContainerType(mLogFileOp);
         }
-        const size_t lastCacheSize = mCache.size();
+        const size_t lastCacheSize = mCache.Size();
         if (READ_BYTE < lastCacheSize) {
             READ_BYTE = lastCacheSize; // this should not happen, just avoid READ_BYTE >= 0 theoratically
         }
-        StringBuffer stringMemory
-            = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE); // allocate modifiable buffer
+        int64_t lastReadPos = GetLastReadPos();
+        // the cached data is already at the beginning of the buffer, which is handed out with the log buffer
+        stringBuffer = mCache.PrepareBuffer(READ_BYTE);
+        logBuffer.sourcebuffer->AddDependency(mCache.GetSegment());
+        size_t prefetchedBytes = TakePrefetchedData(stringBuffer, READ_BYTE, lastCacheSize, lastReadPos);
         if (lastCacheSize) {
             READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
         }
         TruncateInfo* truncateInfo = nullptr;
-        int64_t lastReadPos = GetLastReadPos();
-        nbytes = READ_BYTE
-            ? ReadFile(mLogFileOp, stringMemory.data + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
-            : (size_t)0;
-        stringBuffer = stringMemory.data;
+        nbytes = prefetchedBytes;
+        if (nbytes < READ_BYTE) {
+            // the file may grow after it is prefetched
+            int64_t offset = lastReadPos + nbytes;
+            nbytes += ReadFile(
+                mLogFileOp, stringBuffer + lastCacheSize + nbytes, READ_BYTE - nbytes, offset, &truncateInfo);
+        }
         bool allowRollback = true;
         // Only when there is no new log and not try rollback, then force read
         if (!tryRollback && nbytes == 0) {
@@ -1559,10 +1569,7 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
             // reader's state cannot be changed
             return;
         }
-        if (lastCacheSize) {
-            memcpy(stringBuffer, mCache.data(), lastCacheSize); // copy from cache
-            nbytes += lastCacheSize;
-        }
+        nbytes += lastCacheSize;
         // Ignore \n if last is force read
         if (stringBuffer[0] == '\n' && mLastForceRead) {
             ++stringBuffer;
@@ -1604,15 +1611,15 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
                     SPLIT_LOG_FAIL_ALARM, oss.str(), GetRegion(), GetProject(), GetConfigName(), GetLogstore());
             } else {
                 // line is not finished yet nor more data, put all data in cache
-                mCache.assign(stringBuffer, stringBufferLen);
+                mCache.Keep(stringBuffer, stringBufferLen);
                 return;
             }
         }
         if (nbytes < stringBufferLen) {
             // rollback happend, put rollbacked part in cache
-            mCache.assign(stringBuffer + nbytes, stringBufferLen - nbytes);
+            mCache.Keep(stringBuffer + nbytes, stringBufferLen - nbytes);
         } else {
-            mCache.clear();
+            mCache.Clear();
         }
         if (!moreData && fromCpt && lastReadPos < end) {
             moreData = true;
@@ -1627,6 +1634,10 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
                 == '\0')) { // \0 is for json, such behavior make ilogtail not able to collect binary log
         --stringLen;
     }
+    if (!mCache.Empty() && stringBuffer + stringLen == mCache.Data()) {
+        // the log is split right before the cached data, which must not be overwritten by the terminating '\0'
+        mCache.Assign(mCache.Data(), mCache.Size());
+    }
     stringBuffer[stringLen] = '\0';
 
     logBuffer.rawBuffer = StringView(stringBuffer, stringLen); // set readable buffer
@@ -1638,7 +1649,6 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
 }
 
 void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback) {
-    std::unique_ptr<char[]> gbkMemory;
     char* gbkBuffer = nullptr;
     size_t readCharCount = 0;
     size_t originReadCount = 0;
@@ -1650,10 +1660,8 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
     logBuffer.readOffset = mLastFilePos;
     if (!mLogFileOp.IsOpen()) {
         // read flush timeout
-        readCharCount = mCache.size();
-        gbkMemory.reset(new char[readCharCount + 1]);
-        gbkBuffer = gbkMemory.get();
-        memcpy(gbkBuffer, mCache.data(), readCharCount);
+        readCharCount = mCache.Size();
+        gbkBuffer = mCache.PrepareBuffer(readCharCount);
         // Ignore \n if last is force read
         if (gbkBuffer[0] == '\n' && mLastForceRead) {
             ++gbkBuffer;
@@ -1668,12 +1676,12 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
         moreData = false;
     } else {
         size_t READ_BYTE = getNextReadSize(end, fromCpt);
-        const size_t lastCacheSize = mCache.size();
+        const size_t lastCacheSize = mCache.Size();
         if (READ_BYTE < lastCacheSize) {
             READ_BYTE = lastCacheSize; // this should not happen, just avoid READ_BYTE >= 0 theoratically
         }
-        gbkMemory.reset(new char[READ_BYTE + 1]);
-        gbkBuffer = gbkMemory.get();
+        // the cached data is already at the beginning of the buffer
+        gbkBuffer = mCache.PrepareBuffer(READ_BYTE);
         if (lastCacheSize) {
             READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
         }
@@ -1693,10 +1701,7 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
             && !mHasReadContainerBom) {
             checkContainerType(mLogFileOp);
         }
-        if (lastCacheSize) {
-            memcpy(gbkBuffer, mCache.data(), lastCacheSize); // copy from cache
-            readCharCount += lastCacheSize;
-        }
+        readCharCount += lastCacheSize;
         // Ignore \n if last is force read
         if (gbkBuffer[0] == '\n' && mLastForceRead) {
             ++gbkBuffer;
@@ -1719,7 +1724,7 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
                 alignedBytes = BUFFER_SIZE;
             } else {
                 // line is not finished yet nor more data, put all data in cache
-                mCache.assign(gbkBuffer, originReadCount);
+                mCache.Keep(gbkBuffer, originReadCount);
                 return;
             }
         }
@@ -1744,9 +1749,9 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
     if (resultCharCount == 0) {
         if (readCharCount < originReadCount) {
             // skip unconvertable part, put rollbacked part in cache
-            mCache.assign(gbkBuffer + readCharCount, originReadCount - readCharCount);
+            mCache.Keep(gbkBuffer + readCharCount, originReadCount - readCharCount);
         } else {
-            mCache.clear();
+            mCache.Clear();
         }
         mLastFilePos += readCharCount;
         logBuffer.readOffset = mLastFilePos;
@@ -1769,7 +1774,7 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
             logTooLongSplitFlag = true;
         } else {
             // line is not finished yet nor more data, put all data in cache
-            mCache.assign(gbkBuffer, originReadCount);
+            mCache.Keep(gbkBuffer, originReadCount);
             return;
         }
     }
@@ -1780,9 +1785,9 @@ void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, b
     }
     if (readCharCount < originReadCount) {
         // rollback happend, put rollbacked part in cache
-        mCache.assign(gbkBuffer + readCharCount, originReadCount - readCharCount);
+        mCache.Keep(gbkBuffer + readCharCount, originReadCount - readCharCount);
     } else {
-        mCache.clear();
+        mCache.Clear();
     }
     // cache is sealed, readCharCount should not change any more
     size_t stringLen = resultCharCount;
@@ -1836,6 +1841,73 @@ LogFileReader::ReadFile(LogFileOperator& op, void* buf, size_t size, int64_t& of
     return nbytes;
 }
 
+bool LogFileReader::PrepareRead(size_t size, FileReadRequest& request) {
+    // exactly once replay needs reads of specified length, and GBK files are read in a different way
+    if (mPrefetchedData || !mLogFileOp.IsOpen() || mEOOption
+        || mReaderConfig.first->mFileEncoding == FileReaderOptions::Encoding::GBK
+        || (mReaderConfig.first->mInputType == FileReaderOptions::InputType::InputContainerStdio
+            && !mHasReadContainerBom)) {
+        return false;
+    }
+    const size_t cacheSize = mCache.Size();
+    if (size == 0 || cacheSize >= BUFFER_SIZE) {
+        return false;
+    }
+    size = min(size, BUFFER_SIZE - cacheSize);
+
+    mPrefetchedData.reset(new PrefetchedData);
+    mPrefetchedData->data = mCache.PrepareBuffer(cacheSize + size);
+    mPrefetchedData->segment = mCache.GetSegment();
+    mPrefetchedData->cacheSize = cacheSize;
+    mPrefetchedData->offset = GetLastReadPos();
+    mPrefetchedData->fd = mLogFileOp.GetFd();
+
+    request.fd = mPrefetchedData->fd;
+    request.buf = mPrefetchedData->data + cacheSize;
+    request.size = size;
+    request.offset = mPrefetchedData->offset;
+    return true;
+}
+
+void LogFileReader::SetPrefetchResult(int64_t result) {
+    if (!mPrefetchedData) {
+        return;
+    }
+    if (result < 0) {
+        LOG_DEBUG(sLogger,
+                  ("failed to prefetch log file", mHostLogPath)("offset", mPrefetchedData->offset)("errno", -result));
+        mPrefetchedData.reset();
+        return;
+    }
+    mPrefetchedData->size = result;
+}
+
+void LogFileReader::DropPrefetchedData() {
+    mPrefetchedData.reset();
+    if (mCache.Empty()) {
+        // release the segment prepared for the prefetch if the data is not taken
+        mCache.Clear();
+    }
+}
+
+size_t LogFileReader::TakePrefetchedData(char* buffer, size_t bufferSize, size_t cacheSize, int64_t offset) {
+    if (!mPrefetchedData) {
+        return 0;
+    }
+    unique_ptr<PrefetchedData> prefetched = std::move(mPrefetchedData);
+    // the reader may be moved, truncated or reopened since the data is prefetched
+    if (prefetched->size <= 0 || prefetched->offset != offset || prefetched->cacheSize != cacheSize
+        || prefetched->fd != mLogFileOp.GetFd() || bufferSize <= cacheSize) {
+        return 0;
+    }
+    size_t size = min(static_cast<size_t>(prefetched->size), bufferSize - cacheSize);
+    if (buffer != prefetched->data) {
+        // mCache is moved to a larger segment for the read
+        memcpy(buffer + cacheSize, prefetched->data + cacheSize, size);
+    }
+    return size;
+}
+
 LogFileReader::FileCompareResult LogFileReader::CompareToFile(const string& filePath) {
     LogFileOperator logFileOp;
     logFileOp.Open(filePath.c_str());
@@ -1927,10 +1999,12 @@ LogFileReader::RemoveLastIncompleteLog(char* buffer, int32_t size, int32_t& roll
             LineInfo content = GetLastLine(StringView(buffer, size), endPs, false);
             if (mMultilineConfig.first->GetEndPatternReg()) {
                 // start + end, continue + end, end
-                if (BoostRegexSearch(content.data.data(),
-                                     content.data.size(),
-                                     *mMultilineConfig.first->GetEndPatternReg(),
-                                     exception)) {
+                if (mMultilineConfig.first->GetEndPatternPrefixFilter().MayMatch(content.data.data(),
+                                                                                 content.data.size())
+                    && BoostRegexSearch(content.data.data(),
+                                        content.data.size(),
+                                        *mMultilineConfig.first->GetEndPatternReg(),
+                                        exception)) {
                     rollbackLineFeedCount += content.forceRollbackLineFeedCount;
                     foundEnd = true;
                     // Ensure the end line is complete
@@ -1939,6 +2013,8 @@ LogFileReader::RemoveLastIncompleteLog(char* buffer, int32_t size, int32_t& roll
                     }
                 }
             } else if (mMultilineConfig.first->GetStartPatternReg()
+                       && mMultilineConfig.first->GetStartPatternPrefixFilter().MayMatch(content.data.data(),
+                                                                                         content.data.size())
                        && BoostRegexSearch(content.data.data(),
                                            content.data.size(),
                                            *mMultilineConfig.first->GetStartPatternReg(),
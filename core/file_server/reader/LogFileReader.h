@@ -39,6 +39,8 @@
 #include "file_server/FileServer.h"
 #include "file_server/MultilineOptions.h"
 #include "file_server/event/Event.h"
+#include "file_server/reader/BatchFileReader.h"
+#include "file_server/reader/FileReadCache.h"
 #include "file_server/reader/FileReaderOptions.h"
 #include "logger/Logger.h"
 #include "protobuf/sls/sls_logs.pb.h"
@@ -204,6 +206,13 @@ public:
                   const FileTagConfig& tagConfig);
 
     bool ReadLog(LogBuffer& logBuffer, const Event* event);
+    // Prepare a read of at most size bytes from the position of the next ReadLog, so that files of many readers can
+    // be read in one batch. The result of the request should be given back by SetPrefetchResult, and is used by the
+    // next ReadLog if the reader state is unchanged by then.
+    // @return false if the reader does not support reading in batch
+    bool PrepareRead(size_t size, FileReadRequest& request);
+    void SetPrefetchResult(int64_t result);
+    void DropPrefetchedData();
     time_t GetLastUpdateTime() const // actually it's the time whenever ReadLogs is called
     {
         return mLastUpdateTime;
@@ -357,7 +366,7 @@ public:
 
     bool IsReadToEnd() const { return GetLastReadPos() == mLastFileSize; }
 
-    bool HasDataInCache() const { return mCache.size(); }
+    bool HasDataInCache() const { return !mCache.Empty(); }
 
     LogFileReaderPtrArray* GetReaderArray();
 
@@ -468,13 +477,16 @@ protected:
 
     size_t
     ReadFile(LogFileOperator& logFileOp, void* buf, size_t size, int64_t& offset, TruncateInfo** truncateInfo = NULL);
+    // make the prefetched data at offset follow the cacheSize bytes of mCache at the beginning of buffer, which holds
+    // bufferSize bytes, and return the size of the data
+    size_t TakePrefetchedData(char* buffer, size_t bufferSize, size_t cacheSize, int64_t offset);
     static int32_t ParseTime(const char* buffer, const std::string& timeFormat);
     void SetFilePosBackwardToFixedPos(LogFileOperator& logFileOp);
 
     bool CheckForFirstOpen(FileReadPolicy policy = BACKWARD_TO_FIXED_POS);
     void FixLastFilePos(LogFileOperator& logFileOp, int64_t endOffset);
     inline int64_t GetLastReadPos() const { // pos read but may not consumed, used for read needed
-        return mLastFilePos + mCache.size();
+        return mLastFilePos + mCache.Size();
     }
 
     // std::string mRegion;
@@ -492,7 +504,19 @@ protected:
     int64_t mLastFilePos = 0; // pos read and consumed, used for next read begin
     int64_t mLastFileSize = 0;
     time_t mLastMTime = 0;
-    std::string mCache;
+    FileReadCache mCache;
+    struct PrefetchedData {
+        // the segment of mCache the data is read into, which may be replaced before the data is taken
+        std::shared_ptr<SourceBuffer> segment;
+        // the first cacheSize bytes are mCache
+        char* data = nullptr;
+        size_t cacheSize = 0;
+        int64_t offset = 0;
+        int fd = -1;
+        // bytes read, negative if not read yet or failed
+        int64_t size = -1;
+    };
+    std::unique_ptr<PrefetchedData> mPrefetchedData;
     // >= 0: index of reader array, -1: new reader, -2: not in reader array
     int32_t mIdxInReaderArrayFromLastCpt = CHECKPOINT_IDX_OF_NEW_READER_IN_ARRAY;
     // std::string mProjectName;
@@ -565,6 +589,7 @@ protected:
     CounterPtr mOutSizeBytes;
     IntGaugePtr mSourceSizeBytes;
     IntGaugePtr mSourceReadOffsetBytes;
+    CounterPtr mCacheCopiedBytes;
 
 private:
     bool mHasReadContainerBom = false;
@@ -716,6 +741,7 @@ private:
     friend class FileTagUnittest;
     friend class CreateModifyHandlerUnittest;
     friend class LogFileReaderHoleUnittest;
+    friend class LogFileReaderPrefetchUnittest;
 
 protected:
     void UpdateReaderManual();
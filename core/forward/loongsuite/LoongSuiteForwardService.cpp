@@ -16,35 +16,120 @@
 
 #include "forward/loongsuite/LoongSuiteForwardService.h"
 
+#include <memory>
+#include <mutex>
+
+#include "google/protobuf/arena.h"
+
+#include "collection_pipeline/queue/ProcessQueueItem.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
 #include "grpcpp/support/status.h"
 #include "logger/Logger.h"
+#include "models/PipelineEventGroup.h"
+#include "protobuf/models/ProtocolConversion.h"
 
 namespace logtail {
 
 const std::string LoongSuiteForwardServiceImpl::sName = "LoongSuiteForwardService";
+const std::string LoongSuiteForwardServiceImpl::sConfigNameMetaKey = "x-loongsuite-config-name";
 
 bool LoongSuiteForwardServiceImpl::Update(std::string configName, const Json::Value& config) {
-    // Initialize the service with the provided configuration
-    // For now, we just log the initialization
-    LOG_INFO(sLogger, ("LoongSuiteForwardServiceImpl updated with config", config.toStyledString()));
-    return true; // Return true to indicate successful initialization
+    ForwardConfig forwardConfig;
+    // the same key as the process queue of the pipeline
+    forwardConfig.mQueueKey = QueueKeyManager::GetInstance()->GetKey(configName);
+    if (config.isMember("InputIndex")) {
+        if (!config["InputIndex"].isUInt()) {
+            LOG_ERROR(sLogger,
+                      ("LoongSuiteForwardServiceImpl", "InputIndex is not an unsigned integer")("config", configName));
+            return false;
+        }
+        forwardConfig.mInputIndex = config["InputIndex"].asUInt();
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(mConfigsMutex);
+        mConfigs[configName] = forwardConfig;
+    }
+    LOG_INFO(sLogger,
+             ("LoongSuiteForwardServiceImpl updated", configName)("queue key", forwardConfig.mQueueKey)(
+                 "input index", forwardConfig.mInputIndex));
+    return true;
 }
 
 bool LoongSuiteForwardServiceImpl::Remove(std::string configName) {
-    // Handle the removal of the service configuration
-    // For now, we just log the removal
+    {
+        std::unique_lock<std::shared_mutex> lock(mConfigsMutex);
+        mConfigs.erase(configName);
+    }
     LOG_INFO(sLogger, ("LoongSuiteForwardServiceImpl removed for config", configName));
-    return true; // Return true to indicate successful removal
+    return true;
+}
+
+grpc::Status LoongSuiteForwardServiceImpl::FindConfig(const grpc::CallbackServerContext* context,
+                                                      ForwardConfig& config) const {
+    const auto& metadata = context->client_metadata();
+    auto metaIt = metadata.find(sConfigNameMetaKey);
+    std::shared_lock<std::shared_mutex> lock(mConfigsMutex);
+    if (metaIt == metadata.end()) {
+        if (mConfigs.size() != 1) {
+            return grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, sConfigNameMetaKey + " is required");
+        }
+        config = mConfigs.begin()->second;
+        return grpc::Status::OK;
+    }
+    auto it = mConfigs.find(std::string(metaIt->second.data(), metaIt->second.size()));
+    if (it == mConfigs.end()) {
+        return grpc::Status(grpc::StatusCode::NOT_FOUND, "config not found");
+    }
+    config = it->second;
+    return grpc::Status::OK;
 }
 
 grpc::ServerUnaryReactor* LoongSuiteForwardServiceImpl::Forward(grpc::CallbackServerContext* context,
                                                                 const LoongSuiteForwardRequest* request,
                                                                 LoongSuiteForwardResponse* response) {
-    // Implement the logic to handle the request and fill the response
-    // For now, we just return nullptr to indicate no further processing
-    LOG_INFO(sLogger, ("Received LoongSuiteForwardRequest", "logic not implemented yet"));
     auto* reactor = context->DefaultReactor();
-    reactor->Finish(grpc::Status::OK);
+    ForwardConfig config;
+    grpc::Status status = FindConfig(context, config);
+    if (!status.ok()) {
+        reactor->Finish(status);
+        return reactor;
+    }
+    // reject before decoding so that clients back off without wasting cpu, which also happens while the pipeline is
+    // being updated and its queue does not exist
+    if (!ProcessQueueManager::GetInstance()->IsValidToPush(config.mQueueKey)) {
+        reactor->Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "process queue is full"));
+        return reactor;
+    }
+
+    // The strings are parsed once onto the arena, which is then kept alive by the source buffer of the group, so that
+    // events reference them instead of copying them again.
+    auto arena = std::make_shared<google::protobuf::Arena>();
+    auto* pbGroup = google::protobuf::Arena::CreateMessage<models::PipelineEventGroup>(arena.get());
+    if (!pbGroup->ParseFromString(request->data())) {
+        reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, "failed to parse PipelineEventGroup"));
+        return reactor;
+    }
+    PipelineEventGroup group(std::make_shared<SourceBuffer>());
+    std::string errMsg;
+    if (!TransferPBToPipelineEventGroup(*pbGroup, group, errMsg, true)) {
+        reactor->Finish(grpc::Status(grpc::StatusCode::INVALID_ARGUMENT, errMsg));
+        return reactor;
+    }
+    group.GetSourceBuffer()->AddDependency(std::move(arena));
+
+    auto item = std::make_unique<ProcessQueueItem>(std::move(group), config.mInputIndex);
+    switch (ProcessQueueManager::GetInstance()->PushQueue(config.mQueueKey, std::move(item))) {
+        case QueueStatus::OK:
+            reactor->Finish(grpc::Status::OK);
+            break;
+        case QueueStatus::QUEUE_FULL:
+            reactor->Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "process queue is full"));
+            break;
+        default:
+            reactor->Finish(grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED, "process queue not found"));
+            break;
+    }
     return reactor;
 }
 
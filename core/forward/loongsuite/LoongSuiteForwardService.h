@@ -16,6 +16,11 @@
 
 #pragma once
 
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+#include "collection_pipeline/queue/QueueKey.h"
 #include "forward/BaseService.h"
 #include "protobuf/forward/loongsuite.grpc.pb.h"
 
@@ -34,10 +39,26 @@ public:
                                       const LoongSuiteForwardRequest* request,
                                       LoongSuiteForwardResponse* response) override;
 
+    // metadata key of the config name to forward a request to, which can be omitted when only one config listens on
+    // the address
+    static const std::string sConfigNameMetaKey;
+
 private:
+    struct ForwardConfig {
+        QueueKey mQueueKey = -1;
+        size_t mInputIndex = 0;
+    };
+
+    grpc::Status FindConfig(const grpc::CallbackServerContext* context, ForwardConfig& config) const;
+
     static const std::string sName;
+
+    mutable std::shared_mutex mConfigsMutex;
+    std::unordered_map<std::string, ForwardConfig> mConfigs;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class GrpcRunnerUnittest;
+    friend class LoongSuiteForwardServiceUnittest;
 #endif
 };
 
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "models/ColumnarLogEvents.h"
+
+#include <algorithm>
+
+#include "models/LogEvent.h"
+#include "models/PipelineEventGroup.h"
+
+using namespace std;
+
+namespace logtail {
+
+template <class T>
+static void CompactColumn(vector<T>& column, const vector<bool>& kept) {
+    size_t wIdx = 0;
+    for (size_t rIdx = 0; rIdx < column.size(); ++rIdx) {
+        if (kept[rIdx]) {
+            if (wIdx != rIdx) {
+                column[wIdx] = std::move(column[rIdx]);
+            }
+            ++wIdx;
+        }
+    }
+    column.resize(wIdx);
+}
+
+void ColumnarLogEvents::Reserve(size_t rowCnt) {
+    mRowContentCnt.reserve(rowCnt);
+    mRowNextSeqs.reserve(rowCnt);
+    mTimestamps.reserve(rowCnt);
+    mTimestampNanoseconds.reserve(rowCnt);
+    mFileOffsets.reserve(rowCnt);
+    mRawSizes.reserve(rowCnt);
+    for (auto& column : mColumns) {
+        column.mValues.reserve(rowCnt);
+        column.mPresent.reserve(rowCnt);
+        column.mSeqs.reserve(rowCnt);
+    }
+}
+
+size_t ColumnarLogEvents::AddRow(time_t timestamp,
+                                 optional<uint32_t> timestampNs,
+                                 uint64_t offset,
+                                 uint64_t rawSize) {
+    mRowContentCnt.push_back(0);
+    mRowNextSeqs.push_back(0);
+    mTimestamps.push_back(timestamp);
+    mTimestampNanoseconds.push_back(timestampNs);
+    mFileOffsets.push_back(offset);
+    mRawSizes.push_back(rawSize);
+    for (auto& column : mColumns) {
+        column.mValues.emplace_back();
+        column.mPresent.push_back(0);
+        column.mSeqs.push_back(0);
+    }
+    return mRowCnt++;
+}
+
+void ColumnarLogEvents::FilterRows(const vector<bool>& kept) {
+    for (size_t row = 0; row < mRowCnt; ++row) {
+        if (kept[row]) {
+            continue;
+        }
+        for (auto& column : mColumns) {
+            if (column.mPresent[row]) {
+                mAllocatedContentSize -= column.mKey.size() + column.mValues[row].size();
+            }
+        }
+    }
+    CompactColumn(mRowContentCnt, kept);
+    CompactColumn(mRowNextSeqs, kept);
+    CompactColumn(mTimestamps, kept);
+    CompactColumn(mTimestampNanoseconds, kept);
+    CompactColumn(mFileOffsets, kept);
+    CompactColumn(mRawSizes, kept);
+    for (auto& column : mColumns) {
+        CompactColumn(column.mValues, kept);
+        CompactColumn(column.mPresent, kept);
+        CompactColumn(column.mSeqs, kept);
+    }
+    mRowCnt = mTimestamps.size();
+}
+
+size_t ColumnarLogEvents::AddColumn(StringView key) {
+    size_t col = FindColumn(key);
+    if (col != npos) {
+        return col;
+    }
+    mColumns.emplace_back();
+    auto& column = mColumns.back();
+    column.mKey = key;
+    column.mValues.resize(mRowCnt);
+    column.mPresent.resize(mRowCnt, 0);
+    column.mSeqs.resize(mRowCnt, 0);
+    return mColumns.size() - 1;
+}
+
+size_t ColumnarLogEvents::FindColumn(StringView key) const {
+    // the number of distinct keys in one group is small, linear search is faster than any index here
+    for (size_t col = 0; col < mColumns.size(); ++col) {
+        if (mColumns[col].mKey == key) {
+            return col;
+        }
+    }
+    return npos;
+}
+
+void ColumnarLogEvents::SetValue(size_t col, size_t row, StringView val) {
+    auto& column = mColumns[col];
+    if (column.mPresent[row]) {
+        mAllocatedContentSize -= column.mValues[row].size();
+        mAllocatedContentSize += val.size();
+    } else {
+        column.mPresent[row] = 1;
+        column.mSeqs[row] = mRowNextSeqs[row]++;
+        ++mRowContentCnt[row];
+        mAllocatedContentSize += column.mKey.size() + val.size();
+    }
+    column.mValues[row] = val;
+}
+
+void ColumnarLogEvents::DelValue(size_t col, size_t row) {
+    auto& column = mColumns[col];
+    if (!column.mPresent[row]) {
+        return;
+    }
+    mAllocatedContentSize -= column.mKey.size() + column.mValues[row].size();
+    column.mPresent[row] = 0;
+    column.mValues[row] = StringView();
+    --mRowContentCnt[row];
+}
+
+void ColumnarLogEvents::Materialize(PipelineEventGroup& group, EventsContainer& events) {
+    events.reserve(events.size() + mRowCnt);
+    // (seq, col) of the present values in a row, reused across rows
+    vector<pair<uint32_t, size_t>> order;
+    order.reserve(mColumns.size());
+    for (size_t row = 0; row < mRowCnt; ++row) {
+        unique_ptr<LogEvent> event = group.CreateLogEvent(true);
+        order.clear();
+        bool sorted = true;
+        for (size_t col = 0; col < mColumns.size(); ++col) {
+            if (mColumns[col].mPresent[row]) {
+                uint32_t seq = mColumns[col].mSeqs[row];
+                sorted = sorted && (order.empty() || order.back().first < seq);
+                order.emplace_back(seq, col);
+            }
+        }
+        // rows adding keys in the column order, which is the common case, need no sorting
+        if (!sorted) {
+            sort(order.begin(), order.end());
+        }
+        for (const auto& item : order) {
+            const auto& column = mColumns[item.second];
+            event->SetContentNoCopy(column.mKey, column.mValues[row]);
+        }
+        event->SetTimestamp(mTimestamps[row], mTimestampNanoseconds[row]);
+        event->SetPosition(mFileOffsets[row], mRawSizes[row]);
+        events.emplace_back(std::move(event), true, nullptr);
+    }
+    mColumns.clear();
+    mRowCnt = 0;
+    mRowContentCnt.clear();
+    mRowNextSeqs.clear();
+    mTimestamps.clear();
+    mTimestampNanoseconds.clear();
+    mFileOffsets.clear();
+    mRawSizes.clear();
+    mAllocatedContentSize = 0;
+}
+
+size_t ColumnarLogEvents::DataSize() const {
+    // keep consistent with the sum of LogEvent::DataSize() so that group size based statistics do not change
+    return mRowCnt * (sizeof(time_t) + sizeof(optional<uint32_t>) + sizeof(ContentsContainer))
+        + mAllocatedContentSize;
+}
+
+} // namespace logtail
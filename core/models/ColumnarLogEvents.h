@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "common/StringView.h"
+#include "models/PipelineEventPtr.h"
+
+namespace logtail {
+
+class PipelineEventGroup;
+
+// Structure-of-arrays representation of the log events in one PipelineEventGroup. Each key is stored once per group
+// and owns a column with one value slot per row, all values pointing into the group's SourceBuffer. Processors that
+// support this representation work on columns directly, others get ordinary LogEvents through Materialize().
+//
+// Each value remembers when it was added to its row, so materialized contents follow the insertion order of the row
+// rather than the column order, the same as a LogEvent: overwriting a value keeps its position, while a deleted value
+// set again is moved to the end. Log reduce in SLS server relies on this order.
+class ColumnarLogEvents {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    size_t Size() const { return mRowCnt; }
+    bool Empty() const { return mRowCnt == 0; }
+    void Reserve(size_t rowCnt);
+
+    size_t AddRow(time_t timestamp, std::optional<uint32_t> timestampNs, uint64_t offset, uint64_t rawSize);
+    // only keep rows whose flag is true, the relative order of remaining rows is preserved
+    void FilterRows(const std::vector<bool>& kept);
+
+    size_t ColumnSize() const { return mColumns.size(); }
+    // return the existing column if key is already added
+    size_t AddColumn(StringView key);
+    size_t FindColumn(StringView key) const;
+    StringView GetColumnKey(size_t col) const { return mColumns[col].mKey; }
+
+    bool HasValue(size_t col, size_t row) const { return mColumns[col].mPresent[row] != 0; }
+    StringView GetValue(size_t col, size_t row) const { return mColumns[col].mValues[row]; }
+    // the order in which present values were added to the row, only comparable within one row
+    uint32_t GetValueSeq(size_t col, size_t row) const { return mColumns[col].mSeqs[row]; }
+    void SetValue(size_t col, size_t row, StringView val);
+    void DelValue(size_t col, size_t row);
+    // number of contents in the row, the same as LogEvent::Size()
+    size_t GetRowContentSize(size_t row) const { return mRowContentCnt[row]; }
+
+    time_t GetTimestamp(size_t row) const { return mTimestamps[row]; }
+    std::optional<uint32_t> GetTimestampNanosecond(size_t row) const { return mTimestampNanoseconds[row]; }
+    void SetTimestamp(size_t row, time_t t, std::optional<uint32_t> ns) {
+        mTimestamps[row] = t;
+        mTimestampNanoseconds[row] = ns;
+    }
+    std::pair<uint64_t, uint64_t> GetPosition(size_t row) const { return {mFileOffsets[row], mRawSizes[row]}; }
+
+    // convert all rows to LogEvents and append them to events, leaving this object empty
+    void Materialize(PipelineEventGroup& group, std::vector<PipelineEventPtr>& events);
+
+    size_t DataSize() const;
+
+private:
+    struct Column {
+        StringView mKey;
+        std::vector<StringView> mValues;
+        std::vector<uint8_t> mPresent;
+        std::vector<uint32_t> mSeqs;
+    };
+
+    std::vector<Column> mColumns;
+    size_t mRowCnt = 0;
+    std::vector<uint32_t> mRowContentCnt;
+    std::vector<uint32_t> mRowNextSeqs;
+    std::vector<time_t> mTimestamps;
+    std::vector<std::optional<uint32_t>> mTimestampNanoseconds;
+    std::vector<uint64_t> mFileOffsets;
+    std::vector<uint64_t> mRawSizes;
+    size_t mAllocatedContentSize = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class ColumnarLogEventsUnittest;
+#endif
+};
+
+} // namespace logtail
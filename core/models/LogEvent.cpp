@@ -20,6 +20,143 @@ using namespace std;
 
 namespace logtail {
 
+size_t LogContentIndex::Find(StringView key, const ContentsContainer& contents) const {
+    if (!IsHashMode()) {
+        for (size_t i = 0; i < mSize; ++i) {
+            if (contents[mLinear[i]].first.first == key) {
+                return mLinear[i];
+            }
+        }
+        return npos;
+    }
+    bool found = false;
+    size_t slot = FindSlot(key, contents, found);
+    return found ? mSlots[slot] : npos;
+}
+
+pair<size_t, bool> LogContentIndex::Emplace(StringView key, size_t pos, const ContentsContainer& contents) {
+    if (!IsHashMode()) {
+        for (size_t i = 0; i < mSize; ++i) {
+            if (contents[mLinear[i]].first.first == key) {
+                return {mLinear[i], false};
+            }
+        }
+        if (mSize < kMaxLinearSize) {
+            mLinear[mSize++] = static_cast<uint32_t>(pos);
+            return {pos, true};
+        }
+        Rehash(kMinSlotSize, contents);
+    } else if ((mSize + mDeletedCnt + 1) * 4 > mSlots.size() * 3) {
+        // tombstones are dropped on rehash, so the table only grows when it is really full of keys
+        Rehash((mSize + 1) * 2 > mSlots.size() ? mSlots.size() * 2 : mSlots.size(), contents);
+    }
+    bool found = false;
+    size_t slot = FindSlot(key, contents, found);
+    if (found) {
+        return {mSlots[slot], false};
+    }
+    if (mSlots[slot] == kDeletedSlot) {
+        --mDeletedCnt;
+    }
+    mSlots[slot] = static_cast<uint32_t>(pos);
+    ++mSize;
+    return {pos, true};
+}
+
+void LogContentIndex::Assign(StringView key, size_t pos, const ContentsContainer& contents) {
+    auto rst = Emplace(key, pos, contents);
+    if (rst.second) {
+        return;
+    }
+    if (!IsHashMode()) {
+        for (size_t i = 0; i < mSize; ++i) {
+            if (mLinear[i] == rst.first) {
+                mLinear[i] = static_cast<uint32_t>(pos);
+                return;
+            }
+        }
+        return;
+    }
+    bool found = false;
+    mSlots[FindSlot(key, contents, found)] = static_cast<uint32_t>(pos);
+}
+
+size_t LogContentIndex::Erase(StringView key, const ContentsContainer& contents) {
+    if (!IsHashMode()) {
+        for (size_t i = 0; i < mSize; ++i) {
+            size_t pos = mLinear[i];
+            if (contents[pos].first.first == key) {
+                mLinear[i] = mLinear[--mSize];
+                return pos;
+            }
+        }
+        return npos;
+    }
+    bool found = false;
+    size_t slot = FindSlot(key, contents, found);
+    if (!found) {
+        return npos;
+    }
+    size_t pos = mSlots[slot];
+    mSlots[slot] = kDeletedSlot;
+    --mSize;
+    ++mDeletedCnt;
+    return pos;
+}
+
+void LogContentIndex::Clear() {
+    mSlots.clear();
+    mSize = 0;
+    mDeletedCnt = 0;
+}
+
+size_t LogContentIndex::FindSlot(StringView key, const ContentsContainer& contents, bool& found) const {
+    size_t mask = mSlots.size() - 1;
+    size_t slot = StringViewHash()(key) & mask;
+    size_t firstDeleted = npos;
+    // the table is never full, so an empty slot is always reached
+    while (true) {
+        uint32_t pos = mSlots[slot];
+        if (pos == kEmptySlot) {
+            found = false;
+            return firstDeleted == npos ? slot : firstDeleted;
+        }
+        if (pos == kDeletedSlot) {
+            if (firstDeleted == npos) {
+                firstDeleted = slot;
+            }
+        } else if (contents[pos].first.first == key) {
+            found = true;
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+void LogContentIndex::Rehash(size_t slotSize, const ContentsContainer& contents) {
+    vector<uint32_t> positions;
+    positions.reserve(mSize);
+    if (IsHashMode()) {
+        for (uint32_t pos : mSlots) {
+            if (pos != kEmptySlot && pos != kDeletedSlot) {
+                positions.push_back(pos);
+            }
+        }
+    } else {
+        positions.assign(mLinear.begin(), mLinear.begin() + mSize);
+    }
+    mSlots.assign(slotSize, kEmptySlot);
+    mDeletedCnt = 0;
+    size_t mask = slotSize - 1;
+    for (uint32_t pos : positions) {
+        size_t slot = StringViewHash()(contents[pos].first.first) & mask;
+        while (mSlots[slot] != kEmptySlot) {
+            slot = (slot + 1) & mask;
+        }
+        mSlots[slot] = pos;
+    }
+}
+
 LogEvent::LogEvent(PipelineEventGroup* ptr) : PipelineEvent(Type::LOG, ptr) {
 }
 
@@ -30,22 +167,22 @@ unique_ptr<PipelineEvent> LogEvent::Copy() const {
 void LogEvent::Reset() {
     PipelineEvent::Reset();
     mContents.clear();
-    mIndex.clear();
+    mIndex.Clear();
     mAllocatedContentSize = 0;
     mFileOffset = 0;
     mRawSize = 0;
 }
 
 StringView LogEvent::GetContent(StringView key) const {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return mContents[it->second].first.second;
+    size_t pos = mIndex.Find(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        return mContents[pos].first.second;
     }
     return gEmptyStringView;
 }
 
 bool LogEvent::HasContent(StringView key) const {
-    return mIndex.find(key) != mIndex.end();
+    return mIndex.Find(key, mContents) != LogContentIndex::npos;
 }
 
 void LogEvent::SetContent(StringView key, StringView val) {
@@ -65,10 +202,9 @@ void LogEvent::SetContentNoCopy(const StringBuffer& key, const StringBuffer& val
 }
 
 void LogEvent::SetContentNoCopy(StringView key, StringView val) {
-    auto rst = mIndex.insert(make_pair(key, mContents.size()));
+    auto rst = mIndex.Emplace(key, mContents.size(), mContents);
     if (!rst.second) {
-        auto& it = rst.first;
-        auto& field = mContents[it->second].first;
+        auto& field = mContents[rst.first].first;
         mAllocatedContentSize += key.size() + val.size() - field.first.size() - field.second.size();
         field = make_pair(key, val);
     } else {
@@ -78,12 +214,11 @@ void LogEvent::SetContentNoCopy(StringView key, StringView val) {
 }
 
 void LogEvent::DelContent(StringView key) {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        auto& field = mContents[it->second].first;
+    size_t pos = mIndex.Erase(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        auto& field = mContents[pos].first;
         mAllocatedContentSize -= field.first.size() + field.second.size();
-        mContents[it->second].second = false;
-        mIndex.erase(it);
+        mContents[pos].second = false;
     }
 }
 
@@ -93,17 +228,17 @@ void LogEvent::SetLevel(const std::string& level) {
 }
 
 LogEvent::ContentIterator LogEvent::FindContent(StringView key) {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return ContentIterator(mContents.begin() + it->second, mContents);
+    size_t pos = mIndex.Find(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        return ContentIterator(mContents.begin() + pos, mContents);
     }
     return ContentIterator(mContents.end(), mContents);
 }
 
 LogEvent::ConstContentIterator LogEvent::FindContent(StringView key) const {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return ConstContentIterator(mContents.begin() + it->second, mContents);
+    size_t pos = mIndex.Find(key, mContents);
+    if (pos != LogContentIndex::npos) {
+        return ConstContentIterator(mContents.begin() + pos, mContents);
     }
     return ConstContentIterator(mContents.end(), mContents);
 }
@@ -144,7 +279,7 @@ LogEvent::ConstContentIterator LogEvent::cend() const {
 void LogEvent::AppendContentNoCopy(StringView key, StringView val) {
     mAllocatedContentSize += key.size() + val.size();
     mContents.emplace_back(make_pair(key, val), true);
-    mIndex[key] = mContents.size() - 1;
+    mIndex.Assign(key, mContents.size() - 1, mContents);
 }
 
 size_t LogEvent::DataSize() const {
@@ -16,6 +16,9 @@
 
 #pragma once
 
+#include <array>
+#include <limits>
+
 #include "models/PipelineEvent.h"
 
 namespace logtail {
@@ -61,6 +64,42 @@ private:
     const ContentsContainer& container;
 };
 
+// Maps content keys to their positions in ContentsContainer, where the keys themselves are stored. Most events have
+// only a few keys, which are looked up by a linear scan over an inline array without any allocation. Once the number of
+// keys exceeds kMaxLinearSize, an open addressing hash table is built instead and kept until Clear() is called.
+class LogContentIndex {
+public:
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+    static constexpr size_t kMaxLinearSize = 16;
+
+    size_t Find(StringView key, const ContentsContainer& contents) const;
+    // same as std::map::insert, return the position of key and whether it is newly inserted
+    std::pair<size_t, bool> Emplace(StringView key, size_t pos, const ContentsContainer& contents);
+    // insert key or overwrite its position if it already exists
+    void Assign(StringView key, size_t pos, const ContentsContainer& contents);
+    // return the position of the erased key, or npos if key does not exist
+    size_t Erase(StringView key, const ContentsContainer& contents);
+    void Clear();
+
+    bool Empty() const { return mSize == 0; }
+    size_t Size() const { return mSize; }
+
+private:
+    static constexpr uint32_t kEmptySlot = std::numeric_limits<uint32_t>::max();
+    static constexpr uint32_t kDeletedSlot = kEmptySlot - 1;
+    static constexpr size_t kMinSlotSize = kMaxLinearSize * 4;
+
+    bool IsHashMode() const { return !mSlots.empty(); }
+    // return the slot holding key, or the slot to insert key at if it does not exist
+    size_t FindSlot(StringView key, const ContentsContainer& contents, bool& found) const;
+    void Rehash(size_t slotSize, const ContentsContainer& contents);
+
+    std::array<uint32_t, kMaxLinearSize> mLinear{};
+    std::vector<uint32_t> mSlots;
+    size_t mSize = 0;
+    size_t mDeletedCnt = 0;
+};
+
 class LogEvent : public PipelineEvent {
     friend class PipelineEventGroup;
     friend class EventPool;
@@ -91,9 +130,10 @@ public:
 
     StringView GetLevel() const { return mLevel; }
     void SetLevel(const std::string& level);
+    void SetLevelNoCopy(StringView level) { mLevel = level; }
 
-    bool Empty() const { return mIndex.empty(); }
-    size_t Size() const { return mIndex.size(); }
+    bool Empty() const { return mIndex.Empty(); }
+    size_t Size() const { return mIndex.Size(); }
 
     ContentIterator begin();
     ContentIterator end();
@@ -121,7 +161,7 @@ private:
     // information for backward compatability.
     ContentsContainer mContents;
     size_t mAllocatedContentSize = 0;
-    std::map<StringView, size_t> mIndex;
+    LogContentIndex mIndex;
     uint64_t mFileOffset = 0;
     uint64_t mRawSize = 0;
     StringView mLevel;
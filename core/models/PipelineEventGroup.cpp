@@ -67,7 +67,9 @@ PipelineEventGroup::PipelineEventGroup(PipelineEventGroup&& rhs) noexcept
     : mMetadata(std::move(rhs.mMetadata)),
       mTags(std::move(rhs.mTags)),
       mEvents(std::move(rhs.mEvents)),
-      mSourceBuffer(std::move(rhs.mSourceBuffer)) {
+      mColumnarLogs(std::move(rhs.mColumnarLogs)),
+      mSourceBuffer(std::move(rhs.mSourceBuffer)),
+      mExactlyOnceCheckpoint(std::move(rhs.mExactlyOnceCheckpoint)) {
     for (auto& item : mEvents) {
         item->ResetPipelineEventGroup(this);
     }
@@ -100,7 +102,9 @@ PipelineEventGroup& PipelineEventGroup::operator=(PipelineEventGroup&& rhs) noex
         mMetadata = std::move(rhs.mMetadata);
         mTags = std::move(rhs.mTags);
         mEvents = std::move(rhs.mEvents);
+        mColumnarLogs = std::move(rhs.mColumnarLogs);
         mSourceBuffer = std::move(rhs.mSourceBuffer);
+        mExactlyOnceCheckpoint = std::move(rhs.mExactlyOnceCheckpoint);
         for (auto& item : mEvents) {
             item->ResetPipelineEventGroup(this);
         }
@@ -117,6 +121,9 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
         res.mEvents.emplace_back(event.Copy());
         res.mEvents.back()->ResetPipelineEventGroup(&res);
     }
+    if (mColumnarLogs) {
+        res.mColumnarLogs = make_unique<ColumnarLogEvents>(*mColumnarLogs);
+    }
     return res;
 }
 
@@ -236,6 +243,25 @@ RawEvent* PipelineEventGroup::AddRawEvent(bool fromPool, EventPool* pool) {
     return e;
 }
 
+size_t PipelineEventGroup::GetEventsCount() const {
+    return mColumnarLogs ? mEvents.size() + mColumnarLogs->Size() : mEvents.size();
+}
+
+ColumnarLogEvents& PipelineEventGroup::EnableColumnarLogs() {
+    if (!mColumnarLogs) {
+        mColumnarLogs = make_unique<ColumnarLogEvents>();
+    }
+    return *mColumnarLogs;
+}
+
+void PipelineEventGroup::MaterializeColumnarLogs() {
+    if (!mColumnarLogs) {
+        return;
+    }
+    mColumnarLogs->Materialize(*this, mEvents);
+    mColumnarLogs.reset();
+}
+
 void PipelineEventGroup::SetMetadata(EventGroupMetaKey key, StringView val) {
     SetMetadataNoCopy(key, mSourceBuffer->CopyString(val));
 }
@@ -318,6 +344,9 @@ size_t PipelineEventGroup::DataSize() const {
     for (const auto& item : mEvents) {
         eventsSize += item->DataSize();
     }
+    if (mColumnarLogs) {
+        eventsSize += mColumnarLogs->DataSize();
+    }
     return eventsSize + mTags.DataSize();
 }
 
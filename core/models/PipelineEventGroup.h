@@ -22,6 +22,7 @@
 #include "checkpoint/RangeCheckpoint.h"
 #include "common/memory/SourceBuffer.h"
 #include "constants/Constants.h"
+#include "models/ColumnarLogEvents.h"
 #include "models/PipelineEventPtr.h"
 
 namespace logtail {
@@ -96,6 +97,16 @@ public:
     RawEvent* AddRawEvent(bool fromPool = false, EventPool* pool = nullptr);
     void SwapEvents(EventsContainer& other) { mEvents.swap(other); }
     void ReserveEvents(size_t size) { mEvents.reserve(size); }
+    // number of events, including log rows held in columnar mode
+    size_t GetEventsCount() const;
+
+    // In columnar mode, log events are held by ColumnarLogEvents instead of the events container, which is empty.
+    bool IsColumnar() const { return mColumnarLogs != nullptr; }
+    ColumnarLogEvents& EnableColumnarLogs();
+    ColumnarLogEvents* GetColumnarLogs() { return mColumnarLogs.get(); }
+    const ColumnarLogEvents* GetColumnarLogs() const { return mColumnarLogs.get(); }
+    // convert columnar log rows into ordinary LogEvents and leave columnar mode, no-op if not in columnar mode
+    void MaterializeColumnarLogs();
 
     std::shared_ptr<SourceBuffer>& GetSourceBuffer() { return mSourceBuffer; }
 
@@ -140,6 +151,7 @@ private:
     GroupMetadata mMetadata; // Used to generate tag/log. Will not output.
     SizedMap mTags; // custom tags to output
     EventsContainer mEvents;
+    std::unique_ptr<ColumnarLogEvents> mColumnarLogs;
     std::shared_ptr<SourceBuffer> mSourceBuffer;
     RangeCheckpointPtr mExactlyOnceCheckpoint;
 };
@@ -37,6 +37,7 @@ const string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED = "group_batch_enabled";
 // label values
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER = "batcher";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR = "compressor";
+const string METRIC_LABEL_VALUE_COMPONENT_NAME_PAYLOAD_BUFFER_POOL = "payload_buffer_pool";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE = "process_queue";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER = "router";
 const string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE = "sender_queue";
@@ -71,6 +72,7 @@ const string METRIC_COMPONENT_QUEUE_SIZE_BYTES = "queue_size_bytes";
 const string METRIC_COMPONENT_QUEUE_VALID_TO_PUSH_FLAG = "valid_to_push_status";
 const string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE = "extra_buffer_size";
 const string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES = "extra_buffer_size_bytes";
+const string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SPILLED_SIZE_BYTES = "extra_buffer_spilled_size_bytes";
 const string& METRIC_COMPONENT_QUEUE_DISCARDED_EVENTS_TOTAL = METRIC_DISCARDED_EVENTS_TOTAL;
 
 const string METRIC_COMPONENT_QUEUE_FETCHED_ITEMS_TOTAL = "fetched_items_total";
@@ -81,4 +83,11 @@ const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_PROJECT_LIMITER_TIMES_TOTA
 const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_LOGSTORE_LIMITER_TIMES_TOTAL = "logstore_reject_times_total";
 const string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL = "rate_reject_times_total";
 
+/**********************************************************
+ *   pool
+ **********************************************************/
+const string METRIC_COMPONENT_POOL_HITS_TOTAL = "pool_hits_total";
+const string METRIC_COMPONENT_POOL_MISSES_TOTAL = "pool_misses_total";
+const string METRIC_COMPONENT_POOL_CACHED_SIZE_BYTES = "pool_cached_size_bytes";
+
 } // namespace logtail
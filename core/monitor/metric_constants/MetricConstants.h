@@ -90,6 +90,7 @@ extern const std::string METRIC_LABEL_KEY_FILE_INODE;
 extern const std::string METRIC_LABEL_KEY_FILE_NAME;
 
 extern const std::string METRIC_PLUGIN_MONITOR_FILE_TOTAL;
+extern const std::string METRIC_PLUGIN_SOURCE_CACHE_COPIED_BYTES;
 extern const std::string METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES;
 extern const std::string METRIC_PLUGIN_SOURCE_SIZE_BYTES;
 
@@ -229,6 +230,7 @@ extern const std::string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED;
 // label values
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_PAYLOAD_BUFFER_POOL;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE;
@@ -263,6 +265,7 @@ extern const std::string METRIC_COMPONENT_QUEUE_SIZE_BYTES;
 extern const std::string METRIC_COMPONENT_QUEUE_VALID_TO_PUSH_FLAG;
 extern const std::string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE;
 extern const std::string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SIZE_BYTES;
+extern const std::string METRIC_COMPONENT_QUEUE_EXTRA_BUFFER_SPILLED_SIZE_BYTES;
 extern const std::string& METRIC_COMPONENT_QUEUE_DISCARDED_EVENTS_TOTAL;
 
 extern const std::string METRIC_COMPONENT_QUEUE_FETCHED_ITEMS_TOTAL;
@@ -273,6 +276,13 @@ extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_PROJECT_LIMITE
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_LOGSTORE_LIMITER_TIMES_TOTAL;
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL;
 
+/**********************************************************
+ *   pool
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_POOL_HITS_TOTAL;
+extern const std::string METRIC_COMPONENT_POOL_MISSES_TOTAL;
+extern const std::string METRIC_COMPONENT_POOL_CACHED_SIZE_BYTES;
+
 //////////////////////////////////////////////////////////////////////////
 // runner
 //////////////////////////////////////////////////////////////////////////
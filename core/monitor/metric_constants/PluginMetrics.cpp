@@ -42,6 +42,7 @@ const string METRIC_LABEL_KEY_FILE_INODE = "file_inode";
 const string METRIC_LABEL_KEY_FILE_NAME = "file_name";
 
 const string METRIC_PLUGIN_MONITOR_FILE_TOTAL = "monitor_file_total";
+const string METRIC_PLUGIN_SOURCE_CACHE_COPIED_BYTES = "cache_copied_bytes";
 const string METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES = "read_offset_bytes";
 const string METRIC_PLUGIN_SOURCE_SIZE_BYTES = "size_bytes";
 
@@ -0,0 +1,192 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "parser/DelimiterModeSimdParser.h"
+
+#include <cstdint>
+#include <cstring>
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LOGTAIL_DELIMITER_SIMD_X86 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace logtail {
+
+static const size_t kBlockSize = 64;
+
+static inline size_t CountTrailingZeros(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long idx = 0;
+    _BitScanForward64(&idx, mask);
+    return static_cast<size_t>(idx);
+#else
+    return static_cast<size_t>(__builtin_ctzll(mask));
+#endif
+}
+
+// bit i of the result is set if p[i] == c, for the first len (at most 64) bytes
+static inline uint64_t CharMask(const char* p, size_t len, char c) {
+    uint64_t mask = 0;
+#ifdef LOGTAIL_DELIMITER_SIMD_X86
+    if (len == kBlockSize) {
+        const __m128i needle = _mm_set1_epi8(c);
+        for (size_t i = 0; i < kBlockSize; i += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+            mask |= static_cast<uint64_t>(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))))
+                << i;
+        }
+        return mask;
+    }
+#endif
+    for (size_t i = 0; i < len; ++i) {
+        mask |= static_cast<uint64_t>(p[i] == c) << i;
+    }
+    return mask;
+}
+
+// bit i of the result is the parity of the bits of mask up to i, i.e. whether i is inside quotes
+static inline uint64_t PrefixXor(uint64_t mask) {
+    mask ^= mask << 1;
+    mask ^= mask << 2;
+    mask ^= mask << 4;
+    mask ^= mask << 8;
+    mask ^= mask << 16;
+    mask ^= mask << 32;
+    return mask;
+}
+
+DelimiterModeSimdParser::DelimiterModeSimdParser(char quote, const std::string& separator)
+    : mQuote(quote), mSeparator(separator) {
+}
+
+void DelimiterModeSimdParser::SplitLine(StringView line,
+                                        size_t maxFields,
+                                        std::vector<StringView>& columnValues) const {
+    const char* data = line.data();
+    const size_t size = line.size();
+    const size_t sepSize = mSeparator.size();
+    const char first = mSeparator[0];
+    size_t fieldStart = 0;
+    for (size_t base = 0; base < size; base += kBlockSize) {
+        uint64_t mask = CharMask(data + base, std::min(kBlockSize, size - base), first);
+        while (mask != 0) {
+            size_t pos = base + CountTrailingZeros(mask);
+            mask &= mask - 1;
+            // separators do not overlap
+            if (pos < fieldStart || pos + sepSize > size
+                || (sepSize > 1 && memcmp(data + pos + 1, mSeparator.data() + 1, sepSize - 1) != 0)) {
+                continue;
+            }
+            columnValues.emplace_back(data + fieldStart, pos - fieldStart);
+            fieldStart = pos + sepSize;
+            if (maxFields != 0 && columnValues.size() >= maxFields) {
+                columnValues.emplace_back(data + pos, size - pos);
+                return;
+            }
+        }
+    }
+    columnValues.emplace_back(data + fieldStart, size - fieldStart);
+}
+
+bool DelimiterModeSimdParser::ParseDelimiterLine(StringView line,
+                                                 std::vector<StringView>& columnValues,
+                                                 SourceBuffer& sourceBuffer) const {
+    const char* data = line.data();
+    const size_t size = line.size();
+    const char separator = mSeparator[0];
+
+    // a field is either unquoted without any quote, or quoted with escaped quotes doubled inside
+    auto addField = [&](size_t start, size_t end, size_t quoteCount, size_t lastQuote) {
+        if (quoteCount == 0) {
+            columnValues.emplace_back(data + start, end - start);
+            return true;
+        }
+        if (quoteCount % 2 != 0 || lastQuote + 1 != end) {
+            return false;
+        }
+        if (quoteCount == 2) {
+            columnValues.emplace_back(data + start + 1, end - start - 2);
+            return true;
+        }
+        size_t length = end - start - 2 - (quoteCount - 2) / 2;
+        StringBuffer sb = sourceBuffer.AllocateStringBuffer(length);
+        char* out = sb.data;
+        const char* cur = data + start + 1;
+        const char* last = data + end - 1;
+        while (cur < last) {
+            const char* quote = static_cast<const char*>(memchr(cur, mQuote, last - cur));
+            if (quote == nullptr) {
+                memcpy(out, cur, last - cur);
+                break;
+            }
+            // keep the first quote of the pair
+            memcpy(out, cur, quote - cur + 1);
+            out += quote - cur + 1;
+            cur = quote + 2;
+        }
+        columnValues.emplace_back(sb.data, length);
+        return true;
+    };
+
+    size_t fieldStart = 0;
+    size_t quoteCount = 0;
+    size_t lastQuote = 0;
+    // all ones if the previous block ends inside quotes
+    uint64_t carry = 0;
+    for (size_t base = 0; base < size; base += kBlockSize) {
+        size_t len = std::min(kBlockSize, size - base);
+        uint64_t sepMask = CharMask(data + base, len, separator);
+        uint64_t quoteMask = CharMask(data + base, len, mQuote);
+        uint64_t quoted = PrefixXor(quoteMask) ^ carry;
+        carry = static_cast<uint64_t>(static_cast<int64_t>(quoted) >> 63);
+        uint64_t events = quoteMask | (sepMask & ~quoted);
+        while (events != 0) {
+            size_t offset = CountTrailingZeros(events);
+            size_t pos = base + offset;
+            events &= events - 1;
+            if ((quoteMask >> offset) & 1) {
+                // the first quote opens the field, and each escaped quote is followed by another one
+                if ((quoteCount == 0 && pos != fieldStart)
+                    || (quoteCount >= 2 && quoteCount % 2 == 0 && pos != lastQuote + 1)) {
+                    columnValues.clear();
+                    return false;
+                }
+                ++quoteCount;
+                lastQuote = pos;
+            } else {
+                if (!addField(fieldStart, pos, quoteCount, lastQuote)) {
+                    columnValues.clear();
+                    return false;
+                }
+                fieldStart = pos + 1;
+                quoteCount = 0;
+            }
+        }
+    }
+    if (!addField(fieldStart, size, quoteCount, lastQuote)) {
+        columnValues.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace logtail
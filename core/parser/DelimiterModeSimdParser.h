@@ -0,0 +1,49 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/StringView.h"
+#include "common/memory/SourceBuffer.h"
+
+namespace logtail {
+
+// Splitter for delimiter logs, which finds separators and quotes of 64 bytes at a time with SIMD bitmasks instead of
+// walking a state machine char by char. Separators inside quotes are masked out by the prefix xor of the quote mask,
+// as simdcsv does.
+//
+// Columns are views of the line, and a copy is only made in the source buffer for quoted fields with escaped quotes.
+class DelimiterModeSimdParser {
+public:
+    DelimiterModeSimdParser(char quote, const std::string& separator);
+
+    // Splits the line by the non-empty separator of any length, ignoring quotes. Once maxFields columns are split, the
+    // rest of the line starting from the next separator is appended as the last column. 0 means no limit.
+    void SplitLine(StringView line, size_t maxFields, std::vector<StringView>& columnValues) const;
+
+    // Same as DelimiterModeFsmParser::ParseDelimiterLine, where the separator is the first char of the separator.
+    // @return false if the line is not valid csv, in which case columnValues is cleared
+    bool ParseDelimiterLine(StringView line, std::vector<StringView>& columnValues, SourceBuffer& sourceBuffer) const;
+
+private:
+    const char mQuote;
+    const std::string mSeparator;
+};
+
+} // namespace logtail
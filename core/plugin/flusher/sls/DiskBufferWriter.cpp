@@ -16,6 +16,8 @@
 
 #include <cstddef>
 
+#include <algorithm>
+
 #include "Flags.h"
 #include "app_config/AppConfig.h"
 #include "application/Application.h"
@@ -50,6 +52,10 @@ DEFINE_FLAG_INT32(send_retry_sleep_interval, "sleep microseconds when sync send
 DEFINE_FLAG_INT32(buffer_check_period, "check logtail local storage buffer period", 60);
 DEFINE_FLAG_INT32(unauthorized_wait_interval, "", 1);
 DEFINE_FLAG_INT32(send_retrytimes, "how many times should retry if PostLogStoreLogs operation fail", 3);
+DEFINE_FLAG_BOOL(enable_disk_buffer_segment,
+                 "write disk buffer into memory-mapped segments instead of buffer files, only works on linux",
+                 true);
+DEFINE_FLAG_INT32(disk_buffer_replay_thread_cnt, "number of threads sending records of a buffer segment", 4);
 
 DECLARE_FLAG_INT32(discard_send_fail_interval);
 
@@ -86,6 +92,16 @@ static const string kAKErrorMsg = "can not get valid access key";
 
 static const string kNoHostErrorMsg = "can not get available host";
 
+#ifdef __linux__
+static const string kBufferSegmentNamePrefix = "buffer_segment_";
+static const string kBufferSegmentWritingSuffix = ".writing";
+
+// the part of a segment file name after the prefix
+static bool IsBufferSegmentId(const string& id) {
+    return !id.empty() && all_of(id.begin(), id.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+#endif
+
 static const string& GetSLSCompressTypeString(sls_logs::SlsCompressType compressType) {
     switch (compressType) {
         case sls_logs::SLS_CMP_NONE: {
@@ -110,6 +126,9 @@ void DiskBufferWriter::Init() {
     mBufferDivideTime = time(NULL);
     mCheckPeriod = INT32_FLAG(buffer_check_period);
     SetBufferFilePath(AppConfig::GetInstance()->GetBufferFilePath());
+#ifdef __linux__
+    RecoverBufferSegments();
+#endif
 
     mBufferSenderThreadRes = async(launch::async, &DiskBufferWriter::BufferSenderThread, this);
     mBufferWriterThreadRes = async(launch::async, &DiskBufferWriter::BufferWriterThread, this);
@@ -152,7 +171,7 @@ bool DiskBufferWriter::PushToDiskBuffer(SenderQueueItem* item, uint32_t retryTim
         if (Application::GetInstance()->IsExiting()
             || mQueue.Size() < static_cast<size_t>(INT32_FLAG(secondary_buffer_count_limit))) {
             if (slsItem->mExactlyOnceCheckpoint == nullptr) {
-                // explicitly clone the data to avoid dataPtr be destructed by queue
+                // explicitly clone the item to avoid dataPtr be destructed by queue, the payload is shared by the clone
                 mQueue.Push(item->Clone());
             }
             return true;
@@ -187,16 +206,31 @@ void DiskBufferWriter::BufferWriterThread() {
         // update bufferDiveideTime to flush data; buffer file before bufferDiveideTime will be ready for read
         if (time(NULL) - mBufferDivideTime > INT32_FLAG(buffer_file_alive_interval)) {
             CreateNewFile();
+#ifdef __linux__
+            // sealed segments are ready for read
+            SealBufferSegment();
+#endif
         }
 
         if (!res.empty()) {
             for (auto itr = res.begin(); itr != res.end(); ++itr) {
+#ifdef __linux__
+                if (BOOL_FLAG(enable_disk_buffer_segment)) {
+                    SendToBufferSegment(*itr);
+                } else {
+                    SendToBufferFile(*itr);
+                }
+#else
                 SendToBufferFile(*itr);
+#endif
                 delete *itr;
             }
             res.clear();
         }
     }
+#ifdef __linux__
+    SealBufferSegment();
+#endif
 }
 
 void DiskBufferWriter::BufferSenderThread() {
@@ -247,8 +281,18 @@ void DiskBufferWriter::BufferSenderThread() {
                                                        "check header of buffer file failed, delete file: " + fileName);
             }
         }
+#ifdef __linux__
+        vector<string> segmentsToSend;
+        LoadSegmentToSend(segmentsToSend);
+        for (size_t i = 0; i < segmentsToSend.size() && IsSendBufferThreadRunning(); ++i) {
+            SendBufferSegment(GetBufferFilePath() + segmentsToSend[i]);
+        }
+#endif
 #ifdef __ENTERPRISE__
-        mCandidateHostsInfos.clear();
+        {
+            lock_guard<mutex> lock(mCandidateHostsInfosMux);
+            mCandidateHostsInfos.clear();
+        }
 #endif
         // mIsSendingBuffer = false;
         lock.lock();
@@ -555,78 +599,10 @@ void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t
                     }
                 }
                 if (!sendResult) {
-                    time_t beginTime = time(nullptr);
-                    while (true) {
-                        string host;
-                        auto response = SendBufferFileData(bufferMeta, logData, host);
-                        SendResult sendRes = SEND_OK;
-                        if (response.mStatusCode != 200) {
-                            sendRes = ConvertErrorCode(response.mErrorCode);
-                        }
-                        switch (sendRes) {
-                            case SEND_OK:
-                                sendResult = true;
-                                break;
-                            case SEND_NETWORK_ERROR:
-                            case SEND_SERVER_ERROR:
-                                if (response.mErrorMsg != kNoHostErrorMsg) {
-                                    LOG_WARNING(
-                                        sLogger,
-                                        ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
-                                            "error_code", response.mErrorCode)("error_message", response.mErrorMsg)(
-                                            "endpoint", host)("projectName", bufferMeta.project())(
-                                            "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
-                                }
-                                usleep(INT32_FLAG(send_retry_sleep_interval));
-                                break;
-                            case SEND_QUOTA_EXCEED:
-                                AlarmManager::GetInstance()->SendAlarm(SEND_QUOTA_EXCEED_ALARM,
-                                                                       "error_code: " + response.mErrorCode
-                                                                           + ", error_message: " + response.mErrorMsg,
-                                                                       bufferMeta.region(),
-                                                                       bufferMeta.project(),
-                                                                       "",
-                                                                       bufferMeta.logstore());
-                                // no region
-                                if (!GetProfileSender()->IsProfileData("", bufferMeta.project(), bufferMeta.logstore()))
-                                    LOG_WARNING(
-                                        sLogger,
-                                        ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
-                                            "error_code", response.mErrorCode)("error_message", response.mErrorMsg)(
-                                            "endpoint", host)("projectName", bufferMeta.project())(
-                                            "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
-                                usleep(INT32_FLAG(quota_exceed_wait_interval));
-                                break;
-                            case SEND_UNAUTHORIZED:
-                                usleep(INT32_FLAG(unauthorized_wait_interval));
-                                break;
-                            default:
-                                sendResult = true;
-                                discardCount++;
-                                break;
-                        }
-#ifdef __ENTERPRISE__
-                        if (sendRes != SEND_NETWORK_ERROR && sendRes != SEND_SERVER_ERROR) {
-                            bool hasAuthError = sendRes == SEND_UNAUTHORIZED && response.mErrorMsg != kAKErrorMsg;
-                            EnterpriseSLSClientManager::GetInstance()->UpdateAccessKeyStatus(bufferMeta.aliuid(),
-                                                                                             !hasAuthError);
-                            EnterpriseSLSClientManager::GetInstance()->UpdateProjectAnonymousWriteStatus(
-                                bufferMeta.project(), !hasAuthError);
-                        }
-#endif
-                        if (time(nullptr) - beginTime >= INT32_FLAG(discard_send_fail_interval)) {
-                            sendResult = true;
-                            discardCount++;
-                        }
-                        if (sendResult) {
-                            break;
-                        }
-                        {
-                            lock_guard<mutex> lock(mBufferSenderThreadRunningMux);
-                            if (!mIsSendBufferThreadRunning) {
-                                break;
-                            }
-                        }
+                    bool discarded = false;
+                    sendResult = SendBufferDataWithRetry(bufferMeta, logData, discarded);
+                    if (discarded) {
+                        discardCount++;
                     }
                 }
             }
@@ -665,6 +641,86 @@ void DiskBufferWriter::SendEncryptionBuffer(const std::string& filename, int32_t
     }
 }
 
+bool DiskBufferWriter::SendBufferDataWithRetry(const sls_logs::LogtailBufferMeta& bufferMeta,
+                                               const std::string& logData,
+                                               bool& discarded) {
+    bool sendResult = false;
+    discarded = false;
+    time_t beginTime = time(nullptr);
+    while (true) {
+        string host;
+        auto response = SendBufferFileData(bufferMeta, logData, host);
+        SendResult sendRes = SEND_OK;
+        if (response.mStatusCode != 200) {
+            sendRes = ConvertErrorCode(response.mErrorCode);
+        }
+        switch (sendRes) {
+            case SEND_OK:
+                sendResult = true;
+                break;
+            case SEND_NETWORK_ERROR:
+            case SEND_SERVER_ERROR:
+                if (response.mErrorMsg != kNoHostErrorMsg) {
+                    LOG_WARNING(sLogger,
+                                ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
+                                    "error_code", response.mErrorCode)("error_message", response.mErrorMsg)(
+                                    "endpoint", host)("projectName", bufferMeta.project())(
+                                    "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
+                }
+                usleep(INT32_FLAG(send_retry_sleep_interval));
+                break;
+            case SEND_QUOTA_EXCEED:
+                AlarmManager::GetInstance()->SendAlarm(SEND_QUOTA_EXCEED_ALARM,
+                                                       "error_code: " + response.mErrorCode + ", error_message: "
+                                                           + response.mErrorMsg,
+                                                       bufferMeta.region(),
+                                                       bufferMeta.project(),
+                                                       "",
+                                                       bufferMeta.logstore());
+                // no region
+                if (!GetProfileSender()->IsProfileData("", bufferMeta.project(), bufferMeta.logstore()))
+                    LOG_WARNING(sLogger,
+                                ("send data to SLS fail", "retry later")("request id", response.mRequestId)(
+                                    "error_code", response.mErrorCode)("error_message", response.mErrorMsg)(
+                                    "endpoint", host)("projectName", bufferMeta.project())(
+                                    "logstore", bufferMeta.logstore())("rawsize", bufferMeta.rawsize()));
+                usleep(INT32_FLAG(quota_exceed_wait_interval));
+                break;
+            case SEND_UNAUTHORIZED:
+                usleep(INT32_FLAG(unauthorized_wait_interval));
+                break;
+            default:
+                sendResult = true;
+                discarded = true;
+                break;
+        }
+#ifdef __ENTERPRISE__
+        if (sendRes != SEND_NETWORK_ERROR && sendRes != SEND_SERVER_ERROR) {
+            bool hasAuthError = sendRes == SEND_UNAUTHORIZED && response.mErrorMsg != kAKErrorMsg;
+            EnterpriseSLSClientManager::GetInstance()->UpdateAccessKeyStatus(bufferMeta.aliuid(), !hasAuthError);
+            EnterpriseSLSClientManager::GetInstance()->UpdateProjectAnonymousWriteStatus(bufferMeta.project(),
+                                                                                         !hasAuthError);
+        }
+#endif
+        if (time(nullptr) - beginTime >= INT32_FLAG(discard_send_fail_interval)) {
+            sendResult = true;
+            discarded = true;
+        }
+        if (sendResult) {
+            break;
+        }
+        if (!IsSendBufferThreadRunning()) {
+            break;
+        }
+    }
+    return sendResult;
+}
+
+bool DiskBufferWriter::IsSendBufferThreadRunning() const {
+    lock_guard<mutex> lock(mBufferSenderThreadRunningMux);
+    return mIsSendBufferThreadRunning;
+}
+
 // file is not really created when call CreateNewFile(), file created happened when SendToBufferFile() first called
 bool DiskBufferWriter::CreateNewFile() {
     vector<string> filesToSend;
@@ -745,6 +801,25 @@ string DiskBufferWriter::GetBufferFileHeader() {
     return (STRING_FLAG(file_encryption_magic_number) + reserve + nullHeader);
 }
 
+void DiskBufferWriter::BuildBufferMeta(const SenderQueueItem* dataPtr, sls_logs::LogtailBufferMeta& bufferMeta) {
+    auto data = static_cast<const SLSSenderQueueItem*>(dataPtr);
+    auto flusher = static_cast<const FlusherSLS*>(data->mFlusher);
+    bufferMeta.set_project(flusher->mProject);
+    bufferMeta.set_region(flusher->mRegion);
+    bufferMeta.set_aliuid(flusher->mAliuid);
+    bufferMeta.set_logstore(data->mLogstore);
+    bufferMeta.set_datatype(int32_t(data->mType));
+    bufferMeta.set_rawsize(data->mRawSize);
+    bufferMeta.set_shardhashkey(data->mShardHashKey);
+    bufferMeta.set_compresstype(ConvertCompressType(flusher->GetCompressType()));
+    bufferMeta.set_telemetrytype(flusher->mTelemetryType);
+    bufferMeta.set_subpath(flusher->GetSubpath());
+#ifdef __ENTERPRISE__
+    bufferMeta.set_endpointmode(GetEndpointMode(flusher->mEndpointMode));
+#endif
+    bufferMeta.set_endpoint(flusher->mEndpoint);
+}
+
 bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
     auto data = static_cast<SLSSenderQueueItem*>(dataPtr);
     auto flusher = static_cast<const FlusherSLS*>(data->mFlusher);
@@ -787,7 +862,7 @@ bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
 
     char* des;
     int32_t desLength;
-    if (!FileEncryption::GetInstance()->Encrypt(data->mData.c_str(), data->mData.size(), des, desLength)) {
+    if (!FileEncryption::GetInstance()->Encrypt(data->mData.data(), data->mData.size(), des, desLength)) {
         fclose(fout);
         LOG_ERROR(sLogger, ("encrypt error, project_name", flusher->mProject));
         AlarmManager::GetInstance()->SendAlarm(ENCRYPT_DECRYPT_FAIL_ALARM,
@@ -800,20 +875,7 @@ bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
     }
 
     sls_logs::LogtailBufferMeta bufferMeta;
-    bufferMeta.set_project(flusher->mProject);
-    bufferMeta.set_region(flusher->mRegion);
-    bufferMeta.set_aliuid(flusher->mAliuid);
-    bufferMeta.set_logstore(data->mLogstore);
-    bufferMeta.set_datatype(int32_t(data->mType));
-    bufferMeta.set_rawsize(data->mRawSize);
-    bufferMeta.set_shardhashkey(data->mShardHashKey);
-    bufferMeta.set_compresstype(ConvertCompressType(flusher->GetCompressType()));
-    bufferMeta.set_telemetrytype(flusher->mTelemetryType);
-    bufferMeta.set_subpath(flusher->GetSubpath());
-#ifdef __ENTERPRISE__
-    bufferMeta.set_endpointmode(GetEndpointMode(flusher->mEndpointMode));
-#endif
-    bufferMeta.set_endpoint(flusher->mEndpoint);
+    BuildBufferMeta(data, bufferMeta);
     string encodedInfo;
     bufferMeta.SerializeToString(&encodedInfo);
 
@@ -859,7 +921,10 @@ bool DiskBufferWriter::SendToBufferFile(SenderQueueItem* dataPtr) {
 SLSResponse DiskBufferWriter::SendBufferFileData(const sls_logs::LogtailBufferMeta& bufferMeta,
                                                  const std::string& logData,
                                                  std::string& host) {
-    RateLimiter::FlowControl(bufferMeta.rawsize(), mSendLastTime, mSendLastByte, false);
+    {
+        lock_guard<mutex> lock(mSendFlowControlMux);
+        RateLimiter::FlowControl(bufferMeta.rawsize(), mSendLastTime, mSendLastByte, false);
+    }
     string region = bufferMeta.region();
 #ifdef __ENTERPRISE__
     // old buffer file which record the endpoint
@@ -889,7 +954,10 @@ SLSResponse DiskBufferWriter::SendBufferFileData(const sls_logs::LogtailBufferMe
     }
     auto info = EnterpriseSLSClientManager::GetInstance()->GetCandidateHostsInfo(
         region, bufferMeta.project(), GetEndpointMode(bufferMeta.endpointmode()));
-    mCandidateHostsInfos.insert(info);
+    {
+        lock_guard<mutex> lock(mCandidateHostsInfosMux);
+        mCandidateHostsInfos.insert(info);
+    }
 
     host = info->GetCurrentHost();
     if (host.empty()) {
@@ -965,6 +1033,242 @@ SLSResponse DiskBufferWriter::SendBufferFileData(const sls_logs::LogtailBufferMe
     }
 }
 
+#ifdef __linux__
+bool DiskBufferWriter::SendToBufferSegment(SenderQueueItem* dataPtr) {
+    auto data = static_cast<SLSSenderQueueItem*>(dataPtr);
+    auto flusher = static_cast<const FlusherSLS*>(data->mFlusher);
+    char* des;
+    int32_t desLength;
+    if (!FileEncryption::GetInstance()->Encrypt(data->mData.data(), data->mData.size(), des, desLength)) {
+        LOG_ERROR(sLogger, ("encrypt error, project_name", flusher->mProject));
+        AlarmManager::GetInstance()->SendAlarm(ENCRYPT_DECRYPT_FAIL_ALARM,
+                                               string("encrypt error, project_name:" + flusher->mProject),
+                                               flusher->mRegion,
+                                               flusher->mProject,
+                                               "",
+                                               data->mLogstore);
+        return false;
+    }
+    unique_ptr<char[]> encryption(des);
+
+    sls_logs::LogtailBufferMeta bufferMeta;
+    BuildBufferMeta(data, bufferMeta);
+    string encodedInfo;
+    bufferMeta.SerializeToString(&encodedInfo);
+
+    SegmentRecordMeta meta;
+    meta.mLogDataSize = data->mData.size();
+    meta.mEncodedInfoSize = encodedInfo.size();
+    meta.mKeyVersion = FileEncryption::GetInstance()->GetDefaultKeyVersion();
+    meta.mTimeStamp = time(nullptr);
+    initializer_list<StringView> parts = {StringView(reinterpret_cast<const char*>(&meta), sizeof(meta)),
+                                          StringView(encodedInfo),
+                                          StringView(encryption.get(), desLength)};
+
+    if (mSegmentWriter.IsOpen() && !mSegmentWriter.Append(parts)) {
+        // the segment is full
+        SealBufferSegment();
+    }
+    if (!mSegmentWriter.IsOpen()) {
+        size_t recordSize = DiskSegmentWriter::GetRecordSize(sizeof(meta) + encodedInfo.size() + desLength);
+        size_t capacity = max(static_cast<size_t>(AppConfig::GetInstance()->GetLocalFileSize()), recordSize);
+        if (!OpenNewBufferSegment(capacity) || !mSegmentWriter.Append(parts)) {
+            AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
+                                                   string("write buffer segment error:") + mSegmentWriter.GetPath(),
+                                                   flusher->mRegion,
+                                                   flusher->mProject,
+                                                   "",
+                                                   data->mLogstore);
+            LOG_ERROR(sLogger, ("write buffer segment", "fail")("segment", mSegmentWriter.GetPath()));
+            return false;
+        }
+    }
+    LOG_DEBUG(sLogger, ("write buffer segment", mSegmentWriter.GetPath()));
+    return true;
+}
+
+bool DiskBufferWriter::OpenNewBufferSegment(size_t capacity) {
+    vector<string> segments;
+    if (LoadSegmentToSend(segments)) {
+        int32_t bufferFileNumValue = AppConfig::GetInstance()->GetNumOfBufferFile();
+        for (int32_t i = 0; i <= static_cast<int32_t>(segments.size()) - bufferFileNumValue; ++i) {
+            string fileName = GetBufferFilePath() + segments[i];
+            DiskSegmentReader::Remove(fileName);
+            LOG_ERROR(sLogger,
+                      ("buffer file count exceed limit",
+                       "segment created earlier will be cleaned, and new segment will create for new log data")(
+                          "delete file", fileName));
+            AlarmManager::GetInstance()->SendAlarm(DISCARD_SECONDARY_ALARM,
+                                                   "buffer file count exceed, delete file: " + fileName);
+        }
+    }
+    string fileName = GetBufferFilePath() + kBufferSegmentNamePrefix + ToString(GetCurrentTimeInMicroSeconds());
+    return mSegmentWriter.Open(fileName, capacity);
+}
+
+void DiskBufferWriter::SealBufferSegment() {
+    if (!mSegmentWriter.IsOpen()) {
+        return;
+    }
+    if (!mSegmentWriter.Seal()) {
+        AlarmManager::GetInstance()->SendAlarm(SECONDARY_READ_WRITE_ALARM,
+                                               string("seal buffer segment error:") + mSegmentWriter.GetPath());
+        return;
+    }
+    LOG_DEBUG(sLogger,
+              ("seal buffer segment", mSegmentWriter.GetPath())("record count", mSegmentWriter.GetRecordCnt()));
+}
+
+void DiskBufferWriter::RecoverBufferSegments() {
+    string bufferFilePath = GetBufferFilePath();
+    fsutil::Dir dir(bufferFilePath);
+    if (!dir.Open()) {
+        return;
+    }
+    fsutil::Entry ent;
+    while ((ent = dir.ReadNext())) {
+        string filename = ent.Name();
+        if (filename.find(kBufferSegmentNamePrefix) != 0 || !EndWith(filename, kBufferSegmentWritingSuffix)) {
+            continue;
+        }
+        string segmentName = filename.substr(0, filename.size() - kBufferSegmentWritingSuffix.size());
+        if (DiskSegmentWriter::Recover(bufferFilePath + segmentName)) {
+            LOG_INFO(sLogger, ("recover unsealed buffer segment", bufferFilePath + segmentName));
+        }
+    }
+}
+
+bool DiskBufferWriter::LoadSegmentToSend(vector<string>& segmentsToSend) {
+    string bufferFilePath = GetBufferFilePath();
+    fsutil::Dir dir(bufferFilePath);
+    if (!dir.Open()) {
+        return false;
+    }
+    fsutil::Entry ent;
+    while ((ent = dir.ReadNext())) {
+        string filename = ent.Name();
+        // unsealed segments and ack bitmaps are excluded
+        if (filename.find(kBufferSegmentNamePrefix) == 0
+            && IsBufferSegmentId(filename.substr(kBufferSegmentNamePrefix.size()))) {
+            segmentsToSend.push_back(filename);
+        }
+    }
+    sort(segmentsToSend.begin(), segmentsToSend.end());
+    return true;
+}
+
+void DiskBufferWriter::SendBufferSegment(const string& filename) {
+    DiskSegmentReader reader;
+    if (!reader.Open(filename)) {
+        DiskSegmentReader::Remove(filename);
+        LOG_ERROR(sLogger, ("open buffer segment failed, delete file", filename));
+        AlarmManager::GetInstance()->SendAlarm(DISCARD_SECONDARY_ALARM,
+                                               "open buffer segment failed, delete file: " + filename);
+        return;
+    }
+    if (reader.IsTruncated()) {
+        AlarmManager::GetInstance()->SendAlarm(DISCARD_SECONDARY_ALARM,
+                                               "buffer segment is corrupted, records after the corrupted one are lost: "
+                                                   + filename);
+    }
+
+    // records are sent concurrently, so they may arrive out of order
+    atomic_size_t nextIdx(0);
+    atomic_int32_t discardCount(0);
+    auto sendRecords = [&]() {
+        size_t idx = 0;
+        while ((idx = nextIdx.fetch_add(1)) < reader.GetRecordCnt() && IsSendBufferThreadRunning()) {
+            if (reader.IsAcked(idx)) {
+                continue;
+            }
+            bool discarded = false;
+            if (SendSegmentRecord(filename, reader.GetRecord(idx), discarded)) {
+                reader.Ack(idx);
+                if (discarded) {
+                    ++discardCount;
+                }
+            }
+        }
+    };
+    size_t threadCnt
+        = min(static_cast<size_t>(max(INT32_FLAG(disk_buffer_replay_thread_cnt), 1)), reader.GetRecordCnt());
+    vector<future<void>> results;
+    for (size_t i = 1; i < threadCnt; ++i) {
+        results.emplace_back(async(launch::async, sendRecords));
+    }
+    sendRecords();
+    for (auto& res : results) {
+        res.get();
+    }
+    if (!reader.IsAllAcked()) {
+        // sender is stopped, the rest records will be sent next time
+        return;
+    }
+
+    reader.Close();
+    DiskSegmentReader::Remove(filename);
+    if (discardCount > 0) {
+        LOG_ERROR(sLogger,
+                  ("send buffer segment, discard LogGroup count", discardCount.load())("delete file", filename));
+        AlarmManager::GetInstance()->SendAlarm(DISCARD_SECONDARY_ALARM,
+                                               "delete buffer file: " + filename + ", discard "
+                                                   + ToString(discardCount.load()) + " logGroups");
+    } else {
+        LOG_INFO(sLogger, ("send buffer segment success, delete buffer file", filename));
+    }
+}
+
+bool DiskBufferWriter::SendSegmentRecord(const string& filename, StringView record, bool& discarded) {
+    discarded = true;
+    SegmentRecordMeta meta;
+    if (record.size() < sizeof(meta)) {
+        LOG_ERROR(sLogger, ("invalid record in buffer segment", filename)("record size", record.size()));
+        return true;
+    }
+    memcpy(&meta, record.data(), sizeof(meta));
+    if (meta.mLogDataSize <= 0 || meta.mEncodedInfoSize < 0
+        || static_cast<size_t>(meta.mEncodedInfoSize) > record.size() - sizeof(meta)) {
+        LOG_ERROR(sLogger,
+                  ("invalid record meta in buffer segment", filename)("meta.mLogDataSize", meta.mLogDataSize)(
+                      "meta.mEncodedInfoSize", meta.mEncodedInfoSize));
+        return true;
+    }
+    if (time(nullptr) - meta.mTimeStamp > INT32_FLAG(log_expire_time)) {
+        LOG_WARNING(sLogger, ("timeout record in buffer segment", filename)("meta.mTimeStamp", meta.mTimeStamp));
+        return true;
+    }
+
+    sls_logs::LogtailBufferMeta bufferMeta;
+    if (!bufferMeta.ParseFromArray(record.data() + sizeof(meta), meta.mEncodedInfoSize)) {
+        LOG_ERROR(sLogger, ("parse buffer meta from buffer segment error", filename));
+        return true;
+    }
+    if (!CheckBufferMetaValidation(filename, bufferMeta)) {
+        return true;
+    }
+
+    const char* encryption = record.data() + sizeof(meta) + meta.mEncodedInfoSize;
+    int32_t encryptionSize = record.size() - sizeof(meta) - meta.mEncodedInfoSize;
+    string logData(meta.mLogDataSize, '\0');
+    if (!FileEncryption::GetInstance()->Decrypt(
+            encryption, encryptionSize, &logData[0], meta.mLogDataSize, meta.mKeyVersion)) {
+        LOG_ERROR(sLogger,
+                  ("decrypt error, project_name", bufferMeta.project())("key_version", meta.mKeyVersion)(
+                      "meta.mLogDataSize", meta.mLogDataSize));
+        AlarmManager::GetInstance()->SendAlarm(ENCRYPT_DECRYPT_FAIL_ALARM,
+                                               string("decrypt error, project_name:" + bufferMeta.project()
+                                                      + ", key_version:" + ToString(meta.mKeyVersion)
+                                                      + ", meta.mLogDataSize:" + ToString(meta.mLogDataSize)),
+                                               bufferMeta.region(),
+                                               bufferMeta.project(),
+                                               "",
+                                               bufferMeta.logstore());
+        return true;
+    }
+    return SendBufferDataWithRetry(bufferMeta, logData, discarded);
+}
+#endif
+
 bool DiskBufferWriter::CheckBufferMetaValidation(const std::string& filename,
                                                  const sls_logs::LogtailBufferMeta& bufferMeta) {
     if (bufferMeta.project().empty()) {
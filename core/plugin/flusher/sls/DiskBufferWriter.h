@@ -29,6 +29,7 @@
 
 #include "collection_pipeline/queue/SenderQueueItem.h"
 #include "common/SafeQueue.h"
+#include "common/StringView.h"
 #include "plugin/flusher/sls/SLSClientManager.h"
 #include "plugin/flusher/sls/SLSResponse.h"
 #include "protobuf/sls/logtail_buffer_meta.pb.h"
@@ -37,6 +38,9 @@
 
 #include "plugin/flusher/sls/EnterpriseSLSClientManager.h"
 #endif
+#ifdef __linux__
+#include "common/DiskSegment.h"
+#endif
 
 namespace logtail {
 
@@ -68,6 +72,14 @@ private:
         int32_t mRetryTime;
     };
 
+    // leading part of a record in buffer segments, followed by the encoded buffer meta and the encrypted data
+    struct SegmentRecordMeta {
+        int32_t mLogDataSize;
+        int32_t mEncodedInfoSize;
+        int32_t mKeyVersion;
+        int32_t mTimeStamp;
+    };
+
     DiskBufferWriter() = default;
     ~DiskBufferWriter() = default;
 
@@ -76,6 +88,11 @@ private:
 
     SLSResponse
     SendBufferFileData(const sls_logs::LogtailBufferMeta& bufferMeta, const std::string& logData, std::string& host);
+    // returns false if the sender is stopped before the data is sent or discarded
+    bool SendBufferDataWithRetry(const sls_logs::LogtailBufferMeta& bufferMeta,
+                                 const std::string& logData,
+                                 bool& discarded);
+    void BuildBufferMeta(const SenderQueueItem* dataPtr, sls_logs::LogtailBufferMeta& bufferMeta);
     bool SendToBufferFile(SenderQueueItem* dataPtr);
     bool LoadFileToSend(time_t timeLine, std::vector<std::string>& filesToSend);
     bool CreateNewFile();
@@ -93,6 +110,20 @@ private:
     void SetBufferFileName(const std::string& filename);
     std::string GetBufferFileHeader();
     bool CheckBufferMetaValidation(const std::string& filename, const sls_logs::LogtailBufferMeta& bufferMeta);
+    bool IsSendBufferThreadRunning() const;
+
+#ifdef __linux__
+    bool SendToBufferSegment(SenderQueueItem* dataPtr);
+    bool OpenNewBufferSegment(size_t capacity);
+    void SealBufferSegment();
+    void RecoverBufferSegments();
+    bool LoadSegmentToSend(std::vector<std::string>& segmentsToSend);
+    void SendBufferSegment(const std::string& filename);
+    // returns false if the record is neither sent nor discarded
+    bool SendSegmentRecord(const std::string& filename, StringView record, bool& discarded);
+
+    DiskSegmentWriter mSegmentWriter;
+#endif
 
     SafeQueue<SenderQueueItem*> mQueue;
 
@@ -118,6 +149,7 @@ private:
         }
     };
 
+    std::mutex mCandidateHostsInfosMux;
     std::unordered_set<std::shared_ptr<CandidateHostsInfo>, PointerHash, PointerEqual> mCandidateHostsInfos;
 #endif
 
@@ -128,6 +160,8 @@ private:
     volatile time_t mBufferDivideTime = 0;
     int64_t mCheckPeriod = 0;
 
+    // buffer data is sent by several threads when replaying buffer segments
+    std::mutex mSendFlowControlMux;
     int64_t mSendLastTime = 0;
     int32_t mSendLastByte = 0;
 };
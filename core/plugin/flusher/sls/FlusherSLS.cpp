@@ -29,6 +29,7 @@
 #include "common/compression/CompressorFactory.h"
 #include "common/http/Constant.h"
 #include "common/http/HttpRequest.h"
+#include "common/memory/PayloadBuffer.h"
 #include "plugin/flusher/sls/DiskBufferWriter.h"
 #include "plugin/flusher/sls/PackIdManager.h"
 #include "plugin/flusher/sls/SLSClientManager.h"
@@ -60,7 +61,11 @@ DEFINE_FLAG_INT32(unknow_error_try_max, "discard data when try times > this valu
 DEFINE_FLAG_BOOL(enable_metricstore_channel, "only works for metrics data for enhance metrics query performance", true);
 DEFINE_FLAG_INT32(max_send_log_group_size, "bytes", 10 * 1024 * 1024);
 DEFINE_FLAG_DOUBLE(sls_serialize_size_expansion_ratio, "", 1.2);
+DEFINE_FLAG_BOOL(enable_sls_stream_compress,
+                 "serialize log groups chunk by chunk into the compressor if it supports streaming",
+                 true);
 DEFINE_FLAG_INT32(sls_request_dscp, "set dscp for sls request, from 0 to 63", -1);
+DEFINE_FLAG_INT32(sls_batcher_shard_cnt, "number of shards of the batcher, each guarded by its own lock", 8);
 
 DECLARE_FLAG_BOOL(send_prefer_real_ip);
 
@@ -92,6 +97,15 @@ static OperationOnFail DefaultOperation(uint32_t retryTimes) {
     }
 }
 
+// Compressors write into a buffer reused across calls in the same thread, whose result is then copied into pooled
+// memory fitting its own size as the payload of the sender queue item. Otherwise, a block sized by the raw data
+// would be pinned by the item while it is queued.
+static string ToPayload(const string& data) {
+    string res = PayloadBufferPool::GetInstance()->Acquire(data.size());
+    res.assign(data);
+    return res;
+}
+
 void FlusherSLS::InitResource() {
 #ifndef APSARA_UNIT_TEST_MAIN
     if (!sIsResourceInited) {
@@ -508,7 +522,8 @@ bool FlusherSLS::Init(const Json::Value& config, Json::Value& optionalGoPipeline
     if (!mBatcher.Init(itr ? *itr : Json::Value(),
                        this,
                        strategy,
-                       !mContext->IsExactlyOnceEnabled() && mShardHashKeys.empty() && IsMetricsTelemetryType())) {
+                       !mContext->IsExactlyOnceEnabled() && mShardHashKeys.empty() && IsMetricsTelemetryType(),
+                       static_cast<size_t>(max(INT32_FLAG(sls_batcher_shard_cnt), 1)))) {
         // when either exactly once is enabled or ShardHashKeys is not empty or telemetry type is metrics, we don't
         // enable group batch
         return false;
@@ -912,10 +927,12 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
 }
 
 bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& logstore) {
+    size_t rawSize = data.size();
     string compressedData;
     if (mCompressor) {
+        thread_local string compressBuffer;
         string errorMsg;
-        if (!mCompressor->DoCompress(data, compressedData, errorMsg)) {
+        if (!mCompressor->DoCompress(data, compressBuffer, errorMsg)) {
             LOG_WARNING(mContext->GetLogger(),
                         ("failed to compress data",
                          errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
@@ -928,8 +945,9 @@ bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& l
                                            mContext->GetLogstoreName());
             return false;
         }
+        compressedData = ToPayload(compressBuffer);
     } else {
-        compressedData = data;
+        compressedData = std::move(data);
     }
 
     QueueKey key = mQueueKey;
@@ -942,7 +960,7 @@ bool FlusherSLS::Send(string&& data, const string& shardHashKey, const string& l
         }
     }
     return Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                data.size(),
+                                                                rawSize,
                                                                 this,
                                                                 key,
                                                                 logstore.empty() ? mLogstore : logstore,
@@ -966,16 +984,34 @@ void FlusherSLS::GenerateGoPlugin(const Json::Value& config, Json::Value& res) c
     }
 }
 
-bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
-    string serializedData, compressedData;
-    BatchedEvents g(std::move(group.MutableEvents()),
-                    std::move(group.GetSizedTags()),
-                    std::move(group.GetSourceBuffer()),
-                    group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
-                    std::move(group.GetExactlyOnceCheckpoint()));
-    AddPackId(g);
+bool FlusherSLS::SerializeAndCompress(BatchedEvents&& group, string& compressedData, size_t& rawSize) {
     string errorMsg;
-    if (!mGroupSerializer->DoSerialize(std::move(g), serializedData, errorMsg)) {
+    // reused across calls in the same thread, see ToPayload
+    thread_local string compressBuffer;
+    if (mCompressor && mCompressor->IsStreamSupported() && BOOL_FLAG(enable_sls_stream_compress)) {
+        // serialization and compression can not be told apart in stream mode
+        if (!mGroupSerializer->DoSerializeAndCompress(
+                std::move(group), *mCompressor, compressBuffer, rawSize, errorMsg)) {
+            LOG_WARNING(mContext->GetLogger(),
+                        ("failed to serialize and compress event group",
+                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
+            mContext->GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
+                                           "failed to serialize and compress event group: " + errorMsg
+                                               + "\taction: discard data\tplugin: " + sName
+                                               + "\tconfig: " + mContext->GetConfigName(),
+                                           mContext->GetRegion(),
+                                           mContext->GetProjectName(),
+                                           mContext->GetConfigName(),
+                                           mContext->GetLogstoreName());
+            return false;
+        }
+        compressedData = ToPayload(compressBuffer);
+        return true;
+    }
+
+    // serialized data is only an intermediate result, so the buffer is reused across calls in the same thread
+    thread_local string serializedData;
+    if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
         LOG_WARNING(mContext->GetLogger(),
                     ("failed to serialize event group",
                      errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
@@ -989,8 +1025,9 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
                                        mContext->GetLogstoreName());
         return false;
     }
+    rawSize = serializedData.size();
     if (mCompressor) {
-        if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
+        if (!mCompressor->DoCompress(serializedData, compressBuffer, errorMsg)) {
             LOG_WARNING(mContext->GetLogger(),
                         ("failed to compress event group",
                          errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
@@ -1004,14 +1041,31 @@ bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
                                            mContext->GetLogstoreName());
             return false;
         }
+        compressedData = ToPayload(compressBuffer);
     } else {
-        compressedData = serializedData;
+        compressedData = ToPayload(serializedData);
+    }
+    return true;
+}
+
+bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
+    string compressedData;
+    size_t rawSize = 0;
+    BatchedEvents g(std::move(group.MutableEvents()),
+                    std::move(group.GetSizedTags()),
+                    std::move(group.GetSourceBuffer()),
+                    group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                    std::move(group.GetExactlyOnceCheckpoint()));
+    AddPackId(g);
+    // the checkpoint is not touched by serialization, so it is still valid in g afterwards
+    if (!SerializeAndCompress(std::move(g), compressedData, rawSize)) {
+        return false;
     }
     // must create a tmp, because eoo checkpoint is moved in second param
     auto fbKey = g.mExactlyOnceCheckpoint->fbKey;
     return PushToQueue(fbKey,
                        make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                       serializedData.size(),
+                                                       rawSize,
                                                        this,
                                                        fbKey,
                                                        mLogstore,
@@ -1026,8 +1080,8 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
         return true;
     }
     vector<CompressedLogGroup> compressedLogGroups;
-    string shardHashKey, serializedData, compressedData;
-    size_t packageSize = 0;
+    string shardHashKey, compressedData;
+    size_t packageSize = 0, compressedPackageSize = 0;
     bool enablePackageList = groupList.size() > 1;
 
     bool allSucceeded = true;
@@ -1036,44 +1090,15 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
             shardHashKey = GetShardHashKey(group);
         }
         AddPackId(group);
-        string errorMsg;
-        if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
-            LOG_WARNING(mContext->GetLogger(),
-                        ("failed to serialize event group",
-                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-            mContext->GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
-                                           "failed to serialize event group: " + errorMsg
-                                               + "\taction: discard data\tplugin: " + sName
-                                               + "\tconfig: " + mContext->GetConfigName(),
-                                           mContext->GetRegion(),
-                                           mContext->GetProjectName(),
-                                           mContext->GetConfigName(),
-                                           mContext->GetLogstoreName());
+        size_t rawSize = 0;
+        if (!SerializeAndCompress(std::move(group), compressedData, rawSize)) {
             allSucceeded = false;
             continue;
         }
-        if (mCompressor) {
-            if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
-                LOG_WARNING(mContext->GetLogger(),
-                            ("failed to compress event group",
-                             errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-                mContext->GetAlarm().SendAlarm(COMPRESS_FAIL_ALARM,
-                                               "failed to compress event group: " + errorMsg
-                                                   + "\taction: discard data\tplugin: " + sName
-                                                   + "\tconfig: " + mContext->GetConfigName(),
-                                               mContext->GetRegion(),
-                                               mContext->GetProjectName(),
-                                               mContext->GetConfigName(),
-                                               mContext->GetLogstoreName());
-                allSucceeded = false;
-                continue;
-            }
-        } else {
-            compressedData = serializedData;
-        }
         if (enablePackageList) {
-            packageSize += serializedData.size();
-            compressedLogGroups.emplace_back(std::move(compressedData), serializedData.size());
+            packageSize += rawSize;
+            compressedPackageSize += compressedData.size();
+            compressedLogGroups.emplace_back(std::move(compressedData), rawSize);
         } else {
             if (group.mExactlyOnceCheckpoint) {
                 // must create a tmp, because eoo checkpoint is moved in second param
@@ -1081,7 +1106,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                 allSucceeded
                     = PushToQueue(fbKey,
                                   make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                  serializedData.size(),
+                                                                  rawSize,
                                                                   this,
                                                                   fbKey,
                                                                   mLogstore,
@@ -1092,7 +1117,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                     && allSucceeded;
             } else {
                 allSucceeded = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                                    serializedData.size(),
+                                                                                    rawSize,
                                                                                     this,
                                                                                     mQueueKey,
                                                                                     mLogstore,
@@ -1104,6 +1129,9 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
     }
     if (enablePackageList) {
         string errorMsg;
+        // the package list only adds a few bytes of metadata to each package
+        string serializedData
+            = PayloadBufferPool::GetInstance()->Acquire(compressedPackageSize + compressedPackageSize / 64);
         mGroupListSerializer->DoSerialize(std::move(compressedLogGroups), serializedData, errorMsg);
         allSucceeded
             = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(
@@ -1199,7 +1227,7 @@ unique_ptr<HttpSinkRequest> FlusherSLS::CreatePostLogStoreLogsRequest(const stri
                                    item->mLogstore,
                                    CompressTypeToString(mCompressor->GetCompressType()),
                                    item->mType,
-                                   item->mData,
+                                   item->mData.str(),
                                    item->mRawSize,
                                    item->mShardHashKey,
                                    seqId,
@@ -1232,7 +1260,7 @@ unique_ptr<HttpSinkRequest> FlusherSLS::CreatePostHostMetricsRequest(const strin
                                   type,
                                   CompressTypeToString(mCompressor->GetCompressType()),
                                   item->mType,
-                                  item->mData,
+                                  item->mData.str(),
                                   item->mRawSize,
                                   path,
                                   header);
@@ -1265,7 +1293,7 @@ unique_ptr<HttpSinkRequest> FlusherSLS::CreatePostMetricStoreLogsRequest(const s
                                       mProject,
                                       item->mLogstore,
                                       CompressTypeToString(mCompressor->GetCompressType()),
-                                      item->mData,
+                                      item->mData.str(),
                                       item->mRawSize,
                                       path,
                                       header);
@@ -1300,7 +1328,7 @@ unique_ptr<HttpSinkRequest> FlusherSLS::CreatePostAPMBackendRequest(const string
                                  item->mLogstore,
                                  CompressTypeToString(mCompressor->GetCompressType()),
                                  item->mType,
-                                 item->mData,
+                                 item->mData.str(),
                                  item->mRawSize,
                                  mSubpath,
                                  query,
@@ -172,6 +172,7 @@ bool InputContainerStdio::Init(const Json::Value& config, Json::Value& optionalG
         {METRIC_PLUGIN_OUT_SIZE_BYTES, MetricType::METRIC_TYPE_COUNTER},
         {METRIC_PLUGIN_SOURCE_SIZE_BYTES, MetricType::METRIC_TYPE_INT_GAUGE},
         {METRIC_PLUGIN_SOURCE_READ_OFFSET_BYTES, MetricType::METRIC_TYPE_INT_GAUGE},
+        {METRIC_PLUGIN_SOURCE_CACHE_COPIED_BYTES, MetricType::METRIC_TYPE_COUNTER},
     };
     mPluginMetricManager = std::make_shared<PluginMetricManager>(
         GetMetricsRecordRef()->GetLabels(), inputFileMetricKeys, MetricCategory::METRIC_CATEGORY_PLUGIN_SOURCE);
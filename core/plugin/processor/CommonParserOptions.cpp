@@ -117,4 +117,29 @@ bool CommonParserOptions::ShouldEraseEvent(bool parseSuccess,
     return false;
 }
 
+bool CommonParserOptions::ShouldEraseEvent(bool parseSuccess,
+                                           const ColumnarLogEvents& columns,
+                                           size_t row,
+                                           const GroupMetadata& metadata) {
+    if (!parseSuccess && !mKeepingSourceWhenParseFail) {
+        size_t size = columns.GetRowContentSize(row);
+        if (size == 0) {
+            return true;
+        }
+        auto hasContent = [&](StringView key) {
+            size_t col = columns.FindColumn(key);
+            return col != ColumnarLogEvents::npos && columns.HasValue(col, row);
+        };
+        // "__file_offset__"
+        auto offsetKey = metadata.find(EventGroupMetaKey::LOG_FILE_OFFSET_KEY);
+        if (size == 1 && (offsetKey != metadata.end() && hasContent(offsetKey->second))) {
+            return true;
+        } else if (size == 2 && hasContent(ProcessorParseContainerLogNative::containerTimeKey)
+                   && hasContent(ProcessorParseContainerLogNative::containerSourceKey)) {
+            return true;
+        }
+    }
+    return false;
+}
+
 } // namespace logtail
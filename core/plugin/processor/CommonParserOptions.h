@@ -21,6 +21,7 @@
 #include "json/json.h"
 
 #include "collection_pipeline/CollectionPipelineContext.h"
+#include "models/ColumnarLogEvents.h"
 #include "models/LogEvent.h"
 
 namespace logtail {
@@ -37,6 +38,10 @@ struct CommonParserOptions {
     bool ShouldAddSourceContent(bool parseSuccess);
     bool ShouldAddLegacyUnmatchedRawLog(bool parseSuccess);
     bool ShouldEraseEvent(bool parseSuccess, const LogEvent& sourceEvent, const GroupMetadata& metadata);
+    bool ShouldEraseEvent(bool parseSuccess,
+                          const ColumnarLogEvents& columns,
+                          size_t row,
+                          const GroupMetadata& metadata);
 };
 
 } // namespace logtail
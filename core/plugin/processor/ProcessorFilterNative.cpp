@@ -16,13 +16,23 @@
 
 #include "plugin/processor/ProcessorFilterNative.h"
 
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
 #include <vector>
 
+#include "common/Flags.h"
 #include "common/ParamExtractor.h"
+#include "common/StringTools.h"
 #include "logger/Logger.h"
 #include "models/LogEvent.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+// unlike capturing groups, whether the regexes match is told by the DFA of re2, which is faster than boost
+DEFINE_FLAG_BOOL(enable_filter_regex_re2,
+                 "match filter rules on the same key with one re2 set if the regexes have the same meaning in re2",
+                 true);
+
 namespace logtail {
 
 const std::string ProcessorFilterNative::sName = "processor_filter_regex_native";
@@ -100,6 +110,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
             mFilterRule = std::make_shared<LogFilterRule>();
             mFilterRule->FilterKeys = filterKeys;
             mFilterRule->FilterRegs = regs;
+            InitKeyMatchers(*mFilterRule, filterRegs);
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -117,7 +128,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         } else if (!mInclude.empty()) {
-            std::vector<std::string> keys;
+            std::vector<std::string> keys, regexes;
             std::vector<boost::regex> regs;
             for (auto& include : mInclude) {
                 if (!IsRegexValid(include.second)) {
@@ -131,11 +142,13 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                        mContext->GetRegion());
                 }
                 keys.emplace_back(include.first);
+                regexes.emplace_back(include.second);
                 regs.emplace_back(boost::regex(include.second));
             }
             mFilterRule = std::make_shared<LogFilterRule>();
             mFilterRule->FilterKeys = keys;
             mFilterRule->FilterRegs = regs;
+            InitKeyMatchers(*mFilterRule, regexes);
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -157,6 +170,10 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
 }
 
 void ProcessorFilterNative::Process(PipelineEventGroup& logGroup) {
+    if (logGroup.IsColumnar()) {
+        ProcessColumnar(logGroup);
+        return;
+    }
     if (logGroup.GetEvents().empty()) {
         return;
     }
@@ -256,32 +273,263 @@ bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFil
 }
 
 bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterRule& rule) {
-    const std::vector<std::string>& keys = rule.FilterKeys;
-    const std::vector<boost::regex> regs = rule.FilterRegs;
-    std::string exception;
-    for (uint32_t i = 0; i < keys.size(); ++i) {
-        const auto& content = contents.FindContent(keys[i]);
+    for (const auto& matcher : rule.Matchers) {
+        const auto& content = contents.FindContent(matcher.Key);
         if (content == contents.end()) {
             return false;
         }
-        if (!BoostRegexMatch(content->second.data(), content->second.size(), regs[i], exception)) {
-            if (!exception.empty()) {
-                LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
-                if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
-                    GetContext().GetAlarm().SendAlarm(REGEX_MATCH_ALARM,
-                                                      "regex_match in Filter fail:" + exception,
-                                                      GetContext().GetRegion(),
-                                                      GetContext().GetProjectName(),
-                                                      GetContext().GetConfigName(),
-                                                      GetContext().GetLogstoreName());
-                }
+        if (!IsKeyMatched(content->second, matcher, rule)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ProcessorFilterNative::InitKeyMatchers(LogFilterRule& rule, const std::vector<std::string>& regexes) {
+    std::unordered_map<std::string, size_t> matcherIdx;
+    std::vector<std::vector<std::string>> re2Regexes;
+    std::vector<bool> sameMeaning;
+    for (size_t i = 0; i < rule.FilterKeys.size(); ++i) {
+        auto res = matcherIdx.emplace(rule.FilterKeys[i], rule.Matchers.size());
+        if (res.second) {
+            rule.Matchers.emplace_back();
+            rule.Matchers.back().Key = rule.FilterKeys[i];
+            re2Regexes.emplace_back();
+            sameMeaning.push_back(true);
+        }
+        auto& matcher = rule.Matchers[res.first->second];
+        matcher.RuleIndexes.push_back(i);
+        std::string literal = ExtractRegexRequiredLiteral(regexes[i]);
+        if (!literal.empty()) {
+            matcher.RequiredLiterals.push_back(std::move(literal));
+        }
+        std::string re2Regex;
+        if (TranslateBoostRegexToRe2(regexes[i], re2Regex)) {
+            re2Regexes[res.first->second].push_back(std::move(re2Regex));
+        } else {
+            sameMeaning[res.first->second] = false;
+        }
+    }
+    if (!BOOL_FLAG(enable_filter_regex_re2)) {
+        return;
+    }
+
+    re2::RE2::Options options;
+    // match bytes as boost does, so that logs not in utf8 are matched in the same way
+    options.set_encoding(re2::RE2::Options::EncodingLatin1);
+    options.set_dot_nl(true);
+    options.set_log_errors(false);
+    for (size_t i = 0; i < rule.Matchers.size(); ++i) {
+        auto& matcher = rule.Matchers[i];
+        if (!sameMeaning[i]) {
+            LOG_INFO(mContext->GetLogger(),
+                     ("filter regex engine", "boost")("key", matcher.Key)("reason", "different meaning in re2"));
+            continue;
+        }
+        auto set = std::make_shared<re2::RE2::Set>(options, re2::RE2::ANCHOR_BOTH);
+        std::string error;
+        bool ok = true;
+        for (const auto& re2Regex : re2Regexes[i]) {
+            if (set->Add(re2Regex, &error) < 0) {
+                ok = false;
+                break;
             }
+        }
+        if (ok && !set->Compile()) {
+            ok = false;
+            error = "out of memory";
+        }
+        if (!ok) {
+            LOG_INFO(mContext->GetLogger(), ("filter regex engine", "boost")("key", matcher.Key)("reason", error));
+            continue;
+        }
+        matcher.Re2Set = std::move(set);
+        LOG_INFO(mContext->GetLogger(),
+                 ("filter regex engine", "re2")("key", matcher.Key)("regex count", matcher.RuleIndexes.size()));
+    }
+}
+
+bool ProcessorFilterNative::IsKeyMatched(const StringView& value,
+                                         const KeyMatcher& matcher,
+                                         const LogFilterRule& rule) {
+    for (const auto& literal : matcher.RequiredLiterals) {
+#if defined(__linux__)
+        if (memmem(value.data(), value.size(), literal.data(), literal.size()) == nullptr) {
+            return false;
+        }
+#else
+        if (value.find(literal) == StringView::npos) {
+            return false;
+        }
+#endif
+    }
+    if (matcher.Re2Set) {
+        std::vector<int> matched;
+        re2::RE2::Set::ErrorInfo errorInfo;
+        if (matcher.Re2Set->Match(re2::StringPiece(value.data(), value.size()), &matched, &errorInfo)) {
+            return matched.size() == matcher.RuleIndexes.size();
+        }
+        if (errorInfo.kind == re2::RE2::Set::kNoError) {
+            return false;
+        }
+        // the DFA runs out of memory on some values, which are matched by boost instead
+    }
+    for (size_t idx : matcher.RuleIndexes) {
+        if (!IsRuleValueMatched(value, rule.FilterRegs[idx])) {
             return false;
         }
     }
     return true;
 }
 
+bool ProcessorFilterNative::IsRuleValueMatched(const StringView& value, const boost::regex& reg) {
+    std::string exception;
+    if (BoostRegexMatch(value.data(), value.size(), reg, exception)) {
+        return true;
+    }
+    if (!exception.empty()) {
+        LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
+        if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
+            GetContext().GetAlarm().SendAlarm(REGEX_MATCH_ALARM,
+                                              "regex_match in Filter fail:" + exception,
+                                              GetContext().GetRegion(),
+                                              GetContext().GetProjectName(),
+                                              GetContext().GetConfigName(),
+                                              GetContext().GetLogstoreName());
+        }
+    }
+    return false;
+}
+
+void ProcessorFilterNative::ProcessColumnar(PipelineEventGroup& logGroup) {
+    ColumnarLogEvents& columns = *logGroup.GetColumnarLogs();
+    if (columns.Empty()) {
+        return;
+    }
+
+    std::vector<size_t> ruleColumns;
+    if (mFilterMode == Mode::RULE_MODE && mFilterRule) {
+        for (const auto& matcher : mFilterRule->Matchers) {
+            ruleColumns.push_back(columns.FindColumn(matcher.Key));
+        }
+    }
+
+    std::vector<bool> kept(columns.Size(), true);
+    bool hasDiscarded = false;
+    for (size_t row = 0; row < columns.Size(); ++row) {
+        bool res = true;
+        if (mFilterMode == Mode::EXPRESSION_MODE) {
+            res = FilterExpressionRoot(columns, row, mConditionExp);
+        } else if (mFilterMode == Mode::RULE_MODE) {
+            res = FilterFilterRule(columns, row, mFilterRule.get(), ruleColumns);
+        }
+        if (!res) {
+            kept[row] = false;
+            hasDiscarded = true;
+        }
+    }
+    if (hasDiscarded) {
+        columns.FilterRows(kept);
+    }
+    if (mDiscardingNonUTF8) {
+        DiscardNoneUtf8(columns, logGroup);
+    }
+}
+
+bool ProcessorFilterNative::FilterExpressionRoot(const ColumnarLogEvents& columns,
+                                                 size_t row,
+                                                 const BaseFilterNodePtr& node) {
+    if (columns.GetRowContentSize(row) == 0) {
+        return false;
+    }
+    if (node.get() == nullptr) {
+        return true;
+    }
+
+    try {
+        return node->Match(columns, row, GetContext());
+    } catch (...) {
+        LOG_ERROR(GetContext().GetLogger(), ("filter error ", ""));
+        return false;
+    }
+}
+
+bool ProcessorFilterNative::FilterFilterRule(const ColumnarLogEvents& columns,
+                                             size_t row,
+                                             const LogFilterRule* filterRule,
+                                             const std::vector<size_t>& ruleColumns) {
+    if (columns.GetRowContentSize(row) == 0) {
+        return false;
+    }
+    if (filterRule == NULL) {
+        return true;
+    }
+
+    try {
+        for (size_t i = 0; i < ruleColumns.size(); ++i) {
+            size_t col = ruleColumns[i];
+            if (col == ColumnarLogEvents::npos || !columns.HasValue(col, row)) {
+                return false;
+            }
+            if (!IsKeyMatched(columns.GetValue(col, row), filterRule->Matchers[i], *filterRule)) {
+                return false;
+            }
+        }
+        return true;
+    } catch (...) {
+        LOG_ERROR(GetContext().GetLogger(), ("filter error ", ""));
+        return false;
+    }
+}
+
+void ProcessorFilterNative::DiscardNoneUtf8(ColumnarLogEvents& columns, PipelineEventGroup& logGroup) {
+    auto& sourceBuffer = logGroup.GetSourceBuffer();
+    // (column of the non-utf8 key, column of the fixed key)
+    std::vector<std::pair<size_t, size_t>> keyFixes;
+    // iterate over the original columns only, since a fixed key may append a new one
+    size_t colCnt = columns.ColumnSize();
+    for (size_t col = 0; col < colCnt; ++col) {
+        for (size_t row = 0; row < columns.Size(); ++row) {
+            if (!columns.HasValue(col, row) || !CheckNoneUtf8(columns.GetValue(col, row))) {
+                continue;
+            }
+            auto value = columns.GetValue(col, row).to_string();
+            FilterNoneUtf8(value);
+            StringBuffer valueBuffer = sourceBuffer->CopyString(value);
+            columns.SetValue(col, row, StringView(valueBuffer.data, valueBuffer.size));
+        }
+        StringView key = columns.GetColumnKey(col);
+        if (!CheckNoneUtf8(key)) {
+            continue;
+        }
+        auto newKey = key.to_string();
+        FilterNoneUtf8(newKey);
+        StringBuffer keyBuffer = sourceBuffer->CopyString(newKey);
+        keyFixes.emplace_back(col, columns.AddColumn(StringView(keyBuffer.data, keyBuffer.size)));
+    }
+    if (keyFixes.empty()) {
+        return;
+    }
+    // as in the row path, contents with non-utf8 keys are moved to the end of the row in their original order, unless
+    // the fixed key already exists in the row, in which case its value is overwritten in place
+    std::vector<std::pair<uint32_t, size_t>> moved;
+    for (size_t row = 0; row < columns.Size(); ++row) {
+        moved.clear();
+        for (size_t i = 0; i < keyFixes.size(); ++i) {
+            if (columns.HasValue(keyFixes[i].first, row)) {
+                moved.emplace_back(columns.GetValueSeq(keyFixes[i].first, row), i);
+            }
+        }
+        std::sort(moved.begin(), moved.end());
+        for (const auto& item : moved) {
+            const auto& fix = keyFixes[item.second];
+            StringView value = columns.GetValue(fix.first, row);
+            columns.DelValue(fix.first, row);
+            columns.SetValue(fix.second, row, value);
+        }
+    }
+}
+
 static const char UTF8_BYTE_PREFIX = 0x80;
 static const char UTF8_BYTE_MASK = 0xc0;
 
@@ -456,14 +704,40 @@ bool BinaryFilterOperatorNode::Match(const LogEvent& contents, const CollectionP
     return false;
 }
 
+bool BinaryFilterOperatorNode::Match(const ColumnarLogEvents& columns,
+                                     size_t row,
+                                     const CollectionPipelineContext& mContext) {
+    if (BOOST_LIKELY(left && right)) {
+        if (op == AND_OPERATOR) {
+            return left->Match(columns, row, mContext) && right->Match(columns, row, mContext);
+        } else if (op == OR_OPERATOR) {
+            return left->Match(columns, row, mContext) || right->Match(columns, row, mContext);
+        }
+    }
+    return false;
+}
+
 bool RegexFilterValueNode::Match(const LogEvent& contents, const CollectionPipelineContext& mContext) {
     const auto& content = contents.FindContent(key);
     if (content == contents.end()) {
         return false;
     }
+    return MatchValue(content->second, mContext);
+}
+
+bool RegexFilterValueNode::Match(const ColumnarLogEvents& columns,
+                                 size_t row,
+                                 const CollectionPipelineContext& mContext) {
+    size_t col = columns.FindColumn(key);
+    if (col == ColumnarLogEvents::npos || !columns.HasValue(col, row)) {
+        return false;
+    }
+    return MatchValue(columns.GetValue(col, row), mContext);
+}
 
+bool RegexFilterValueNode::MatchValue(const StringView& value, const CollectionPipelineContext& mContext) {
     std::string exception;
-    bool result = BoostRegexMatch(content->second.data(), content->second.size(), reg, exception);
+    bool result = BoostRegexMatch(value.data(), value.size(), reg, exception);
     if (!result && !exception.empty() && AppConfig::GetInstance()->IsLogParseAlarmValid()) {
         LOG_ERROR(mContext.GetLogger(), ("regex_match in Filter fail", exception));
         if (mContext.GetAlarm().IsLowLevelAlarmValid()) {
@@ -485,4 +759,13 @@ bool UnaryFilterOperatorNode::Match(const LogEvent& contents, const CollectionPi
     return false;
 }
 
+bool UnaryFilterOperatorNode::Match(const ColumnarLogEvents& columns,
+                                    size_t row,
+                                    const CollectionPipelineContext& mContext) {
+    if (BOOST_LIKELY(child.get() != NULL)) {
+        return !child->Match(columns, row, mContext);
+    }
+    return false;
+}
+
 } // namespace logtail
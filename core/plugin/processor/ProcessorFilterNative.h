@@ -16,10 +16,16 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "boost/regex.hpp"
+#include "re2/set.h"
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/interface/Processor.h"
+#include "models/ColumnarLogEvents.h"
 #include "models/LogEvent.h"
 
 namespace logtail {
@@ -38,6 +44,9 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext) { return true; }
+    virtual bool Match(const ColumnarLogEvents& columns, size_t row, const CollectionPipelineContext& mContext) {
+        return true;
+    }
 
 public:
     FilterNodeType GetNodeType() const { return nodeType; }
@@ -57,6 +66,7 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual bool Match(const ColumnarLogEvents& columns, size_t row, const CollectionPipelineContext& mContext);
 
 private:
     FilterOperator op;
@@ -74,8 +84,11 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual bool Match(const ColumnarLogEvents& columns, size_t row, const CollectionPipelineContext& mContext);
 
 private:
+    bool MatchValue(const StringView& value, const CollectionPipelineContext& mContext);
+
     std::string key;
     boost::regex reg;
 };
@@ -89,6 +102,7 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual bool Match(const ColumnarLogEvents& columns, size_t row, const CollectionPipelineContext& mContext);
 
 private:
     BaseFilterNodePtr child;
@@ -105,6 +119,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsColumnarSupported() const override { return true; }
+    bool IsParallelSupported() const override { return true; }
 
     // Log field whitelist. The relationship between multiple conditions is "and". Only when all conditions are met, the
     // log will be collected.
@@ -118,9 +134,21 @@ protected:
 private:
     enum class Mode { BYPASS_MODE, EXPRESSION_MODE, RULE_MODE };
 
+    // all rules on the same key, which are matched against the value of the key at once
+    struct KeyMatcher {
+        std::string Key;
+        // indexes of the rules in LogFilterRule
+        std::vector<size_t> RuleIndexes;
+        // substrings required by the rules, values without any of them are rejected before running the regexes
+        std::vector<std::string> RequiredLiterals;
+        // all regexes of the rules, null if any of them cannot be matched by re2 with the same meaning
+        std::shared_ptr<re2::RE2::Set> Re2Set;
+    };
+
     struct LogFilterRule {
         std::vector<std::string> FilterKeys;
         std::vector<boost::regex> FilterRegs;
+        std::vector<KeyMatcher> Matchers;
     };
 
     bool ProcessEvent(PipelineEventPtr& e);
@@ -131,6 +159,18 @@ private:
     // Filter logs through FilterRule
     bool FilterFilterRule(LogEvent& sourceEvent, const LogFilterRule* filterRule);
     bool IsMatched(const LogEvent& contents, const LogFilterRule& rule);
+    bool IsRuleValueMatched(const StringView& value, const boost::regex& reg);
+    void InitKeyMatchers(LogFilterRule& rule, const std::vector<std::string>& regexes);
+    bool IsKeyMatched(const StringView& value, const KeyMatcher& matcher, const LogFilterRule& rule);
+
+    void ProcessColumnar(PipelineEventGroup& logGroup);
+    bool FilterExpressionRoot(const ColumnarLogEvents& columns, size_t row, const BaseFilterNodePtr& node);
+    // ruleColumns holds the column of the key of each matcher, resolved once per group
+    bool FilterFilterRule(const ColumnarLogEvents& columns,
+                          size_t row,
+                          const LogFilterRule* filterRule,
+                          const std::vector<size_t>& ruleColumns);
+    void DiscardNoneUtf8(ColumnarLogEvents& columns, PipelineEventGroup& logGroup);
 
     bool noneUtf8(StringView& strSrc, bool modify);
     bool CheckNoneUtf8(const StringView& strSrc);
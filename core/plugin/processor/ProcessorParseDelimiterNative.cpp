@@ -17,10 +17,16 @@
 #include "plugin/processor/ProcessorParseDelimiterNative.h"
 
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/Flags.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+// columns are the same as those split by DelimiterModeFsmParser and std::search, which are used otherwise
+DEFINE_FLAG_BOOL(enable_delimiter_simd_parser,
+                 "find separators and quotes of delimiter logs with simd bitmasks rather than char by char",
+                 true);
+
 namespace logtail {
 
 const std::string ProcessorParseDelimiterNative::sName = "processor_parse_delimiter_native";
@@ -107,6 +113,7 @@ bool ProcessorParseDelimiterNative::Init(const Json::Value& config) {
     }
 
     mDelimiterModeFsmParserPtr.reset(new DelimiterModeFsmParser(mQuote, mSeparatorChar));
+    mDelimiterModeSimdParserPtr.reset(new DelimiterModeSimdParser(mQuote, mSeparator));
 
     // Keys
     if (!GetMandatoryListParam(config, "Keys", mKeys, errorMsg)) {
@@ -244,16 +251,19 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
     size_t reserveSize
         = mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND ? (mKeys.size() + 10) : (mKeys.size() + 1);
     std::vector<StringView> columnValues;
-    std::vector<size_t> colBegIdxs;
-    std::vector<size_t> colLens;
     bool parseSuccess = false;
     size_t parsedColCount = 0;
     bool useQuote = (mSeparator.size() == 1) && (mQuote != mSeparatorChar);
     if (mKeys.size() > 0) {
+        columnValues.reserve(reserveSize);
         if (useQuote) {
-            columnValues.reserve(reserveSize);
-            parseSuccess
-                = mDelimiterModeFsmParserPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
+            if (BOOL_FLAG(enable_delimiter_simd_parser)) {
+                parseSuccess = mDelimiterModeSimdParserPtr->ParseDelimiterLine(
+                    buffer.substr(begIdx, endIdx - begIdx), columnValues, *sourceEvent.GetSourceBuffer());
+            } else {
+                parseSuccess
+                    = mDelimiterModeFsmParserPtr->ParseDelimiterLine(buffer, begIdx, endIdx, columnValues, sourceEvent);
+            }
             // handle auto extend
             if (!(mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND)
                 && columnValues.size() > mKeys.size()) {
@@ -273,13 +283,10 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
                 columnValues.resize(mKeys.size());
                 columnValues.push_back(StringView(sb.data, requiredLen));
             }
-            parsedColCount = columnValues.size();
         } else {
-            colBegIdxs.reserve(reserveSize);
-            colLens.reserve(reserveSize);
-            parseSuccess = SplitString(buffer.data(), begIdx, endIdx, colBegIdxs, colLens);
-            parsedColCount = colBegIdxs.size();
+            parseSuccess = SplitString(buffer, begIdx, endIdx, columnValues);
         }
+        parsedColCount = columnValues.size();
 
         if (parseSuccess) {
             if (parsedColCount <= 0 || (!mAllowingShortenedFields && parsedColCount < mKeys.size())) {
@@ -328,18 +335,14 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
                 if (mExtractingPartialFields && mKeys[idx] == s_mDiscardedFieldKey) {
                     continue;
                 }
-                AddLog(mKeys[idx],
-                       useQuote ? columnValues[idx] : StringView(buffer.data() + colBegIdxs[idx], colLens[idx]),
-                       sourceEvent);
+                AddLog(mKeys[idx], columnValues[idx], sourceEvent);
             } else {
                 if (mExtractingPartialFields) {
                     continue;
                 }
                 std::string key = "__column" + ToString(idx) + "__";
                 StringBuffer sb = sourceEvent.GetSourceBuffer()->CopyString(key);
-                AddLog(StringView(sb.data, sb.size),
-                       useQuote ? columnValues[idx] : StringView(buffer.data() + colBegIdxs[idx], colLens[idx]),
-                       sourceEvent);
+                AddLog(StringView(sb.data, sb.size), columnValues[idx], sourceEvent);
             }
         }
         ADD_COUNTER(mOutSuccessfulEventsTotal, 1);
@@ -363,47 +366,48 @@ bool ProcessorParseDelimiterNative::ProcessEvent(const StringView& logPath,
     return true;
 }
 
-bool ProcessorParseDelimiterNative::SplitString(
-    const char* buffer, int32_t begIdx, int32_t endIdx, std::vector<size_t>& colBegIdxs, std::vector<size_t>& colLens) {
+bool ProcessorParseDelimiterNative::SplitString(StringView buffer,
+                                                int32_t begIdx,
+                                                int32_t endIdx,
+                                                std::vector<StringView>& columnValues) {
     if (endIdx <= begIdx || mSeparator.size() == 0 || mKeys.size() == 0)
         return false;
+    if (BOOL_FLAG(enable_delimiter_simd_parser)) {
+        mDelimiterModeSimdParserPtr->SplitLine(
+            buffer.substr(begIdx, endIdx - begIdx),
+            mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND ? 0 : mKeys.size(),
+            columnValues);
+        return true;
+    }
+    const char* data = buffer.data();
     size_t size = endIdx - begIdx;
     size_t d_size = mSeparator.size();
     if (d_size == 0 || d_size > size) {
-        colBegIdxs.push_back(begIdx);
-        colLens.push_back(size);
+        columnValues.emplace_back(data + begIdx, size);
         return true;
     }
     size_t pos = begIdx;
     size_t top = endIdx - d_size;
     while (pos <= top) {
-        const char* pch = std::search(buffer + pos, buffer + endIdx, mSeparator.begin(), mSeparator.end());
+        const char* pch = std::search(data + pos, data + endIdx, mSeparator.begin(), mSeparator.end());
         size_t pos2;
         // if not found, pos2 = endIdx
-        if (pch == buffer + endIdx) {
+        if (pch == data + endIdx) {
             pos2 = endIdx;
         } else {
-            pos2 = pch - buffer;
-        }
-        if (pos2 != pos) {
-            colBegIdxs.push_back(pos);
-            colLens.push_back(pos2 - pos);
-        } else {
-            colBegIdxs.push_back(pos);
-            colLens.push_back(0);
+            pos2 = pch - data;
         }
+        columnValues.emplace_back(data + pos, pos2 - pos);
         if (pos2 == (size_t)endIdx)
             return true;
         pos = pos2 + d_size;
-        if (colLens.size() >= mKeys.size() && !(mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND)) {
-            colBegIdxs.push_back(pos2);
-            colLens.push_back(endIdx - pos2);
+        if (columnValues.size() >= mKeys.size() && !(mOverflowedFieldsTreatment == OverflowedFieldsTreatment::EXTEND)) {
+            columnValues.emplace_back(data + pos2, endIdx - pos2);
             return true;
         }
     }
     if (pos <= (size_t)endIdx) {
-        colBegIdxs.push_back(pos);
-        colLens.push_back(endIdx - pos);
+        columnValues.emplace_back(data + pos, endIdx - pos);
     }
     return true;
 }
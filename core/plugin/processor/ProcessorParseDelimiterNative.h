@@ -21,6 +21,7 @@
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
 #include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterModeSimdParser.h"
 #include "plugin/processor/CommonParserOptions.h"
 
 namespace logtail {
@@ -34,6 +35,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelSupported() const override { return true; }
 
     // Required: source field name.
     std::string mSourceKey;
@@ -63,16 +65,13 @@ private:
     static const std::string s_mDiscardedFieldKey;
 
     bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e, const GroupMetadata& metadata);
-    bool SplitString(const char* buffer,
-                     int32_t begIdx,
-                     int32_t endIdx,
-                     std::vector<size_t>& colBegIdxs,
-                     std::vector<size_t>& colLens);
+    bool SplitString(StringView buffer, int32_t begIdx, int32_t endIdx, std::vector<StringView>& columnValues);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
 
     char mSeparatorChar;
     bool mSourceKeyOverwritten = false;
     std::unique_ptr<DelimiterModeFsmParser> mDelimiterModeFsmParserPtr;
+    std::unique_ptr<DelimiterModeSimdParser> mDelimiterModeSimdParserPtr;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
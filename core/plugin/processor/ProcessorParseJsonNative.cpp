@@ -21,10 +21,17 @@
 #include "rapidjson/writer.h"
 
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/Flags.h"
+#include "common/OnDemandJsonParser.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+// members are the same as those parsed by rapidjson, which is still used for objects not supported on demand
+DEFINE_FLAG_BOOL(enable_parse_json_on_demand,
+                 "split json objects into views of the log without building documents if possible",
+                 true);
+
 namespace logtail {
 
 static std::string RapidjsonValueToString(const rapidjson::Value& value) {
@@ -83,6 +90,10 @@ bool ProcessorParseJsonNative::Init(const Json::Value& config) {
 }
 
 void ProcessorParseJsonNative::Process(PipelineEventGroup& logGroup) {
+    if (logGroup.IsColumnar()) {
+        ProcessColumnar(logGroup);
+        return;
+    }
     if (logGroup.GetEvents().empty()) {
         return;
     }
@@ -137,15 +148,22 @@ bool ProcessorParseJsonNative::ProcessEvent(const StringView& logPath,
     return true;
 }
 
-bool ProcessorParseJsonNative::JsonLogLineParser(LogEvent& sourceEvent,
-                                                 const StringView& logPath,
-                                                 PipelineEventPtr& e,
-                                                 bool& sourceKeyOverwritten) {
-    StringView buffer = sourceEvent.GetContent(mSourceKey);
-
+template <class F>
+bool ProcessorParseJsonNative::ParseJsonObject(StringView buffer,
+                                               SourceBuffer& sourceBuffer,
+                                               const StringView& logPath,
+                                               F&& onMember) {
     if (buffer.empty())
         return false;
 
+    if (BOOL_FLAG(enable_parse_json_on_demand)) {
+        static thread_local OnDemandJsonParser sParser;
+        if (sParser.Parse(buffer)) {
+            sParser.ForEachMember(sourceBuffer, onMember);
+            return true;
+        }
+    }
+
     bool parseSuccess = true;
     rapidjson::Document doc;
     doc.Parse(buffer.data(), buffer.size());
@@ -184,21 +202,94 @@ bool ProcessorParseJsonNative::JsonLogLineParser(LogEvent& sourceEvent,
     }
 
     for (rapidjson::Value::ConstMemberIterator itr = doc.MemberBegin(); itr != doc.MemberEnd(); ++itr) {
-        std::string contentKey = RapidjsonValueToString(itr->name);
-        std::string contentValue = RapidjsonValueToString(itr->value);
+        StringBuffer keyBuffer = sourceBuffer.CopyString(itr->name.GetString(), itr->name.GetStringLength());
+        StringBuffer valueBuffer = sourceBuffer.CopyString(RapidjsonValueToString(itr->value));
+        onMember(StringView(keyBuffer.data, keyBuffer.size), StringView(valueBuffer.data, valueBuffer.size));
+    }
+    return true;
+}
+
+bool ProcessorParseJsonNative::JsonLogLineParser(LogEvent& sourceEvent,
+                                                 const StringView& logPath,
+                                                 PipelineEventPtr& e,
+                                                 bool& sourceKeyOverwritten) {
+    return ParseJsonObject(sourceEvent.GetContent(mSourceKey),
+                           *sourceEvent.GetSourceBuffer(),
+                           logPath,
+                           [&](StringView contentKey, StringView contentValue) {
+                               if (contentKey == mSourceKey) {
+                                   sourceKeyOverwritten = true;
+                               }
+                               AddLog(contentKey, contentValue, sourceEvent);
+                           });
+}
 
-        StringBuffer contentKeyBuffer = sourceEvent.GetSourceBuffer()->CopyString(contentKey);
-        StringBuffer contentValueBuffer = sourceEvent.GetSourceBuffer()->CopyString(contentValue);
+void ProcessorParseJsonNative::ProcessColumnar(PipelineEventGroup& logGroup) {
+    ColumnarLogEvents& columns = *logGroup.GetColumnarLogs();
+    if (columns.Empty()) {
+        return;
+    }
+    size_t sourceCol = columns.FindColumn(mSourceKey);
+    if (sourceCol == ColumnarLogEvents::npos) {
+        ADD_COUNTER(mOutKeyNotFoundEventsTotal, columns.Size());
+        return;
+    }
+    const StringView& logPath = logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
+    auto& sourceBuffer = logGroup.GetSourceBuffer();
 
-        if (contentKey.c_str() == mSourceKey) {
-            sourceKeyOverwritten = true;
+    std::vector<bool> kept(columns.Size(), true);
+    bool hasDiscarded = false;
+    // column of the i-th member in the last row, json logs of one group mostly share the same keys in the same order
+    std::vector<size_t> memberCols;
+    for (size_t row = 0; row < columns.Size(); ++row) {
+        if (!columns.HasValue(sourceCol, row)) {
+            ADD_COUNTER(mOutKeyNotFoundEventsTotal, 1);
+            continue;
         }
+        StringView rawContent = columns.GetValue(sourceCol, row);
+
+        bool sourceKeyOverwritten = false;
+        size_t memberIdx = 0;
+        bool parseSuccess
+            = ParseJsonObject(rawContent, *sourceBuffer, logPath, [&](StringView contentKey, StringView contentValue) {
+                  if (memberIdx == memberCols.size()) {
+                      memberCols.push_back(columns.AddColumn(contentKey));
+                  } else if (columns.GetColumnKey(memberCols[memberIdx]) != contentKey) {
+                      memberCols[memberIdx] = columns.AddColumn(contentKey);
+                  }
+                  size_t col = memberCols[memberIdx++];
+                  if (col == sourceCol) {
+                      sourceKeyOverwritten = true;
+                  }
+                  columns.SetValue(col, row, contentValue);
+              });
 
-        AddLog(StringView(contentKeyBuffer.data, contentKeyBuffer.size),
-               StringView(contentValueBuffer.data, contentValueBuffer.size),
-               sourceEvent);
+        if (!parseSuccess || !sourceKeyOverwritten) {
+            columns.DelValue(sourceCol, row);
+        }
+        if (mCommonParserOptions.ShouldAddSourceContent(parseSuccess)) {
+            size_t col = columns.AddColumn(mCommonParserOptions.mRenamedSourceKey);
+            if (!columns.HasValue(col, row)) {
+                columns.SetValue(col, row, rawContent);
+            }
+        }
+        if (mCommonParserOptions.ShouldAddLegacyUnmatchedRawLog(parseSuccess)) {
+            size_t col = columns.AddColumn(mCommonParserOptions.legacyUnmatchedRawLogKey);
+            if (!columns.HasValue(col, row)) {
+                columns.SetValue(col, row, rawContent);
+            }
+        }
+        if (mCommonParserOptions.ShouldEraseEvent(parseSuccess, columns, row, logGroup.GetAllMetadata())) {
+            ADD_COUNTER(mDiscardedEventsTotal, 1);
+            kept[row] = false;
+            hasDiscarded = true;
+            continue;
+        }
+        ADD_COUNTER(mOutSuccessfulEventsTotal, 1);
+    }
+    if (hasDiscarded) {
+        columns.FilterRows(kept);
     }
-    return true;
 }
 
 void ProcessorParseJsonNative::AddLog(const StringView& key,
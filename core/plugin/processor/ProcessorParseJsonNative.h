@@ -28,6 +28,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsColumnarSupported() const override { return true; }
+    bool IsParallelSupported() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -43,6 +45,11 @@ private:
                            bool& sourceKeyOverwritten);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
     bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e, const GroupMetadata& metadata);
+    void ProcessColumnar(PipelineEventGroup& logGroup);
+    // parse buffer as a json object and call onMember(key, value) for each member, alarms are reported on failure. The
+    // views passed to onMember point to buffer or to memory allocated from sourceBuffer.
+    template <class F>
+    bool ParseJsonObject(StringView buffer, SourceBuffer& sourceBuffer, const StringView& logPath, F&& onMember);
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -17,9 +17,16 @@
 #include "plugin/processor/ProcessorParseRegexNative.h"
 
 #include "app_config/AppConfig.h"
+#include "common/Flags.h"
 #include "common/ParamExtractor.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+// re2 rejects unmatched logs in linear time and never backtracks exponentially, but extracts groups slower than boost
+// from logs that match, so it is only worthwhile when many logs do not match or the regex backtracks a lot
+DEFINE_FLAG_BOOL(enable_parse_regex_re2,
+                 "parse with re2 instead of boost if the regex can be compiled by re2 with the same meaning",
+                 false);
+
 namespace logtail {
 
 const std::string ProcessorParseRegexNative::sName = "processor_parse_regex_native";
@@ -59,8 +66,35 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
                            mContext->GetLogstoreName(),
                            mContext->GetRegion());
     }
-    mReg = boost::regex(mRegex);
     mIsWholeLineMode = mRegex == "(.*)";
+    if (!mIsWholeLineMode) {
+        std::string re2Regex, reason = "re2 is disabled";
+        if (BOOL_FLAG(enable_parse_regex_re2)) {
+            if (TranslateBoostRegexToRe2(mRegex, re2Regex)) {
+                re2::RE2::Options options;
+                // match bytes as boost does, so that logs not in utf8 are matched in the same way
+                options.set_encoding(re2::RE2::Options::EncodingLatin1);
+                options.set_dot_nl(true);
+                options.set_log_errors(false);
+                mRe2.reset(new re2::RE2(re2Regex, options));
+                if (!mRe2->ok()) {
+                    reason = mRe2->error();
+                    mRe2.reset();
+                }
+            } else {
+                reason = "regex features interpreted differently by re2 are used";
+            }
+        }
+        if (mRe2) {
+            LOG_INFO(mContext->GetLogger(),
+                     ("regex engine", "re2")("regex", mRegex)("config", mContext->GetConfigName()));
+        } else {
+            mReg = boost::regex(mRegex);
+            LOG_INFO(mContext->GetLogger(),
+                     ("regex engine", "boost")("reason", reason)("regex", mRegex)("config",
+                                                                                  mContext->GetConfigName()));
+        }
+    }
 
     // Keys
     if (!GetMandatoryListParam(config, "Keys", mKeys, errorMsg)) {
@@ -101,15 +135,20 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
 }
 
 void ProcessorParseRegexNative::Process(PipelineEventGroup& logGroup) {
+    if (logGroup.IsColumnar()) {
+        ProcessColumnar(logGroup);
+        return;
+    }
     if (logGroup.GetEvents().empty()) {
         return;
     }
     const StringView& logPath = logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
     EventsContainer& events = logGroup.MutableEvents();
 
+    MatchResult result;
     size_t wIdx = 0;
     for (size_t rIdx = 0; rIdx < events.size(); ++rIdx) {
-        if (ProcessEvent(logPath, events[rIdx], logGroup.GetAllMetadata())) {
+        if (ProcessEvent(logPath, events[rIdx], logGroup.GetAllMetadata(), result)) {
             if (wIdx != rIdx) {
                 events[wIdx] = std::move(events[rIdx]);
             }
@@ -120,13 +159,86 @@ void ProcessorParseRegexNative::Process(PipelineEventGroup& logGroup) {
     return;
 }
 
+void ProcessorParseRegexNative::ProcessColumnar(PipelineEventGroup& logGroup) {
+    ColumnarLogEvents& columns = *logGroup.GetColumnarLogs();
+    if (columns.Empty()) {
+        return;
+    }
+    size_t sourceCol = columns.FindColumn(mSourceKey);
+    if (sourceCol == ColumnarLogEvents::npos) {
+        ADD_COUNTER(mOutKeyNotFoundEventsTotal, columns.Size());
+        return;
+    }
+    const StringView& logPath = logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED);
+
+    // columns of extracted keys are resolved once for the whole group
+    std::vector<size_t> keyCols;
+    if (mIsWholeLineMode) {
+        keyCols.push_back(columns.AddColumn(mKeys.empty() ? StringView(DEFAULT_CONTENT_KEY) : StringView(mKeys[0])));
+    } else {
+        keyCols.reserve(mKeys.size());
+        for (const auto& key : mKeys) {
+            keyCols.push_back(columns.AddColumn(key));
+        }
+    }
+
+    MatchResult result;
+    std::vector<bool> kept(columns.Size(), true);
+    bool hasDiscarded = false;
+    for (size_t row = 0; row < columns.Size(); ++row) {
+        if (!columns.HasValue(sourceCol, row)) {
+            ADD_COUNTER(mOutKeyNotFoundEventsTotal, 1);
+            continue;
+        }
+        StringView rawContent = columns.GetValue(sourceCol, row);
+        bool parseSuccess = true;
+        if (mIsWholeLineMode) {
+            columns.SetValue(keyCols[0], row, rawContent);
+        } else {
+            parseSuccess = RegexMatch(rawContent, mKeys, logPath, result);
+            if (parseSuccess) {
+                for (size_t i = 0; i < keyCols.size(); ++i) {
+                    columns.SetValue(keyCols[i], row, GetGroup(result, i + 1));
+                }
+            }
+        }
+
+        if (!parseSuccess || !mSourceKeyOverwritten) {
+            columns.DelValue(sourceCol, row);
+        }
+        if (mCommonParserOptions.ShouldAddSourceContent(parseSuccess)) {
+            size_t col = columns.AddColumn(mCommonParserOptions.mRenamedSourceKey);
+            if (!columns.HasValue(col, row)) {
+                columns.SetValue(col, row, rawContent);
+            }
+        }
+        if (mCommonParserOptions.ShouldAddLegacyUnmatchedRawLog(parseSuccess)) {
+            size_t col = columns.AddColumn(mCommonParserOptions.legacyUnmatchedRawLogKey);
+            if (!columns.HasValue(col, row)) {
+                columns.SetValue(col, row, rawContent);
+            }
+        }
+        if (mCommonParserOptions.ShouldEraseEvent(parseSuccess, columns, row, logGroup.GetAllMetadata())) {
+            ADD_COUNTER(mDiscardedEventsTotal, 1);
+            kept[row] = false;
+            hasDiscarded = true;
+            continue;
+        }
+        ADD_COUNTER(mOutSuccessfulEventsTotal, 1);
+    }
+    if (hasDiscarded) {
+        columns.FilterRows(kept);
+    }
+}
+
 bool ProcessorParseRegexNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
 
 bool ProcessorParseRegexNative::ProcessEvent(const StringView& logPath,
                                              PipelineEventPtr& e,
-                                             const GroupMetadata& metadata) {
+                                             const GroupMetadata& metadata,
+                                             MatchResult& result) {
     if (!IsSupportedEvent(e)) {
         ADD_COUNTER(mOutFailedEventsTotal, 1);
         return true;
@@ -142,7 +254,7 @@ bool ProcessorParseRegexNative::ProcessEvent(const StringView& logPath,
     if (mIsWholeLineMode) {
         parseSuccess = WholeLineModeParser(sourceEvent, mKeys.empty() ? DEFAULT_CONTENT_KEY : mKeys[0]);
     } else {
-        parseSuccess = RegexLogLineParser(sourceEvent, mReg, mKeys, logPath);
+        parseSuccess = RegexLogLineParser(sourceEvent, mKeys, logPath, result);
     }
 
     if (!parseSuccess || !mSourceKeyOverwritten) {
@@ -179,14 +291,43 @@ void ProcessorParseRegexNative::AddLog(const StringView& key,
 }
 
 bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
-                                                   const boost::regex& reg,
                                                    const std::vector<std::string>& keys,
-                                                   const StringView& logPath) {
-    boost::match_results<const char*> what;
+                                                   const StringView& logPath,
+                                                   MatchResult& result) {
+    if (!RegexMatch(sourceEvent.GetContent(mSourceKey), keys, logPath, result)) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < keys.size(); i++) {
+        AddLog(keys[i], GetGroup(result, i + 1), sourceEvent);
+    }
+    return true;
+}
+
+bool ProcessorParseRegexNative::RegexMatch(StringView buffer,
+                                           const std::vector<std::string>& keys,
+                                           const StringView& logPath,
+                                           MatchResult& result) {
     std::string exception;
-    StringView buffer = sourceEvent.GetContent(mSourceKey);
     bool parseSuccess = true;
-    if (!BoostRegexMatch(buffer.data(), buffer.size(), reg, exception, what, boost::match_default)) {
+    bool matched = false;
+    size_t groupCnt = 0;
+    if (mRe2) {
+        groupCnt = mRe2->NumberOfCapturingGroups() + 1;
+        // groups not needed by keys are not extracted, which saves the work of re2
+        result.re2Groups.resize(std::min(groupCnt, keys.size() + 1));
+        matched = mRe2->Match(re2::StringPiece(buffer.data(), buffer.size()),
+                              0,
+                              buffer.size(),
+                              re2::RE2::ANCHOR_BOTH,
+                              result.re2Groups.data(),
+                              result.re2Groups.size());
+    } else {
+        matched = BoostRegexMatch(
+            buffer.data(), buffer.size(), mReg, exception, result.boostGroups, boost::match_default);
+        groupCnt = result.boostGroups.size();
+    }
+    if (!matched) {
         if (!exception.empty()) {
             if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -219,16 +360,16 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
         }
         ADD_COUNTER(mOutFailedEventsTotal, 1);
         parseSuccess = false;
-    } else if (what.size() <= keys.size()) {
+    } else if (groupCnt <= keys.size()) {
         if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
             if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
                 LOG_WARNING(GetContext().GetLogger(),
                             ("parse key count not match",
-                             what.size())("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
+                             groupCnt)("parse regex log fail", buffer)("project", GetContext().GetProjectName())(
                                 "logstore", GetContext().GetLogstoreName())("file", logPath));
             }
             GetContext().GetAlarm().SendAlarm(REGEX_MATCH_ALARM,
-                                              "parse key count not match" + ToString(what.size())
+                                              "parse key count not match" + ToString(groupCnt)
                                                   + "errorlog:" + buffer.to_string(),
                                               GetContext().GetRegion(),
                                               GetContext().GetProjectName(),
@@ -237,14 +378,16 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
         }
         parseSuccess = false;
     }
-    if (!parseSuccess) {
-        return false;
-    }
+    return parseSuccess;
+}
 
-    for (uint32_t i = 0; i < keys.size(); i++) {
-        AddLog(keys[i], StringView(what[i + 1].begin(), what[i + 1].length()), sourceEvent);
+StringView ProcessorParseRegexNative::GetGroup(const MatchResult& result, size_t i) const {
+    if (mRe2) {
+        // groups not participating in the match are null
+        const re2::StringPiece& group = result.re2Groups[i];
+        return group.data() == nullptr ? StringView() : StringView(group.data(), group.size());
     }
-    return true;
+    return StringView(result.boostGroups[i].begin(), result.boostGroups[i].length());
 }
 
 } // namespace logtail
@@ -16,9 +16,11 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "boost/regex.hpp"
+#include "re2/re2.h"
 
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
@@ -33,6 +35,8 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsColumnarSupported() const override { return true; }
+    bool IsParallelSupported() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -46,18 +50,37 @@ protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
+    // groups of the last match of either engine, reused for the events of a group
+    struct MatchResult {
+        boost::match_results<const char*> boostGroups;
+        std::vector<re2::StringPiece> re2Groups;
+    };
+
     /// @return false if data need to be discarded
-    bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e, const GroupMetadata& metadata);
+    bool ProcessEvent(const StringView& logPath,
+                      PipelineEventPtr& e,
+                      const GroupMetadata& metadata,
+                      MatchResult& result);
     bool WholeLineModeParser(LogEvent& sourceEvent, const std::string& key);
     bool RegexLogLineParser(LogEvent& sourceEvent,
-                            const boost::regex& reg,
                             const std::vector<std::string>& keys,
-                            const StringView& logPath);
+                            const StringView& logPath,
+                            MatchResult& result);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
+    void ProcessColumnar(PipelineEventGroup& logGroup);
+    // match buffer against the regex and report alarms on failure
+    bool RegexMatch(StringView buffer,
+                    const std::vector<std::string>& keys,
+                    const StringView& logPath,
+                    MatchResult& result);
+    // the i-th group of a successful match, 0 for the whole match
+    StringView GetGroup(const MatchResult& result, size_t i) const;
 
     bool mSourceKeyOverwritten = false;
     bool mIsWholeLineMode = false;
     boost::regex mReg;
+    // re2 never backtracks, and is used if the regex can be compiled by it with the same meaning as boost
+    std::unique_ptr<re2::RE2> mRe2;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
@@ -18,10 +18,15 @@
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/Flags.h"
 #include "common/LogtailCommonFlags.h"
 #include "common/ParamExtractor.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
+DEFINE_FLAG_BOOL(enable_compiled_time_format,
+                 "parse log time with the source format compiled at init instead of interpreting it for each log",
+                 true);
+
 namespace logtail {
 
 const std::string ProcessorParseTimestampNative::sName = "processor_parse_timestamp_native";
@@ -87,6 +92,16 @@ bool ProcessorParseTimestampNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    // Second-level cache only work when:
+    // 1. No %f in the time format
+    // 2. The %f is at the end of the time format
+    size_t nanosecondPos = mSourceFormat.find("%f");
+    mHaveNanosecond = nanosecondPos != std::string::npos;
+    mEndWithNanosecond = mHaveNanosecond && nanosecondPos + 2 == mSourceFormat.size();
+    if (BOOL_FLAG(enable_compiled_time_format)) {
+        mCompiledFormat.Compile(mSourceFormat, mSourceYear);
+    }
+
     mDiscardedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_DISCARDED_EVENTS_TOTAL);
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
     mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
@@ -182,24 +197,23 @@ bool ProcessorParseTimestampNative::ParseLogTime(const StringView& curTimeStr, /
                                                  uint64_t& preciseTimestamp,
                                                  StringView& timeStrCache // cache
 ) {
-    // Second-level cache only work when:
-    // 1. No %f in the time format
-    // 2. The %f is at the end of the time format
-    const char* compareResult = strstr(mSourceFormat.c_str(), "%f");
-    bool haveNanosecond = compareResult != nullptr;
-    bool endWithNanosecond = compareResult == (mSourceFormat.c_str() + mSourceFormat.size() - 2);
     int nanosecondLength = -1;
     const char* strptimeResult = NULL;
-    if ((!haveNanosecond || endWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
+    if ((!mHaveNanosecond || mEndWithNanosecond) && IsPrefixString(curTimeStr, timeStrCache)) {
         bool isTimestampNanosecond = (mSourceFormat == "%s") && (curTimeStr.length() > timeStrCache.length());
-        if (endWithNanosecond || isTimestampNanosecond) {
+        if (mEndWithNanosecond || isTimestampNanosecond) {
             strptimeResult = Strptime(curTimeStr.data() + timeStrCache.length(), "%f", &logTime, nanosecondLength);
         } else {
             strptimeResult = curTimeStr.data() + timeStrCache.length();
             logTime.tv_nsec = 0;
         }
     } else {
-        strptimeResult = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        if (mCompiledFormat.IsCompiled()) {
+            strptimeResult = mCompiledFormat.Parse(curTimeStr.data(), &logTime, nanosecondLength);
+        } else {
+            strptimeResult
+                = Strptime(curTimeStr.data(), mSourceFormat.c_str(), &logTime, nanosecondLength, mSourceYear);
+        }
         if (NULL != strptimeResult) {
             timeStrCache = curTimeStr.substr(0, curTimeStr.length() - nanosecondLength);
             logTime.tv_sec = logTime.tv_sec - mLogTimeZoneOffsetSecond;
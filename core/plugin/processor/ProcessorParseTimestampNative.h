@@ -17,6 +17,7 @@
 #pragma once
 
 #include "collection_pipeline/plugin/interface/Processor.h"
+#include "common/CompiledTimeFormat.h"
 #include "common/TimeUtil.h"
 
 namespace logtail {
@@ -27,6 +28,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool IsParallelSupported() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -52,6 +54,10 @@ private:
     bool IsPrefixString(const StringView& all, const StringView& prefix);
 
     int32_t mLogTimeZoneOffsetSecond = 0;
+    // SourceFormat compiled at Init, Strptime is used if it is not supported
+    CompiledTimeFormat mCompiledFormat;
+    bool mHaveNanosecond = false;
+    bool mEndWithNanosecond = false;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
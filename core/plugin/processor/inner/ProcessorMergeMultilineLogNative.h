@@ -50,6 +50,11 @@ private:
 
     void MergeEvents(std::vector<LogEvent*>& logEvents, bool insertLineBreak = true);
 
+    // the line is checked by the prefix filter of the pattern before the regex
+    bool IsStartPatternMatched(const StringView& line, std::string& exception) const;
+    bool IsContinuePatternMatched(const StringView& line, std::string& exception) const;
+    bool IsEndPatternMatched(const StringView& line, std::string& exception) const;
+
     CounterPtr mMergedEventsTotal; // 成功合并了多少条日志
     // CounterPtr mProcMergedEventsBytes; // 成功合并了多少字节的日志
     CounterPtr mUnmatchedEventsTotal; // 未成功合并的日志条数
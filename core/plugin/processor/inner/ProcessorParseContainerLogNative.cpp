@@ -16,7 +16,14 @@
 
 #include "plugin/processor/inner/ProcessorParseContainerLogNative.h"
 
-#include <codecvt>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#include "rapidjson/document.h"
 
 #include "common/JsonUtil.h"
 #include "common/ParamExtractor.h"
@@ -361,81 +368,167 @@ static int32_t parseLogType(char* buffer, int32_t idx, int32_t size, DockerLogTy
     return idx;
 }
 
-// windows can't instantiation with char32_t.
+static inline uint32_t countTrailingZeros(uint32_t mask) {
 #if defined(_MSC_VER)
-std::wstring_convert<std::codecvt_utf8<unsigned long>, unsigned long> convert;
+    unsigned long idx = 0;
+    _BitScanForward(&idx, mask);
+    return static_cast<uint32_t>(idx);
 #else
-std::wstring_convert<std::codecvt_utf8<char32_t>, char32_t> convert;
+    return static_cast<uint32_t>(__builtin_ctz(mask));
 #endif
+}
 
-static int32_t parseValue(char* buffer, int32_t idx, int32_t size, DockerLogType logType, int32_t& endIndex) {
-    while (idx < size && buffer[idx] != '\"') {
-        if (buffer[idx] == '\\') {
-            if (logType != DockerLogType::Log) {
-                return -1;
-            }
-            ++idx; // skip escape char
-            if (idx >= size) {
-                return -1;
-            }
-            switch (buffer[idx]) {
-                case '\"':
-                    buffer[endIndex++] = '\"';
-                    break;
-                case '\\':
-                    buffer[endIndex++] = '\\';
-                    break;
-                case '/':
-                    buffer[endIndex++] = '/';
-                    break;
-                case 'b':
-                    buffer[endIndex++] = '\b';
-                    break;
-                case 'f':
-                    buffer[endIndex++] = '\f';
-                    break;
-                case 'n':
-                    buffer[endIndex++] = '\n';
-                    break;
-                case 'r':
-                    buffer[endIndex++] = '\r';
-                    break;
-                case 't':
-                    buffer[endIndex++] = '\t';
-                    break;
-                default:
-                    if (idx + 4 < size && buffer[idx] == 'u') {
-                        std::string unicode_seq;
-                        unicode_seq.append(buffer + idx + 1, 4);
-                        unsigned long unicode_char = std::stoul(unicode_seq, nullptr, 16);
-                        std::string res = convert.to_bytes(unicode_char);
-                        for (size_t i = 0; i < res.size(); ++i) {
-                            buffer[endIndex++] = res[i];
-                        }
-                        idx += 4;
-                    } else {
-                        buffer[endIndex++] = '\\';
-                        buffer[endIndex++] = buffer[idx];
-                    }
-                    break;
-            }
-        } else {
-            buffer[endIndex++] = buffer[idx];
+// index of the first quote or backslash in [idx, size), or size if there is none
+static int32_t findQuoteOrBackslash(const char* buffer, int32_t idx, int32_t size) {
+#if defined(__x86_64__) || defined(_M_X64)
+    const __m128i quote = _mm_set1_epi8('\"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + idx));
+        uint32_t mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash))));
+        if (mask != 0) {
+            return idx + countTrailingZeros(mask);
         }
+    }
+#endif
+    while (idx < size && buffer[idx] != '\"' && buffer[idx] != '\\') {
         ++idx;
     }
     return idx;
 }
 
+// finds the closing quote of the value without modifying the buffer, only log is allowed to have escapes
+static int32_t scanValue(const char* buffer, int32_t idx, int32_t size, DockerLogType logType, bool& escaped) {
+    while (true) {
+        idx = findQuoteOrBackslash(buffer, idx, size);
+        if (idx >= size || buffer[idx] == '\"') {
+            return idx;
+        }
+        if (logType != DockerLogType::Log) {
+            return -1;
+        }
+        escaped = true;
+        idx += 2; // skip escape char
+        if (idx > size) {
+            return -1;
+        }
+    }
+}
+
+static inline bool parseHex4(const char* p, uint32_t& code) {
+    code = 0;
+    for (int i = 0; i < 4; ++i) {
+        char c = p[i];
+        uint32_t digit = 0;
+        if (c >= '0' && c <= '9') {
+            digit = c - '0';
+        } else if (c >= 'a' && c <= 'f') {
+            digit = c - 'a' + 10;
+        } else if (c >= 'A' && c <= 'F') {
+            digit = c - 'A' + 10;
+        } else {
+            return false;
+        }
+        code = (code << 4) | digit;
+    }
+    return true;
+}
+
+static inline int32_t encodeUtf8(uint32_t code, char* out) {
+    if (code < 0x80) {
+        out[0] = static_cast<char>(code);
+        return 1;
+    }
+    if (code < 0x800) {
+        out[0] = static_cast<char>(0xC0 | (code >> 6));
+        out[1] = static_cast<char>(0x80 | (code & 0x3F));
+        return 2;
+    }
+    if (code < 0x10000) {
+        out[0] = static_cast<char>(0xE0 | (code >> 12));
+        out[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+        out[2] = static_cast<char>(0x80 | (code & 0x3F));
+        return 3;
+    }
+    out[0] = static_cast<char>(0xF0 | (code >> 18));
+    out[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+    out[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out[3] = static_cast<char>(0x80 | (code & 0x3F));
+    return 4;
+}
+
+// unescapes the value scanned by scanValue in place, and returns the end of the result. Unknown escapes are kept.
+static int32_t unescapeValue(char* buffer, int32_t idx, int32_t size) {
+    int32_t endIndex = idx;
+    while (idx < size) {
+        int32_t next = findQuoteOrBackslash(buffer, idx, size);
+        if (endIndex != idx) {
+            memmove(buffer + endIndex, buffer + idx, next - idx);
+        }
+        endIndex += next - idx;
+        if (next >= size) {
+            break;
+        }
+        char escapedChar = buffer[next + 1];
+        idx = next + 2;
+        switch (escapedChar) {
+            case '\"':
+            case '\\':
+            case '/':
+                buffer[endIndex++] = escapedChar;
+                break;
+            case 'b':
+                buffer[endIndex++] = '\b';
+                break;
+            case 'f':
+                buffer[endIndex++] = '\f';
+                break;
+            case 'n':
+                buffer[endIndex++] = '\n';
+                break;
+            case 'r':
+                buffer[endIndex++] = '\r';
+                break;
+            case 't':
+                buffer[endIndex++] = '\t';
+                break;
+            default: {
+                uint32_t code = 0;
+                if (escapedChar == 'u' && idx + 4 <= size && parseHex4(buffer + idx, code)) {
+                    idx += 4;
+                    uint32_t low = 0;
+                    // surrogate pairs are combined, and others are encoded as they are
+                    if (code >= 0xD800 && code <= 0xDBFF && idx + 6 <= size && buffer[idx] == '\\'
+                        && buffer[idx + 1] == 'u' && parseHex4(buffer + idx + 2, low) && low >= 0xDC00
+                        && low <= 0xDFFF) {
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                        idx += 6;
+                    }
+                    endIndex += encodeUtf8(code, buffer + endIndex);
+                } else {
+                    buffer[endIndex++] = '\\';
+                    buffer[endIndex++] = escapedChar;
+                }
+                break;
+            }
+        }
+    }
+    return endIndex;
+}
+
 // buffer: {"log":"Hello, World!","stream":"stdout","time":"2021-12-01T00:00:00.000Z"}
+// The buffer is only modified when the line is parsed successfully, where log is unescaped in place.
 bool ProcessorParseContainerLogNative::ParseDockerLog(char* buffer, int32_t size, DockerLog& dockerLog) {
     if (size == 0 || buffer[0] != '{' || buffer[size - 1] != '}') {
         return false;
     }
     int logTypeCnt = 0;
-    int32_t endIndex = 0;
     int32_t idx = 1; // skip '{'
     DockerLogType logType;
+    int32_t logBegin = -1;
+    int32_t logEnd = -1;
+    bool logEscaped = false;
     while (idx < size) {
         idx = skipSpaces(buffer, idx, size);
         if (idx >= size) {
@@ -444,7 +537,7 @@ bool ProcessorParseContainerLogNative::ParseDockerLog(char* buffer, int32_t size
         // skip '}'
         if (buffer[idx] == '}') {
             if (idx == size - 1) {
-                return true;
+                break;
             }
             return false;
         }
@@ -489,12 +582,13 @@ bool ProcessorParseContainerLogNative::ParseDockerLog(char* buffer, int32_t size
             return false;
         }
 
-        endIndex = idx;
-        char* valueBegion = buffer + endIndex;
-        idx = parseValue(buffer, idx, size, logType, endIndex);
+        int32_t valueBegin = idx;
+        bool escaped = false;
+        idx = scanValue(buffer, idx, size, logType, escaped);
         if (idx == -1) {
             return false;
         }
+        int32_t valueEnd = idx;
 
         ++idx; // skip '\"'
         idx = skipSpaces(buffer, idx, size);
@@ -517,17 +611,50 @@ bool ProcessorParseContainerLogNative::ParseDockerLog(char* buffer, int32_t size
 
         switch (logType) {
             case DockerLogType::Log:
-                dockerLog.log = StringView(valueBegion, endIndex - (valueBegion - buffer));
+                logBegin = valueBegin;
+                logEnd = valueEnd;
+                logEscaped = escaped;
                 break;
             case DockerLogType::Stream:
-                dockerLog.stream = StringView(valueBegion, endIndex - (valueBegion - buffer));
+                dockerLog.stream = StringView(buffer + valueBegin, valueEnd - valueBegin);
                 break;
             case DockerLogType::Time:
-                dockerLog.time = StringView(valueBegion, endIndex - (valueBegion - buffer));
+                dockerLog.time = StringView(buffer + valueBegin, valueEnd - valueBegin);
                 break;
         }
     }
 
+    if (logBegin >= 0) {
+        if (logEscaped) {
+            logEnd = unescapeValue(buffer, logBegin, logEnd);
+        }
+        dockerLog.log = StringView(buffer + logBegin, logEnd - logBegin);
+    }
+    return true;
+}
+
+// for lines not in the shape of ParseDockerLog, e.g. with other keys like attrs or with escaped stream
+bool ProcessorParseContainerLogNative::ParseDockerLogAsJson(StringView buffer,
+                                                            SourceBuffer& sourceBuffer,
+                                                            DockerLog& dockerLog) {
+    rapidjson::Document doc;
+    doc.Parse(buffer.data(), buffer.size());
+    if (doc.HasParseError() || !doc.IsObject()) {
+        return false;
+    }
+    auto log = doc.FindMember(DOCKER_JSON_LOG.c_str());
+    auto stream = doc.FindMember(DOCKER_JSON_STREAM_TYPE.c_str());
+    auto time = doc.FindMember(DOCKER_JSON_TIME.c_str());
+    if (log == doc.MemberEnd() || !log->value.IsString() || stream == doc.MemberEnd() || !stream->value.IsString()
+        || time == doc.MemberEnd() || !time->value.IsString()) {
+        return false;
+    }
+    StringBuffer sb = sourceBuffer.CopyString(log->value.GetString(), log->value.GetStringLength());
+    dockerLog.log = StringView(sb.data, sb.size);
+    sb = sourceBuffer.CopyString(stream->value.GetString(), stream->value.GetStringLength());
+    dockerLog.stream = StringView(sb.data, sb.size);
+    sb = sourceBuffer.CopyString(time->value.GetString(), time->value.GetStringLength());
+    dockerLog.time = StringView(sb.data, sb.size);
     return true;
 }
 
@@ -539,7 +666,8 @@ bool ProcessorParseContainerLogNative::ParseDockerJsonLogLine(LogEvent& sourceEv
 
     char* data = const_cast<char*>(buffer.data());
 
-    if (ParseDockerLog(data, buffer.size(), entry)) {
+    if (ParseDockerLog(data, buffer.size(), entry)
+        || ParseDockerLogAsJson(buffer, *sourceEvent.GetSourceBuffer(), entry)) {
         timeValue = entry.time;
         content = entry.log;
         sourceValue = entry.stream;
@@ -16,6 +16,7 @@
 
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 
+#include "common/DelimiterScanner.h"
 #include "common/ParamExtractor.h"
 #include "models/LogEvent.h"
 
@@ -75,6 +76,10 @@ void ProcessorSplitLogStringNative::Process(PipelineEventGroup& logGroup) {
     if (logGroup.GetEvents().empty()) {
         return;
     }
+    // global config is initialized after inputs, so the flag can only be checked here
+    if (!mEnableRawContent && mContext->GetGlobalConfig().mEnableColumnarEvents && SplitToColumnar(logGroup)) {
+        return;
+    }
     EventsContainer newEvents;
     for (PipelineEventPtr& e : logGroup.MutableEvents()) {
         ProcessEvent(logGroup, std::move(e), newEvents);
@@ -130,9 +135,15 @@ void ProcessorSplitLogStringNative::ProcessEvent(PipelineEventGroup& logGroup,
     StringView sourceVal = sourceEvent.GetContent(mSourceKey);
     StringBuffer sourceKey = logGroup.GetSourceBuffer()->CopyString(mSourceKey);
 
+    // find all line boundaries in one pass, the split char is rare compared to the content bytes
+    std::vector<size_t> splitPositions;
+    splitPositions.reserve(sourceVal.size() / kEstimatedLineSize + 1);
+    FindAllDelimiters(sourceVal.data(), sourceVal.size(), mSplitChar, splitPositions);
+
     size_t begin = 0;
-    while (begin < sourceVal.size()) {
-        StringView content = GetNextLine(sourceVal, begin);
+    for (size_t idx = 0; begin < sourceVal.size(); ++idx) {
+        size_t end = idx < splitPositions.size() ? splitPositions[idx] : sourceVal.size();
+        StringView content(sourceVal.data() + begin, end - begin);
         if (mEnableRawContent) {
             std::unique_ptr<RawEvent> targetEvent = logGroup.CreateRawEvent(true);
             targetEvent->SetContentNoCopy(content);
@@ -160,17 +171,59 @@ void ProcessorSplitLogStringNative::ProcessEvent(PipelineEventGroup& logGroup,
     }
 }
 
-StringView ProcessorSplitLogStringNative::GetNextLine(StringView log, size_t begin) {
-    if (begin >= log.size()) {
-        return StringView();
+bool ProcessorSplitLogStringNative::SplitToColumnar(PipelineEventGroup& logGroup) {
+    // only groups consisting of well-formed source events are split into columnar mode, others take the ordinary path
+    // so that errors are reported as usual
+    if (logGroup.IsColumnar()) {
+        return false;
+    }
+    for (const auto& e : logGroup.GetEvents()) {
+        if (!e.Is<LogEvent>()) {
+            return false;
+        }
+        const LogEvent& sourceEvent = e.Cast<LogEvent>();
+        if (sourceEvent.Size() != 1 || !sourceEvent.HasContent(mSourceKey)) {
+            return false;
+        }
     }
 
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == mSplitChar) {
-            return StringView(log.data() + begin, end - begin);
+    ColumnarLogEvents& columns = logGroup.EnableColumnarLogs();
+    StringBuffer sourceKey = logGroup.GetSourceBuffer()->CopyString(mSourceKey);
+    size_t contentCol = columns.AddColumn(StringView(sourceKey.data, sourceKey.size));
+    size_t offsetCol = ColumnarLogEvents::npos;
+    if (logGroup.HasMetadata(EventGroupMetaKey::LOG_FILE_OFFSET_KEY)) {
+        offsetCol = columns.AddColumn(logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_OFFSET_KEY));
+    }
+
+    std::vector<size_t> splitPositions;
+    for (const auto& e : logGroup.GetEvents()) {
+        const LogEvent& sourceEvent = e.Cast<LogEvent>();
+        StringView sourceVal = sourceEvent.GetContent(mSourceKey);
+        splitPositions.clear();
+        FindAllDelimiters(sourceVal.data(), sourceVal.size(), mSplitChar, splitPositions);
+        columns.Reserve(columns.Size() + splitPositions.size() + 1);
+
+        size_t begin = 0;
+        for (size_t idx = 0; begin < sourceVal.size(); ++idx) {
+            size_t end = idx < splitPositions.size() ? splitPositions[idx] : sourceVal.size();
+            StringView content(sourceVal.data() + begin, end - begin);
+            auto const offset = sourceEvent.GetPosition().first + (content.data() - sourceVal.data());
+            auto const length = end == sourceVal.size()
+                ? sourceEvent.GetPosition().second - (content.data() - sourceVal.data())
+                : content.size() + 1;
+            size_t row = columns.AddRow(
+                sourceEvent.GetTimestamp(), sourceEvent.GetTimestampNanosecond(), offset, length);
+            columns.SetValue(contentCol, row, content);
+            if (offsetCol != ColumnarLogEvents::npos) {
+                StringBuffer offsetStr = logGroup.GetSourceBuffer()->CopyString(ToString(offset));
+                columns.SetValue(offsetCol, row, StringView(offsetStr.data, offsetStr.size));
+            }
+            begin = end + 1;
         }
     }
-    return StringView(log.data() + begin, log.size() - begin);
+    EventsContainer emptyEvents;
+    logGroup.SwapEvents(emptyEvents);
+    return true;
 }
 
 } // namespace logtail
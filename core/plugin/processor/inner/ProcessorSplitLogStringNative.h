@@ -42,7 +42,11 @@ protected:
 
 private:
     void ProcessEvent(PipelineEventGroup& logGroup, PipelineEventPtr&& e, EventsContainer& newEvents);
-    StringView GetNextLine(StringView log, size_t begin);
+    // split all events of the group into columnar log rows, return false if the group is not eligible
+    bool SplitToColumnar(PipelineEventGroup& logGroup);
+
+    // only used to reserve the boundary vector, an underestimate just costs a few reallocations
+    static constexpr size_t kEstimatedLineSize = 128;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorRegexStringNativeUnittest;
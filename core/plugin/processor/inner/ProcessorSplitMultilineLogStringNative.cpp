@@ -176,17 +176,13 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (HasStartPattern()) {
-                regex = GetStartPatternReg();
-            } else {
-                regex = GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            bool matched = HasStartPattern() ? IsStartPatternMatched(content, exception)
+                                             : IsContinuePatternMatched(content, exception);
+            if (matched) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (HasEndPattern() && !HasStartPattern() && HasContinuePattern()
-                       && BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                       && IsEndPatternMatched(content, exception)) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -197,8 +193,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             }
         } else {
             // case: start + continue or continue + end
-            if (HasContinuePattern()
-                && BoostRegexSearch(content.data(), content.size(), GetContinuePatternReg(), exception)) {
+            if (HasContinuePattern() && IsContinuePatternMatched(content, exception)) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -207,7 +202,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (HasContinuePattern()) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -229,7 +224,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (IsEndPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -250,7 +245,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (!HasContinuePattern()) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (IsStartPatternMatched(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -270,7 +265,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     ADD_COUNTER(mMatchedEventsTotal, 1);
-                    if (!BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (!IsStartPatternMatched(content, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -393,16 +388,21 @@ StringView ProcessorSplitMultilineLogStringNative::GetNextLine(StringView log, s
     return StringView(log.data() + begin, log.size() - begin);
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
-    return mStartPatternReg[ProcessorRunner::GetThreadNo()];
+bool ProcessorSplitMultilineLogStringNative::IsStartPatternMatched(const StringView& line,
+                                                                   std::string& exception) const {
+    return mMultiline.GetStartPatternPrefixFilter().MayMatch(line.data(), line.size())
+        && BoostRegexSearch(line.data(), line.size(), mStartPatternReg[ProcessorRunner::GetThreadNo()], exception);
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetContinuePatternReg() const {
-    return mContinuePatternReg[ProcessorRunner::GetThreadNo()];
+bool ProcessorSplitMultilineLogStringNative::IsContinuePatternMatched(const StringView& line,
+                                                                      std::string& exception) const {
+    return mMultiline.GetContinuePatternPrefixFilter().MayMatch(line.data(), line.size())
+        && BoostRegexSearch(line.data(), line.size(), mContinuePatternReg[ProcessorRunner::GetThreadNo()], exception);
 }
 
-const boost::regex& ProcessorSplitMultilineLogStringNative::GetEndPatternReg() const {
-    return mEndPatternReg[ProcessorRunner::GetThreadNo()];
+bool ProcessorSplitMultilineLogStringNative::IsEndPatternMatched(const StringView& line, std::string& exception) const {
+    return mMultiline.GetEndPatternPrefixFilter().MayMatch(line.data(), line.size())
+        && BoostRegexSearch(line.data(), line.size(), mEndPatternReg[ProcessorRunner::GetThreadNo()], exception);
 }
 
 } // namespace logtail
@@ -68,9 +68,10 @@ private:
     bool HasStartPattern() const { return !mStartPatternReg.empty(); }
     bool HasContinuePattern() const { return !mContinuePatternReg.empty(); }
     bool HasEndPattern() const { return !mEndPatternReg.empty(); }
-    const boost::regex& GetStartPatternReg() const;
-    const boost::regex& GetContinuePatternReg() const;
-    const boost::regex& GetEndPatternReg() const;
+    // the line is checked by the prefix filter of the pattern before the regex
+    bool IsStartPatternMatched(const StringView& line, std::string& exception) const;
+    bool IsContinuePatternMatched(const StringView& line, std::string& exception) const;
+    bool IsEndPatternMatched(const StringView& line, std::string& exception) const;
 
     // boost::regex object shared by multi-thread leads to performance degradation. Therefore, each thread should be
     // allocated a different copy.
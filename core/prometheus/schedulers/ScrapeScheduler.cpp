@@ -165,7 +165,11 @@ void ScrapeScheduler::ScheduleNext() {
     }
 
     auto event = BuildScrapeTimerEvent(GetNextExecTime());
-    Timer::GetInstance()->PushEvent(std::move(event));
+    TimerId timerEventId = Timer::GetInstance()->PushEvent(std::move(event));
+    {
+        WriteLock lock(mLock);
+        mTimerEventId = timerEventId;
+    }
 }
 
 void ScrapeScheduler::ScrapeOnce(std::chrono::steady_clock::time_point execTime) {
@@ -217,10 +221,15 @@ void ScrapeScheduler::Cancel() {
     if (mIsContextValidFuture != nullptr) {
         mIsContextValidFuture->Cancel();
     }
+    TimerId timerEventId = kInvalidTimerId;
     {
         WriteLock lock(mLock);
         mValidState = false;
+        timerEventId = mTimerEventId;
+        mTimerEventId = kInvalidTimerId;
     }
+    // the pending scrape is dropped from the timer at once instead of being kept until its exec time
+    Timer::GetInstance()->CancelEvent(timerEventId);
 }
 
 void ScrapeScheduler::InitSelfMonitor(const MetricLabels& defaultLabels) {
@@ -81,6 +81,7 @@ private:
     std::string mMetricsPath;
     std::string mScheme;
     uint64_t mScrapeTimeoutSeconds;
+    TimerId mTimerEventId = kInvalidTimerId;
 
     // pipeline
     QueueKey mQueueKey;
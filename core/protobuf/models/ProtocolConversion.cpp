@@ -6,7 +6,8 @@ namespace logtail {
 
 bool TransferPBToPipelineEventGroup(const logtail::models::PipelineEventGroup& src,
                                     logtail::PipelineEventGroup& dst,
-                                    std::string& errMsg) {
+                                    std::string& errMsg,
+                                    bool noCopy) {
     // events
     switch (src.PipelineEvents_case()) {
         case logtail::models::PipelineEventGroup::PipelineEventsCase::kLogs:
@@ -17,7 +18,7 @@ bool TransferPBToPipelineEventGroup(const logtail::models::PipelineEventGroup& s
             dst.MutableEvents().reserve(src.logs().events_size());
             for (auto& logSrc : src.logs().events()) {
                 auto logDst = dst.AddLogEvent();
-                if (!TransferPBToLogEvent(logSrc, *logDst, errMsg)) {
+                if (!TransferPBToLogEvent(logSrc, *logDst, errMsg, noCopy)) {
                     return false;
                 }
             }
@@ -30,7 +31,7 @@ bool TransferPBToPipelineEventGroup(const logtail::models::PipelineEventGroup& s
             dst.MutableEvents().reserve(src.metrics().events_size());
             for (auto& metricSrc : src.metrics().events()) {
                 auto metricDst = dst.AddMetricEvent();
-                if (!TransferPBToMetricEvent(metricSrc, *metricDst, errMsg)) {
+                if (!TransferPBToMetricEvent(metricSrc, *metricDst, errMsg, noCopy)) {
                     return false;
                 }
             }
@@ -55,7 +56,11 @@ bool TransferPBToPipelineEventGroup(const logtail::models::PipelineEventGroup& s
 
     // tags
     for (auto& tag : src.tags()) {
-        dst.SetTag(tag.first, tag.second);
+        if (noCopy) {
+            dst.SetTagNoCopy(tag.first, tag.second);
+        } else {
+            dst.SetTag(tag.first, tag.second);
+        }
     }
 
     // TODO: transfer metadatas
@@ -68,29 +73,49 @@ bool TransferPBToPipelineEventGroup(const logtail::models::PipelineEventGroup& s
     return true;
 }
 
-bool TransferPBToLogEvent(const logtail::models::LogEvent& src, logtail::LogEvent& dst, std::string& errMsg) {
+bool TransferPBToLogEvent(const logtail::models::LogEvent& src,
+                          logtail::LogEvent& dst,
+                          std::string& errMsg,
+                          bool noCopy) {
     // timestamp
     std::chrono::nanoseconds tns(src.timestamp());
     std::chrono::seconds ts = std::chrono::duration_cast<std::chrono::seconds>(tns);
     dst.SetTimestamp(ts.count(), tns.count() - ts.count() * 1000000000);
     // contents
-    for (auto& contentPair : src.contents()) {
-        dst.SetContent(contentPair.key(), contentPair.value());
+    if (noCopy) {
+        for (auto& contentPair : src.contents()) {
+            dst.SetContentNoCopy(contentPair.key(), contentPair.value());
+        }
+    } else {
+        for (auto& contentPair : src.contents()) {
+            dst.SetContent(contentPair.key(), contentPair.value());
+        }
     }
     // level
-    dst.SetLevel(src.level());
+    if (noCopy) {
+        dst.SetLevelNoCopy(src.level());
+    } else {
+        dst.SetLevel(src.level());
+    }
     // fileoffset and rawsize
     dst.SetPosition(src.fileoffset(), src.rawsize());
     return true;
 }
 
-bool TransferPBToMetricEvent(const logtail::models::MetricEvent& src, logtail::MetricEvent& dst, std::string& errMsg) {
+bool TransferPBToMetricEvent(const logtail::models::MetricEvent& src,
+                             logtail::MetricEvent& dst,
+                             std::string& errMsg,
+                             bool noCopy) {
     // timestamp
     std::chrono::nanoseconds tns(src.timestamp());
     std::chrono::seconds ts = std::chrono::duration_cast<std::chrono::seconds>(tns);
     dst.SetTimestamp(ts.count(), tns.count() - ts.count() * 1000000000);
     // name
-    dst.SetName(src.name());
+    if (noCopy) {
+        dst.SetNameNoCopy(src.name());
+    } else {
+        dst.SetName(src.name());
+    }
     // value
     switch (src.Value_case()) {
         case logtail::models::MetricEvent::ValueCase::kUntypedSingleValue:
@@ -102,7 +127,11 @@ bool TransferPBToMetricEvent(const logtail::models::MetricEvent& src, logtail::M
     }
     // tags
     for (auto& tagPair : src.tags()) {
-        dst.SetTag(tagPair.first, tagPair.second);
+        if (noCopy) {
+            dst.SetTagNoCopy(tagPair.first, tagPair.second);
+        } else {
+            dst.SetTag(tagPair.first, tagPair.second);
+        }
     }
     return true;
 }
@@ -27,11 +27,18 @@
 
 namespace logtail {
 
+// With noCopy, strings of logs, metrics and tags are referenced instead of copied into the source buffer of dst, so
+// src must be kept alive as long as dst, e.g. by allocating src on an arena added as a dependency of the source buffer.
+// Spans are always copied.
 bool TransferPBToPipelineEventGroup(const models::PipelineEventGroup& src,
                                     PipelineEventGroup& dst,
-                                    std::string& errMsg);
-bool TransferPBToLogEvent(const models::LogEvent& src, LogEvent& dst, std::string& errMsg);
-bool TransferPBToMetricEvent(const models::MetricEvent& src, MetricEvent& dst, std::string& errMsg);
+                                    std::string& errMsg,
+                                    bool noCopy = false);
+bool TransferPBToLogEvent(const models::LogEvent& src, LogEvent& dst, std::string& errMsg, bool noCopy = false);
+bool TransferPBToMetricEvent(const models::MetricEvent& src,
+                             MetricEvent& dst,
+                             std::string& errMsg,
+                             bool noCopy = false);
 bool TransferPBToSpanEvent(const models::SpanEvent& src, SpanEvent& dst, std::string& errMsg);
 
 bool TransferPipelineEventGroupToPB(const PipelineEventGroup& src,
@@ -14,7 +14,10 @@
 
 #include "protobuf/sls/LogGroupSerializer.h"
 
-#include "common/TimeUtil.h"
+#include <cstring>
+
+#include <algorithm>
+#include <charconv>
 
 using namespace std;
 
@@ -53,59 +56,101 @@ static inline size_t uint32_size(uint32_t v) {
 
 /**
  * Pack an unsigned 32-bit integer in base-128 varint encoding and return the
- * number of bytes written, which must be 5 or less.
+ * position after the last byte written, which is at most 5 bytes after `out`.
  *
  * \param value
  *      Value to encode.
  * \param[out] out
  *      Packed value.
  * \return
- *      Number of bytes written to `out`.
+ *      Position after the packed value.
  */
-static inline size_t uint32_pack(uint32_t value, string& output) {
-    unsigned rv = 1;
-
-    if (value >= 0x80) {
-        output.push_back(value | 0x80);
-        ++rv;
+static inline char* uint32_pack(uint32_t value, char* out) {
+    while (value >= 0x80) {
+        *out++ = static_cast<char>(value | 0x80);
         value >>= 7;
-        if (value >= 0x80) {
-            output.push_back(value | 0x80);
-            ++rv;
-            value >>= 7;
-            if (value >= 0x80) {
-                output.push_back(value | 0x80);
-                ++rv;
-                value >>= 7;
-                if (value >= 0x80) {
-                    output.push_back(value | 0x80);
-                    ++rv;
-                    value >>= 7;
-                }
-            }
-        }
     }
-    /* assert: value<128 */
-    output.push_back(value);
-    return rv;
+    *out++ = static_cast<char>(value);
+    return out;
 }
 
-static inline void fixed32_pack(uint32_t value, string& output) {
+static inline char* fixed32_pack(uint32_t value, char* out) {
     for (size_t i = 0; i < 4; ++i) {
-        output.push_back(value & 0xFF);
+        *out++ = static_cast<char>(value & 0xFF);
         value >>= 8;
     }
+    return out;
+}
+
+static inline char* bytes_pack(const char* data, size_t size, char* out) {
+    memcpy(out, data, size);
+    return out + size;
 }
 
+// max bytes of a varint encoded uint32
+static const size_t kMaxVarint32Size = 5;
+
 void LogGroupSerializer::Prepare(size_t size) {
-    mRes.clear();
-    mRes.reserve(size);
+    Prepare(mRes, size);
+}
+
+void LogGroupSerializer::Prepare(string& output, size_t size) {
+    mChunkHandler = nullptr;
+    mOutput = &output;
+    // capacity is kept by resize, so memory is only allocated when the output grows
+    mOutput->resize(size);
+    mCur = &(*mOutput)[0];
+    mEnd = mCur + size;
+}
+
+void LogGroupSerializer::PrepareStream(size_t chunkSize, ChunkHandler handler) {
+    Prepare(mRes, chunkSize);
+    mChunkHandler = std::move(handler);
+    mStreamFailed = false;
+}
+
+bool LogGroupSerializer::FinishStream() {
+    size_t written = mCur - mOutput->data();
+    if (written > 0 && !mStreamFailed) {
+        mStreamFailed = !mChunkHandler(mOutput->data(), written);
+    }
+    mChunkHandler = nullptr;
+    mCur = &(*mOutput)[0];
+    mEnd = mCur;
+    return !mStreamFailed;
+}
+
+void LogGroupSerializer::Grow(size_t size) {
+    size_t written = mCur - mOutput->data();
+    if (mChunkHandler) {
+        // once the handler fails, the rest of the log group is still serialized but simply dropped
+        if (written > 0 && !mStreamFailed) {
+            mStreamFailed = !mChunkHandler(mOutput->data(), written);
+        }
+        if (mOutput->size() < size) {
+            mOutput->resize(size);
+        }
+        mCur = &(*mOutput)[0];
+        mEnd = mCur + mOutput->size();
+        return;
+    }
+    mOutput->resize(max(mOutput->size() * 2, written + size));
+    mCur = &(*mOutput)[0] + written;
+    mEnd = &(*mOutput)[0] + mOutput->size();
+}
+
+string& LogGroupSerializer::GetResult() {
+    mOutput->resize(mCur - mOutput->data());
+    // further writes must grow the output again
+    mEnd = mCur;
+    return *mOutput;
 }
 
 void LogGroupSerializer::StartToAddLog(size_t size) {
+    Reserve(1 + kMaxVarint32Size);
     // field = 1, wire_type = 2
-    mRes.push_back(0x0A);
-    uint32_pack(size, mRes);
+    *mCur++ = 0x0A;
+    mCur = uint32_pack(size, mCur);
 }
 
 void LogGroupSerializer::AddLogTime(uint32_t logTime) {
@@ -114,113 +159,123 @@ void LogGroupSerializer::AddLogTime(uint32_t logTime) {
     if (logTime < minLogTime) {
         logTime = minLogTime;
     }
+    Reserve(1 + kMaxVarint32Size);
     // field = 1, wire_type = 0
-    mRes.push_back(0x08);
-    uint32_pack(logTime, mRes);
+    *mCur++ = 0x08;
+    mCur = uint32_pack(logTime, mCur);
 }
 
 void LogGroupSerializer::AddLogContent(StringView key, StringView value) {
+    Reserve(3 * (1 + kMaxVarint32Size) + key.size() + value.size());
     // Contents
     // field = 2, wire_type = 2
-    mRes.push_back(0x12);
-    uint32_pack(GetStringSize(key.size()) + GetStringSize(value.size()), mRes);
-    // Key
-    // field = 1, wire_type = 2
-    mRes.push_back(0x0A);
-    uint32_pack(key.size(), mRes);
-    mRes.append(key.data(), key.size());
-    // Value
-    // field = 2, wire_type = 2
-    mRes.push_back(0x12);
-    uint32_pack(value.size(), mRes);
-    mRes.append(value.data(), value.size());
+    *mCur++ = 0x12;
+    AddKeyValue(key, value);
 }
 
 void LogGroupSerializer::AddLogTimeNs(uint32_t logTimeNs) {
+    Reserve(1 + 4);
     // field = 4, wire_type = 5
-    mRes.push_back(0x25);
-    fixed32_pack(logTimeNs, mRes);
+    *mCur++ = 0x25;
+    mCur = fixed32_pack(logTimeNs, mCur);
 }
 
 void LogGroupSerializer::AddTopic(StringView topic) {
+    Reserve(1 + kMaxVarint32Size + topic.size());
     // field = 3, wire_type = 2
-    mRes.push_back(0x1A);
+    *mCur++ = 0x1A;
     AddString(topic);
 }
 
 void LogGroupSerializer::AddSource(StringView source) {
+    Reserve(1 + kMaxVarint32Size + source.size());
     // field = 4, wire_type = 2
-    mRes.push_back(0x22);
+    *mCur++ = 0x22;
     AddString(source);
 }
 
 void LogGroupSerializer::AddMachineUUID(StringView machineUUID) {
+    Reserve(1 + kMaxVarint32Size + machineUUID.size());
     // field = 5, wire_type = 2
-    mRes.push_back(0x2A);
+    *mCur++ = 0x2A;
     AddString(machineUUID);
 }
 
 void LogGroupSerializer::AddLogTag(StringView key, StringView value) {
+    Reserve(3 * (1 + kMaxVarint32Size) + key.size() + value.size());
     // LogTags
     // field = 6, wire_type = 2
-    mRes.push_back(0x32);
-    uint32_pack(GetStringSize(key.size()) + GetStringSize(value.size()), mRes);
+    *mCur++ = 0x32;
+    AddKeyValue(key, value);
+}
+
+// space must be reserved by the caller
+void LogGroupSerializer::AddString(StringView value) {
+    mCur = uint32_pack(value.size(), mCur);
+    mCur = bytes_pack(value.data(), value.size(), mCur);
+}
+
+// space must be reserved by the caller
+void LogGroupSerializer::AddKeyValue(StringView key, StringView value) {
+    mCur = uint32_pack(GetStringSize(key.size()) + GetStringSize(value.size()), mCur);
     // Key
     // field = 1, wire_type = 2
-    mRes.push_back(0x0A);
-    uint32_pack(key.size(), mRes);
-    mRes.append(key.data(), key.size());
+    *mCur++ = 0x0A;
+    AddString(key);
     // Value
     // field = 2, wire_type = 2
-    mRes.push_back(0x12);
-    uint32_pack(value.size(), mRes);
-    mRes.append(value.data(), value.size());
-}
-
-void LogGroupSerializer::AddString(StringView value) {
-    uint32_pack(value.size(), mRes);
-    mRes.append(value.data(), value.size());
+    *mCur++ = 0x12;
+    AddString(value);
 }
 
 void LogGroupSerializer::AddLogContentMetricLabel(const MetricEvent& e, size_t valueSZ) {
+    Reserve(3 * (1 + kMaxVarint32Size) + METRIC_RESERVED_KEY_LABELS.size() + valueSZ);
     // Contents
-    mRes.push_back(0x12);
-    uint32_pack(GetStringSize(METRIC_RESERVED_KEY_LABELS.size()) + GetStringSize(valueSZ), mRes);
+    *mCur++ = 0x12;
+    mCur = uint32_pack(GetStringSize(METRIC_RESERVED_KEY_LABELS.size()) + GetStringSize(valueSZ), mCur);
     // Key
-    mRes.push_back(0x0A);
-    uint32_pack(METRIC_RESERVED_KEY_LABELS.size(), mRes);
-    mRes.append(METRIC_RESERVED_KEY_LABELS);
+    *mCur++ = 0x0A;
+    AddString(METRIC_RESERVED_KEY_LABELS);
     // Value
-    mRes.push_back(0x12);
-    uint32_pack(valueSZ, mRes);
+    *mCur++ = 0x12;
+    mCur = uint32_pack(valueSZ, mCur);
     bool hasPrev = false;
     for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+        // valueSZ is computed from the same tags, but do not trust it for memory safety
+        Reserve(METRIC_LABELS_SEPARATOR.size() + it->first.size() + METRIC_LABELS_KEY_VALUE_SEPARATOR.size()
+                + it->second.size());
         if (hasPrev) {
-            mRes.append(METRIC_LABELS_SEPARATOR);
+            mCur = bytes_pack(METRIC_LABELS_SEPARATOR.data(), METRIC_LABELS_SEPARATOR.size(), mCur);
         }
         hasPrev = true;
-        mRes.append(it->first.data(), it->first.size());
-        mRes.append(METRIC_LABELS_KEY_VALUE_SEPARATOR);
-        mRes.append(it->second.data(), it->second.size());
+        mCur = bytes_pack(it->first.data(), it->first.size(), mCur);
+        mCur = bytes_pack(METRIC_LABELS_KEY_VALUE_SEPARATOR.data(), METRIC_LABELS_KEY_VALUE_SEPARATOR.size(), mCur);
+        mCur = bytes_pack(it->second.data(), it->second.size(), mCur);
     }
 }
 
 void LogGroupSerializer::AddLogContentMetricTimeNano(const MetricEvent& e) {
     size_t valueSZ = e.GetTimestampNanosecond() ? 19U : 10U;
+    // timestamp may have up to 20 digits, plus 9 digits of nanosecond
+    Reserve(3 * (1 + kMaxVarint32Size) + METRIC_RESERVED_KEY_TIME_NANO.size() + 20 + 9);
     // Contents
-    mRes.push_back(0x12);
-    uint32_pack(GetStringSize(METRIC_RESERVED_KEY_TIME_NANO.size()) + GetStringSize(valueSZ), mRes);
+    *mCur++ = 0x12;
+    mCur = uint32_pack(GetStringSize(METRIC_RESERVED_KEY_TIME_NANO.size()) + GetStringSize(valueSZ), mCur);
     // Key
-    mRes.push_back(0x0A);
-    uint32_pack(METRIC_RESERVED_KEY_TIME_NANO.size(), mRes);
-    mRes.append(METRIC_RESERVED_KEY_TIME_NANO);
+    *mCur++ = 0x0A;
+    AddString(METRIC_RESERVED_KEY_TIME_NANO);
     // Value
-    mRes.push_back(0x12);
-    uint32_pack(valueSZ, mRes);
-    // TODO: avoid copy
-    mRes.append(to_string(e.GetTimestamp()));
+    *mCur++ = 0x12;
+    mCur = uint32_pack(valueSZ, mCur);
+    mCur = to_chars(mCur, mEnd, e.GetTimestamp()).ptr;
     if (e.GetTimestampNanosecond()) {
-        mRes.append(NumberToDigitString(e.GetTimestampNanosecond().value(), 9));
+        // same as NumberToDigitString(ns, 9), written in place
+        uint32_t ns = e.GetTimestampNanosecond().value();
+        for (int i = 8; i >= 0; --i) {
+            mCur[i] = static_cast<char>('0' + ns % 10);
+            ns /= 10;
+        }
+        mCur += 9;
     }
 }
 
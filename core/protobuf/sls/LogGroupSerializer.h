@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <functional>
 #include <string>
 
 #include "common/StringView.h"
@@ -34,9 +35,24 @@ extern const std::string METRIC_LABELS_SEPARATOR;
 extern const std::string METRIC_LABELS_KEY_VALUE_SEPARATOR;
 
 // see for detail: https://protobuf.dev/programming-guides/encoding/
+//
+// Fields are written through a raw cursor into a buffer sized in advance by Prepare, so the size passed to Prepare
+// should be the exact size of the log group, as computed by the Get*Size functions below. The buffer still grows if the
+// size turns out to be too small.
+//
+// In stream mode, the internal buffer only holds one chunk, which is passed to the handler whenever it is full, so that
+// the log group can be consumed (e.g., compressed) while being serialized without ever being fully materialized.
 class LogGroupSerializer {
 public:
+    using ChunkHandler = std::function<bool(const char* data, size_t size)>;
+
+    // serialize into the internal buffer, which is returned by GetResult
     void Prepare(size_t size);
+    // serialize directly into output, so that no copy is needed and the capacity of output can be reused
+    void Prepare(std::string& output, size_t size);
+    void PrepareStream(size_t chunkSize, ChunkHandler handler);
+    // pass the remaining bytes to the handler, return false if the handler has ever failed
+    bool FinishStream();
     void StartToAddLog(size_t size);
     void AddLogTime(uint32_t logTime);
     void AddLogContent(StringView key, StringView value);
@@ -45,15 +61,28 @@ public:
     void AddSource(StringView source);
     void AddMachineUUID(StringView machineUUID);
     void AddLogTag(StringView key, StringView value);
-    std::string& GetResult() { return mRes; }
+    // the buffer given to Prepare, truncated to the bytes written
+    std::string& GetResult();
 
     void AddLogContentMetricLabel(const MetricEvent& e, size_t valueSZ);
     void AddLogContentMetricTimeNano(const MetricEvent& e);
 
 private:
     void AddString(StringView value);
+    void AddKeyValue(StringView key, StringView value);
+    void Reserve(size_t size) {
+        if (static_cast<size_t>(mEnd - mCur) < size) {
+            Grow(size);
+        }
+    }
+    void Grow(size_t size);
 
     std::string mRes;
+    std::string* mOutput = &mRes;
+    char* mCur = nullptr;
+    char* mEnd = nullptr;
+    ChunkHandler mChunkHandler;
+    bool mStreamFailed = false;
 };
 
 size_t GetLogContentSize(size_t keySZ, size_t valueSZ);
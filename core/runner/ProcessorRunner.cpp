@@ -17,6 +17,7 @@
 #include "app_config/AppConfig.h"
 #include "batch/TimeoutFlushManager.h"
 #include "collection_pipeline/CollectionPipelineManager.h"
+#include "collection_pipeline/ParallelProcessExecutor.h"
 #include "common/Flags.h"
 #include "go_pipeline/LogtailPlugin.h"
 #include "models/EventPool.h"
@@ -27,6 +28,7 @@
 
 DEFINE_FLAG_INT32(default_flush_merged_buffer_interval, "default flush merged buffer, seconds", 1);
 DEFINE_FLAG_INT32(processor_runner_exit_timeout_sec, "", 60);
+DEFINE_FLAG_BOOL(enable_processor_work_stealing, "schedule process queues by work stealing", false);
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
 
@@ -46,6 +48,9 @@ ProcessorRunner::ProcessorRunner()
 }
 
 void ProcessorRunner::Init() {
+    if (BOOL_FLAG(enable_processor_work_stealing)) {
+        ProcessQueueManager::GetInstance()->EnableWorkStealing(mThreadCount);
+    }
     for (uint32_t threadNo = 0; threadNo < mThreadCount; ++threadNo) {
         mThreadRes[threadNo] = async(launch::async, &ProcessorRunner::Run, this, threadNo);
     }
@@ -66,6 +71,7 @@ void ProcessorRunner::Stop() {
             LOG_WARNING(sLogger, ("processor runner", "forced to stopped")("threadNo", threadNo));
         }
     }
+    ParallelProcessExecutor::GetInstance()->Stop();
 }
 
 bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes) {
@@ -28,7 +28,7 @@ public:
     virtual bool Init() = 0;
     virtual void Stop() = 0;
 
-    bool AddRequest(std::unique_ptr<T>&& request) {
+    virtual bool AddRequest(std::unique_ptr<T>&& request) {
         mQueue.Push(std::move(request));
         return true;
     }
@@ -51,6 +51,10 @@ bool HttpSink::Init() {
         LOG_ERROR(sLogger, ("failed to init http sink", "failed to init curl multi client"));
         return false;
     }
+    if (!mLoop.Init(mClient)) {
+        LOG_ERROR(sLogger, ("failed to init http sink", "failed to init curl socket loop"));
+        return false;
+    }
 
     WriteMetrics::GetInstance()->CreateMetricsRecordRef(
         mMetricsRecordRef,
@@ -88,6 +92,12 @@ void HttpSink::Stop() {
     }
 }
 
+bool HttpSink::AddRequest(unique_ptr<HttpSinkRequest>&& request) {
+    Sink<HttpSinkRequest>::AddRequest(std::move(request));
+    mLoop.Wakeup();
+    return true;
+}
+
 void HttpSink::Run() {
     LOG_INFO(sLogger, ("http sink", "started"));
     while (true) {
@@ -114,10 +124,7 @@ void HttpSink::Run() {
         }
         DoRun();
     }
-    auto mc = curl_multi_cleanup(mClient);
-    if (mc != CURLM_OK) {
-        LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
-    }
+    mLoop.Cleanup();
 }
 
 bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
@@ -129,7 +136,7 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
                                    request->mUrl,
                                    request->mQueryString,
                                    request->mHeader,
-                                   request->mBody,
+                                   request->mPayload.str(),
                                    request->mResponse,
                                    headers,
                                    request->mTimeout,
@@ -176,22 +183,15 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
 }
 
 void HttpSink::DoRun() {
-    CURLMcode mc;
     int runningHandlers = 1;
     while (runningHandlers) {
         auto curTime = chrono::system_clock::now();
         SET_GAUGE(mLastRunTime, chrono::duration_cast<chrono::seconds>(curTime.time_since_epoch()).count());
-        if ((mc = curl_multi_perform(mClient, &runningHandlers)) != CURLM_OK) {
-            LOG_ERROR(
-                sLogger,
-                ("failed to call curl_multi_perform", "sleep 100ms and retry")("errMsg", curl_multi_strerror(mc)));
-            this_thread::sleep_for(chrono::milliseconds(100));
-            continue;
-        }
+        // new requests wake up the loop, so the wait time only bounds how often the last run time is updated
+        mLoop.Run(runningHandlers, 1000);
         HandleCompletedRequests(runningHandlers);
 
         unique_ptr<HttpSinkRequest> request;
-        bool hasRequest = false;
         while (mQueue.TryPop(request)) {
             ADD_COUNTER(mInItemsTotal, 1);
             LOG_TRACE(sLogger,
@@ -204,48 +204,8 @@ void HttpSink::DoRun() {
             if (AddRequestToClient(std::move(request))) {
                 ++runningHandlers;
                 ADD_GAUGE(mSendingItemsTotal, 1);
-                hasRequest = true;
-            }
-        }
-        if (hasRequest) {
-            continue;
-        }
-
-        struct timeval timeout {
-            1, 0
-        };
-        long curlTimeout = -1;
-        if ((mc = curl_multi_timeout(mClient, &curlTimeout)) != CURLM_OK) {
-            LOG_WARNING(
-                sLogger,
-                ("failed to call curl_multi_timeout", "use default timeout 1s")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (curlTimeout >= 0) {
-            auto sec = curlTimeout / 1000;
-            // to avoid waiting too long so that adding new request is delayed
-            if (sec <= 1) {
-                timeout.tv_sec = sec;
-                timeout.tv_usec = (curlTimeout % 1000) * 1000;
             }
         }
-
-        int maxfd = -1;
-        fd_set fdread;
-        fd_set fdwrite;
-        fd_set fdexcep;
-        FD_ZERO(&fdread);
-        FD_ZERO(&fdwrite);
-        FD_ZERO(&fdexcep);
-        if ((mc = curl_multi_fdset(mClient, &fdread, &fdwrite, &fdexcep, &maxfd)) != CURLM_OK) {
-            LOG_ERROR(sLogger, ("failed to call curl_multi_fdset", "sleep 100ms")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (maxfd == -1) {
-            // sleep min(timeout, 100ms) according to libcurl
-            int64_t sleepMs = (curlTimeout >= 0 && curlTimeout < 100) ? curlTimeout : 100;
-            this_thread::sleep_for(chrono::milliseconds(sleepMs));
-        } else {
-            select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
-        }
     }
 }
 
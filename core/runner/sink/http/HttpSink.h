@@ -23,6 +23,7 @@
 
 #include "curl/multi.h"
 
+#include "common/http/CurlSocketLoop.h"
 #include "monitor/MetricManager.h"
 #include "runner/sink/Sink.h"
 #include "runner/sink/http/HttpSinkRequest.h"
@@ -38,6 +39,8 @@ public:
 
     bool Init() override;
     void Stop() override;
+    // wake up the sink thread if it is waiting for responses, so that the request is sent immediately
+    bool AddRequest(std::unique_ptr<HttpSinkRequest>&& request) override;
 
 private:
     HttpSink() = default;
@@ -49,6 +52,7 @@ private:
     void HandleCompletedRequests(int& runningHandlers);
 
     CURLM* mClient = nullptr;
+    CurlSocketLoop mLoop;
 
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
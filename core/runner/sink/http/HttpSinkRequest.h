@@ -20,11 +20,14 @@
 
 #include "collection_pipeline/queue/SenderQueueItem.h"
 #include "common/http/HttpRequest.h"
+#include "common/memory/PayloadBuffer.h"
 
 namespace logtail {
 
 struct HttpSinkRequest : public AsynHttpRequest {
     SenderQueueItem* mItem = nullptr;
+    // the body, which is shared with the item instead of being copied to mBody
+    PayloadBuffer mPayload;
 
     HttpSinkRequest(const std::string& method,
                     bool httpsFlag,
@@ -33,7 +36,7 @@ struct HttpSinkRequest : public AsynHttpRequest {
                     const std::string& url,
                     const std::string& query,
                     const std::map<std::string, std::string>& header,
-                    const std::string& body,
+                    const PayloadBuffer& body,
                     SenderQueueItem* item,
                     uint32_t timeout = static_cast<uint32_t>(INT32_FLAG(default_http_request_timeout_sec)),
                     uint32_t maxTryCnt = static_cast<uint32_t>(INT32_FLAG(default_http_request_max_try_cnt)),
@@ -45,14 +48,15 @@ struct HttpSinkRequest : public AsynHttpRequest {
                           url,
                           query,
                           header,
-                          body,
+                          "",
                           HttpResponse(),
                           timeout,
                           maxTryCnt,
                           false,
                           std::nullopt,
                           std::move(socket)),
-          mItem(item) {}
+          mItem(item),
+          mPayload(body) {}
 
     bool IsContextValid() const override { return true; }
     void OnSendDone(HttpResponse& response) override {}
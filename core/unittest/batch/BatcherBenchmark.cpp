@@ -0,0 +1,137 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/batch/Batcher.h"
+#include "common/StringTools.h"
+#include "common/TimeUtil.h"
+#include "logger/Logger.h"
+#include "unittest/plugin/PluginMock.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const size_t kGroupsPerThread = 20000;
+static const size_t kEventsPerGroup = 10;
+
+// N processor threads feeding one flusher, where each thread sends groups of its own sources (e.g. files) or all
+// threads send groups of the same tags.
+class BatcherBenchmark {
+public:
+    BatcherBenchmark(FlusherMock* flusher, size_t threadCnt, size_t shardCnt, bool sharedTags)
+        : mFlusher(flusher), mThreadCnt(threadCnt), mShardCnt(shardCnt), mSharedTags(sharedTags) {}
+
+    void Run();
+
+private:
+    void RunThread(Batcher<>& batch, std::vector<PipelineEventGroup>& groups);
+
+    FlusherMock* mFlusher;
+    size_t mThreadCnt;
+    size_t mShardCnt;
+    bool mSharedTags;
+};
+
+void BatcherBenchmark::RunThread(Batcher<>& batch, std::vector<PipelineEventGroup>& groups) {
+    std::vector<BatchedEventsList> res;
+    for (auto& group : groups) {
+        batch.Add(std::move(group), res);
+        res.clear();
+    }
+}
+
+void BatcherBenchmark::Run() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMaxSizeBytes = 5 * 1024 * 1024;
+    strategy.mMinSizeBytes = 256 * 1024;
+    strategy.mMinCnt = 4000;
+    strategy.mTimeoutSecs = 3;
+    Batcher<> batch;
+    batch.Init(Json::Value(), mFlusher, strategy, false, mShardCnt);
+
+    // groups are prepared beforehand so that only Add is measured
+    std::vector<std::vector<PipelineEventGroup>> groups(mThreadCnt);
+    for (size_t i = 0; i < mThreadCnt; ++i) {
+        groups[i].reserve(kGroupsPerThread);
+        for (size_t j = 0; j < kGroupsPerThread; ++j) {
+            PipelineEventGroup group(std::make_shared<SourceBuffer>());
+            group.SetTag(std::string("log.file.path"),
+                         mSharedTags ? std::string("/var/log/app.log") : "/var/log/app-" + ToString(i) + ".log");
+            for (size_t k = 0; k < kEventsPerGroup; ++k) {
+                auto* event = group.AddLogEvent();
+                event->SetTimestamp(time(nullptr));
+                event->SetContent(std::string("content"), std::string("benchmark log content of batcher"));
+            }
+            groups[i].emplace_back(std::move(group));
+        }
+    }
+
+    uint64_t starttime = GetCurrentTimeInMicroSeconds();
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < mThreadCnt; ++i) {
+        threads.emplace_back(&BatcherBenchmark::RunThread, this, std::ref(batch), std::ref(groups[i]));
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t timeElapsedUs = GetCurrentTimeInMicroSeconds() - starttime;
+    std::vector<BatchedEventsList> res;
+    batch.FlushAll(res);
+
+    double events = static_cast<double>(mThreadCnt * kGroupsPerThread * kEventsPerGroup);
+    printf("threads %-3zu shards %-3zu %-12s costs %lums, %.2fM events/s\n",
+           mThreadCnt,
+           mShardCnt,
+           mSharedTags ? "shared tags" : "own tags",
+           static_cast<unsigned long>(timeElapsedUs / 1000),
+           events / timeElapsedUs);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    using namespace logtail;
+    Logger::Instance().InitGlobalLoggers();
+
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("batcher_benchmark");
+    FlusherMock flusher;
+    flusher.SetContext(ctx);
+    flusher.CreateMetricsRecordRef(FlusherMock::sName, "1");
+    flusher.CommitMetricsRecordRef();
+    flusher.SetPluginID("1");
+
+    for (bool sharedTags : {false, true}) {
+        for (size_t threadCnt : {1, 2, 4, 8}) {
+            for (size_t shardCnt : {1, 8}) {
+                BatcherBenchmark benchmark(&flusher, threadCnt, shardCnt, sharedTags);
+                benchmark.Run();
+            }
+        }
+    }
+    return 0;
+}
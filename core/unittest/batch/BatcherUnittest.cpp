@@ -12,8 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "collection_pipeline/batch/Batcher.h"
 #include "common/JsonUtil.h"
+#include "common/StringTools.h"
 #include "unittest/Unittest.h"
 #include "unittest/plugin/PluginMock.h"
 
@@ -35,6 +38,8 @@ public:
     void TestFlushAllWithoutGroupBatch();
     void TestFlushAllWithGroupBatch();
     void TestMetric();
+    void TestShards();
+    void TestAddConcurrentlyWithShards();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherMock>(); }
@@ -50,7 +55,7 @@ protected:
     void TearDown() override { TimeoutFlushManager::GetInstance()->mTimeoutRecords.clear(); }
 
 private:
-    PipelineEventGroup CreateEventGroup(size_t cnt);
+    PipelineEventGroup CreateEventGroup(size_t cnt, const string& tagValue = "val");
 
     static unique_ptr<FlusherMock> sFlusher;
 
@@ -158,8 +163,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(2U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -175,8 +180,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -198,8 +203,8 @@ void BatcherUnittest::TestAddWithoutGroupBatch() {
     SourceBuffer* buffer3 = group3.GetSourceBuffer().get();
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -239,8 +244,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer1 = group1.GetSourceBuffer().get();
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(2U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(2U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -256,8 +261,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer2 = group2.GetSourceBuffer().get();
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -279,8 +284,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     RangeCheckpoint* eoo3 = group3.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group3), res);
     APSARA_TEST_EQUAL(0U, res.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
 
     // flush by time to group batch, and then group flush by time
     batch.mGroupFlushStrategy->SetTimeoutSecs(0);
@@ -288,8 +293,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer4 = group4.GetSourceBuffer().get();
     RangeCheckpoint* eoo4 = group4.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group4), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -310,8 +315,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     SourceBuffer* buffer5 = group5.GetSourceBuffer().get();
     RangeCheckpoint* eoo5 = group5.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group5), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].size());
     APSARA_TEST_EQUAL(1U, res[0][0].mEvents.size());
@@ -343,8 +348,8 @@ void BatcherUnittest::TestAddWithGroupBatch() {
     PipelineEventGroup group7 = CreateEventGroup(2);
     SourceBuffer* buffer7 = group7.GetSourceBuffer().get();
     batch.Add(std::move(group7), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
@@ -377,8 +382,8 @@ void BatcherUnittest::TestAddWithOversizedGroup() {
 
     PipelineEventGroup group2 = CreateEventGroup(20);
     batch.Add(std::move(group2), res);
-    APSARA_TEST_EQUAL(1U, batch.mEventQueueMap.size());
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap[key].mBatch.mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[0].mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap[key].mBatch.mEvents.size());
     APSARA_TEST_EQUAL(3U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -411,7 +416,7 @@ void BatcherUnittest::TestFlushEventQueueWithoutGroupBatch() {
 
     // key existed
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -440,7 +445,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo1 = group1.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group1), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(0U, res.size());
     APSARA_TEST_EQUAL(1U, TimeoutFlushManager::GetInstance()->mTimeoutRecords.size());
     APSARA_TEST_EQUAL(2U, TimeoutFlushManager::GetInstance()->mTimeoutRecords["test_config"].size());
@@ -460,7 +465,7 @@ void BatcherUnittest::TestFlushEventQueueWithGroupBatch() {
     RangeCheckpoint* eoo2 = group2.GetExactlyOnceCheckpoint().get();
     batch.Add(std::move(group2), tmp);
     batch.FlushQueue(key, res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(2U, res[0].mEvents.size());
     APSARA_TEST_EQUAL(1U, res[0].mTags.mInner.size());
@@ -534,7 +539,7 @@ void BatcherUnittest::TestFlushAllWithoutGroupBatch() {
 
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(1U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -579,7 +584,7 @@ void BatcherUnittest::TestFlushAllWithGroupBatch() {
     batch.mGroupFlushStrategy->SetMinSizeBytes(10);
     vector<BatchedEventsList> res;
     batch.FlushAll(res);
-    APSARA_TEST_EQUAL(0U, batch.mEventQueueMap.size());
+    APSARA_TEST_EQUAL(0U, batch.mShards[0].mEventQueueMap.size());
     APSARA_TEST_EQUAL(2U, res.size());
     APSARA_TEST_EQUAL(1U, res[0].size());
     APSARA_TEST_EQUAL(2U, res[0][0].mEvents.size());
@@ -657,9 +662,97 @@ void BatcherUnittest::TestMetric() {
     }
 }
 
-PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt) {
+void BatcherUnittest::TestShards() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 3;
+    strategy.mMinSizeBytes = 1000;
+    strategy.mTimeoutSecs = 3;
+
+    Batcher<> batch;
+    batch.Init(Json::Value(), sFlusher.get(), strategy, false, 4);
+    APSARA_TEST_EQUAL(4U, batch.mShards.size());
+
+    // each key lives in the shard of its hash, and is flushed by cnt as without shards
+    vector<BatchedEventsList> res;
+    vector<size_t> keys;
+    for (size_t i = 0; i < 8; ++i) {
+        PipelineEventGroup group = CreateEventGroup(2, "val" + ToString(i));
+        keys.push_back(group.GetTagsHash());
+        batch.Add(std::move(group), res);
+    }
+    APSARA_TEST_EQUAL(0U, res.size());
+    for (size_t key : keys) {
+        APSARA_TEST_EQUAL(2U, batch.mShards[key % 4].mEventQueueMap[key].mBatch.mEvents.size());
+    }
+    APSARA_TEST_EQUAL(8U, batch.mEventBatchItemsTotal->GetValue());
+    batch.Add(CreateEventGroup(2, "val0"), res);
+    APSARA_TEST_EQUAL(1U, res.size());
+    APSARA_TEST_EQUAL(3U, res[0][0].mEvents.size());
+    APSARA_TEST_EQUAL(1U, batch.mShards[keys[0] % 4].mEventQueueMap[keys[0]].mBatch.mEvents.size());
+
+    // flush by key
+    BatchedEventsList flushed;
+    batch.FlushQueue(keys[1], flushed);
+    APSARA_TEST_EQUAL(1U, flushed.size());
+    APSARA_TEST_EQUAL(2U, flushed[0].mEvents.size());
+    APSARA_TEST_STREQ("val1", flushed[0].mTags.mInner["key"].data());
+    APSARA_TEST_TRUE(batch.mShards[keys[1] % 4].mEventQueueMap.find(keys[1])
+                     == batch.mShards[keys[1] % 4].mEventQueueMap.end());
+    APSARA_TEST_EQUAL(7U, batch.mEventBatchItemsTotal->GetValue());
+
+    // flush all shards
+    res.clear();
+    batch.FlushAll(res);
+    APSARA_TEST_EQUAL(7U, res.size());
+    for (const auto& shard : batch.mShards) {
+        APSARA_TEST_EQUAL(0U, shard.mEventQueueMap.size());
+    }
+    APSARA_TEST_EQUAL(0U, batch.mEventBatchItemsTotal->GetValue());
+}
+
+void BatcherUnittest::TestAddConcurrentlyWithShards() {
+    DefaultFlushStrategyOptions strategy;
+    strategy.mMinCnt = 10;
+    strategy.mMinSizeBytes = 1000000;
+    strategy.mTimeoutSecs = 3;
+
+    for (bool enableGroupBatch : {false, true}) {
+        Batcher<> batch;
+        batch.Init(Json::Value(), sFlusher.get(), strategy, enableGroupBatch, 8);
+        const size_t threadCnt = 8;
+        const size_t groupCnt = 1000;
+        vector<vector<BatchedEventsList>> results(threadCnt);
+        vector<thread> threads;
+        for (size_t i = 0; i < threadCnt; ++i) {
+            threads.emplace_back([&, i]() {
+                for (size_t j = 0; j < groupCnt; ++j) {
+                    // threads share some of the keys
+                    batch.Add(CreateEventGroup(3, "val" + ToString((i + j) % 16)), results[i]);
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        results.emplace_back();
+        batch.FlushAll(results.back());
+
+        size_t eventCnt = 0;
+        for (const auto& res : results) {
+            for (const auto& list : res) {
+                for (const auto& events : list) {
+                    APSARA_TEST_TRUE(events.mEvents.size() <= strategy.mMinCnt);
+                    eventCnt += events.mEvents.size();
+                }
+            }
+        }
+        APSARA_TEST_EQUAL(threadCnt * groupCnt * 3, eventCnt);
+    }
+}
+
+PipelineEventGroup BatcherUnittest::CreateEventGroup(size_t cnt, const string& tagValue) {
     PipelineEventGroup group(make_shared<SourceBuffer>());
-    group.SetTag(string("key"), string("val"));
+    group.SetTag(string("key"), tagValue);
     StringBuffer b = group.GetSourceBuffer()->CopyString(string("pack_id"));
     group.SetMetadataNoCopy(EventGroupMetaKey::SOURCE_ID, StringView(b.data, b.size));
     group.SetExactlyOnceCheckpoint(RangeCheckpointPtr(new RangeCheckpoint));
@@ -681,6 +774,8 @@ UNIT_TEST_CASE(BatcherUnittest, TestFlushGroupQueue)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithoutGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestFlushAllWithGroupBatch)
 UNIT_TEST_CASE(BatcherUnittest, TestMetric)
+UNIT_TEST_CASE(BatcherUnittest, TestShards)
+UNIT_TEST_CASE(BatcherUnittest, TestAddConcurrentlyWithShards)
 
 } // namespace logtail
 
@@ -0,0 +1,162 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "common/CompiledTimeFormat.h"
+#include "common/TimeUtil.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CompiledTimeFormatUnittest : public ::testing::Test {
+public:
+    void TestCompile();
+    void TestParse();
+    void TestConsistentWithStrptime();
+
+private:
+    // compare the results with those of Strptime
+    void CheckConsistent(const CompiledTimeFormat& compiled,
+                         const string& fmt,
+                         int32_t specifiedYear,
+                         const string& text) {
+        LogtailTime expectedTime = {0, 0};
+        int expectedLength = -1;
+        const char* expected = Strptime(text.c_str(), fmt.c_str(), &expectedTime, expectedLength, specifiedYear);
+        LogtailTime time = {0, 0};
+        int length = -1;
+        const char* res = compiled.Parse(text.c_str(), &time, length);
+        string desc = fmt + " " + text;
+        APSARA_TEST_TRUE_DESC(expected == res, desc);
+        if (expected != nullptr && res != nullptr) {
+            APSARA_TEST_TRUE_DESC(expectedTime.tv_sec == time.tv_sec, desc);
+            APSARA_TEST_TRUE_DESC(expectedTime.tv_nsec == time.tv_nsec, desc);
+            APSARA_TEST_TRUE_DESC(expectedLength == length, desc);
+        }
+    }
+};
+
+void CompiledTimeFormatUnittest::TestCompile() {
+    CompiledTimeFormat compiled;
+    APSARA_TEST_TRUE(compiled.Compile("%Y-%m-%d %H:%M:%S"));
+    APSARA_TEST_TRUE(compiled.IsCompiled());
+    APSARA_TEST_EQUAL(11U, compiled.mSteps.size());
+    APSARA_TEST_TRUE(compiled.Compile("%F %T.%f"));
+    APSARA_TEST_TRUE(compiled.Compile("%d/%b/%Y:%H:%M:%S"));
+    APSARA_TEST_TRUE(compiled.Compile("%c"));
+    APSARA_TEST_TRUE(compiled.Compile("%m-%d %H:%M:%S", 2024));
+
+    // converted by Strptime in other ways
+    for (const string fmt : {"%s", "%f", "%Y-%m-%d %H:%M:%S %z", "%Y-%m-%d %Z", "%C%y", "%G", "%Ey", "%Y %", "%y %D",
+                             "%S.%f %T"}) {
+        APSARA_TEST_FALSE_DESC(compiled.Compile(fmt), fmt);
+        APSARA_TEST_FALSE(compiled.IsCompiled());
+    }
+    // no year
+    APSARA_TEST_FALSE(compiled.Compile("%m-%d %H:%M:%S"));
+    APSARA_TEST_FALSE(compiled.Compile("%m-%d %H:%M:%S", 0));
+}
+
+void CompiledTimeFormatUnittest::TestParse() {
+    CompiledTimeFormat compiled;
+    APSARA_TEST_TRUE(compiled.Compile("%Y-%m-%d %H:%M:%S.%f"));
+    LogtailTime time = {0, 0};
+    int length = -1;
+    const string text = "2024-07-01 08:30:15.123456 rest";
+    const char* res = compiled.Parse(text.c_str(), &time, length);
+    APSARA_TEST_EQUAL(text.c_str() + 26, res);
+    struct tm tm = {};
+    tm.tm_year = 124;
+    tm.tm_mon = 6;
+    tm.tm_mday = 1;
+    tm.tm_hour = 8;
+    tm.tm_min = 30;
+    tm.tm_sec = 15;
+    APSARA_TEST_EQUAL(mktime(&tm), time.tv_sec);
+    APSARA_TEST_EQUAL(123456000L, time.tv_nsec);
+    APSARA_TEST_EQUAL(6, length);
+
+    // the time is left unchanged on failure
+    APSARA_TEST_TRUE(compiled.Parse("2024-07-01 08:30", &time, length) == nullptr);
+    APSARA_TEST_EQUAL(mktime(&tm), time.tv_sec);
+}
+
+void CompiledTimeFormatUnittest::TestConsistentWithStrptime() {
+    struct Format {
+        string mFormat;
+        string mStrftimeFormat;
+        int32_t mSpecifiedYear;
+    };
+    const vector<Format> formats = {
+        {"%Y-%m-%d %H:%M:%S", "%Y-%m-%d %H:%M:%S", -1},
+        {"%Y-%m-%d %H:%M:%S.%f", "%Y-%m-%d %H:%M:%S.123", -1},
+        {"%m-%d %H:%M:%S.%f", "%m-%d %H:%M:%S.000001", 2018},
+        {"%H:%M:%S.%f %Y-%m-%d", "%H:%M:%S.987654321 %Y-%m-%d", -1},
+        {"%Y-%m-%dT%H:%M:%S", "%Y-%m-%dT%H:%M:%S", -1},
+        {"%d/%b/%Y:%H:%M:%S", "%d/%b/%Y:%H:%M:%S", -1},
+        {"%a %b %d %H:%M:%S %Y", "%a %b %d %H:%M:%S %Y", -1},
+        {"%A, %B %e %Y %l:%M:%S %p", "%A, %B %e %Y %l:%M:%S %p", -1},
+        {"%F %T", "%F %T", -1},
+        {"%D %r", "%D %r", -1},
+        {"%y%m%d %k:%M:%S", "%y%m%d %k:%M:%S", -1},
+        {"%j %Y %H%M%S", "%j %Y %H%M%S", -1},
+        {"[%Y-%m-%d %H:%M:%S]", "[%Y-%m-%d %H:%M:%S]", -1},
+    };
+    srand(0);
+    for (const auto& format : formats) {
+        CompiledTimeFormat compiled;
+        APSARA_TEST_TRUE_DESC(compiled.Compile(format.mFormat, format.mSpecifiedYear), format.mFormat);
+        for (int i = 0; i < 2000; ++i) {
+            time_t t = static_cast<time_t>(rand()) * 2 % 2000000000;
+            // logs of the same minute
+            if (i % 4 != 0) {
+                t += rand() % 60;
+            }
+            struct tm tm;
+            localtime_r(&t, &tm);
+            char buf[128];
+            size_t len = strftime(buf, sizeof(buf), format.mStrftimeFormat.c_str(), &tm);
+            string text(buf, len);
+            CheckConsistent(compiled, format.mFormat, format.mSpecifiedYear, text);
+            // some invalid ones
+            if (i % 10 == 0 && !text.empty()) {
+                string broken = text;
+                broken[rand() % broken.size()] = "0a9 :-/"[rand() % 7];
+                CheckConsistent(compiled, format.mFormat, format.mSpecifiedYear, broken);
+                CheckConsistent(compiled, format.mFormat, format.mSpecifiedYear, text.substr(0, rand() % text.size()));
+            }
+        }
+    }
+    // out of range or lowercase fields
+    CompiledTimeFormat compiled;
+    APSARA_TEST_TRUE(compiled.Compile("%d/%b/%Y:%H:%M:%S"));
+    for (const string text : {"31/feb/2024:10:00:00", "00/Jan/2024:10:00:00", "1/Jan/2024:24:00:00",
+                              "1/JANUARY/2024:9:60:61", "01/Jan/2024:23:59:61"}) {
+        CheckConsistent(compiled, "%d/%b/%Y:%H:%M:%S", -1, text);
+    }
+}
+
+UNIT_TEST_CASE(CompiledTimeFormatUnittest, TestCompile)
+UNIT_TEST_CASE(CompiledTimeFormatUnittest, TestParse)
+UNIT_TEST_CASE(CompiledTimeFormatUnittest, TestConsistentWithStrptime)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
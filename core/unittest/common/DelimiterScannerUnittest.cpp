@@ -0,0 +1,106 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/DelimiterScanner.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+
+class DelimiterScannerUnittest : public ::testing::Test {
+public:
+    void TestEmptyInput();
+    void TestBoundaries();
+    void TestImplsConsistent();
+
+private:
+    std::vector<size_t> naiveScan(const std::string& data, char delim) {
+        std::vector<size_t> res;
+        for (size_t i = 0; i < data.size(); ++i) {
+            if (data[i] == delim) {
+                res.push_back(i);
+            }
+        }
+        return res;
+    }
+};
+
+UNIT_TEST_CASE(DelimiterScannerUnittest, TestEmptyInput)
+UNIT_TEST_CASE(DelimiterScannerUnittest, TestBoundaries)
+UNIT_TEST_CASE(DelimiterScannerUnittest, TestImplsConsistent)
+
+void DelimiterScannerUnittest::TestEmptyInput() {
+    std::vector<size_t> positions;
+    FindAllDelimiters(nullptr, 0, '\n', positions);
+    APSARA_TEST_TRUE(positions.empty());
+    FindAllDelimiters("abc", 3, '\n', positions);
+    APSARA_TEST_TRUE(positions.empty());
+}
+
+void DelimiterScannerUnittest::TestBoundaries() {
+    // delimiters at the edges of 16/32/64-byte chunks as well as in the scalar tail
+    for (size_t len : {1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 129, 200}) {
+        std::string data(len, 'a');
+        for (size_t pos : {size_t(0), len / 2, len - 1}) {
+            data[pos] = '\n';
+        }
+        std::vector<size_t> positions;
+        FindAllDelimiters(data.data(), data.size(), '\n', positions);
+        APSARA_TEST_EQUAL(naiveScan(data, '\n'), positions);
+    }
+
+    // all delimiters
+    std::string data(100, '\0');
+    std::vector<size_t> positions;
+    FindAllDelimiters(data.data(), data.size(), '\0', positions);
+    APSARA_TEST_EQUAL(100U, positions.size());
+    APSARA_TEST_EQUAL(naiveScan(data, '\0'), positions);
+
+    // positions are appended rather than overwritten
+    positions.assign(1, 12345);
+    FindAllDelimiters("a\nb", 3, '\n', positions);
+    APSARA_TEST_EQUAL(std::vector<size_t>({12345, 1}), positions);
+}
+
+void DelimiterScannerUnittest::TestImplsConsistent() {
+    std::mt19937 gen(20240101);
+    std::uniform_int_distribution<int> byteDist(0, 255);
+    std::uniform_int_distribution<size_t> lenDist(0, 4096);
+    for (int round = 0; round < 200; ++round) {
+        std::string data(lenDist(gen), '\0');
+        for (auto& c : data) {
+            c = static_cast<char>(byteDist(gen));
+        }
+        for (char delim : {'\n', '\0', static_cast<char>(0xff)}) {
+            std::vector<size_t> expected = naiveScan(data, delim);
+            std::vector<size_t> scalar, sse2, avx2, dispatched;
+            FindAllDelimitersScalar(data.data(), data.size(), delim, scalar);
+            FindAllDelimitersSSE2(data.data(), data.size(), delim, sse2);
+            FindAllDelimitersAVX2(data.data(), data.size(), delim, avx2);
+            FindAllDelimiters(data.data(), data.size(), delim, dispatched);
+            APSARA_TEST_EQUAL(expected, scalar);
+            APSARA_TEST_EQUAL(expected, sse2);
+            APSARA_TEST_EQUAL(expected, avx2);
+            APSARA_TEST_EQUAL(expected, dispatched);
+        }
+    }
+    APSARA_TEST_TRUE(IsDelimiterScannerImplSupported(GetDelimiterScannerImpl()));
+}
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,223 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "common/Crc32c.h"
+#include "common/DiskSegment.h"
+#include "common/RuntimeUtil.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class DiskSegmentUnittest : public ::testing::Test {
+public:
+    void TestCrc32c();
+    void TestAppendAndRead();
+    void TestAppendWhenFull();
+    void TestCorruptedRecord();
+    void TestAck();
+    void TestRecover();
+
+protected:
+    void SetUp() override {
+        mTestRoot = filesystem::path(GetProcessExecutionDir()) / "DiskSegmentUnittestDir";
+        filesystem::create_directories(mTestRoot);
+        mPath = (mTestRoot / "segment").string();
+    }
+
+    void TearDown() override { filesystem::remove_all(mTestRoot); }
+
+    static string ReadFile(const string& path) {
+        ifstream fin(path, ios::binary);
+        return string(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+    }
+
+    static void WriteFile(const string& path, const string& content) {
+        ofstream fout(path, ios::binary | ios::trunc);
+        fout << content;
+    }
+
+    filesystem::path mTestRoot;
+    string mPath;
+};
+
+void DiskSegmentUnittest::TestCrc32c() {
+    APSARA_TEST_EQUAL(0U, Crc32c("", 0));
+    APSARA_TEST_EQUAL(0xE3069283U, Crc32c("123456789", 9));
+    string data(1000, 'a');
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 31);
+    }
+    uint32_t crc = Crc32c(data.data(), 333);
+    APSARA_TEST_EQUAL(Crc32c(data.data(), data.size()), Crc32c(data.data() + 333, data.size() - 333, crc));
+}
+
+void DiskSegmentUnittest::TestAppendAndRead() {
+    {
+        DiskSegmentWriter writer;
+        APSARA_TEST_TRUE(writer.Open(mPath, 1024 * 1024));
+        APSARA_TEST_TRUE(filesystem::exists(DiskSegmentWriter::GetWritingPath(mPath)));
+        APSARA_TEST_FALSE(filesystem::exists(mPath));
+        APSARA_TEST_TRUE(writer.Append({StringView("hello"), StringView(" world")}));
+        APSARA_TEST_TRUE(writer.Append({StringView(string(10000, 'a'))}));
+        size_t offset = writer.GetLastRecordOffset();
+        APSARA_TEST_TRUE(writer.Append({StringView("x")}));
+        // records can be read back before sealed
+        APSARA_TEST_EQUAL(string(10000, 'a'), writer.GetRecord(offset).to_string());
+        APSARA_TEST_EQUAL("x", writer.GetRecord(writer.GetLastRecordOffset()).to_string());
+        APSARA_TEST_TRUE(writer.GetRecord(writer.GetSize()).empty());
+        APSARA_TEST_FALSE(writer.Append({StringView()}));
+        APSARA_TEST_EQUAL(3U, writer.GetRecordCnt());
+        APSARA_TEST_TRUE(writer.Seal());
+        APSARA_TEST_FALSE(writer.IsOpen());
+        APSARA_TEST_FALSE(filesystem::exists(DiskSegmentWriter::GetWritingPath(mPath)));
+        APSARA_TEST_EQUAL(writer.GetSize(), filesystem::file_size(mPath));
+    }
+
+    DiskSegmentReader reader;
+    APSARA_TEST_TRUE(reader.Open(mPath));
+    APSARA_TEST_FALSE(reader.IsTruncated());
+    APSARA_TEST_EQUAL(3U, reader.GetRecordCnt());
+    APSARA_TEST_EQUAL("hello world", reader.GetRecord(0).to_string());
+    APSARA_TEST_EQUAL(string(10000, 'a'), reader.GetRecord(1).to_string());
+    APSARA_TEST_EQUAL("x", reader.GetRecord(2).to_string());
+    APSARA_TEST_FALSE(reader.IsAllAcked());
+}
+
+void DiskSegmentUnittest::TestAppendWhenFull() {
+    DiskSegmentWriter writer;
+    APSARA_TEST_TRUE(writer.Open(mPath, 2 * DiskSegmentWriter::GetRecordSize(100)));
+    APSARA_TEST_TRUE(writer.Append({StringView(string(100, 'a'))}));
+    APSARA_TEST_FALSE(writer.Append({StringView(string(105, 'b'))}));
+    APSARA_TEST_TRUE(writer.Append({StringView(string(97, 'c'))}));
+    APSARA_TEST_FALSE(writer.Append({StringView("d")}));
+    APSARA_TEST_TRUE(writer.Seal());
+
+    DiskSegmentReader reader;
+    APSARA_TEST_TRUE(reader.Open(mPath));
+    APSARA_TEST_EQUAL(2U, reader.GetRecordCnt());
+    APSARA_TEST_EQUAL(string(97, 'c'), reader.GetRecord(1).to_string());
+}
+
+void DiskSegmentUnittest::TestCorruptedRecord() {
+    {
+        DiskSegmentWriter writer;
+        APSARA_TEST_TRUE(writer.Open(mPath, 1024));
+        APSARA_TEST_TRUE(writer.Append({StringView("first")}));
+        APSARA_TEST_TRUE(writer.Append({StringView("second")}));
+        APSARA_TEST_TRUE(writer.Append({StringView("third")}));
+    }
+    // sealed when the writer is destructed
+    string content = ReadFile(mPath);
+    size_t pos = content.find("second");
+    APSARA_TEST_NOT_EQUAL(string::npos, pos);
+    content[pos] = 'S';
+    WriteFile(mPath, content);
+
+    DiskSegmentReader reader;
+    APSARA_TEST_TRUE(reader.Open(mPath));
+    APSARA_TEST_TRUE(reader.IsTruncated());
+    APSARA_TEST_EQUAL(1U, reader.GetRecordCnt());
+    APSARA_TEST_EQUAL("first", reader.GetRecord(0).to_string());
+    reader.Close();
+
+    // not a segment at all
+    WriteFile(mPath, string(100, 'a'));
+    APSARA_TEST_FALSE(reader.Open(mPath));
+}
+
+void DiskSegmentUnittest::TestAck() {
+    {
+        DiskSegmentWriter writer;
+        APSARA_TEST_TRUE(writer.Open(mPath, 1024 * 1024));
+        for (size_t i = 0; i < 20; ++i) {
+            APSARA_TEST_TRUE(writer.Append({StringView(to_string(i))}));
+        }
+    }
+    {
+        DiskSegmentReader reader;
+        APSARA_TEST_TRUE(reader.Open(mPath));
+        APSARA_TEST_TRUE(filesystem::exists(DiskSegmentReader::GetAckPath(mPath)));
+        APSARA_TEST_EQUAL(3U, reader.mAckBitmapSize);
+        reader.Ack(0);
+        reader.Ack(9);
+        reader.Ack(9);
+        APSARA_TEST_EQUAL(2U, reader.mAckedCnt.load());
+    }
+    // the segment itself is never rewritten
+    DiskSegmentReader reader;
+    APSARA_TEST_TRUE(reader.Open(mPath));
+    APSARA_TEST_EQUAL(2U, reader.mAckedCnt.load());
+    for (size_t i = 0; i < reader.GetRecordCnt(); ++i) {
+        APSARA_TEST_EQUAL(i == 0 || i == 9, reader.IsAcked(i));
+        reader.Ack(i);
+    }
+    APSARA_TEST_TRUE(reader.IsAllAcked());
+    reader.Close();
+
+    DiskSegmentReader::Remove(mPath);
+    APSARA_TEST_FALSE(filesystem::exists(mPath));
+    APSARA_TEST_FALSE(filesystem::exists(DiskSegmentReader::GetAckPath(mPath)));
+}
+
+void DiskSegmentUnittest::TestRecover() {
+    const string crashedPath = (mTestRoot / "crashed").string();
+    const string tornPath = (mTestRoot / "torn").string();
+    {
+        DiskSegmentWriter writer;
+        APSARA_TEST_TRUE(writer.Open(mPath, 1024 * 1024));
+        APSARA_TEST_TRUE(writer.Append({StringView("first")}));
+        APSARA_TEST_TRUE(writer.Append({StringView("second")}));
+        // copies of the unsealed segment as if the process crashed now
+        string content = ReadFile(DiskSegmentWriter::GetWritingPath(mPath));
+        APSARA_TEST_EQUAL(64U + 1024 * 1024, content.size());
+        WriteFile(DiskSegmentWriter::GetWritingPath(crashedPath), content);
+        content[content.find("second") + 3] = 'x';
+        WriteFile(DiskSegmentWriter::GetWritingPath(tornPath), content);
+    }
+
+    APSARA_TEST_TRUE(DiskSegmentWriter::Recover(crashedPath));
+    APSARA_TEST_FALSE(filesystem::exists(DiskSegmentWriter::GetWritingPath(crashedPath)));
+    APSARA_TEST_TRUE(filesystem::file_size(crashedPath) < 1024U);
+    DiskSegmentReader reader;
+    APSARA_TEST_TRUE(reader.Open(crashedPath));
+    APSARA_TEST_FALSE(reader.IsTruncated());
+    APSARA_TEST_EQUAL(2U, reader.GetRecordCnt());
+    APSARA_TEST_EQUAL("second", reader.GetRecord(1).to_string());
+
+    APSARA_TEST_TRUE(DiskSegmentWriter::Recover(tornPath));
+    APSARA_TEST_TRUE(reader.Open(tornPath));
+    APSARA_TEST_FALSE(reader.IsTruncated());
+    APSARA_TEST_EQUAL(1U, reader.GetRecordCnt());
+    APSARA_TEST_EQUAL("first", reader.GetRecord(0).to_string());
+
+    // nothing to recover
+    APSARA_TEST_FALSE(DiskSegmentWriter::Recover((mTestRoot / "none").string()));
+}
+
+UNIT_TEST_CASE(DiskSegmentUnittest, TestCrc32c)
+UNIT_TEST_CASE(DiskSegmentUnittest, TestAppendAndRead)
+UNIT_TEST_CASE(DiskSegmentUnittest, TestAppendWhenFull)
+UNIT_TEST_CASE(DiskSegmentUnittest, TestCorruptedRecord)
+UNIT_TEST_CASE(DiskSegmentUnittest, TestAck)
+UNIT_TEST_CASE(DiskSegmentUnittest, TestRecover)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,158 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/OnDemandJsonParser.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class OnDemandJsonParserUnittest : public ::testing::Test {
+public:
+    void TestParse();
+    void TestViewsOfText();
+    void TestUnescape();
+    void TestNestedValues();
+    void TestUnsupported();
+
+private:
+    vector<pair<string, string>> Members() {
+        vector<pair<string, string>> res;
+        mParser.ForEachMember(mSourceBuffer, [&](StringView key, StringView value) {
+            res.emplace_back(key.to_string(), value.to_string());
+        });
+        return res;
+    }
+
+    OnDemandJsonParser mParser;
+    SourceBuffer mSourceBuffer;
+};
+
+void OnDemandJsonParserUnittest::TestParse() {
+    const string text = R"( {"level": "INFO" ,"code":200, "neg":-12,"ok":true,"bad":false, "empty":"", "none":null} )";
+    APSARA_TEST_TRUE(mParser.Parse(text));
+    vector<pair<string, string>> expected = {{"level", "INFO"},
+                                             {"code", "200"},
+                                             {"neg", "-12"},
+                                             {"ok", "true"},
+                                             {"bad", "false"},
+                                             {"empty", ""},
+                                             {"none", ""}};
+    APSARA_TEST_EQUAL(expected, Members());
+
+    APSARA_TEST_TRUE(mParser.Parse("{}"));
+    APSARA_TEST_EQUAL(0U, mParser.GetMemberCount());
+
+    // duplicated keys are kept in order, so that the last one wins when added to the event
+    APSARA_TEST_TRUE(mParser.Parse(R"({"a":"1","a":"2"})"));
+    expected = {{"a", "1"}, {"a", "2"}};
+    APSARA_TEST_EQUAL(expected, Members());
+}
+
+void OnDemandJsonParserUnittest::TestViewsOfText() {
+    const string text = R"({"msg":"long enough to be scanned 16 bytes at a time","obj":{"k":[1,"v"]}})";
+    APSARA_TEST_TRUE(mParser.Parse(text));
+    vector<StringView> views;
+    mParser.ForEachMember(mSourceBuffer, [&](StringView key, StringView value) {
+        views.push_back(key);
+        views.push_back(value);
+    });
+    APSARA_TEST_EQUAL(4U, views.size());
+    for (const auto& view : views) {
+        APSARA_TEST_TRUE(view.data() >= text.data() && view.data() + view.size() <= text.data() + text.size());
+    }
+    APSARA_TEST_EQUAL(R"({"k":[1,"v"]})", views[3].to_string());
+}
+
+void OnDemandJsonParserUnittest::TestUnescape() {
+    const string text = R"({"k\"ey":"a\"b\\c\/d\b\f\n\r\te","u":"Aé中😀","nul":"x\u0000y"})";
+    APSARA_TEST_TRUE(mParser.Parse(text));
+    vector<pair<string, string>> expected = {{"k\"ey", "a\"b\\c/d\b\f\n\r\te"},
+                                             {"u", "A\xC3\xA9\xE4\xB8\xAD\xF0\x9F\x98\x80"},
+                                             {"nul", string("x\0y", 3)}};
+    APSARA_TEST_EQUAL(expected, Members());
+
+    // escapes after the first 16 bytes
+    const string longText = R"({"msg":"0123456789abcdefghij\"quoted\" text"})";
+    APSARA_TEST_TRUE(mParser.Parse(longText));
+    expected = {{"msg", "0123456789abcdefghij\"quoted\" text"}};
+    APSARA_TEST_EQUAL(expected, Members());
+}
+
+void OnDemandJsonParserUnittest::TestNestedValues() {
+    const string text = R"({"a":[],"b":{},"c":[{"d":"e\"\n","f":[true,false,null,0,-1]}],"g":"x"})";
+    APSARA_TEST_TRUE(mParser.Parse(text));
+    vector<pair<string, string>> expected = {
+        {"a", "[]"}, {"b", "{}"}, {"c", R"([{"d":"e\"\n","f":[true,false,null,0,-1]}])"}, {"g", "x"}};
+    APSARA_TEST_EQUAL(expected, Members());
+}
+
+void OnDemandJsonParserUnittest::TestUnsupported() {
+    const vector<string> texts = {
+        // not an object
+        "",
+        "   ",
+        R"(["a"])",
+        R"("a")",
+        // invalid
+        R"({"a":"b")",
+        R"({"a":"b"} x)",
+        R"({"a":"b",})",
+        R"({"a" "b"})",
+        R"({a:"b"})",
+        R"({"a":"b)",
+        "{\"a\":\"b\tc\"}",
+        R"({"a":"\x"})",
+        R"({"a":"\u12"})",
+        R"({"a":tru})",
+        R"({"a":nul})",
+        R"({"a":01})",
+        R"({"a":-})",
+        R"({"a":[1,]})",
+        R"({"a":{"b"}})",
+        R"({"a":{"b":1,}})",
+        // surrogates not in pairs
+        R"({"a":"\ud83d"})",
+        R"({"a":"\ude00"})",
+        R"({"a":"\ud83dA"})",
+        // written differently by rapidjson
+        R"({"a":1.5})",
+        R"({"a":1e3})",
+        R"({"a":-0})",
+        R"({"a":12345678901234567890})",
+        R"({"a":[1, 2]})",
+        R"({"a":{"b" : 1}})",
+        R"({"a":["\/"]})",
+        R"({"a":{"b":"\u0041"}})",
+        R"({"a":[1.0]})",
+    };
+    for (const auto& text : texts) {
+        APSARA_TEST_FALSE_DESC(mParser.Parse(text), text);
+    }
+}
+
+UNIT_TEST_CASE(OnDemandJsonParserUnittest, TestParse)
+UNIT_TEST_CASE(OnDemandJsonParserUnittest, TestViewsOfText)
+UNIT_TEST_CASE(OnDemandJsonParserUnittest, TestUnescape)
+UNIT_TEST_CASE(OnDemandJsonParserUnittest, TestNestedValues)
+UNIT_TEST_CASE(OnDemandJsonParserUnittest, TestUnsupported)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,131 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "boost/regex.hpp"
+
+#include "common/RegexPrefixFilter.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class RegexPrefixFilterUnittest : public ::testing::Test {
+public:
+    void TestLiteralPrefix();
+    void TestShape();
+    void TestNoFilter();
+    void TestConsistentWithRegex();
+
+private:
+    bool MayMatch(const RegexPrefixFilter& filter, const string& text) {
+        return filter.MayMatch(text.data(), text.size());
+    }
+};
+
+UNIT_TEST_CASE(RegexPrefixFilterUnittest, TestLiteralPrefix)
+UNIT_TEST_CASE(RegexPrefixFilterUnittest, TestShape)
+UNIT_TEST_CASE(RegexPrefixFilterUnittest, TestNoFilter)
+UNIT_TEST_CASE(RegexPrefixFilterUnittest, TestConsistentWithRegex)
+
+void RegexPrefixFilterUnittest::TestLiteralPrefix() {
+    RegexPrefixFilter filter(R"(\[ERROR\]\s.*)");
+    APSARA_TEST_EQUAL("[ERROR]", filter.GetLiteralPrefix());
+    APSARA_TEST_EQUAL(8U, filter.GetMinLength());
+    APSARA_TEST_TRUE(MayMatch(filter, "[ERROR] failed"));
+    APSARA_TEST_FALSE(MayMatch(filter, "[ERROR]"));
+    APSARA_TEST_FALSE(MayMatch(filter, "[WARN] failed"));
+
+    // the quantifier applies to the last character only
+    filter = RegexPrefixFilter("^INFO+x");
+    APSARA_TEST_EQUAL("INFO", filter.GetLiteralPrefix());
+    filter = RegexPrefixFilter("INFO?x");
+    APSARA_TEST_EQUAL("INF", filter.GetLiteralPrefix());
+    filter = RegexPrefixFilter(R"(\QERR.\E*)");
+    APSARA_TEST_EQUAL("ERR", filter.GetLiteralPrefix());
+    // groups matched once without alternatives
+    filter = RegexPrefixFilter(R"((?:at)\s(?<class>com)\..*)");
+    APSARA_TEST_EQUAL("at", filter.GetLiteralPrefix());
+    APSARA_TEST_EQUAL(7U, filter.GetMinLength());
+    APSARA_TEST_TRUE(MayMatch(filter, "at com.example"));
+    APSARA_TEST_FALSE(MayMatch(filter, "at org.example"));
+}
+
+void RegexPrefixFilterUnittest::TestShape() {
+    RegexPrefixFilter filter(R"(\d{4}-\d{2}-\d{2}\s\d+:.*)");
+    APSARA_TEST_TRUE(filter.GetLiteralPrefix().empty());
+    APSARA_TEST_EQUAL(12U, filter.GetMinLength());
+    APSARA_TEST_TRUE(MayMatch(filter, "2024-01-02 10:11:12 INFO"));
+    APSARA_TEST_FALSE(MayMatch(filter, "\tat com.example.Class.method(Class.java:10)"));
+    APSARA_TEST_FALSE(MayMatch(filter, "2024-1-02 10:11:12 INFO"));
+    APSARA_TEST_FALSE(MayMatch(filter, "2024-01-02"));
+
+    filter = RegexPrefixFilter(R"([^]\s][[:upper:]_]\W.)");
+    APSARA_TEST_EQUAL(4U, filter.GetMinLength());
+    APSARA_TEST_TRUE(MayMatch(filter, "aB-c"));
+    APSARA_TEST_TRUE(MayMatch(filter, "x_ \n"));
+    APSARA_TEST_FALSE(MayMatch(filter, "]B-c"));
+    APSARA_TEST_FALSE(MayMatch(filter, "ab-c"));
+    APSARA_TEST_FALSE(MayMatch(filter, "aB1c"));
+    // bytes not in ascii are always accepted by classes
+    APSARA_TEST_TRUE(MayMatch(filter, "\xE4\xB8\xAD\xE6"));
+}
+
+void RegexPrefixFilterUnittest::TestNoFilter() {
+    for (const string& regex : {"INFO|WARN", ".*ERROR", "(?i)error", "(INFO|WARN) .*", "(ab)?c", R"(\bword)", "\\x41",
+                                "[[=a=]]b"}) {
+        RegexPrefixFilter filter(regex);
+        APSARA_TEST_TRUE_DESC(filter.Empty(), regex);
+        APSARA_TEST_TRUE(MayMatch(filter, ""));
+    }
+}
+
+void RegexPrefixFilterUnittest::TestConsistentWithRegex() {
+    const vector<string> regexes = {R"(\d{4}-\d{2}-\d{2}.*)",
+                                    R"(\[\d+-\d+-\w+)",
+                                    R"(^\s*\d)",
+                                    "[A-Z]{4}",
+                                    R"((?:\d{2}):(\d\d)x)",
+                                    R"(\QE.\E+x)",
+                                    R"([^]a-c]\w{2,}z)",
+                                    R"(\S+\s\d)",
+                                    R"([[:digit:]][[:alpha:]].)",
+                                    R"(\t[a\-z])",
+                                    "ab*c"};
+    const string alphabet = "0123456789-:/[] \tazAZE._x\xE9\n";
+    mt19937 rng(0);
+    for (const auto& regex : regexes) {
+        RegexPrefixFilter filter(regex);
+        boost::regex reg(regex);
+        for (int i = 0; i < 10000; ++i) {
+            string text = i % 2 == 0 ? "2024-01-02 " : "";
+            for (size_t len = rng() % 12; len > 0; --len) {
+                text += alphabet[rng() % alphabet.size()];
+            }
+            const char* data = text.data();
+            boost::match_results<const char*> what;
+            if (boost::regex_search(data, data + text.size(), what, reg, boost::match_continuous)) {
+                APSARA_TEST_TRUE_DESC(filter.MayMatch(data, text.size()), regex + " " + text);
+            }
+        }
+    }
+}
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
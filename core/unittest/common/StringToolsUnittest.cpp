@@ -206,6 +206,33 @@ TEST_F(StringToolsUnittest, TestBoostRegexSearch) {
     }
 }
 
+TEST_F(StringToolsUnittest, TestTranslateBoostRegexToRe2) {
+    std::string re2Regex;
+    APSARA_TEST_TRUE(TranslateBoostRegexToRe2(R"(^(\w+)\s+(\S+) .*$)", re2Regex));
+    APSARA_TEST_EQUAL(std::string(R"(^(\w+)[[:space:]]+([^[:space:]]+) .*$)"), re2Regex);
+    APSARA_TEST_TRUE(TranslateBoostRegexToRe2(R"([^]\s]+\Q\s^$\E)", re2Regex));
+    APSARA_TEST_EQUAL(std::string(R"([^][:space:]]+\Q\s^$\E)"), re2Regex);
+    // accepted by re2 with a different meaning
+    APSARA_TEST_FALSE(TranslateBoostRegexToRe2(R"(\<word\>)", re2Regex));
+    APSARA_TEST_FALSE(TranslateBoostRegexToRe2(R"([\S]+)", re2Regex));
+    APSARA_TEST_FALSE(TranslateBoostRegexToRe2("a$\nb", re2Regex));
+}
+
+TEST_F(StringToolsUnittest, TestExtractRegexRequiredLiteral) {
+    APSARA_TEST_EQUAL("abc", ExtractRegexRequiredLiteral("abc"));
+    APSARA_TEST_EQUAL("ERROR", ExtractRegexRequiredLiteral(".*ERROR.*"));
+    APSARA_TEST_EQUAL(" timeout.", ExtractRegexRequiredLiteral(R"(ERROR: (.*) timeout\.)"));
+    APSARA_TEST_EQUAL("baz", ExtractRegexRequiredLiteral("(foo|bar)baz+q"));
+    APSARA_TEST_EQUAL("cd", ExtractRegexRequiredLiteral("ab*cd"));
+    APSARA_TEST_EQUAL("yz", ExtractRegexRequiredLiteral("x{23}yz"));
+    APSARA_TEST_EQUAL("defg", ExtractRegexRequiredLiteral("[abc]defg[[:alpha:]]"));
+    APSARA_TEST_EQUAL("timeout", ExtractRegexRequiredLiteral(R"(.*\<timeout.*)"));
+    // no literal is required
+    APSARA_TEST_EQUAL("", ExtractRegexRequiredLiteral("ERROR|WARN"));
+    APSARA_TEST_EQUAL("", ExtractRegexRequiredLiteral("(?i)error"));
+    APSARA_TEST_EQUAL("", ExtractRegexRequiredLiteral(R"(\x41+)"));
+}
+
 TEST_F(StringToolsUnittest, TestNormalizeTopicRegFormat) {
     { // Perl flavor
         std::string topicFormat(R"(/stdlog/(?<container_name>.*?)/(?<log_name>.*?))");
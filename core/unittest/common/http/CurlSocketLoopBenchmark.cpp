@@ -0,0 +1,142 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <sys/resource.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+#include "curl/curl.h"
+
+#include "common/http/CurlSocketLoop.h"
+#include "unittest/common/http/LocalHttpServer.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const std::chrono::seconds kDuration(5);
+static const std::string kBody(1024, 'x');
+
+static size_t DiscardResponse(char* ptr, size_t size, size_t nmemb, void* userdata) {
+    return size * nmemb;
+}
+
+static double GetThreadCpuSeconds() {
+    rusage usage{};
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Keep inFlight POST requests in flight against a local server for kDuration, and report the requests per second and
+// the cpu usage of the thread driving curl, which is what HttpSink does.
+static void Test(const LocalHttpServer& server, int inFlight) {
+    rlimit limit{};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    // each request holds a connection, and the server holds the other end
+    rlim_t required = static_cast<rlim_t>(inFlight) * 2 + 256;
+    if (limit.rlim_cur < required) {
+        limit.rlim_cur = std::min(required, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+        if (limit.rlim_cur < required) {
+            printf("%d in flight: skipped, open files limit %lu is less than %lu\n",
+                   inFlight,
+                   static_cast<unsigned long>(limit.rlim_cur),
+                   static_cast<unsigned long>(required));
+            return;
+        }
+    }
+
+    CURLM* client = curl_multi_init();
+    CurlSocketLoop loop;
+    if (!loop.Init(client)) {
+        printf("%d in flight: failed to init loop\n", inFlight);
+        return;
+    }
+    std::string url = "http://127.0.0.1:" + std::to_string(server.GetPort()) + "/logstores/test/shards/lb";
+    for (int i = 0; i < inFlight; ++i) {
+        CURL* curl = curl_easy_init();
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, kBody.data());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(kBody.size()));
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, DiscardResponse);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 30L);
+        curl_multi_add_handle(client, curl);
+    }
+
+    size_t succeededCnt = 0, failedCnt = 0;
+    int runningHandlers = inFlight;
+    double startCpu = GetThreadCpuSeconds();
+    auto start = std::chrono::steady_clock::now();
+    auto end = start + kDuration;
+    while (runningHandlers > 0) {
+        loop.Run(runningHandlers, 1000);
+        bool stopping = std::chrono::steady_clock::now() >= end;
+        int msgsLeft = 0;
+        CURLMsg* msg = nullptr;
+        while ((msg = curl_multi_info_read(client, &msgsLeft)) != nullptr) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            CURL* curl = msg->easy_handle;
+            if (msg->data.result == CURLE_OK) {
+                ++succeededCnt;
+            } else {
+                ++failedCnt;
+            }
+            curl_multi_remove_handle(client, curl);
+            if (stopping) {
+                curl_easy_cleanup(curl);
+            } else {
+                // reuse the easy handle, so that the connection is kept alive, as sls sends do
+                curl_multi_add_handle(client, curl);
+                ++runningHandlers;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double cpuSeconds = GetThreadCpuSeconds() - startCpu;
+    printf("%d in flight: %.0f requests/s, %zu failed, client thread cpu %.1f%%, %.2fus cpu per request\n",
+           inFlight,
+           succeededCnt / seconds,
+           failedCnt,
+           cpuSeconds / seconds * 100,
+           succeededCnt == 0 ? 0.0 : cpuSeconds * 1e6 / succeededCnt);
+    loop.Cleanup();
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    curl_global_init(CURL_GLOBAL_ALL);
+    logtail::LocalHttpServer server;
+    if (!server.Start(65535)) {
+        printf("failed to start local http server\n");
+        return 1;
+    }
+    logtail::Test(server, 1000);
+    logtail::Test(server, 10000);
+    server.Stop();
+    curl_global_cleanup();
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "common/http/CurlSocketLoop.h"
+#include "unittest/Unittest.h"
+#include "unittest/common/http/LocalHttpServer.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CurlSocketLoopUnittest : public ::testing::Test {
+public:
+    void TestRun();
+    void TestWakeup();
+
+protected:
+    void SetUp() override {
+        APSARA_TEST_TRUE_FATAL(mServer.Start());
+        mClient = curl_multi_init();
+        APSARA_TEST_TRUE_FATAL(mLoop.Init(mClient));
+    }
+
+    void TearDown() override {
+        mLoop.Cleanup();
+        mServer.Stop();
+    }
+
+private:
+    static size_t DiscardResponse(char* ptr, size_t size, size_t nmemb, void* userdata) { return size * nmemb; }
+
+    LocalHttpServer mServer;
+    CURLM* mClient = nullptr;
+    CurlSocketLoop mLoop;
+};
+
+void CurlSocketLoopUnittest::TestRun() {
+    const int kRequestCnt = 200;
+    string url = "http://127.0.0.1:" + to_string(mServer.GetPort()) + "/";
+    for (int i = 0; i < kRequestCnt; ++i) {
+        CURL* curl = curl_easy_init();
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, DiscardResponse);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10L);
+        curl_multi_add_handle(mClient, curl);
+    }
+
+    int runningHandlers = kRequestCnt;
+    int succeededCnt = 0;
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+    while (runningHandlers > 0 && chrono::steady_clock::now() < deadline) {
+        mLoop.Run(runningHandlers, 1000);
+        int msgsLeft = 0;
+        CURLMsg* msg = nullptr;
+        while ((msg = curl_multi_info_read(mClient, &msgsLeft)) != nullptr) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            long statusCode = 0;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &statusCode);
+            if (msg->data.result == CURLE_OK && statusCode == 200) {
+                ++succeededCnt;
+            }
+            CURL* curl = msg->easy_handle;
+            curl_multi_remove_handle(mClient, curl);
+            curl_easy_cleanup(curl);
+        }
+    }
+    APSARA_TEST_EQUAL(0, runningHandlers);
+    APSARA_TEST_EQUAL(kRequestCnt, succeededCnt);
+    APSARA_TEST_EQUAL(static_cast<size_t>(kRequestCnt), mServer.GetRequestCnt());
+}
+
+void CurlSocketLoopUnittest::TestWakeup() {
+    int runningHandlers = 0;
+    thread t([this]() {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        mLoop.Wakeup();
+    });
+    auto start = chrono::steady_clock::now();
+    mLoop.Run(runningHandlers, 5000);
+    APSARA_TEST_LT(chrono::steady_clock::now() - start, chrono::seconds(1));
+    t.join();
+
+    // wakeups are coalesced until the next run
+    mLoop.Wakeup();
+    mLoop.Wakeup();
+    mLoop.Run(runningHandlers, 5000);
+    start = chrono::steady_clock::now();
+    mLoop.Run(runningHandlers, 100);
+    APSARA_TEST_GE(chrono::steady_clock::now() - start, chrono::milliseconds(90));
+
+    // wakeups racing with the run are never lost
+    atomic_bool stop = false;
+    thread waker([this, &stop]() {
+        while (!stop) {
+            mLoop.Wakeup();
+        }
+    });
+    auto deadline = chrono::steady_clock::now() + chrono::milliseconds(200);
+    while (chrono::steady_clock::now() < deadline) {
+        mLoop.Run(runningHandlers, 1000);
+    }
+    stop = true;
+    waker.join();
+    mLoop.Run(runningHandlers, 0);
+    thread t2([this]() {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        mLoop.Wakeup();
+    });
+    start = chrono::steady_clock::now();
+    mLoop.Run(runningHandlers, 5000);
+    APSARA_TEST_LT(chrono::steady_clock::now() - start, chrono::seconds(1));
+    t2.join();
+}
+
+UNIT_TEST_CASE(CurlSocketLoopUnittest, TestRun)
+UNIT_TEST_CASE(CurlSocketLoopUnittest, TestWakeup)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,147 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace logtail {
+
+// A stand-in for http servers, which answers every request on 127.0.0.1 with 200 and keeps connections alive.
+// Requests are assumed to have no body, or a body with Content-Length.
+class LocalHttpServer {
+public:
+    ~LocalHttpServer() { Stop(); }
+
+    bool Start(int backlog = 4096) {
+        mListenFd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (mListenFd < 0) {
+            return false;
+        }
+        int opt = 1;
+        setsockopt(mListenFd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        socklen_t len = sizeof(addr);
+        if (bind(mListenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(mListenFd, backlog) != 0
+            || getsockname(mListenFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0) {
+            close(mListenFd);
+            return false;
+        }
+        mPort = ntohs(addr.sin_port);
+        mEpollFd = epoll_create1(0);
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = mListenFd;
+        epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mListenFd, &ev);
+        mRunning = true;
+        mThread = std::thread(&LocalHttpServer::Run, this);
+        return true;
+    }
+
+    void Stop() {
+        if (!mRunning.exchange(false)) {
+            return;
+        }
+        mThread.join();
+        for (auto& item : mBuffers) {
+            close(item.first);
+        }
+        mBuffers.clear();
+        close(mListenFd);
+        close(mEpollFd);
+    }
+
+    int GetPort() const { return mPort; }
+    size_t GetRequestCnt() const { return mRequestCnt; }
+
+private:
+    void Run() {
+        static const std::string kResponse = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+        epoll_event events[256];
+        char buf[16 * 1024];
+        while (mRunning) {
+            int n = epoll_wait(mEpollFd, events, 256, 100);
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == mListenFd) {
+                    int conn = 0;
+                    while ((conn = accept4(mListenFd, nullptr, nullptr, SOCK_NONBLOCK)) >= 0) {
+                        epoll_event ev{};
+                        ev.events = EPOLLIN;
+                        ev.data.fd = conn;
+                        epoll_ctl(mEpollFd, EPOLL_CTL_ADD, conn, &ev);
+                        mBuffers[conn];
+                    }
+                    continue;
+                }
+                ssize_t size = read(fd, buf, sizeof(buf));
+                if (size <= 0) {
+                    epoll_ctl(mEpollFd, EPOLL_CTL_DEL, fd, nullptr);
+                    close(fd);
+                    mBuffers.erase(fd);
+                    continue;
+                }
+                auto& pending = mBuffers[fd];
+                pending.append(buf, size);
+                size_t pos = 0;
+                while (true) {
+                    size_t headerEnd = pending.find("\r\n\r\n", pos);
+                    if (headerEnd == std::string::npos) {
+                        break;
+                    }
+                    size_t bodySize = 0;
+                    size_t cl = pending.find("Content-Length: ", pos);
+                    if (cl != std::string::npos && cl < headerEnd) {
+                        bodySize = std::stoul(pending.substr(cl + 16, headerEnd - cl - 16));
+                    }
+                    if (pending.size() < headerEnd + 4 + bodySize) {
+                        break;
+                    }
+                    pos = headerEnd + 4 + bodySize;
+                    // the response is small enough to be written at once
+                    if (write(fd, kResponse.data(), kResponse.size()) < 0) {
+                        break;
+                    }
+                    ++mRequestCnt;
+                }
+                pending.erase(0, pos);
+            }
+        }
+    }
+
+    int mListenFd = -1;
+    int mEpollFd = -1;
+    int mPort = 0;
+    std::atomic_bool mRunning = false;
+    std::atomic_size_t mRequestCnt = 0;
+    std::unordered_map<int, std::string> mBuffers;
+    std::thread mThread;
+};
+
+} // namespace logtail
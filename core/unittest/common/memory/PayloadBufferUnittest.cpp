@@ -0,0 +1,144 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <string>
+
+#include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/Flags.h"
+#include "common/memory/PayloadBuffer.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(payload_buffer_pool_max_cached_size_mb);
+
+using namespace std;
+
+namespace logtail {
+
+class PayloadBufferUnittest : public ::testing::Test {
+public:
+    void TestShare();
+    void TestAcquireAndRelease();
+    void TestSizeClass();
+    void TestCachedSizeLimit();
+
+protected:
+    void SetUp() override {
+        auto pool = PayloadBufferPool::GetInstance();
+        for (auto& freeList : pool->mFreeLists) {
+            freeList.clear();
+        }
+        pool->mCachedSizeBytes = 0;
+        mHits = pool->mHitsTotal->GetValue();
+        mMisses = pool->mMissesTotal->GetValue();
+    }
+
+    void TearDown() override { INT32_FLAG(payload_buffer_pool_max_cached_size_mb) = 64; }
+
+    uint64_t GetHits() const { return PayloadBufferPool::GetInstance()->mHitsTotal->GetValue() - mHits; }
+    uint64_t GetMisses() const { return PayloadBufferPool::GetInstance()->mMissesTotal->GetValue() - mMisses; }
+
+private:
+    uint64_t mHits = 0;
+    uint64_t mMisses = 0;
+};
+
+void PayloadBufferUnittest::TestShare() {
+    PayloadBuffer empty;
+    APSARA_TEST_TRUE(empty.empty());
+    APSARA_TEST_EQUAL("", empty.str());
+
+    string data(10000, 'a');
+    const char* ptr = data.data();
+    PayloadBuffer buffer(std::move(data));
+    APSARA_TEST_EQUAL(10000U, buffer.size());
+    APSARA_TEST_EQUAL(ptr, buffer.data());
+
+    PayloadBuffer copy = buffer;
+    APSARA_TEST_EQUAL(ptr, copy.data());
+
+    // clones of sender queue items refer to the same payload
+    SenderQueueItem item(string(10000, 'b'), 10000, nullptr, 0);
+    unique_ptr<SenderQueueItem> clone(item.Clone());
+    APSARA_TEST_EQUAL(item.mData.data(), clone->mData.data());
+    APSARA_TEST_EQUAL(string(10000, 'b'), clone->mData.str());
+}
+
+void PayloadBufferUnittest::TestAcquireAndRelease() {
+    auto pool = PayloadBufferPool::GetInstance();
+    string data = pool->Acquire(5000);
+    APSARA_TEST_TRUE(data.empty());
+    APSARA_TEST_TRUE(data.capacity() >= 8192U);
+    APSARA_TEST_EQUAL(1U, GetMisses());
+
+    data.assign(6000, 'a');
+    const char* ptr = data.data();
+    {
+        PayloadBuffer buffer(std::move(data));
+        PayloadBuffer copy = buffer;
+        APSARA_TEST_EQUAL(0U, pool->mCachedSizeBytes);
+    }
+    // released when the last copy is destructed
+    APSARA_TEST_TRUE(pool->mCachedSizeBytes >= 8192U);
+
+    data = pool->Acquire(7000);
+    APSARA_TEST_TRUE(data.empty());
+    APSARA_TEST_EQUAL(ptr, data.data());
+    APSARA_TEST_EQUAL(1U, GetHits());
+    APSARA_TEST_EQUAL(0U, pool->mCachedSizeBytes);
+}
+
+void PayloadBufferUnittest::TestSizeClass() {
+    auto pool = PayloadBufferPool::GetInstance();
+    {
+        string data = pool->Acquire(20000);
+        data.assign(20000, 'a');
+        PayloadBuffer buffer(std::move(data));
+    }
+    // a smaller request is served by a buffer of its own class only
+    string data = pool->Acquire(5000);
+    APSARA_TEST_EQUAL(0U, GetHits());
+    APSARA_TEST_EQUAL(2U, GetMisses());
+    data = pool->Acquire(30000);
+    APSARA_TEST_EQUAL(1U, GetHits());
+
+    // too small or too large to be cached
+    { PayloadBuffer buffer(string(100, 'a')); }
+    { PayloadBuffer buffer(string(64 * 1024 * 1024, 'a')); }
+    APSARA_TEST_EQUAL(0U, pool->mCachedSizeBytes);
+    data = pool->Acquire(64 * 1024 * 1024);
+    APSARA_TEST_TRUE(data.capacity() >= 64U * 1024 * 1024);
+    APSARA_TEST_EQUAL(3U, GetMisses());
+}
+
+void PayloadBufferUnittest::TestCachedSizeLimit() {
+    auto pool = PayloadBufferPool::GetInstance();
+    INT32_FLAG(payload_buffer_pool_max_cached_size_mb) = 1;
+    {
+        PayloadBuffer buffer1(string(600 * 1024, 'a'));
+        PayloadBuffer buffer2(string(600 * 1024, 'b'));
+    }
+    APSARA_TEST_TRUE(pool->mCachedSizeBytes >= 600U * 1024);
+    APSARA_TEST_TRUE(pool->mCachedSizeBytes <= 1024U * 1024);
+    APSARA_TEST_EQUAL(pool->mCachedSizeBytes, static_cast<size_t>(pool->mCachedSizeBytesGauge->GetValue()));
+}
+
+UNIT_TEST_CASE(PayloadBufferUnittest, TestShare)
+UNIT_TEST_CASE(PayloadBufferUnittest, TestAcquireAndRelease)
+UNIT_TEST_CASE(PayloadBufferUnittest, TestSizeClass)
+UNIT_TEST_CASE(PayloadBufferUnittest, TestCachedSizeLimit)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
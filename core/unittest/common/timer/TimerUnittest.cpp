@@ -33,6 +33,7 @@ struct TimerEventMock : public TimerEvent {
 class TimerUnittest : public ::testing::Test {
 public:
     void TestPushEvent();
+    void TestCancelEvent();
     void TestPeriodicEvent();
 
 private:
@@ -47,16 +48,43 @@ void TimerUnittest::TestPushEvent() {
     timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(1)));
     timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(3)));
 
-    APSARA_TEST_EQUAL(3U, timer.mQueue.size());
-    APSARA_TEST_EQUAL(now + chrono::seconds(1), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(3), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
+    APSARA_TEST_EQUAL(3U, timer.mWheel.Size());
+    vector<unique_ptr<TimerEvent>> events;
+    auto collect = [&events](TimerId, unique_ptr<TimerEvent>&& e) { events.emplace_back(std::move(e)); };
+    timer.mWheel.Advance(timer.ToTick(now + chrono::seconds(1), true) - 1, collect);
+    APSARA_TEST_TRUE(events.empty());
+    timer.mWheel.Advance(timer.ToTick(now + chrono::seconds(3), true), collect);
+    APSARA_TEST_EQUAL(3U, events.size());
+    APSARA_TEST_EQUAL(now + chrono::seconds(1), events[0]->GetExecTime());
+    APSARA_TEST_EQUAL(now + chrono::seconds(2), events[1]->GetExecTime());
+    APSARA_TEST_EQUAL(now + chrono::seconds(3), events[2]->GetExecTime());
+    APSARA_TEST_EQUAL(0U, timer.mWheel.Size());
+}
+
+void TimerUnittest::TestCancelEvent() {
+    auto now = chrono::steady_clock::now();
+    Timer timer;
+    auto id1 = timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(1)));
+    auto id2 = timer.PushEvent(make_unique<TimerEventMock>(now + chrono::hours(24)));
+    APSARA_TEST_EQUAL(2U, timer.mWheel.Size());
+
+    APSARA_TEST_TRUE(timer.CancelEvent(id2));
+    APSARA_TEST_FALSE(timer.CancelEvent(id2));
+    APSARA_TEST_EQUAL(1U, timer.mWheel.Size());
+
+    vector<unique_ptr<TimerEvent>> events;
+    timer.mWheel.Advance(timer.ToTick(now + chrono::hours(48), true),
+                         [&events](TimerId, unique_ptr<TimerEvent>&& e) { events.emplace_back(std::move(e)); });
+    APSARA_TEST_EQUAL(1U, events.size());
+    APSARA_TEST_EQUAL(now + chrono::seconds(1), events[0]->GetExecTime());
+    // the id of an executed event is no longer valid, even if its node is reused
+    timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(1)));
+    APSARA_TEST_FALSE(timer.CancelEvent(id1));
+    APSARA_TEST_EQUAL(1U, timer.mWheel.Size());
 }
 
 UNIT_TEST_CASE(TimerUnittest, TestPushEvent)
+UNIT_TEST_CASE(TimerUnittest, TestCancelEvent)
 
 
 } // namespace logtail
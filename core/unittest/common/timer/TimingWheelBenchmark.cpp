@@ -0,0 +1,147 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+#include "common/timer/TimingWheel.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+static const size_t kTimerCnt = 100000;
+// 1 tick is 1 ms as in Timer, and the intervals are those of prometheus scrapes
+static const uint64_t kMinIntervalTicks = 1000;
+static const uint64_t kMaxIntervalTicks = 30000;
+static const uint64_t kDurationTicks = 60000;
+
+// the priority queue of Timer before, where cancelled events stay in the queue until their exec time
+struct QueueEntry {
+    uint64_t mExpireTick;
+    uint64_t mInterval;
+    bool operator>(const QueueEntry& rhs) const { return mExpireTick > rhs.mExpireTick; }
+};
+using TimerQueue = priority_queue<QueueEntry, vector<QueueEntry>, greater<QueueEntry>>;
+
+class TimingWheelBenchmark : public testing::Test {
+public:
+    void TestScheduleAndCancel();
+    void TestPeriodicTimers();
+
+protected:
+    void SetUp() override {
+        mt19937_64 gen(20250101);
+        uniform_int_distribution<uint64_t> dist(kMinIntervalTicks, kMaxIntervalTicks);
+        mIntervals.resize(kTimerCnt);
+        for (auto& interval : mIntervals) {
+            interval = dist(gen);
+        }
+    }
+
+    static double ElapsedMs(chrono::steady_clock::time_point start) {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+
+    vector<uint64_t> mIntervals;
+};
+
+/*
+100000 timers, wheel schedule: 4.38446 ms, cancel: 1.53334 ms
+100000 timers, queue push: 3.76565 ms, pop: 14.9792 ms
+*/
+void TimingWheelBenchmark::TestScheduleAndCancel() {
+    {
+        TimingWheel<uint64_t> wheel;
+        vector<TimerId> ids(kTimerCnt);
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < kTimerCnt; ++i) {
+            ids[i] = wheel.Schedule(mIntervals[i], uint64_t(mIntervals[i]));
+        }
+        double scheduleMs = ElapsedMs(start);
+        start = chrono::steady_clock::now();
+        for (auto id : ids) {
+            wheel.Cancel(id);
+        }
+        double cancelMs = ElapsedMs(start);
+        APSARA_TEST_TRUE(wheel.Empty());
+        cout << kTimerCnt << " timers, wheel schedule: " << scheduleMs << " ms, cancel: " << cancelMs << " ms" << endl;
+    }
+    {
+        TimerQueue queue;
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < kTimerCnt; ++i) {
+            queue.push({mIntervals[i], mIntervals[i]});
+        }
+        double pushMs = ElapsedMs(start);
+        start = chrono::steady_clock::now();
+        while (!queue.empty()) {
+            queue.pop();
+        }
+        double popMs = ElapsedMs(start);
+        cout << kTimerCnt << " timers, queue push: " << pushMs << " ms, pop: " << popMs << " ms" << endl;
+    }
+}
+
+/*
+100000 periodic timers in 60000 ticks, wheel: 37.007 ms, 656067 fired
+100000 periodic timers in 60000 ticks, queue: 115.732 ms, 656067 fired
+*/
+void TimingWheelBenchmark::TestPeriodicTimers() {
+    {
+        TimingWheel<uint64_t> wheel;
+        for (size_t i = 0; i < kTimerCnt; ++i) {
+            wheel.Schedule(mIntervals[i], uint64_t(mIntervals[i]));
+        }
+        size_t fired = 0;
+        auto start = chrono::steady_clock::now();
+        for (uint64_t tick = 0; tick <= kDurationTicks; ++tick) {
+            wheel.Advance(tick, [&](TimerId, uint64_t&& interval) {
+                ++fired;
+                wheel.Schedule(tick + interval, std::move(interval));
+            });
+        }
+        cout << kTimerCnt << " periodic timers in " << kDurationTicks << " ticks, wheel: " << ElapsedMs(start)
+             << " ms, " << fired << " fired" << endl;
+    }
+    {
+        TimerQueue queue;
+        for (size_t i = 0; i < kTimerCnt; ++i) {
+            queue.push({mIntervals[i], mIntervals[i]});
+        }
+        size_t fired = 0;
+        auto start = chrono::steady_clock::now();
+        for (uint64_t tick = 0; tick <= kDurationTicks; ++tick) {
+            while (!queue.empty() && queue.top().mExpireTick <= tick) {
+                auto entry = queue.top();
+                queue.pop();
+                ++fired;
+                queue.push({tick + entry.mInterval, entry.mInterval});
+            }
+        }
+        cout << kTimerCnt << " periodic timers in " << kDurationTicks << " ticks, queue: " << ElapsedMs(start)
+             << " ms, " << fired << " fired" << endl;
+    }
+}
+
+UNIT_TEST_CASE(TimingWheelBenchmark, TestScheduleAndCancel)
+UNIT_TEST_CASE(TimingWheelBenchmark, TestPeriodicTimers)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
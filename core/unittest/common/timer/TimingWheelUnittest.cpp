@@ -0,0 +1,188 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+#include <random>
+#include <vector>
+
+#include "common/timer/TimingWheel.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class TimingWheelUnittest : public ::testing::Test {
+public:
+    void TestAdvance();
+    void TestCascade();
+    void TestCancel();
+    void TestScheduleExpired();
+    void TestGetNextCheckTick();
+    void TestConsistentWithMap();
+
+private:
+    static vector<uint64_t> Advance(TimingWheel<uint64_t>& wheel, uint64_t nowTick) {
+        vector<uint64_t> res;
+        wheel.Advance(nowTick, [&res](TimerId, uint64_t&& value) { res.push_back(value); });
+        return res;
+    }
+};
+
+void TimingWheelUnittest::TestAdvance() {
+    TimingWheel<uint64_t> wheel(100);
+    wheel.Schedule(102, 102);
+    wheel.Schedule(101, 101);
+    wheel.Schedule(105, 105);
+    APSARA_TEST_EQUAL(3U, wheel.Size());
+    APSARA_TEST_TRUE(Advance(wheel, 100).empty());
+    APSARA_TEST_EQUAL(vector<uint64_t>({101, 102}), Advance(wheel, 104));
+    APSARA_TEST_EQUAL(105U, wheel.GetCurrentTick());
+    APSARA_TEST_EQUAL(vector<uint64_t>({105}), Advance(wheel, 200));
+    APSARA_TEST_TRUE(wheel.Empty());
+    // nothing to fire, so the current tick jumps to now
+    APSARA_TEST_EQUAL(201U, wheel.GetCurrentTick());
+}
+
+void TimingWheelUnittest::TestCascade() {
+    TimingWheel<uint64_t> wheel(0);
+    // entries of all levels
+    vector<uint64_t> ticks = {255, 256, 300, 65535, 65536, 70000, 16777216, 20000000};
+    for (auto tick : ticks) {
+        wheel.Schedule(tick, std::move(tick));
+    }
+    for (auto tick : ticks) {
+        APSARA_TEST_TRUE_DESC(Advance(wheel, tick - 1).empty(), tick);
+        APSARA_TEST_EQUAL(vector<uint64_t>({tick}), Advance(wheel, tick));
+    }
+    APSARA_TEST_TRUE(wheel.Empty());
+}
+
+void TimingWheelUnittest::TestCancel() {
+    TimingWheel<uint64_t> wheel(0);
+    TimerId id1 = wheel.Schedule(10, 10);
+    TimerId id2 = wheel.Schedule(10, 11);
+    TimerId id3 = wheel.Schedule(100000, 100000);
+    APSARA_TEST_TRUE(wheel.Cancel(id1));
+    APSARA_TEST_FALSE(wheel.Cancel(id1));
+    APSARA_TEST_TRUE(wheel.Cancel(id3));
+    APSARA_TEST_FALSE(wheel.Cancel(kInvalidTimerId));
+    APSARA_TEST_EQUAL(1U, wheel.Size());
+    APSARA_TEST_EQUAL(vector<uint64_t>({11}), Advance(wheel, 100000));
+    // fired entries cannot be cancelled, even if their nodes are reused
+    APSARA_TEST_FALSE(wheel.Cancel(id2));
+    TimerId id4 = wheel.Schedule(100010, 4);
+    APSARA_TEST_FALSE(wheel.Cancel(id2));
+    APSARA_TEST_TRUE(wheel.Cancel(id4));
+
+    // entries can be cancelled by the callback, including those of the same tick
+    TimerId id5 = wheel.Schedule(100020, 5);
+    TimerId id6 = wheel.Schedule(100020, 6);
+    size_t fired = 0;
+    wheel.Advance(100020, [&](TimerId id, uint64_t&&) {
+        ++fired;
+        APSARA_TEST_FALSE(wheel.Cancel(id == id5 ? id6 : id5));
+    });
+    APSARA_TEST_EQUAL(2U, fired);
+}
+
+void TimingWheelUnittest::TestScheduleExpired() {
+    TimingWheel<uint64_t> wheel(0);
+    APSARA_TEST_TRUE(Advance(wheel, 1000).empty());
+    wheel.Schedule(10, 10);
+    wheel.Schedule(1000, 1000);
+    // already passed ticks are fired by the next advance, whatever the tick is
+    APSARA_TEST_EQUAL(2U, Advance(wheel, 0).size());
+
+    // entries rescheduled by the callback for passed ticks are not fired again in the same advance
+    wheel.Schedule(1005, 1005);
+    size_t fired = 0;
+    wheel.Advance(1005, [&](TimerId, uint64_t&& value) {
+        ++fired;
+        wheel.Schedule(value, std::move(value));
+    });
+    APSARA_TEST_EQUAL(1U, fired);
+    APSARA_TEST_EQUAL(vector<uint64_t>({1005}), Advance(wheel, 1005));
+}
+
+void TimingWheelUnittest::TestGetNextCheckTick() {
+    TimingWheel<uint64_t> wheel(1);
+    APSARA_TEST_EQUAL(numeric_limits<uint64_t>::max(), wheel.GetNextCheckTick());
+    wheel.Schedule(10, 10);
+    APSARA_TEST_EQUAL(10U, wheel.GetNextCheckTick());
+    wheel.Schedule(3, 3);
+    APSARA_TEST_EQUAL(3U, wheel.GetNextCheckTick());
+    Advance(wheel, 10);
+    // entries of upper levels are checked at the next cascade
+    wheel.Schedule(1000, 1000);
+    APSARA_TEST_EQUAL(256U, wheel.GetNextCheckTick());
+    Advance(wheel, 256);
+    APSARA_TEST_EQUAL(512U, wheel.GetNextCheckTick());
+    wheel.Schedule(5, 5);
+    APSARA_TEST_EQUAL(0U, wheel.GetNextCheckTick());
+}
+
+void TimingWheelUnittest::TestConsistentWithMap() {
+    mt19937_64 gen(20250101);
+    TimingWheel<uint64_t> wheel(12345);
+    map<TimerId, uint64_t> expected;
+    uint64_t now = 12345;
+    for (int round = 0; round < 20000; ++round) {
+        switch (gen() % 4) {
+            case 0:
+            case 1: {
+                uint64_t tick = now + (gen() % 8 == 0 ? gen() % (1ULL << 34) : gen() % 5000);
+                expected[wheel.Schedule(tick, std::move(tick))] = tick;
+                break;
+            }
+            case 2: {
+                if (!expected.empty()) {
+                    auto it = expected.begin();
+                    advance(it, gen() % min<size_t>(expected.size(), 16));
+                    APSARA_TEST_TRUE(wheel.Cancel(it->first));
+                    expected.erase(it);
+                }
+                break;
+            }
+            default: {
+                now += gen() % 2000;
+                uint64_t last = 0;
+                wheel.Advance(now, [&](TimerId id, uint64_t&& value) {
+                    auto it = expected.find(id);
+                    APSARA_TEST_TRUE_FATAL(it != expected.end());
+                    APSARA_TEST_TRUE(value <= now);
+                    APSARA_TEST_TRUE(value >= last);
+                    last = value;
+                    expected.erase(it);
+                });
+                for (const auto& item : expected) {
+                    APSARA_TEST_TRUE_DESC(item.second > now, item.second);
+                }
+                break;
+            }
+        }
+        APSARA_TEST_EQUAL(expected.size(), wheel.Size());
+    }
+}
+
+UNIT_TEST_CASE(TimingWheelUnittest, TestAdvance)
+UNIT_TEST_CASE(TimingWheelUnittest, TestCascade)
+UNIT_TEST_CASE(TimingWheelUnittest, TestCancel)
+UNIT_TEST_CASE(TimingWheelUnittest, TestScheduleExpired)
+UNIT_TEST_CASE(TimingWheelUnittest, TestGetNextCheckTick)
+UNIT_TEST_CASE(TimingWheelUnittest, TestConsistentWithMap)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
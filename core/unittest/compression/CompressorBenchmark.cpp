@@ -0,0 +1,146 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/StringTools.h"
+#include "common/TimeUtil.h"
+#include "common/compression/LZ4Compressor.h"
+#include "common/compression/ZstdCompressor.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const size_t kLinesPerBatch = 50;
+static const size_t kRounds = 10;
+
+// Usage: compressor_benchmark [corpus file with one log per line]
+//
+// Logs are compressed in small batches, as flushers do with each of their packages.
+class CompressorBenchmark {
+public:
+    explicit CompressorBenchmark(const std::string& corpusPath);
+
+    void Run();
+
+private:
+    void LoadCorpus(const std::string& corpusPath);
+    void GenerateCorpus();
+    void Test(const char* name, Compressor& compressor) const;
+
+    std::vector<std::string> mBatches;
+};
+
+CompressorBenchmark::CompressorBenchmark(const std::string& corpusPath) {
+    if (corpusPath.empty()) {
+        GenerateCorpus();
+    } else {
+        LoadCorpus(corpusPath);
+    }
+}
+
+void CompressorBenchmark::Run() {
+    printf("%zu batches of %zu lines\n", mBatches.size(), kLinesPerBatch);
+    LZ4Compressor lz4(CompressType::LZ4);
+    Test("lz4", lz4);
+    ZstdCompressor zstd(CompressType::ZSTD);
+    Test("zstd level 1", zstd);
+    ZstdCompressor zstd3(CompressType::ZSTD, 3);
+    Test("zstd level 3", zstd3);
+}
+
+void CompressorBenchmark::LoadCorpus(const std::string& corpusPath) {
+    std::ifstream fin(corpusPath);
+    std::string line, batch;
+    size_t lineCnt = 0;
+    while (std::getline(fin, line)) {
+        batch.append(line).append(1, '\n');
+        if (++lineCnt % kLinesPerBatch == 0) {
+            mBatches.push_back(std::move(batch));
+            batch.clear();
+        }
+    }
+}
+
+void CompressorBenchmark::GenerateCorpus() {
+    static const char* kMethods[] = {"GET", "POST", "PUT", "DELETE"};
+    static const char* kLevels[] = {"INFO", "WARN", "ERROR", "DEBUG"};
+    for (size_t i = 0; i < 5000; ++i) {
+        std::string batch;
+        for (size_t j = 0; j < kLinesPerBatch; ++j) {
+            size_t n = i * kLinesPerBatch + j;
+            switch (n % 3) {
+                case 0:
+                    batch += "10.0." + ToString(n % 7) + "." + ToString(n % 251) + " - - [15/Oct/2024:10:"
+                        + ToString(10 + n % 50) + ":" + ToString(10 + n % 49) + " +0800] \"" + kMethods[n % 4]
+                        + " /api/v1/resources/" + ToString(n % 997) + "?with=details HTTP/1.1\" "
+                        + (n % 13 == 0 ? "500" : "200") + " " + ToString(n % 4096)
+                        + " \"-\" \"Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36\"\n";
+                    break;
+                case 1:
+                    batch += "2024-10-15 10:00:" + ToString(10 + n % 49) + "." + ToString(100 + n % 899) + " ["
+                        + kLevels[n % 4] + "] [thread-" + ToString(n % 16)
+                        + "] com.example.service.OrderService - process order " + ToString(n)
+                        + " for user " + ToString(n % 1000) + " costs " + ToString(n % 300) + "ms\n";
+                    break;
+                default:
+                    batch += "{\"time\":\"2024-10-15T10:00:" + ToString(10 + n % 49) + "Z\",\"level\":\""
+                        + kLevels[n % 4] + "\",\"trace_id\":\"5b8efff798038103d269b633" + ToString(10000000 + n)
+                        + "\",\"msg\":\"request handled\",\"latency_ms\":" + ToString(n % 300) + "}\n";
+                    break;
+            }
+        }
+        mBatches.push_back(std::move(batch));
+    }
+}
+
+void CompressorBenchmark::Test(const char* name, Compressor& compressor) const {
+    size_t rawSize = 0, compressedSize = 0;
+    std::string output, errorMsg;
+    uint64_t starttime = GetCurrentTimeInMicroSeconds();
+    for (size_t round = 0; round < kRounds; ++round) {
+        for (const auto& batch : mBatches) {
+            if (!compressor.DoCompress(batch, output, errorMsg)) {
+                printf("%s: failed to compress: %s\n", name, errorMsg.c_str());
+                return;
+            }
+            rawSize += batch.size();
+            compressedSize += output.size();
+        }
+    }
+    uint64_t timeElapsed = GetCurrentTimeInMicroSeconds() - starttime;
+    printf("%s: ratio %.2f, %.2f MB/s\n",
+           name,
+           compressedSize == 0 ? 0.0 : static_cast<double>(rawSize) / compressedSize,
+           timeElapsed == 0 ? 0.0 : rawSize / 1024.0 / 1024.0 * 1000000.0 / timeElapsed);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::CompressorBenchmark benchmark(argc > 1 ? argv[1] : "");
+    benchmark.Run();
+    return 0;
+}
@@ -22,6 +22,8 @@ namespace logtail {
 class ZstdCompressorUnittest : public ::testing::Test {
 public:
     void TestCompress();
+    void TestStreamCompress();
+    void TestStreamCompressWithWrongSize();
 };
 
 void ZstdCompressorUnittest::TestCompress() {
@@ -36,7 +38,49 @@ void ZstdCompressorUnittest::TestCompress() {
     APSARA_TEST_EQUAL(input, decompressed);
 }
 
+void ZstdCompressorUnittest::TestStreamCompress() {
+    ZstdCompressor compressor(CompressType::ZSTD);
+    APSARA_TEST_TRUE(compressor.IsStreamSupported());
+    string input;
+    for (int i = 0; i < 10000; ++i) {
+        input += "hello world " + to_string(i);
+    }
+    string output;
+    string errorMsg;
+    APSARA_TEST_TRUE(compressor.DoStreamCompress(
+        input.size(),
+        [&](const CompressStreamInput& write) {
+            for (size_t pos = 0; pos < input.size(); pos += 1000) {
+                if (!write(input.data() + pos, min<size_t>(1000, input.size() - pos))) {
+                    return false;
+                }
+            }
+            return true;
+        },
+        output,
+        errorMsg));
+    string decompressed;
+    decompressed.resize(input.size());
+    APSARA_TEST_TRUE(compressor.UnCompress(output, decompressed, errorMsg));
+    APSARA_TEST_EQUAL(input, decompressed);
+}
+
+void ZstdCompressorUnittest::TestStreamCompressWithWrongSize() {
+    ZstdCompressor compressor(CompressType::ZSTD);
+    string input = "hello world";
+    string output;
+    string errorMsg;
+    APSARA_TEST_FALSE(compressor.DoStreamCompress(
+        input.size() + 1,
+        [&](const CompressStreamInput& write) { return write(input.data(), input.size()); },
+        output,
+        errorMsg));
+    APSARA_TEST_FALSE(errorMsg.empty());
+}
+
 UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompress)
+UNIT_TEST_CASE(ZstdCompressorUnittest, TestStreamCompress)
+UNIT_TEST_CASE(ZstdCompressorUnittest, TestStreamCompressWithWrongSize)
 
 } // namespace logtail
 
@@ -904,7 +904,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -913,7 +913,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -965,7 +965,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -974,7 +974,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -1026,7 +1026,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -1035,7 +1035,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -1087,7 +1087,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -1096,7 +1096,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -1151,7 +1151,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -1161,7 +1161,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -1215,7 +1215,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -1224,7 +1224,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -1284,7 +1284,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -1293,7 +1293,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -1342,7 +1342,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
@@ -1351,7 +1351,7 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
 #endif
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
 #ifdef __ENTERPRISE__
         APSARA_TEST_EQUAL("test_project.test_region-b.log.aliyuncs.com", req->mHost);
 #else
@@ -1408,14 +1408,14 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
         APSARA_TEST_EQUAL(rawSizeStr, req->mHeader[X_LOG_BODYRAWSIZE]);
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
         APSARA_TEST_EQUAL("192.168.0.1", req->mHost);
         APSARA_TEST_EQUAL(80, req->mPort);
         APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(default_http_request_timeout_sec)), req->mTimeout);
@@ -1435,14 +1435,14 @@ void FlusherSLSUnittest::TestBuildRequest() {
         APSARA_TEST_FALSE(req->mHeader[DATE].empty());
         APSARA_TEST_EQUAL(TYPE_LOG_PROTOBUF, req->mHeader[CONTENT_TYPE]);
         APSARA_TEST_EQUAL(bodyLenStr, req->mHeader[CONTENT_LENGTH]);
-        APSARA_TEST_EQUAL(CalcMD5(req->mBody), req->mHeader[CONTENT_MD5]);
+        APSARA_TEST_EQUAL(CalcMD5(req->mPayload.str()), req->mHeader[CONTENT_MD5]);
         APSARA_TEST_EQUAL(LOG_API_VERSION, req->mHeader[X_LOG_APIVERSION]);
         APSARA_TEST_EQUAL(HMAC_SHA1, req->mHeader[X_LOG_SIGNATUREMETHOD]);
         APSARA_TEST_EQUAL("lz4", req->mHeader[X_LOG_COMPRESSTYPE]);
         APSARA_TEST_EQUAL(rawSizeStr, req->mHeader[X_LOG_BODYRAWSIZE]);
         APSARA_TEST_EQUAL(MD5_SHA1_SALT_KEYPROVIDER, req->mHeader[X_LOG_KEYPROVIDER]);
         APSARA_TEST_FALSE(req->mHeader[AUTHORIZATION].empty());
-        APSARA_TEST_EQUAL(body, req->mBody);
+        APSARA_TEST_EQUAL(body, req->mPayload.str());
         APSARA_TEST_EQUAL("test_project." + kAccelerationDataEndpoint, req->mHost);
         APSARA_TEST_EQUAL(80, req->mPort);
         APSARA_TEST_EQUAL(static_cast<uint32_t>(INT32_FLAG(default_http_request_timeout_sec)), req->mTimeout);
@@ -1547,7 +1547,7 @@ void FlusherSLSUnittest::TestSend() {
                 = CompressorFactory::GetInstance()->Create(Json::Value(), ctx, "flusher_sls", "1", CompressType::LZ4);
             string output, errorMsg;
             output.resize(item->mRawSize);
-            APSARA_TEST_TRUE(compressor->UnCompress(item->mData, output, errorMsg));
+            APSARA_TEST_TRUE(compressor->UnCompress(item->mData.str(), output, errorMsg));
 
             sls_logs::LogGroup logGroup;
             APSARA_TEST_TRUE(logGroup.ParseFromString(output));
@@ -1564,6 +1564,31 @@ void FlusherSLSUnittest::TestSend() {
 
             ExactlyOnceQueueManager::GetInstance()->RemoveSenderQueueItem(eooKey, item);
         }
+        {
+            // the payload only holds memory of about the compressed size
+            PipelineEventGroup group(make_shared<SourceBuffer>());
+            auto cpt = make_shared<RangeCheckpoint>();
+            cpt->index = 1;
+            cpt->fbKey = eooKey;
+            cpt->data.set_hash_key("hash_key_1");
+            cpt->data.set_sequence_id(0);
+            cpt->data.set_read_offset(0);
+            cpt->data.set_read_length(10);
+            group.SetExactlyOnceCheckpoint(cpt);
+            auto e = group.AddLogEvent();
+            e->SetTimestamp(1234567890);
+            e->SetContent(string("content_key"), string(1024 * 1024, 'a'));
+
+            APSARA_TEST_TRUE(flusher.Send(std::move(group)));
+            vector<SenderQueueItem*> res;
+            ExactlyOnceQueueManager::GetInstance()->GetAvailableSenderQueueItems(res, 80);
+            APSARA_TEST_EQUAL(1U, res.size());
+            auto item = static_cast<SLSSenderQueueItem*>(res[0]);
+            APSARA_TEST_TRUE(item->mRawSize > 1024 * 1024);
+            APSARA_TEST_TRUE(item->mData.str().capacity() < item->mRawSize / 16);
+
+            ExactlyOnceQueueManager::GetInstance()->RemoveSenderQueueItem(eooKey, item);
+        }
         {
             // non-replay group
             flusher.mBatcher.GetEventFlushStrategy().SetMinCnt(1);
@@ -1598,7 +1623,7 @@ void FlusherSLSUnittest::TestSend() {
                 = CompressorFactory::GetInstance()->Create(Json::Value(), ctx, "flusher_sls", "1", CompressType::LZ4);
             string output, errorMsg;
             output.resize(item->mRawSize);
-            APSARA_TEST_TRUE(compressor->UnCompress(item->mData, output, errorMsg));
+            APSARA_TEST_TRUE(compressor->UnCompress(item->mData.str(), output, errorMsg));
 
             sls_logs::LogGroup logGroup;
             APSARA_TEST_TRUE(logGroup.ParseFromString(output));
@@ -1676,7 +1701,7 @@ void FlusherSLSUnittest::TestSend() {
                 = CompressorFactory::GetInstance()->Create(Json::Value(), ctx, "flusher_sls", "1", CompressType::LZ4);
             string output, errorMsg;
             output.resize(item->mRawSize);
-            APSARA_TEST_TRUE(compressor->UnCompress(item->mData, output, errorMsg));
+            APSARA_TEST_TRUE(compressor->UnCompress(item->mData.str(), output, errorMsg));
 
             sls_logs::LogGroup logGroup;
             APSARA_TEST_TRUE(logGroup.ParseFromString(output));
@@ -1769,7 +1794,7 @@ void FlusherSLSUnittest::TestSend() {
             = CompressorFactory::GetInstance()->Create(Json::Value(), ctx, "flusher_sls", "1", CompressType::LZ4);
 
         sls_logs::SlsLogPackageList packageList;
-        APSARA_TEST_TRUE(packageList.ParseFromString(item->mData));
+        APSARA_TEST_TRUE(packageList.ParseFromString(item->mData.str()));
         APSARA_TEST_EQUAL(2, packageList.packages_size());
         uint32_t rawSize = 0;
         for (size_t i = 0; i < 2; ++i) {
@@ -1944,7 +1969,7 @@ void FlusherSLSUnittest::OnGoPipelineSend() {
                 = CompressorFactory::GetInstance()->Create(Json::Value(), ctx, "flusher_sls", "1", CompressType::LZ4);
             string output;
             output.resize(item->mRawSize);
-            APSARA_TEST_TRUE(compressor->UnCompress(item->mData, output, errorMsg));
+            APSARA_TEST_TRUE(compressor->UnCompress(item->mData.str(), output, errorMsg));
             APSARA_TEST_EQUAL("content", output);
         }
         {
@@ -1988,7 +2013,7 @@ void FlusherSLSUnittest::OnGoPipelineSend() {
         string output;
         output.resize(item->mRawSize);
         string errorMsg;
-        APSARA_TEST_TRUE(compressor->UnCompress(item->mData, output, errorMsg));
+        APSARA_TEST_TRUE(compressor->UnCompress(item->mData.str(), output, errorMsg));
         APSARA_TEST_EQUAL("content", output);
     }
 }
@@ -0,0 +1,184 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <json/value.h>
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/queue/ProcessQueueItem.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/TimeUtil.h"
+#include "forward/GrpcInputManager.h"
+#include "forward/loongsuite/LoongSuiteForwardService.h"
+#include "logger/Logger.h"
+#include "protobuf/models/pipeline_event_group.pb.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const char* kConfigName = "loongsuite_forward_benchmark";
+static const char* kAddress = "127.0.0.1:50090";
+static const uint64_t kDurationMs = 5000;
+
+// Load generator of LoongSuiteForwardService through GrpcInputManager on localhost, with a consumer thread popping the
+// process queue in place of processor threads. Requests rejected by backpressure are retried by the clients.
+class LoongSuiteForwardBenchmark {
+public:
+    LoongSuiteForwardBenchmark(size_t clientCnt, size_t eventsPerRequest)
+        : mClientCnt(clientCnt), mEventsPerRequest(eventsPerRequest) {}
+
+    void Run();
+
+private:
+    std::string MakeRequestData() const;
+    void RunClient(const std::string& data);
+    void RunConsumer();
+
+    size_t mClientCnt;
+    size_t mEventsPerRequest;
+    std::atomic_bool mStop = false;
+    std::atomic_uint64_t mAcceptedRequests = 0;
+    std::atomic_uint64_t mRejectedRequests = 0;
+};
+
+std::string LoongSuiteForwardBenchmark::MakeRequestData() const {
+    models::PipelineEventGroup pbGroup;
+    (*pbGroup.mutable_tags())["host.name"] = "benchmark-host";
+    (*pbGroup.mutable_tags())["service.name"] = "benchmark-service";
+    for (size_t i = 0; i < mEventsPerRequest; ++i) {
+        auto* log = pbGroup.mutable_logs()->add_events();
+        log->set_timestamp(1719792000000000000ULL + i);
+        log->set_level("INFO");
+        const char* keys[] = {"trace_id", "span_id", "method", "content"};
+        const std::string values[] = {"5b8aa5a2d2c872e8321cf37308d69df2",
+                                      "051581bf3cb55c13",
+                                      "GET /api/v1/orders",
+                                      "request completed in " + std::to_string(i) + "ms with status 200"};
+        for (size_t j = 0; j < 4; ++j) {
+            auto* content = log->add_contents();
+            content->set_key(keys[j]);
+            content->set_value(values[j]);
+        }
+    }
+    return pbGroup.SerializeAsString();
+}
+
+void LoongSuiteForwardBenchmark::RunClient(const std::string& data) {
+    auto stub = LoongSuiteForwardService::NewStub(grpc::CreateChannel(kAddress, grpc::InsecureChannelCredentials()));
+    LoongSuiteForwardRequest request;
+    request.set_data(data);
+    while (!mStop) {
+        grpc::ClientContext context;
+        LoongSuiteForwardResponse response;
+        auto status = stub->Forward(&context, request, &response);
+        if (status.ok()) {
+            ++mAcceptedRequests;
+        } else if (status.error_code() == grpc::StatusCode::RESOURCE_EXHAUSTED) {
+            ++mRejectedRequests;
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        } else {
+            printf("unexpected status: %s\n", status.error_message().c_str());
+            return;
+        }
+    }
+}
+
+void LoongSuiteForwardBenchmark::RunConsumer() {
+    std::unique_ptr<ProcessQueueItem> item;
+    std::string configName;
+    while (!mStop) {
+        if (!ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+            ProcessQueueManager::GetInstance()->Wait(10);
+        }
+    }
+}
+
+void LoongSuiteForwardBenchmark::Run() {
+    std::string data = MakeRequestData();
+    std::thread consumer(&LoongSuiteForwardBenchmark::RunConsumer, this);
+    std::vector<std::thread> clients;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (size_t i = 0; i < mClientCnt; ++i) {
+        clients.emplace_back(&LoongSuiteForwardBenchmark::RunClient, this, std::cref(data));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(kDurationMs));
+    mStop = true;
+    for (auto& client : clients) {
+        client.join();
+    }
+    consumer.join();
+    uint64_t timeElapsedMs = GetCurrentTimeInMilliSeconds() - starttime;
+
+    std::unique_ptr<ProcessQueueItem> item;
+    std::string configName;
+    while (ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+    }
+    double events = static_cast<double>(mAcceptedRequests * mEventsPerRequest);
+    printf("clients %-3zu events per request %-5zu request size %-7zu accepted %-8lu rejected %-8lu "
+           "%.0f events/s, %.1f MB/s\n",
+           mClientCnt,
+           mEventsPerRequest,
+           data.size(),
+           static_cast<unsigned long>(mAcceptedRequests.load()),
+           static_cast<unsigned long>(mRejectedRequests.load()),
+           events * 1000 / timeElapsedMs,
+           static_cast<double>(mAcceptedRequests * data.size()) / 1024 / 1024 * 1000 / timeElapsedMs);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    using namespace logtail;
+    Logger::Instance().InitGlobalLoggers();
+
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey(kConfigName);
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName(kConfigName);
+    ctx.SetProcessQueueKey(key);
+    ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(key, 0, ctx);
+    ProcessQueueManager::GetInstance()->EnablePop(kConfigName);
+    GrpcInputManager::GetInstance()->Init();
+    if (!GrpcInputManager::GetInstance()->AddListenInput<LoongSuiteForwardServiceImpl>(
+            kConfigName, kAddress, Json::Value())) {
+        printf("failed to listen on %s\n", kAddress);
+        return 1;
+    }
+
+    for (size_t clientCnt : {1, 4, 16}) {
+        for (size_t eventsPerRequest : {10, 100, 1000}) {
+            LoongSuiteForwardBenchmark benchmark(clientCnt, eventsPerRequest);
+            benchmark.Run();
+        }
+    }
+
+    GrpcInputManager::GetInstance()->Stop();
+    return 0;
+}
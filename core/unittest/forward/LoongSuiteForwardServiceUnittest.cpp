@@ -0,0 +1,184 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <grpcpp/create_channel.h>
+#include <grpcpp/security/credentials.h>
+#include <json/value.h>
+
+#include <memory>
+#include <string>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/queue/ProcessQueueItem.h"
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "forward/GrpcInputManager.h"
+#include "forward/loongsuite/LoongSuiteForwardService.h"
+#include "protobuf/models/pipeline_event_group.pb.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class LoongSuiteForwardServiceUnittest : public ::testing::Test {
+public:
+    void TestUpdateAndRemove() const;
+    void TestForward();
+    void TestForwardBackpressure();
+    void TestForwardInvalidRequest();
+
+protected:
+    static void SetUpTestCase() {
+        mQueueKey = QueueKeyManager::GetInstance()->GetKey(mConfigName);
+        CollectionPipelineContext ctx;
+        ctx.SetConfigName(mConfigName);
+        ctx.SetProcessQueueKey(mQueueKey);
+        ProcessQueueManager::GetInstance()->CreateOrUpdateBoundedQueue(mQueueKey, 0, ctx);
+        ProcessQueueManager::GetInstance()->EnablePop(mConfigName);
+
+        Json::Value config;
+        config["InputIndex"] = 1;
+        GrpcInputManager::GetInstance()->Init();
+        GrpcInputManager::GetInstance()->AddListenInput<LoongSuiteForwardServiceImpl>(mConfigName, mAddress, config);
+        mStub = LoongSuiteForwardService::NewStub(grpc::CreateChannel(mAddress, grpc::InsecureChannelCredentials()));
+    }
+
+    static void TearDownTestCase() {
+        GrpcInputManager::GetInstance()->Stop();
+        ProcessQueueManager::GetInstance()->DeleteQueue(mQueueKey);
+    }
+
+    void TearDown() override {
+        unique_ptr<ProcessQueueItem> item;
+        string configName;
+        while (ProcessQueueManager::GetInstance()->PopItem(0, item, configName)) {
+        }
+    }
+
+    static grpc::Status Forward(const string& data, const string& configName = "") {
+        grpc::ClientContext context;
+        if (!configName.empty()) {
+            context.AddMetadata(LoongSuiteForwardServiceImpl::sConfigNameMetaKey, configName);
+        }
+        LoongSuiteForwardRequest request;
+        request.set_data(data);
+        LoongSuiteForwardResponse response;
+        return mStub->Forward(&context, request, &response);
+    }
+
+    static string MakeLogGroup(size_t logCnt) {
+        models::PipelineEventGroup pbGroup;
+        (*pbGroup.mutable_tags())["host"] = "test-host";
+        for (size_t i = 0; i < logCnt; ++i) {
+            auto* log = pbGroup.mutable_logs()->add_events();
+            log->set_timestamp(1234567890123456789ULL + i);
+            log->set_level("INFO");
+            auto* content = log->add_contents();
+            content->set_key("content");
+            content->set_value("log " + to_string(i));
+        }
+        return pbGroup.SerializeAsString();
+    }
+
+    static const string mConfigName;
+    static const string mAddress;
+    static QueueKey mQueueKey;
+    static unique_ptr<LoongSuiteForwardService::Stub> mStub;
+};
+
+const string LoongSuiteForwardServiceUnittest::mConfigName = "test_loongsuite_forward";
+const string LoongSuiteForwardServiceUnittest::mAddress = "127.0.0.1:50070";
+QueueKey LoongSuiteForwardServiceUnittest::mQueueKey = -1;
+unique_ptr<LoongSuiteForwardService::Stub> LoongSuiteForwardServiceUnittest::mStub;
+
+void LoongSuiteForwardServiceUnittest::TestUpdateAndRemove() const {
+    LoongSuiteForwardServiceImpl service;
+    Json::Value config;
+    APSARA_TEST_TRUE(service.Update("configA", config));
+    config["InputIndex"] = 2;
+    APSARA_TEST_TRUE(service.Update("configB", config));
+    APSARA_TEST_EQUAL(2U, service.mConfigs.size());
+    APSARA_TEST_EQUAL(QueueKeyManager::GetInstance()->GetKey("configA"), service.mConfigs["configA"].mQueueKey);
+    APSARA_TEST_EQUAL(0U, service.mConfigs["configA"].mInputIndex);
+    APSARA_TEST_EQUAL(QueueKeyManager::GetInstance()->GetKey("configB"), service.mConfigs["configB"].mQueueKey);
+    APSARA_TEST_EQUAL(2U, service.mConfigs["configB"].mInputIndex);
+
+    config["InputIndex"] = "invalid";
+    APSARA_TEST_FALSE(service.Update("configC", config));
+    APSARA_TEST_EQUAL(2U, service.mConfigs.size());
+
+    APSARA_TEST_TRUE(service.Remove("configA"));
+    APSARA_TEST_EQUAL(1U, service.mConfigs.size());
+    APSARA_TEST_TRUE(service.mConfigs.find("configB") != service.mConfigs.end());
+}
+
+void LoongSuiteForwardServiceUnittest::TestForward() {
+    APSARA_TEST_TRUE_FATAL(Forward(MakeLogGroup(2)).ok());
+    // the config name can be specified explicitly
+    APSARA_TEST_TRUE_FATAL(Forward(MakeLogGroup(1), mConfigName).ok());
+
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    APSARA_TEST_TRUE_FATAL(ProcessQueueManager::GetInstance()->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL(mConfigName, configName);
+    APSARA_TEST_EQUAL(1U, item->mInputIndex);
+    const auto& group = item->mEventGroup;
+    APSARA_TEST_EQUAL("test-host", group.GetTag("host").to_string());
+    APSARA_TEST_EQUAL(2U, group.GetEvents().size());
+    for (size_t i = 0; i < group.GetEvents().size(); ++i) {
+        const auto& log = group.GetEvents()[i].Cast<LogEvent>();
+        APSARA_TEST_EQUAL(1234567890, log.GetTimestamp());
+        APSARA_TEST_EQUAL(123456789U + i, log.GetTimestampNanosecond().value());
+        APSARA_TEST_EQUAL("INFO", log.GetLevel().to_string());
+        APSARA_TEST_EQUAL("log " + to_string(i), log.GetContent("content").to_string());
+    }
+    APSARA_TEST_TRUE_FATAL(ProcessQueueManager::GetInstance()->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL(1U, item->mEventGroup.GetEvents().size());
+}
+
+void LoongSuiteForwardServiceUnittest::TestForwardBackpressure() {
+    string data = MakeLogGroup(1);
+    size_t accepted = 0;
+    grpc::Status status;
+    for (size_t i = 0; i < 100; ++i) {
+        status = Forward(data);
+        if (!status.ok()) {
+            break;
+        }
+        ++accepted;
+    }
+    APSARA_TEST_EQUAL(grpc::StatusCode::RESOURCE_EXHAUSTED, status.error_code());
+    APSARA_TEST_TRUE(accepted > 0U);
+
+    // the queue accepts again once it is consumed
+    TearDown();
+    APSARA_TEST_TRUE(Forward(data).ok());
+}
+
+void LoongSuiteForwardServiceUnittest::TestForwardInvalidRequest() {
+    APSARA_TEST_EQUAL(grpc::StatusCode::INVALID_ARGUMENT, Forward("not a protobuf").error_code());
+    // no events
+    APSARA_TEST_EQUAL(grpc::StatusCode::INVALID_ARGUMENT, Forward("").error_code());
+    APSARA_TEST_EQUAL(grpc::StatusCode::NOT_FOUND, Forward(MakeLogGroup(1), "unknown_config").error_code());
+}
+
+UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestUpdateAndRemove)
+UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestForward)
+UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestForwardBackpressure)
+UNIT_TEST_CASE(LoongSuiteForwardServiceUnittest, TestForwardInvalidRequest)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
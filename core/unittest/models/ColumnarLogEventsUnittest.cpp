@@ -0,0 +1,247 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "models/ColumnarLogEvents.h"
+#include "models/LogEvent.h"
+#include "models/PipelineEventGroup.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class ColumnarLogEventsUnittest : public ::testing::Test {
+public:
+    void TestAddRowAndColumn();
+    void TestSetAndDelValue();
+    void TestFilterRows();
+    void TestDataSize();
+    void TestMaterialize();
+    void TestContentOrder();
+    void TestEventGroup();
+
+protected:
+    void SetUp() override {
+        mSourceBuffer.reset(new SourceBuffer);
+        mEventGroup.reset(new PipelineEventGroup(mSourceBuffer));
+    }
+
+private:
+    shared_ptr<SourceBuffer> mSourceBuffer;
+    unique_ptr<PipelineEventGroup> mEventGroup;
+};
+
+void ColumnarLogEventsUnittest::TestAddRowAndColumn() {
+    ColumnarLogEvents columns;
+    APSARA_TEST_TRUE(columns.Empty());
+    APSARA_TEST_EQUAL(0U, columns.AddRow(1, 2, 0, 10));
+    size_t col = columns.AddColumn("key1");
+    APSARA_TEST_EQUAL(0U, col);
+    APSARA_TEST_EQUAL(1U, columns.AddRow(3, nullopt, 10, 20));
+    // existing column is returned
+    APSARA_TEST_EQUAL(col, columns.AddColumn("key1"));
+    APSARA_TEST_EQUAL(1U, columns.AddColumn("key2"));
+    APSARA_TEST_EQUAL(2U, columns.ColumnSize());
+    APSARA_TEST_EQUAL(2U, columns.Size());
+    APSARA_TEST_EQUAL(1U, columns.FindColumn("key2"));
+    APSARA_TEST_EQUAL(ColumnarLogEvents::npos, columns.FindColumn("key3"));
+    APSARA_TEST_EQUAL("key1", columns.GetColumnKey(0).to_string());
+
+    // columns added later have empty slots for existing rows
+    APSARA_TEST_FALSE(columns.HasValue(0, 0));
+    APSARA_TEST_FALSE(columns.HasValue(1, 1));
+
+    APSARA_TEST_EQUAL(1, columns.GetTimestamp(0));
+    APSARA_TEST_EQUAL(2U, columns.GetTimestampNanosecond(0).value());
+    APSARA_TEST_FALSE(columns.GetTimestampNanosecond(1).has_value());
+    APSARA_TEST_EQUAL(10U, columns.GetPosition(1).first);
+    APSARA_TEST_EQUAL(20U, columns.GetPosition(1).second);
+    columns.SetTimestamp(1, 4, 5);
+    APSARA_TEST_EQUAL(4, columns.GetTimestamp(1));
+    APSARA_TEST_EQUAL(5U, columns.GetTimestampNanosecond(1).value());
+}
+
+void ColumnarLogEventsUnittest::TestSetAndDelValue() {
+    ColumnarLogEvents columns;
+    columns.AddRow(0, nullopt, 0, 0);
+    size_t col = columns.AddColumn("key");
+    columns.SetValue(col, 0, "value1");
+    APSARA_TEST_TRUE(columns.HasValue(col, 0));
+    APSARA_TEST_EQUAL("value1", columns.GetValue(col, 0).to_string());
+    APSARA_TEST_EQUAL(1U, columns.GetRowContentSize(0));
+
+    // overwrite does not change content count
+    columns.SetValue(col, 0, "value2");
+    APSARA_TEST_EQUAL("value2", columns.GetValue(col, 0).to_string());
+    APSARA_TEST_EQUAL(1U, columns.GetRowContentSize(0));
+
+    columns.DelValue(col, 0);
+    APSARA_TEST_FALSE(columns.HasValue(col, 0));
+    APSARA_TEST_EQUAL(0U, columns.GetRowContentSize(0));
+    // deleting an absent value is a no-op
+    columns.DelValue(col, 0);
+    APSARA_TEST_EQUAL(0U, columns.GetRowContentSize(0));
+}
+
+void ColumnarLogEventsUnittest::TestFilterRows() {
+    ColumnarLogEvents columns;
+    size_t col = columns.AddColumn("key");
+    for (size_t i = 0; i < 4; ++i) {
+        size_t row = columns.AddRow(i, nullopt, i, 1);
+        if (i != 2) {
+            columns.SetValue(col, row, i % 2 == 0 ? "even" : "odd");
+        }
+    }
+    columns.FilterRows({true, false, true, false});
+    APSARA_TEST_EQUAL(2U, columns.Size());
+    APSARA_TEST_EQUAL(0, columns.GetTimestamp(0));
+    APSARA_TEST_EQUAL(2, columns.GetTimestamp(1));
+    APSARA_TEST_EQUAL(2U, columns.GetPosition(1).first);
+    APSARA_TEST_EQUAL("even", columns.GetValue(col, 0).to_string());
+    APSARA_TEST_FALSE(columns.HasValue(col, 1));
+    APSARA_TEST_EQUAL(1U, columns.GetRowContentSize(0));
+    APSARA_TEST_EQUAL(0U, columns.GetRowContentSize(1));
+}
+
+void ColumnarLogEventsUnittest::TestDataSize() {
+    ColumnarLogEvents columns;
+    size_t col1 = columns.AddColumn("key1");
+    size_t col2 = columns.AddColumn("key2");
+    size_t row1 = columns.AddRow(0, nullopt, 0, 0);
+    size_t row2 = columns.AddRow(0, nullopt, 0, 0);
+    columns.SetValue(col1, row1, "a");
+    columns.SetValue(col2, row1, "bb");
+    columns.SetValue(col1, row2, "ccc");
+
+    auto event1 = mEventGroup->CreateLogEvent();
+    event1->SetContentNoCopy(StringView("key1"), StringView("a"));
+    event1->SetContentNoCopy(StringView("key2"), StringView("bb"));
+    auto event2 = mEventGroup->CreateLogEvent();
+    event2->SetContentNoCopy(StringView("key1"), StringView("ccc"));
+    APSARA_TEST_EQUAL(event1->DataSize() + event2->DataSize(), columns.DataSize());
+
+    columns.DelValue(col2, row1);
+    event1->DelContent(StringView("key2"));
+    columns.FilterRows({false, true});
+    APSARA_TEST_EQUAL(event2->DataSize(), columns.DataSize());
+}
+
+void ColumnarLogEventsUnittest::TestMaterialize() {
+    ColumnarLogEvents columns;
+    size_t col1 = columns.AddColumn("key1");
+    size_t row1 = columns.AddRow(100, 5, 10, 20);
+    size_t col2 = columns.AddColumn("key2");
+    size_t row2 = columns.AddRow(200, nullopt, 30, 40);
+    columns.SetValue(col1, row1, "value1");
+    columns.SetValue(col2, row1, "value2");
+    columns.SetValue(col2, row2, "value3");
+
+    EventsContainer events;
+    columns.Materialize(*mEventGroup, events);
+    APSARA_TEST_TRUE(columns.Empty());
+    APSARA_TEST_EQUAL(0U, columns.ColumnSize());
+    APSARA_TEST_EQUAL(0U, columns.DataSize());
+    APSARA_TEST_EQUAL(2U, events.size());
+
+    const auto& event1 = events[0].Cast<LogEvent>();
+    APSARA_TEST_EQUAL(2U, event1.Size());
+    APSARA_TEST_EQUAL("value1", event1.GetContent("key1").to_string());
+    APSARA_TEST_EQUAL("value2", event1.GetContent("key2").to_string());
+    // contents keep the column order
+    APSARA_TEST_EQUAL("key1", event1.begin()->first.to_string());
+    APSARA_TEST_EQUAL(100, event1.GetTimestamp());
+    APSARA_TEST_EQUAL(5U, event1.GetTimestampNanosecond().value());
+    APSARA_TEST_EQUAL(10U, event1.GetPosition().first);
+    APSARA_TEST_EQUAL(20U, event1.GetPosition().second);
+
+    const auto& event2 = events[1].Cast<LogEvent>();
+    APSARA_TEST_EQUAL(1U, event2.Size());
+    APSARA_TEST_FALSE(event2.HasContent("key1"));
+    APSARA_TEST_EQUAL("value3", event2.GetContent("key2").to_string());
+    APSARA_TEST_EQUAL(200, event2.GetTimestamp());
+    APSARA_TEST_FALSE(event2.GetTimestampNanosecond().has_value());
+}
+
+void ColumnarLogEventsUnittest::TestContentOrder() {
+    ColumnarLogEvents columns;
+    size_t col1 = columns.AddColumn("key1");
+    size_t col2 = columns.AddColumn("key2");
+    size_t col3 = columns.AddColumn("key3");
+    // the column order
+    size_t row1 = columns.AddRow(0, nullopt, 0, 0);
+    columns.SetValue(col1, row1, "a");
+    columns.SetValue(col2, row1, "b");
+    // keys in a different order, e.g. json objects with different key order
+    size_t row2 = columns.AddRow(0, nullopt, 0, 0);
+    columns.SetValue(col3, row2, "c");
+    columns.SetValue(col1, row2, "a");
+    columns.SetValue(col2, row2, "b");
+    // overwritten value keeps its position, while deleted value set again is moved to the end
+    size_t row3 = columns.AddRow(0, nullopt, 0, 0);
+    columns.SetValue(col1, row3, "a");
+    columns.SetValue(col2, row3, "b");
+    columns.SetValue(col3, row3, "c");
+    columns.SetValue(col1, row3, "A");
+    columns.DelValue(col2, row3);
+    columns.SetValue(col2, row3, "B");
+    APSARA_TEST_TRUE(columns.GetValueSeq(col3, row3) < columns.GetValueSeq(col2, row3));
+    columns.FilterRows({false, true, true});
+
+    EventsContainer events;
+    columns.Materialize(*mEventGroup, events);
+    APSARA_TEST_EQUAL(2U, events.size());
+    auto getContents = [](const PipelineEventPtr& e) {
+        string res;
+        for (const auto& kv : e.Cast<LogEvent>()) {
+            res += kv.first.to_string() + "=" + kv.second.to_string() + ";";
+        }
+        return res;
+    };
+    APSARA_TEST_EQUAL("key3=c;key1=a;key2=b;", getContents(events[0]));
+    APSARA_TEST_EQUAL("key1=A;key3=c;key2=B;", getContents(events[1]));
+}
+
+void ColumnarLogEventsUnittest::TestEventGroup() {
+    APSARA_TEST_FALSE(mEventGroup->IsColumnar());
+    mEventGroup->AddLogEvent();
+    auto& columns = mEventGroup->EnableColumnarLogs();
+    APSARA_TEST_TRUE(mEventGroup->IsColumnar());
+    APSARA_TEST_EQUAL(&columns, &mEventGroup->EnableColumnarLogs());
+    size_t col = columns.AddColumn("key");
+    size_t row = columns.AddRow(0, nullopt, 0, 0);
+    columns.SetValue(col, row, "value");
+    APSARA_TEST_EQUAL(2U, mEventGroup->GetEventsCount());
+
+    auto copied = mEventGroup->Copy();
+    APSARA_TEST_TRUE(copied.IsColumnar());
+    APSARA_TEST_EQUAL(1U, copied.GetColumnarLogs()->Size());
+
+    mEventGroup->MaterializeColumnarLogs();
+    APSARA_TEST_FALSE(mEventGroup->IsColumnar());
+    APSARA_TEST_EQUAL(2U, mEventGroup->GetEvents().size());
+    APSARA_TEST_EQUAL(2U, mEventGroup->GetEventsCount());
+    APSARA_TEST_EQUAL("value", mEventGroup->GetEvents()[1].Cast<LogEvent>().GetContent("key").to_string());
+}
+
+UNIT_TEST_CASE(ColumnarLogEventsUnittest, TestAddRowAndColumn)
+UNIT_TEST_CASE(ColumnarLogEventsUnittest, TestSetAndDelValue)
+UNIT_TEST_CASE(ColumnarLogEventsUnittest, TestFilterRows)
+UNIT_TEST_CASE(ColumnarLogEventsUnittest, TestDataSize)
+UNIT_TEST_CASE(ColumnarLogEventsUnittest, TestMaterialize)
+UNIT_TEST_CASE(ColumnarLogEventsUnittest, TestContentOrder)
+UNIT_TEST_CASE(ColumnarLogEventsUnittest, TestEventGroup)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
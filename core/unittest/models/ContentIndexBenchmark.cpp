@@ -0,0 +1,136 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <map>
+
+#include "common/TimeUtil.h"
+#include "models/LogEvent.h"
+#include "models/PipelineEventGroup.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const size_t kEventCnt = 4096;
+static const int kRounds = 100;
+
+// the content index of LogEvent before LogContentIndex was introduced
+class MapIndexedContents {
+public:
+    void SetContentNoCopy(StringView key, StringView val) {
+        auto rst = mIndex.insert(std::make_pair(key, mContents.size()));
+        if (!rst.second) {
+            mContents[rst.first->second].first = std::make_pair(key, val);
+        } else {
+            mContents.emplace_back(std::make_pair(key, val), true);
+        }
+    }
+    StringView GetContent(StringView key) const {
+        auto it = mIndex.find(key);
+        return it == mIndex.end() ? StringView() : mContents[it->second].first.second;
+    }
+    void DelContent(StringView key) {
+        auto it = mIndex.find(key);
+        if (it != mIndex.end()) {
+            mContents[it->second].second = false;
+            mIndex.erase(it);
+        }
+    }
+
+private:
+    ContentsContainer mContents;
+    std::map<StringView, size_t> mIndex;
+};
+
+class ContentIndexBenchmark {
+public:
+    explicit ContentIndexBenchmark(size_t keyCnt);
+
+    void TestMap();
+    void TestLogEvent();
+
+private:
+    size_t mKeyCnt;
+    std::vector<std::string> mKeys;
+    std::string mSourceKey = "content";
+    std::string mValue = "some_value";
+};
+
+ContentIndexBenchmark::ContentIndexBenchmark(size_t keyCnt) : mKeyCnt(keyCnt) {
+    for (size_t i = 0; i < keyCnt; ++i) {
+        mKeys.emplace_back("parsed_key_" + std::to_string(i));
+    }
+}
+
+// same access pattern as a parser followed by a filter: set the source, add all parsed keys, drop the source and read
+// some of the keys back
+template <class T>
+static void ProcessEvent(T& event,
+                         const std::string& sourceKey,
+                         const std::vector<std::string>& keys,
+                         const std::string& value,
+                         size_t& hit) {
+    event.SetContentNoCopy(StringView(sourceKey), StringView(value));
+    for (const auto& key : keys) {
+        event.SetContentNoCopy(StringView(key), StringView(value));
+    }
+    event.DelContent(StringView(sourceKey));
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        hit += event.GetContent(StringView(keys[i])).size();
+    }
+}
+
+void ContentIndexBenchmark::TestMap() {
+    size_t hit = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (int r = 0; r < kRounds; ++r) {
+        std::vector<MapIndexedContents> events(kEventCnt);
+        for (auto& event : events) {
+            ProcessEvent(event, mSourceKey, mKeys, mValue, hit);
+        }
+    }
+    printf("%s with %zu keys costs %lums\n", __func__, mKeyCnt, GetCurrentTimeInMilliSeconds() - starttime);
+}
+
+void ContentIndexBenchmark::TestLogEvent() {
+    size_t hit = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (int r = 0; r < kRounds; ++r) {
+        PipelineEventGroup eventGroup(std::make_shared<SourceBuffer>());
+        eventGroup.ReserveEvents(kEventCnt);
+        for (size_t i = 0; i < kEventCnt; ++i) {
+            ProcessEvent(*eventGroup.AddLogEvent(), mSourceKey, mKeys, mValue, hit);
+        }
+    }
+    printf("%s with %zu keys costs %lums\n", __func__, mKeyCnt, GetCurrentTimeInMilliSeconds() - starttime);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    for (size_t keyCnt : {5, 10, 20, 40}) {
+        logtail::ContentIndexBenchmark benchmark(keyCnt);
+        benchmark.TestMap();
+        benchmark.TestLogEvent();
+    }
+    return 0;
+}
@@ -0,0 +1,137 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdlib>
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/DelimiterScanner.h"
+#include "common/TimeUtil.h"
+#include "models/LogEvent.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+// same size as one read buffer of LogFileReader
+static const size_t kBufferSize = 512 * 1024;
+static const int kRounds = 1000;
+
+class LineSplitBenchmark {
+public:
+    LineSplitBenchmark();
+
+    void TestByteLoop();
+    void TestScanner(const char* name,
+                     void (*scan)(const char*, size_t, char, std::vector<size_t>&),
+                     DelimiterScannerImpl impl);
+    void TestProcessor();
+
+private:
+    std::string mData;
+};
+
+LineSplitBenchmark::LineSplitBenchmark() {
+    srand(0);
+    mData.reserve(kBufferSize);
+    while (mData.size() < kBufferSize) {
+        // single line logs of 80~200 bytes
+        size_t len = 80 + rand() % 120;
+        for (size_t i = 0; i < len && mData.size() < kBufferSize - 1; ++i) {
+            mData.push_back(static_cast<char>('a' + rand() % 26));
+        }
+        mData.push_back('\n');
+    }
+}
+
+static void PrintResult(const char* name, uint64_t timeElapsedMs, size_t lines) {
+    double mbPerSec = timeElapsedMs == 0 ? 0.0 : kBufferSize * kRounds / 1024.0 / 1024.0 / (timeElapsedMs / 1000.0);
+    printf("%s costs %lums, %.1fMB/s, %zu lines per buffer\n", name, timeElapsedMs, mbPerSec, lines);
+}
+
+void LineSplitBenchmark::TestByteLoop() {
+    std::vector<size_t> positions;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (int r = 0; r < kRounds; ++r) {
+        positions.clear();
+        for (size_t i = 0; i < mData.size(); ++i) {
+            if (mData[i] == '\n') {
+                positions.push_back(i);
+            }
+        }
+    }
+    PrintResult(__func__, GetCurrentTimeInMilliSeconds() - starttime, positions.size());
+}
+
+void LineSplitBenchmark::TestScanner(const char* name,
+                                     void (*scan)(const char*, size_t, char, std::vector<size_t>&),
+                                     DelimiterScannerImpl impl) {
+    if (!IsDelimiterScannerImplSupported(impl)) {
+        printf("%s skipped, not supported by current cpu\n", name);
+        return;
+    }
+    std::vector<size_t> positions;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (int r = 0; r < kRounds; ++r) {
+        positions.clear();
+        scan(mData.data(), mData.size(), '\n', positions);
+    }
+    PrintResult(name, GetCurrentTimeInMilliSeconds() - starttime, positions.size());
+}
+
+void LineSplitBenchmark::TestProcessor() {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("project##config_0");
+    ProcessorSplitLogStringNative processor;
+    processor.SetContext(ctx);
+    processor.Init(Json::Value());
+
+    size_t lines = 0;
+    uint64_t timeElapsed = 0;
+    for (int r = 0; r < kRounds; ++r) {
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        auto* event = eventGroup.AddLogEvent();
+        StringBuffer content = sourceBuffer->CopyString(mData);
+        event->SetContentNoCopy(StringView(DEFAULT_CONTENT_KEY), StringView(content.data, content.size));
+        event->SetPosition(0, mData.size());
+        uint64_t starttime = GetCurrentTimeInMilliSeconds();
+        processor.Process(eventGroup);
+        timeElapsed += GetCurrentTimeInMilliSeconds() - starttime;
+        lines = eventGroup.GetEvents().size();
+    }
+    PrintResult(__func__, timeElapsed, lines);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::LineSplitBenchmark benchmark;
+    printf("selected scanner: %s\n", logtail::DelimiterScannerImplToString(logtail::GetDelimiterScannerImpl()));
+    benchmark.TestByteLoop();
+    benchmark.TestScanner("TestScalar", logtail::FindAllDelimitersScalar, logtail::DelimiterScannerImpl::SCALAR);
+    benchmark.TestScanner("TestSSE2", logtail::FindAllDelimitersSSE2, logtail::DelimiterScannerImpl::SSE2);
+    benchmark.TestScanner("TestAVX2", logtail::FindAllDelimitersAVX2, logtail::DelimiterScannerImpl::AVX2);
+    benchmark.TestProcessor();
+    return 0;
+}
@@ -26,6 +26,7 @@ public:
     void TestTimestampOp();
     void TestSetContent();
     void TestDelContent();
+    void TestManyContents();
     void TestReadContentOp();
     void TestIterateContent();
     void TestMeta();
@@ -102,6 +103,45 @@ void LogEventUnittest::TestDelContent() {
     }
 }
 
+void LogEventUnittest::TestManyContents() {
+    // enough keys to switch the content index from linear scan to hash table
+    const size_t keyCnt = 100;
+    for (size_t i = 0; i < keyCnt; ++i) {
+        mLogEvent->SetContent("key" + to_string(i), "value" + to_string(i));
+    }
+    APSARA_TEST_EQUAL(keyCnt, mLogEvent->Size());
+    for (size_t i = 0; i < keyCnt; ++i) {
+        APSARA_TEST_EQUAL("value" + to_string(i), mLogEvent->GetContent("key" + to_string(i)).to_string());
+    }
+    APSARA_TEST_FALSE(mLogEvent->HasContent("key" + to_string(keyCnt)));
+
+    // overwrite and delete
+    for (size_t i = 0; i < keyCnt; i += 2) {
+        mLogEvent->DelContent("key" + to_string(i));
+    }
+    mLogEvent->SetContent(string("key1"), string("new_value1"));
+    APSARA_TEST_EQUAL(keyCnt / 2, mLogEvent->Size());
+    APSARA_TEST_FALSE(mLogEvent->HasContent("key0"));
+    APSARA_TEST_EQUAL("new_value1", mLogEvent->GetContent("key1").to_string());
+
+    // re-added keys are appended, others keep the insertion order
+    mLogEvent->SetContent(string("key0"), string("value0"));
+    vector<string> keys;
+    for (const auto& content : *mLogEvent) {
+        keys.emplace_back(content.first.to_string());
+    }
+    APSARA_TEST_EQUAL(keyCnt / 2 + 1, keys.size());
+    APSARA_TEST_EQUAL("key1", keys.front());
+    APSARA_TEST_EQUAL("key3", keys[1]);
+    APSARA_TEST_EQUAL("key0", keys.back());
+
+    mLogEvent->Reset();
+    APSARA_TEST_TRUE(mLogEvent->Empty());
+    APSARA_TEST_FALSE(mLogEvent->HasContent("key1"));
+    mLogEvent->SetContent(string("key1"), string("value1"));
+    APSARA_TEST_EQUAL("value1", mLogEvent->GetContent("key1").to_string());
+}
+
 void LogEventUnittest::TestReadContentOp() {
     mLogEvent->SetContent(string("key1"), string("value1"));
     {
@@ -225,6 +265,7 @@ void LogEventUnittest::TestLevel() {
 UNIT_TEST_CASE(LogEventUnittest, TestTimestampOp)
 UNIT_TEST_CASE(LogEventUnittest, TestSetContent)
 UNIT_TEST_CASE(LogEventUnittest, TestDelContent)
+UNIT_TEST_CASE(LogEventUnittest, TestManyContents)
 UNIT_TEST_CASE(LogEventUnittest, TestReadContentOp)
 UNIT_TEST_CASE(LogEventUnittest, TestIterateContent)
 UNIT_TEST_CASE(LogEventUnittest, TestMeta)
@@ -0,0 +1,162 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "collection_pipeline/ParallelProcessExecutor.h"
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "plugin/processor/ProcessorFilterNative.h"
+#include "plugin/processor/ProcessorParseRegexNative.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(parallel_process_thread_num);
+DECLARE_FLAG_INT32(parallel_process_min_events_per_task);
+
+using namespace std;
+
+namespace logtail {
+
+class ParallelProcessExecutorUnittest : public testing::Test {
+public:
+    void TestSplitAndMerge();
+    void TestProcess();
+    void TestProcessSmallGroup();
+    void TestProcessAfterStop();
+
+protected:
+    static void SetUpTestCase() {
+        INT32_FLAG(parallel_process_thread_num) = 3;
+        INT32_FLAG(parallel_process_min_events_per_task) = 10;
+    }
+
+    void SetUp() override {
+        mContext.SetConfigName("test_config");
+
+        Json::Value config;
+        config["SourceKey"] = "content";
+        config["Regex"] = "(\\w+) (\\d+)";
+        config["Keys"] = Json::arrayValue;
+        config["Keys"].append("key");
+        config["Keys"].append("idx");
+        mParseProcessor = make_unique<ProcessorInstance>(new ProcessorParseRegexNative, PluginInstance::PluginMeta{"1"});
+        APSARA_TEST_TRUE_FATAL(mParseProcessor->Init(config, mContext));
+
+        config.clear();
+        config["Include"]["key"] = "keep";
+        mFilterProcessor = make_unique<ProcessorInstance>(new ProcessorFilterNative, PluginInstance::PluginMeta{"2"});
+        APSARA_TEST_TRUE_FATAL(mFilterProcessor->Init(config, mContext));
+    }
+
+private:
+    // event i has content "keep i" if i is even, or "drop i" otherwise
+    static PipelineEventGroup GenerateGroup(size_t cnt);
+
+    CollectionPipelineContext mContext;
+    unique_ptr<ProcessorInstance> mParseProcessor;
+    unique_ptr<ProcessorInstance> mFilterProcessor;
+};
+
+void ParallelProcessExecutorUnittest::TestSplitAndMerge() {
+    auto group = GenerateGroup(100);
+    group.SetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED, string("/var/log/test.log"));
+    group.SetTag(string("tag_key"), string("tag_value"));
+
+    auto subGroups = ParallelProcessExecutor::Split(group, 3);
+    APSARA_TEST_EQUAL(3U, subGroups.size());
+    APSARA_TEST_EQUAL(0U, group.GetEvents().size());
+    APSARA_TEST_EQUAL(33U, subGroups[0].GetEvents().size());
+    APSARA_TEST_EQUAL(33U, subGroups[1].GetEvents().size());
+    APSARA_TEST_EQUAL(34U, subGroups[2].GetEvents().size());
+    for (auto& subGroup : subGroups) {
+        APSARA_TEST_EQUAL("/var/log/test.log", subGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_PATH_RESOLVED));
+        APSARA_TEST_EQUAL("tag_value", subGroup.GetTag("tag_key"));
+        APSARA_TEST_NOT_EQUAL(group.GetSourceBuffer(), subGroup.GetSourceBuffer());
+        for (auto& e : subGroup.MutableEvents()) {
+            APSARA_TEST_EQUAL(&subGroup, e->GetPipelineEventGroupPtr());
+        }
+    }
+
+    ParallelProcessExecutor::Merge(group, subGroups);
+    APSARA_TEST_EQUAL(100U, group.GetEvents().size());
+    for (size_t i = 0; i < group.GetEvents().size(); ++i) {
+        auto& e = group.MutableEvents()[i];
+        APSARA_TEST_EQUAL(&group, e->GetPipelineEventGroupPtr());
+        APSARA_TEST_EQUAL((i % 2 == 0 ? "keep " : "drop ") + ToString(i), e.Cast<LogEvent>().GetContent("content"));
+    }
+}
+
+void ParallelProcessExecutorUnittest::TestProcess() {
+    vector<PipelineEventGroup> groups;
+    groups.emplace_back(GenerateGroup(1000));
+    groups.emplace_back(GenerateGroup(5));
+    groups.emplace_back(GenerateGroup(333));
+
+    ParallelProcessExecutor::GetInstance()->Process(groups, {mParseProcessor.get(), mFilterProcessor.get()});
+
+    APSARA_TEST_EQUAL(3U, groups.size());
+    vector<size_t> expectedCnts{500, 3, 167};
+    for (size_t i = 0; i < groups.size(); ++i) {
+        auto& events = groups[i].MutableEvents();
+        APSARA_TEST_EQUAL(expectedCnts[i], events.size());
+        for (size_t j = 0; j < events.size(); ++j) {
+            // keys are allocated in the source buffers of sub groups, which must be kept alive by the merged group
+            const auto& log = events[j].Cast<LogEvent>();
+            APSARA_TEST_EQUAL(&groups[i], events[j]->GetPipelineEventGroupPtr());
+            APSARA_TEST_EQUAL("keep", log.GetContent("key"));
+            APSARA_TEST_EQUAL(ToString(j * 2), log.GetContent("idx"));
+        }
+    }
+}
+
+void ParallelProcessExecutorUnittest::TestProcessSmallGroup() {
+    vector<PipelineEventGroup> groups;
+    groups.emplace_back(GenerateGroup(15));
+    auto sourceBuffer = groups[0].GetSourceBuffer();
+
+    ParallelProcessExecutor::GetInstance()->Process(groups, {mParseProcessor.get()});
+
+    // groups smaller than twice the min events per task are not split
+    APSARA_TEST_EQUAL(sourceBuffer, groups[0].GetSourceBuffer());
+    APSARA_TEST_EQUAL(15U, groups[0].GetEvents().size());
+    APSARA_TEST_EQUAL("keep", groups[0].GetEvents()[0].Cast<LogEvent>().GetContent("key"));
+}
+
+void ParallelProcessExecutorUnittest::TestProcessAfterStop() {
+    ParallelProcessExecutor::GetInstance()->Stop();
+
+    // the calling thread processes all sub groups by itself
+    vector<PipelineEventGroup> groups;
+    groups.emplace_back(GenerateGroup(100));
+    ParallelProcessExecutor::GetInstance()->Process(groups, {mParseProcessor.get(), mFilterProcessor.get()});
+    APSARA_TEST_EQUAL(50U, groups[0].GetEvents().size());
+    APSARA_TEST_EQUAL("98", groups[0].GetEvents()[49].Cast<LogEvent>().GetContent("idx"));
+}
+
+PipelineEventGroup ParallelProcessExecutorUnittest::GenerateGroup(size_t cnt) {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    for (size_t i = 0; i < cnt; ++i) {
+        auto e = group.AddLogEvent();
+        e->SetContent(string("content"), (i % 2 == 0 ? "keep " : "drop ") + ToString(i));
+    }
+    return group;
+}
+
+UNIT_TEST_CASE(ParallelProcessExecutorUnittest, TestSplitAndMerge)
+UNIT_TEST_CASE(ParallelProcessExecutorUnittest, TestProcess)
+UNIT_TEST_CASE(ParallelProcessExecutorUnittest, TestProcessSmallGroup)
+UNIT_TEST_CASE(ParallelProcessExecutorUnittest, TestProcessAfterStop)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
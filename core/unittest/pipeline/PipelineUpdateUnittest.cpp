@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <memory>
+#include <shared_mutex>
 #include <string>
 #include <vector>
 
@@ -212,7 +213,7 @@ private:
         {
             auto manager = ProcessQueueManager::GetInstance();
             manager->CreateOrUpdateBoundedQueue(key, 0, CollectionPipelineContext{});
-            lock_guard<mutex> lock(manager->mQueueMux);
+            lock_guard<shared_mutex> lock(manager->mQueueMux);
             auto iter = manager->mQueues.find(key);
             APSARA_TEST_NOT_EQUAL(iter, manager->mQueues.end());
             static_cast<BoundedProcessQueue*>((*iter->second.first).get())->mValidToPush = true;
@@ -265,7 +266,7 @@ private:
             i = from;
             j = 0;
             while ((i < to + 1) && j < requests.size()) {
-                auto content = requests[j].mData;
+                const auto& content = requests[j].mData.str();
                 auto actualLogstore = static_cast<FlusherSLS*>(requests[j].mFlusher)->mLogstore;
                 if (actualLogstore != logstore) {
                     ++j;
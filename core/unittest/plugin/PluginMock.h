@@ -242,16 +242,16 @@ public:
                       std::unique_ptr<HttpSinkRequest>& req,
                       bool* keepItem,
                       std::string* errMsg) override {
-        if (item->mData == "invalid_keep") {
+        if (item->mData.str() == "invalid_keep") {
             *keepItem = true;
             return false;
         }
-        if (item->mData == "invalid_discard") {
+        if (item->mData.str() == "invalid_discard") {
             *keepItem = false;
             return false;
         }
         req = std::make_unique<HttpSinkRequest>(
-            "", false, "", 80, "", "", std::map<std::string, std::string>(), "", nullptr);
+            "", false, "", 80, "", "", std::map<std::string, std::string>(), PayloadBuffer(), nullptr);
         return true;
     }
     void OnSendDone(const HttpResponse& response, SenderQueueItem* item) override {}
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2024 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "models/LogEvent.h"
+#include "models/PipelineEventGroup.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+
+// Helpers for checking that processors produce the same output on columnar groups as on ordinary ones.
+class ColumnarEventsHelper {
+public:
+    // move the log events of the group into columnar mode, keeping the content order of each event
+    static void ConvertToColumnar(PipelineEventGroup& group) {
+        auto& columns = group.EnableColumnarLogs();
+        for (const auto& e : group.GetEvents()) {
+            const auto& event = e.Cast<LogEvent>();
+            size_t row = columns.AddRow(event.GetTimestamp(),
+                                        event.GetTimestampNanosecond(),
+                                        event.GetPosition().first,
+                                        event.GetPosition().second);
+            for (const auto& content : event) {
+                columns.SetValue(columns.AddColumn(content.first), row, content.second);
+            }
+        }
+        EventsContainer emptyEvents;
+        group.SwapEvents(emptyEvents);
+    }
+
+    // dump all log events of the group with contents in order, which ToJsonString does not keep
+    static std::string DumpLogEvents(const PipelineEventGroup& group) {
+        std::string res;
+        for (const auto& e : group.GetEvents()) {
+            const auto& event = e.Cast<LogEvent>();
+            res += std::to_string(event.GetTimestamp()) + " " + std::to_string(event.GetPosition().first) + " "
+                + std::to_string(event.GetPosition().second);
+            for (const auto& content : event) {
+                res += "\t" + content.first.to_string() + "=" + content.second.to_string();
+            }
+            res += "\n";
+        }
+        return res;
+    }
+
+    // run a new processor of type P on the group made by makeGroup, in columnar mode if columnar is true, and return
+    // the dumped output along with the data size before materialization
+    template <class P, class F>
+    static std::pair<std::string, size_t>
+    Process(const Json::Value& config, CollectionPipelineContext& ctx, F&& makeGroup, bool columnar) {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        makeGroup(group);
+        if (columnar) {
+            ConvertToColumnar(group);
+        }
+        ProcessorInstance processorInstance(new P, PluginInstance::PluginMeta{"1"});
+        bool initRes = processorInstance.Init(config, ctx);
+        APSARA_TEST_TRUE(initRes);
+        if (!initRes) {
+            return {};
+        }
+        std::vector<PipelineEventGroup> groups;
+        groups.emplace_back(std::move(group));
+        processorInstance.Process(groups);
+        size_t dataSize = groups[0].DataSize();
+        groups[0].MaterializeColumnarLogs();
+        return {DumpLogEvents(groups[0]), dataSize};
+    }
+};
+
+} // namespace logtail
@@ -0,0 +1,192 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "models/PipelineEventGroup.h"
+#include "parser/DelimiterModeFsmParser.h"
+#include "parser/DelimiterModeSimdParser.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class DelimiterModeSimdParserUnittest : public ::testing::Test {
+public:
+    void TestSplitLine();
+    void TestParseDelimiterLine();
+    void TestSplitLineConsistent();
+    void TestParseDelimiterLineConsistentWithFsm();
+
+private:
+    vector<string> SplitLine(const DelimiterModeSimdParser& parser, const string& line, size_t maxFields = 0) {
+        vector<StringView> columns;
+        parser.SplitLine(line, maxFields, columns);
+        return ToStrings(columns);
+    }
+
+    static vector<string> ToStrings(const vector<StringView>& columns) {
+        vector<string> res;
+        for (const auto& column : columns) {
+            res.push_back(column.to_string());
+        }
+        return res;
+    }
+
+    // the same as the splitting with std::search in ProcessorParseDelimiterNative
+    static vector<string> SearchSplit(const string& line, const string& separator, size_t maxFields) {
+        vector<string> res;
+        size_t pos = 0;
+        while (true) {
+            size_t next = line.find(separator, pos);
+            if (next == string::npos) {
+                res.push_back(line.substr(pos));
+                return res;
+            }
+            res.push_back(line.substr(pos, next - pos));
+            pos = next + separator.size();
+            if (maxFields != 0 && res.size() >= maxFields) {
+                res.push_back(line.substr(next));
+                return res;
+            }
+        }
+    }
+
+    SourceBuffer mSourceBuffer;
+};
+
+void DelimiterModeSimdParserUnittest::TestSplitLine() {
+    DelimiterModeSimdParser parser('"', ",");
+    APSARA_TEST_EQUAL(vector<string>({"a", "b", "", "c"}), SplitLine(parser, "a,b,,c"));
+    APSARA_TEST_EQUAL(vector<string>({"", "a", ""}), SplitLine(parser, ",a,"));
+    APSARA_TEST_EQUAL(vector<string>({"\"a", "b\""}), SplitLine(parser, "\"a,b\""));
+    // the rest starting from the separator is kept as the last column
+    APSARA_TEST_EQUAL(vector<string>({"a", "b", ",c,d"}), SplitLine(parser, "a,b,c,d", 2));
+    APSARA_TEST_EQUAL(vector<string>({"a", "b"}), SplitLine(parser, "a,b", 2));
+
+    DelimiterModeSimdParser multiChar('"', "||");
+    APSARA_TEST_EQUAL(vector<string>({"a", "b|c", "|"}), SplitLine(multiChar, "a||b|c|||"));
+    APSARA_TEST_EQUAL(vector<string>({"|"}), SplitLine(multiChar, "|"));
+    // separators do not overlap
+    APSARA_TEST_EQUAL(vector<string>({"", "|"}), SplitLine(multiChar, "|||"));
+    APSARA_TEST_EQUAL(vector<string>({"a", "||b||c"}), SplitLine(multiChar, "a||b||c", 1));
+
+    // separators at the edges of 64-byte blocks
+    string line(200, 'x');
+    for (size_t pos : {0, 62, 63, 64, 127, 128, 199}) {
+        line[pos] = ',';
+    }
+    APSARA_TEST_EQUAL(SearchSplit(line, ",", 0), SplitLine(parser, line));
+    line[63] = '|';
+    line[64] = '|';
+    APSARA_TEST_EQUAL(SearchSplit(line, "||", 0), SplitLine(multiChar, line));
+}
+
+void DelimiterModeSimdParserUnittest::TestParseDelimiterLine() {
+    DelimiterModeSimdParser parser('"', ",");
+    vector<StringView> columns;
+    string line = R"(a,"b,c","d""e",,"")";
+    APSARA_TEST_TRUE(parser.ParseDelimiterLine(line, columns, mSourceBuffer));
+    APSARA_TEST_EQUAL(vector<string>({"a", "b,c", "d\"e", "", ""}), ToStrings(columns));
+    // only the field with escaped quotes is copied
+    APSARA_TEST_TRUE(columns[0].data() == line.data());
+    APSARA_TEST_TRUE(columns[1].data() == line.data() + 3);
+    APSARA_TEST_TRUE(columns[2].data() < line.data() || columns[2].data() >= line.data() + line.size());
+
+    // quoted fields across 64-byte blocks
+    columns.clear();
+    string longField = string(70, 'x') + "\"\"," + string(60, 'y');
+    line = "\"" + longField + "\",\"\"\"\"";
+    APSARA_TEST_TRUE(parser.ParseDelimiterLine(line, columns, mSourceBuffer));
+    APSARA_TEST_EQUAL(vector<string>({string(70, 'x') + "\"," + string(60, 'y'), "\""}), ToStrings(columns));
+
+    for (const string invalid : {"a\"b", "\"a\"b", "\"a", "\"a\"\"", "\"a\" ,b", "a,\"b\"c\",d", "\""}) {
+        columns.clear();
+        APSARA_TEST_FALSE_DESC(parser.ParseDelimiterLine(invalid, columns, mSourceBuffer), invalid);
+        APSARA_TEST_TRUE(columns.empty());
+    }
+}
+
+void DelimiterModeSimdParserUnittest::TestSplitLineConsistent() {
+    mt19937 gen(20240101);
+    for (const string separator : {",", "\t", "||", "|#|", "abcd"}) {
+        DelimiterModeSimdParser parser('"', separator);
+        const string alphabet = separator + "xa";
+        uniform_int_distribution<size_t> charDist(0, alphabet.size() - 1);
+        uniform_int_distribution<size_t> lenDist(1, 300);
+        for (int round = 0; round < 500; ++round) {
+            string line(lenDist(gen), '\0');
+            for (auto& c : line) {
+                c = alphabet[charDist(gen)];
+            }
+            for (size_t maxFields : {0, 1, 5}) {
+                APSARA_TEST_EQUAL(SearchSplit(line, separator, maxFields), SplitLine(parser, line, maxFields));
+            }
+        }
+    }
+}
+
+void DelimiterModeSimdParserUnittest::TestParseDelimiterLineConsistentWithFsm() {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    LogEvent* event = group.AddLogEvent();
+    mt19937 gen(20240101);
+    for (char quote : {'"', '\''}) {
+        DelimiterModeFsmParser fsmParser(quote, ',');
+        DelimiterModeSimdParser parser(quote, ",");
+        const string alphabet = string(",,xy ") + quote + quote;
+        uniform_int_distribution<size_t> charDist(0, alphabet.size() - 1);
+        uniform_int_distribution<size_t> lenDist(1, 200);
+        for (int round = 0; round < 20000; ++round) {
+            string line(lenDist(gen), '\0');
+            for (auto& c : line) {
+                c = alphabet[charDist(gen)];
+            }
+            // most random lines are invalid, so every other line is made of quoted fields
+            if (round % 2 == 0) {
+                string valid;
+                for (size_t i = 0; i < line.size(); i += 20) {
+                    string field = line.substr(i, 20);
+                    if (field.find(quote) != string::npos || field.find(',') != string::npos) {
+                        string quoted(1, quote);
+                        for (char c : field) {
+                            quoted += c == quote ? string(2, quote) : string(1, c);
+                        }
+                        field = quoted + quote;
+                    }
+                    valid += (i == 0 ? "" : ",") + field;
+                }
+                line = valid;
+            }
+            vector<StringView> expected;
+            bool expectedRes = fsmParser.ParseDelimiterLine(line, 0, line.size(), expected, *event);
+            vector<StringView> columns;
+            bool res = parser.ParseDelimiterLine(line, columns, mSourceBuffer);
+            APSARA_TEST_TRUE_DESC(expectedRes == res, line);
+            APSARA_TEST_TRUE_DESC(ToStrings(expected) == ToStrings(columns), line);
+        }
+    }
+}
+
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestSplitLine)
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestParseDelimiterLine)
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestSplitLineConsistent)
+UNIT_TEST_CASE(DelimiterModeSimdParserUnittest, TestParseDelimiterLineConsistentWithFsm)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,132 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include "common/CompiledTimeFormat.h"
+#include "common/TimeUtil.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const size_t kTimeCount = 100000;
+static const int kRounds = 20;
+
+// formats used by ProcessorParseTimestampNativeUnittest, and those of nginx and apache logs
+struct TimeFormat {
+    const char* mFormat;
+    const char* mStrftimeFormat;
+    int32_t mSpecifiedYear;
+};
+static const TimeFormat kFormats[] = {
+    {"%Y-%m-%d %H:%M:%S", "%Y-%m-%d %H:%M:%S", -1},
+    {"%Y-%m-%d %H:%M:%S.%f", "%Y-%m-%d %H:%M:%S.123456", -1},
+    {"%m-%d %H:%M:%S.%f", "%m-%d %H:%M:%S.123", 2018},
+    {"%H:%M:%S.%f %Y-%m-%d", "%H:%M:%S.123456789 %Y-%m-%d", -1},
+    {"%d/%b/%Y:%H:%M:%S", "%d/%b/%Y:%H:%M:%S", -1},
+    {"%a %b %d %H:%M:%S %Y", "%a %b %d %H:%M:%S %Y", -1},
+};
+
+class ParseTimestampBenchmark {
+public:
+    explicit ParseTimestampBenchmark(const TimeFormat& format);
+
+    void TestStrptime();
+    void TestCompiled();
+
+private:
+    void PrintResult(const char* name, uint64_t timeElapsedMs, time_t checksum);
+
+    TimeFormat mFormat;
+    std::vector<std::string> mTimes;
+};
+
+ParseTimestampBenchmark::ParseTimestampBenchmark(const TimeFormat& format) : mFormat(format) {
+    // a few logs per second, as in a busy log file
+    time_t t = 1719792000;
+    for (size_t i = 0; i < kTimeCount; ++i) {
+        time_t cur = t + i / 4;
+        struct tm tm;
+        localtime_r(&cur, &tm);
+        char buf[128];
+        size_t len = strftime(buf, sizeof(buf), format.mStrftimeFormat, &tm);
+        mTimes.emplace_back(buf, len);
+    }
+}
+
+void ParseTimestampBenchmark::PrintResult(const char* name, uint64_t timeElapsedMs, time_t checksum) {
+    double nsPerTime = timeElapsedMs * 1000000.0 / (kTimeCount * kRounds);
+    printf("%-24s %-30s costs %lums, %.1fns per time, checksum %ld\n",
+           mFormat.mFormat,
+           name,
+           timeElapsedMs,
+           nsPerTime,
+           static_cast<long>(checksum));
+}
+
+void ParseTimestampBenchmark::TestStrptime() {
+    LogtailTime logTime = {0, 0};
+    int nanosecondLength = -1;
+    time_t checksum = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (int r = 0; r < kRounds; ++r) {
+        for (const auto& time : mTimes) {
+            Strptime(time.c_str(), mFormat.mFormat, &logTime, nanosecondLength, mFormat.mSpecifiedYear);
+            checksum += logTime.tv_sec;
+        }
+    }
+    PrintResult(__func__, GetCurrentTimeInMilliSeconds() - starttime, checksum);
+}
+
+void ParseTimestampBenchmark::TestCompiled() {
+    CompiledTimeFormat compiled;
+    if (!compiled.Compile(mFormat.mFormat, mFormat.mSpecifiedYear)) {
+        printf("%-24s %s skipped, not supported\n", mFormat.mFormat, __func__);
+        return;
+    }
+    LogtailTime logTime = {0, 0};
+    int nanosecondLength = -1;
+    time_t checksum = 0;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (int r = 0; r < kRounds; ++r) {
+        for (const auto& time : mTimes) {
+            compiled.Parse(time.c_str(), &logTime, nanosecondLength);
+            checksum += logTime.tv_sec;
+        }
+    }
+    PrintResult(__func__, GetCurrentTimeInMilliSeconds() - starttime, checksum);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    for (const auto& format : logtail::kFormats) {
+        logtail::ParseTimestampBenchmark benchmark(format);
+        benchmark.TestStrptime();
+        benchmark.TestCompiled();
+    }
+    return 0;
+}
@@ -13,13 +13,17 @@
 // limitations under the License.
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
 #include "common/ExceptionBase.h"
+#include "common/Flags.h"
 #include "common/JsonUtil.h"
 #include "plugin/processor/ProcessorFilterNative.h"
 #include "unittest/Unittest.h"
+#include "unittest/processor/ColumnarEventsHelper.h"
 
 using boost::regex;
 using namespace std;
 
+DECLARE_FLAG_BOOL(enable_filter_regex_re2);
+
 namespace logtail {
 
 class ProcessorFilterNativeUnittest : public ::testing::Test {
@@ -31,6 +35,8 @@ public:
     void TestLogFilterRule();
     void TestBaseFilter();
     void TestFilterNoneUtf8();
+    void TestKeyMatcher();
+    void TestProcessColumnar();
 
     CollectionPipelineContext mContext;
 };
@@ -40,6 +46,8 @@ UNIT_TEST_CASE(ProcessorFilterNativeUnittest, OnFailedInit)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestLogFilterRule)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestBaseFilter)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterNoneUtf8)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestKeyMatcher)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestProcessColumnar)
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -1095,6 +1103,134 @@ void ProcessorFilterNativeUnittest::TestFilterNoneUtf8() {
     }
 } // end of case
 
+void ProcessorFilterNativeUnittest::TestKeyMatcher() {
+    Json::Value config;
+    config["FilterKey"] = Json::Value(Json::arrayValue);
+    config["FilterKey"].append("content");
+    config["FilterKey"].append("level");
+    config["FilterKey"].append("content");
+    config["FilterRegex"] = Json::Value(Json::arrayValue);
+    config["FilterRegex"].append(R"(\d+ \[\w+\] .*)");
+    config["FilterRegex"].append("ERROR|WARN");
+    config["FilterRegex"].append(".*timeout.*");
+
+    auto isMatched = [](ProcessorFilterNative& processor, const string& content, const string& level) {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto* event = group.AddLogEvent();
+        event->SetContent(string("content"), content);
+        event->SetContent(string("level"), level);
+        return processor.IsMatched(*event, *processor.mFilterRule);
+    };
+    auto checkMatched = [&](ProcessorFilterNative& processor) {
+        APSARA_TEST_TRUE(isMatched(processor, "1 [main] request timeout", "ERROR"));
+        APSARA_TEST_TRUE(isMatched(processor, "1 [main] timeout\nretry", "WARN"));
+        APSARA_TEST_FALSE(isMatched(processor, "1 [main] request timeout", "INFO"));
+        // rejected by the required literals
+        APSARA_TEST_FALSE(isMatched(processor, "1 [main] request done", "ERROR"));
+        APSARA_TEST_FALSE(isMatched(processor, "1 main timeout", "ERROR"));
+        // rejected by the regex
+        APSARA_TEST_FALSE(isMatched(processor, "a [main] request timeout", "ERROR"));
+        APSARA_TEST_FALSE(isMatched(processor, "1 [main] timeout", "ERROR\n"));
+    };
+
+    {
+        ProcessorFilterNative processor;
+        processor.SetContext(mContext);
+        processor.CreateMetricsRecordRef(ProcessorFilterNative::sName, "1");
+        APSARA_TEST_TRUE_FATAL(processor.Init(config));
+        processor.CommitMetricsRecordRef();
+        // rules on the same key are matched together
+        const auto& matchers = processor.mFilterRule->Matchers;
+        APSARA_TEST_EQUAL_FATAL(2U, matchers.size());
+        APSARA_TEST_EQUAL("content", matchers[0].Key);
+        APSARA_TEST_EQUAL(vector<size_t>({0, 2}), matchers[0].RuleIndexes);
+        APSARA_TEST_EQUAL(vector<string>({" [", "timeout"}), matchers[0].RequiredLiterals);
+        APSARA_TEST_TRUE(matchers[0].Re2Set != nullptr);
+        APSARA_TEST_EQUAL("level", matchers[1].Key);
+        APSARA_TEST_EQUAL(vector<size_t>({1}), matchers[1].RuleIndexes);
+        APSARA_TEST_TRUE(matchers[1].RequiredLiterals.empty());
+        APSARA_TEST_TRUE(matchers[1].Re2Set != nullptr);
+        checkMatched(processor);
+    }
+    {
+        // \< has a different meaning in re2, so all rules on the key are matched by boost
+        config["FilterRegex"][2] = R"(.*\<timeout.*)";
+        ProcessorFilterNative processor;
+        processor.SetContext(mContext);
+        processor.CreateMetricsRecordRef(ProcessorFilterNative::sName, "1");
+        APSARA_TEST_TRUE_FATAL(processor.Init(config));
+        processor.CommitMetricsRecordRef();
+        const auto& matchers = processor.mFilterRule->Matchers;
+        APSARA_TEST_TRUE(matchers[0].Re2Set == nullptr);
+        APSARA_TEST_TRUE(matchers[1].Re2Set != nullptr);
+        checkMatched(processor);
+        APSARA_TEST_FALSE(isMatched(processor, "1 [main] requesttimeout", "ERROR"));
+    }
+    {
+        BOOL_FLAG(enable_filter_regex_re2) = false;
+        ProcessorFilterNative processor;
+        processor.SetContext(mContext);
+        processor.CreateMetricsRecordRef(ProcessorFilterNative::sName, "1");
+        APSARA_TEST_TRUE_FATAL(processor.Init(config));
+        processor.CommitMetricsRecordRef();
+        BOOL_FLAG(enable_filter_regex_re2) = true;
+        const auto& matchers = processor.mFilterRule->Matchers;
+        APSARA_TEST_TRUE(matchers[0].Re2Set == nullptr);
+        APSARA_TEST_TRUE(matchers[1].Re2Set == nullptr);
+        checkMatched(processor);
+    }
+}
+
+void ProcessorFilterNativeUnittest::TestProcessColumnar() {
+    auto makeGroup = [](PipelineEventGroup& group) {
+        auto addEvent = [&group](const std::vector<std::pair<std::string, std::string>>& contents) {
+            auto* event = group.AddLogEvent();
+            for (const auto& content : contents) {
+                event->SetContent(content.first, content.second);
+            }
+            event->SetTimestamp(12345678901);
+            event->SetPosition(group.GetEvents().size() * 100, 50);
+        };
+        addEvent({{"key1", "value1x"}, {"key2", "value2x"}});
+        addEvent({{"key1", "abc"}, {"key2", "value2x"}});
+        addEvent({{"key2", "value2\xff"}, {"bad\xff" "key", "v\xfe"}, {"key1", "value1"}, {"k\xc3", "x"}});
+        // the fixed key exists already
+        addEvent({{"bad key", "old"}, {"key2", "value2y"}, {"bad\xff" "key", "moved"}, {"key1", "value1"}});
+        addEvent({});
+        addEvent({{"k\xc3", "\xe4\xbd"}, {"key1", "value1"}});
+    };
+
+    std::vector<Json::Value> filters(3);
+    filters[1]["Include"] = Json::Value(Json::objectValue);
+    filters[1]["Include"]["key1"] = ".*value1";
+    filters[1]["Include"]["key2"] = "value2.*";
+    Json::Value exp;
+    exp["operator"] = "or";
+    Json::Value operand1;
+    operand1["key"] = "key1";
+    operand1["exp"] = "abc";
+    operand1["type"] = "regex";
+    Json::Value operand2;
+    operand2["operator"] = "not";
+    Json::Value operand3;
+    operand3["key"] = "key2";
+    operand3["exp"] = "value2x";
+    operand3["type"] = "regex";
+    operand2["operands"].append(operand3);
+    exp["operands"].append(operand1);
+    exp["operands"].append(operand2);
+    filters[2]["ConditionExp"] = exp;
+    for (auto config : filters) {
+        for (bool discardingNonUtf8 : {true, false}) {
+            config["DiscardingNonUTF8"] = discardingNonUtf8;
+            auto rowRes = ColumnarEventsHelper::Process<ProcessorFilterNative>(config, mContext, makeGroup, false);
+            auto columnarRes = ColumnarEventsHelper::Process<ProcessorFilterNative>(config, mContext, makeGroup, true);
+            APSARA_TEST_EQUAL(rowRes.first, columnarRes.first);
+            APSARA_TEST_EQUAL(rowRes.second, columnarRes.second);
+        }
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
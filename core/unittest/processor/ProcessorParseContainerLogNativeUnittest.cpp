@@ -1405,7 +1405,7 @@ void ProcessorParseContainerLogNativeUnittest::TestDockerJsonLogLineParser() {
                     {
                         "contents" :
                         {
-                            "content": "{\"log\":\"Exception in thread  \"main\" java.lang.NullPoinntterException\nn\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"stdout\",\"time1\":\"2024-02-19T03:49:37.793559367Z\"}"
+                            "content": "{\"log\":\"Exception in thread  \\\"main\\\" java.lang.NullPoinntterException\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"stdout\",\"time1\":\"2024-02-19T03:49:37.793559367Z\"}"
                         },
                         "timestamp" : 12345678901,
                         "timestampNanosecond" : 0,
@@ -1450,7 +1450,7 @@ void ProcessorParseContainerLogNativeUnittest::TestDockerJsonLogLineParser() {
                     {
                         "contents" :
                         {
-                            "content": "{\"log\":\"Exception in thread  \"main\" java.lang.NullPoinntterException\nn\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"stdout\",\"time\":\"\"}"
+                            "content": "{\"log\":\"Exception in thread  \\\"main\\\" java.lang.NullPoinntterException\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"stdout\",\"time\":\"\"}"
                         },
                         "timestamp" : 12345678901,
                         "timestampNanosecond" : 0,
@@ -1495,7 +1495,7 @@ void ProcessorParseContainerLogNativeUnittest::TestDockerJsonLogLineParser() {
                     {
                         "contents" :
                         {
-                            "content": "{\"log\":\"Exception in thread  \"main\" java.lang.NullPoinntterException\nn\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"stdout\",\"time\":1}"
+                            "content": "{\"log\":\"Exception in thread  \\\"main\\\" java.lang.NullPoinntterException\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"stdout\",\"time\":1}"
                         },
                         "timestamp" : 12345678901,
                         "timestampNanosecond" : 0,
@@ -1543,7 +1543,7 @@ void ProcessorParseContainerLogNativeUnittest::TestDockerJsonLogLineParser() {
                     {
                         "contents" :
                         {
-                            "content": "{\"log\":\"Exception in thread  \"main\" java.lang.NullPoinntterException\nn\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream1\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793559367Z\"}"
+                            "content": "{\"log\":\"Exception in thread  \\\"main\\\" java.lang.NullPoinntterException\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream1\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793559367Z\"}"
                         },
                         "timestamp" : 12345678901,
                         "timestampNanosecond" : 0,
@@ -1588,7 +1588,7 @@ void ProcessorParseContainerLogNativeUnittest::TestDockerJsonLogLineParser() {
                     {
                         "contents" :
                         {
-                            "content": "{\"log\":\"Exception in thread  \"main\" java.lang.NullPoinntterException\nn\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"std\",\"time\":\"2024-02-19T03:49:37.793559367Z\"}"
+                            "content": "{\"log\":\"Exception in thread  \\\"main\\\" java.lang.NullPoinntterException\\n\",\"stream\":\"stdout\",\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"std\",\"time\":\"2024-02-19T03:49:37.793559367Z\"}"
                         },
                         "timestamp" : 12345678901,
                         "timestampNanosecond" : 0,
@@ -1633,7 +1633,7 @@ void ProcessorParseContainerLogNativeUnittest::TestDockerJsonLogLineParser() {
                     {
                         "contents" :
                         {
-                            "content": "{\"log\":\"Exception in thread  \"main\" java.lang.NullPoinntterException\nn\\n\",\"stream\":1,\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"std\",\"time\":\"2024-02-19T03:49:37.793559367Z\"}"
+                            "content": "{\"log\":\"Exception in thread  \\\"main\\\" java.lang.NullPoinntterException\\n\",\"stream\":1,\"time\":\"2024-02-19T03:49:37.793533014Z\"}\n{\"log\":\"     at com.example.myproject.Book.getTitle\\n\",\"stream\":\"std\",\"time\":\"2024-02-19T03:49:37.793559367Z\"}"
                         },
                         "timestamp" : 12345678901,
                         "timestampNanosecond" : 0,
@@ -2275,6 +2275,47 @@ void ProcessorParseContainerLogNativeUnittest::TestParseDockerLog() {
         APSARA_TEST_FALSE(result);
         delete[] buffer;
     }
+    // Test with escapes of html chars, surrogate pairs and invalid unicode escapes
+    {
+        DockerLog dockerLog;
+        std::string str
+            = R"({"log":"\u003cdiv\u003e \ud83c\udf0d \uzzzz \u12","stream":"stdout","time":"2021-12-01T00:00:00.000Z"})";
+        bool result = ProcessorParseContainerLogNative::ParseDockerLog(&str[0], str.size(), dockerLog);
+
+        APSARA_TEST_TRUE(result);
+        APSARA_TEST_EQUAL("<div> 🌍 \\uzzzz \\u12", dockerLog.log.to_string());
+        APSARA_TEST_EQUAL("stdout", dockerLog.stream);
+    }
+    // Test that the buffer is left unchanged on failure
+    {
+        DockerLog dockerLog;
+        std::string str = R"({"log":"a\n\"b\"","stream":"stdout","time1":"2021-12-01T00:00:00.000Z"})";
+        std::string original = str;
+        bool result = ProcessorParseContainerLogNative::ParseDockerLog(&str[0], str.size(), dockerLog);
+
+        APSARA_TEST_FALSE(result);
+        APSARA_TEST_EQUAL(original, str);
+    }
+    // Test with lines in other shapes, which are parsed as general json
+    {
+        SourceBuffer sourceBuffer;
+        for (const std::string str :
+             {R"({"log":"a\n","stream":"stderr","attrs":{"tag":"x"},"time":"2021-12-01T00:00:00.000Z"})",
+              R"({"log":"a\n",	"stream":"stderr","time":"2021-12-01T00:00:00.000Z"})"}) {
+            DockerLog dockerLog;
+            std::string buffer = str;
+            APSARA_TEST_FALSE(ProcessorParseContainerLogNative::ParseDockerLog(&buffer[0], buffer.size(), dockerLog));
+            APSARA_TEST_TRUE(ProcessorParseContainerLogNative::ParseDockerLogAsJson(str, sourceBuffer, dockerLog));
+            APSARA_TEST_EQUAL("a\n", dockerLog.log.to_string());
+            APSARA_TEST_EQUAL("stderr", dockerLog.stream);
+            APSARA_TEST_EQUAL("2021-12-01T00:00:00.000Z", dockerLog.time);
+        }
+        DockerLog dockerLog;
+        APSARA_TEST_FALSE(ProcessorParseContainerLogNative::ParseDockerLogAsJson(
+            R"({"log":"a","stream":"stdout","time":1})", sourceBuffer, dockerLog));
+        APSARA_TEST_FALSE(ProcessorParseContainerLogNative::ParseDockerLogAsJson(
+            R"({"log":"a","stream":"stdout"})", sourceBuffer, dockerLog));
+    }
 }
 
 } // namespace logtail
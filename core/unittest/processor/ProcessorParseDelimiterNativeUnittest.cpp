@@ -24,6 +24,8 @@
 #include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_BOOL(enable_delimiter_simd_parser);
+
 namespace logtail {
 
 class ProcessorParseDelimiterNativeUnittest : public ::testing::Test {
@@ -47,6 +49,7 @@ public:
     void TestAllowingShortenedFields();
     void TestExtend();
     void TestEmpty();
+    void TestSimdParserConsistentWithFsm();
     CollectionPipelineContext mContext;
 };
 
@@ -64,12 +67,58 @@ UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestProcessEventDiscardUnm
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestAllowingShortenedFields);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestExtend);
 UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestEmpty);
+UNIT_TEST_CASE(ProcessorParseDelimiterNativeUnittest, TestSimdParserConsistentWithFsm);
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
     return pluginMeta;
 }
 
+void ProcessorParseDelimiterNativeUnittest::TestSimdParserConsistentWithFsm() {
+    const std::vector<std::string> lines = {
+        R"(a,"b,c","d""e",,"",f,g)",
+        R"(  2024-07-01,"GET /index.html?a=1,b=2",200,"say ""hi"""  )",
+        R"(a,"b"c,d)",
+        R"(a,"b)",
+        R"(a@@b@@@c@@d@@e)",
+        std::string(70, 'x') + R"(,")" + std::string(70, 'y') + R"(,""",z)",
+    };
+    for (const std::string separator : {",", "@@"}) {
+        for (const std::string treatment : {"extend", "keep", "discard"}) {
+            Json::Value config;
+            config["SourceKey"] = "content";
+            config["Separator"] = separator;
+            config["Keys"] = Json::arrayValue;
+            config["Keys"].append("a");
+            config["Keys"].append("_");
+            config["Keys"].append("c");
+            config["OverflowedFieldsTreatment"] = treatment;
+            config["KeepingSourceWhenParseFail"] = true;
+            config["KeepingSourceWhenParseSucceed"] = false;
+            config["RenamedSourceKey"] = "rawLog";
+            auto process = [&](bool simd) {
+                BOOL_FLAG(enable_delimiter_simd_parser) = simd;
+                auto sourceBuffer = std::make_shared<SourceBuffer>();
+                PipelineEventGroup eventGroup(sourceBuffer);
+                for (const auto& line : lines) {
+                    auto* event = eventGroup.AddLogEvent();
+                    event->SetContent(std::string("content"), line);
+                    event->SetTimestamp(12345678901);
+                }
+                ProcessorParseDelimiterNative& processor = *(new ProcessorParseDelimiterNative);
+                ProcessorInstance processorInstance(&processor, getPluginMeta());
+                APSARA_TEST_TRUE(processorInstance.Init(config, mContext));
+                std::vector<PipelineEventGroup> eventGroupList;
+                eventGroupList.emplace_back(std::move(eventGroup));
+                processorInstance.Process(eventGroupList);
+                BOOL_FLAG(enable_delimiter_simd_parser) = true;
+                return eventGroupList[0].ToJsonString();
+            };
+            APSARA_TEST_EQUAL(process(false), process(true));
+        }
+    }
+}
+
 void ProcessorParseDelimiterNativeUnittest::TestAllowingShortenedFields() {
     // make config
     Json::Value config;
@@ -20,6 +20,9 @@
 #include "plugin/processor/ProcessorParseJsonNative.h"
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 #include "unittest/Unittest.h"
+#include "unittest/processor/ColumnarEventsHelper.h"
+
+DECLARE_FLAG_BOOL(enable_parse_json_on_demand);
 
 namespace logtail {
 
@@ -36,6 +39,8 @@ public:
     void TestProcessJsonContent();
     void TestProcessJsonRaw();
     void TestMultipleLines();
+    void TestOnDemandConsistentWithRapidjson();
+    void TestProcessColumnar();
 
     CollectionPipelineContext mContext;
 };
@@ -58,11 +63,98 @@ UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestProcessJsonRaw);
 
 UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestMultipleLines);
 
+UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestOnDemandConsistentWithRapidjson);
+
+UNIT_TEST_CASE(ProcessorParseJsonNativeUnittest, TestProcessColumnar);
+
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
     return pluginMeta;
 }
 
+void ProcessorParseJsonNativeUnittest::TestOnDemandConsistentWithRapidjson() {
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["KeepingSourceWhenParseFail"] = true;
+    config["KeepingSourceWhenParseSucceed"] = false;
+    config["RenamedSourceKey"] = "rawLog";
+
+    // lines parsed on demand, and those left to rapidjson
+    const std::vector<std::string> lines = {
+        R"({"level":"INFO","code":200,"neg":-1,"ok":true,"none":null,"big":12345678901234})",
+        R"( {"msg" : "a\"b\\c\/d\n\u00e9\ud83d\ude00" , "content":"overwritten"} )",
+        R"({"obj":{"a":[1,"x\"y",{"b":false}],"c":{}},"arr":[]})",
+        R"({"obj":{"a": 1},"d":1.50,"e":1e3,"f":-0,"g":18446744073709551616,"h":["\u0041\/"]})",
+        R"({"lone":"\ud83d"})",
+        R"({"a":"b"} trailing)",
+        R"(["not an object"])",
+        R"({"a":"b",})",
+    };
+    auto process = [&](bool onDemand) {
+        BOOL_FLAG(enable_parse_json_on_demand) = onDemand;
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        for (const auto& line : lines) {
+            auto* event = eventGroup.AddLogEvent();
+            event->SetContent(std::string("content"), line);
+            event->SetTimestamp(12345678901);
+        }
+        ProcessorParseJsonNative& processor = *(new ProcessorParseJsonNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE(processorInstance.Init(config, mContext));
+        std::vector<PipelineEventGroup> eventGroupList;
+        eventGroupList.emplace_back(std::move(eventGroup));
+        processorInstance.Process(eventGroupList);
+        BOOL_FLAG(enable_parse_json_on_demand) = true;
+        return eventGroupList[0].ToJsonString();
+    };
+    APSARA_TEST_EQUAL(process(false), process(true));
+}
+
+void ProcessorParseJsonNativeUnittest::TestProcessColumnar() {
+    auto makeGroup = [](PipelineEventGroup& group) {
+        group.SetMetadata(EventGroupMetaKey::LOG_FILE_OFFSET_KEY, std::string("__file_offset__"));
+        auto addEvent = [&group](const std::vector<std::pair<std::string, std::string>>& contents) {
+            auto* event = group.AddLogEvent();
+            for (const auto& content : contents) {
+                event->SetContent(content.first, content.second);
+            }
+            event->SetTimestamp(12345678901);
+            event->SetPosition(group.GetEvents().size() * 100, 50);
+        };
+        addEvent({{"content", R"({"a":"1","b":"2"})"}});
+        // keys in another order, with the source key overwritten
+        addEvent({{"content", R"({"b":"3","content":"x","a":"4"})"}});
+        // only the file offset is left on failure
+        addEvent({{"__file_offset__", "200"}, {"content", "not json"}});
+        addEvent({{"content", R"(["not an object"])"}, {"other", "y"}});
+        // the renamed source key exists already
+        addEvent({{"rawLog", "old"}, {"content", R"({"c":"5","rawLog":"new"})"}});
+        // no source key
+        addEvent({{"other", "z"}});
+        addEvent({{"a", "old"}, {"content", ""}});
+        addEvent({{"content", R"({"d":{"e":[1,2]},"a":"6","f":null})"}, {"__file_offset__", "700"}});
+    };
+
+    for (bool onDemand : {true, false}) {
+        BOOL_FLAG(enable_parse_json_on_demand) = onDemand;
+        for (int flags = 0; flags < 8; ++flags) {
+            Json::Value config;
+            config["SourceKey"] = "content";
+            config["KeepingSourceWhenParseFail"] = (flags & 1) != 0;
+            config["KeepingSourceWhenParseSucceed"] = (flags & 2) != 0;
+            config["CopingRawLog"] = (flags & 4) != 0;
+            config["RenamedSourceKey"] = "rawLog";
+            auto rowRes = ColumnarEventsHelper::Process<ProcessorParseJsonNative>(config, mContext, makeGroup, false);
+            auto columnarRes
+                = ColumnarEventsHelper::Process<ProcessorParseJsonNative>(config, mContext, makeGroup, true);
+            APSARA_TEST_EQUAL(rowRes.first, columnarRes.first);
+            APSARA_TEST_EQUAL(rowRes.second, columnarRes.second);
+        }
+    }
+    BOOL_FLAG(enable_parse_json_on_demand) = true;
+}
+
 void ProcessorParseJsonNativeUnittest::TestMultipleLines() {
     // error json
     {
@@ -20,6 +20,9 @@
 #include "models/LogEvent.h"
 #include "plugin/processor/ProcessorParseRegexNative.h"
 #include "unittest/Unittest.h"
+#include "unittest/processor/ColumnarEventsHelper.h"
+
+DECLARE_FLAG_BOOL(enable_parse_regex_re2);
 
 namespace logtail {
 
@@ -35,6 +38,8 @@ public:
     void TestProcessEventKeyCountUnmatch();
     void TestProcessRegexRaw();
     void TestProcessRegexContent();
+    void TestRegexEngine();
+    void TestProcessColumnar();
 
 protected:
     void SetUp() override { ctx.SetConfigName("test_config"); }
@@ -43,6 +48,16 @@ private:
     CollectionPipelineContext ctx;
 };
 
+// run the same cases with re2
+class ProcessorParseRegexNativeRe2Unittest : public ProcessorParseRegexNativeUnittest {
+protected:
+    void SetUp() override {
+        ProcessorParseRegexNativeUnittest::SetUp();
+        BOOL_FLAG(enable_parse_regex_re2) = true;
+    }
+    void TearDown() override { BOOL_FLAG(enable_parse_regex_re2) = false; }
+};
+
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
     return pluginMeta;
@@ -652,6 +667,88 @@ void ProcessorParseRegexNativeUnittest::TestProcessEventKeyCountUnmatch() {
     APSARA_TEST_EQUAL_FATAL(0, processor.mOutFailedEventsTotal->GetValue());
 }
 
+void ProcessorParseRegexNativeUnittest::TestRegexEngine() {
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Keys"] = Json::arrayValue;
+    config["Keys"].append("key1");
+    config["Keys"].append("key2");
+    auto isRe2Used = [&](const std::string& regex) {
+        config["Regex"] = regex;
+        ProcessorParseRegexNative& processor = *(new ProcessorParseRegexNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE(processorInstance.Init(config, ctx));
+        return processor.mRe2 != nullptr;
+    };
+
+    APSARA_TEST_FALSE(isRe2Used(R"((\w+)\s(.*))"));
+
+    BOOL_FLAG(enable_parse_regex_re2) = true;
+    APSARA_TEST_TRUE(isRe2Used(R"(^(\w+)\s(.*)$)"));
+    APSARA_TEST_TRUE(isRe2Used(R"(([^]\s]+)[\s,]+\Q^$\E(.*))"));
+    // not supported by re2
+    APSARA_TEST_FALSE(isRe2Used(R"((\w+)\s(?=a)(.*))"));
+    APSARA_TEST_FALSE(isRe2Used(R"((\w+)\s\1(.*))"));
+    // supported by re2 with a different meaning
+    APSARA_TEST_FALSE(isRe2Used(R"((\w+)\v(.*))"));
+    APSARA_TEST_FALSE(isRe2Used(R"((\w+)$\n^(.*))"));
+    APSARA_TEST_FALSE(isRe2Used(R"((\w+)[\S,](.*))"));
+    BOOL_FLAG(enable_parse_regex_re2) = false;
+}
+
+void ProcessorParseRegexNativeUnittest::TestProcessColumnar() {
+    auto makeGroup = [](PipelineEventGroup& group) {
+        group.SetMetadata(EventGroupMetaKey::LOG_FILE_OFFSET_KEY, std::string("__file_offset__"));
+        auto addEvent = [&group](const std::vector<std::pair<std::string, std::string>>& contents) {
+            auto* event = group.AddLogEvent();
+            for (const auto& content : contents) {
+                event->SetContent(content.first, content.second);
+            }
+            event->SetTimestamp(12345678901);
+            event->SetPosition(group.GetEvents().size() * 100, 50);
+        };
+        addEvent({{"content", "value1\tvalue2"}});
+        // only the file offset is left on failure
+        addEvent({{"__file_offset__", "100"}, {"content", "unmatched"}});
+        // the renamed source key exists already
+        addEvent({{"rawLog", "old"}, {"content", "value3\tvalue4"}, {"key1", "old"}});
+        // no source key
+        addEvent({{"other", "x"}});
+        addEvent({{"content", "bad line"}, {"other", "y"}});
+        addEvent({{"key2", "old"}, {"content", "value5\tvalue6"}, {"__file_offset__", "500"}});
+        // only container fields are left on failure
+        addEvent({{"_time_", "2024-01-01"}, {"content", "bad"}, {"_source_", "stdout"}});
+    };
+
+    // the source key is overwritten by the second keys
+    const std::vector<std::vector<std::string>> keysList = {{"key1", "key2"}, {"content", "key2"}};
+    std::vector<Json::Value> configs;
+    for (const auto& regex : {R"((\w+)\t(\w+).*)", "(.*)"}) {
+        for (const auto& keys : keysList) {
+            for (int flags = 0; flags < 8; ++flags) {
+                Json::Value config;
+                config["SourceKey"] = "content";
+                config["Regex"] = regex;
+                config["Keys"] = Json::arrayValue;
+                for (const auto& key : keys) {
+                    config["Keys"].append(key);
+                }
+                config["KeepingSourceWhenParseFail"] = (flags & 1) != 0;
+                config["KeepingSourceWhenParseSucceed"] = (flags & 2) != 0;
+                config["CopingRawLog"] = (flags & 4) != 0;
+                config["RenamedSourceKey"] = "rawLog";
+                configs.push_back(config);
+            }
+        }
+    }
+    for (const auto& config : configs) {
+        auto rowRes = ColumnarEventsHelper::Process<ProcessorParseRegexNative>(config, ctx, makeGroup, false);
+        auto columnarRes = ColumnarEventsHelper::Process<ProcessorParseRegexNative>(config, ctx, makeGroup, true);
+        APSARA_TEST_EQUAL(rowRes.first, columnarRes.first);
+        APSARA_TEST_EQUAL(rowRes.second, columnarRes.second);
+    }
+}
+
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, OnSuccessfulInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessWholeLine)
@@ -662,6 +759,16 @@ UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventDiscardUnmatch
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventKeyCountUnmatch)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexRaw)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexContent)
+UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestRegexEngine)
+UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessColumnar)
+
+UNIT_TEST_CASE(ProcessorParseRegexNativeRe2Unittest, TestProcessRegex)
+UNIT_TEST_CASE(ProcessorParseRegexNativeRe2Unittest, TestProcessEventKeepUnmatch)
+UNIT_TEST_CASE(ProcessorParseRegexNativeRe2Unittest, TestProcessEventDiscardUnmatch)
+UNIT_TEST_CASE(ProcessorParseRegexNativeRe2Unittest, TestProcessEventKeyCountUnmatch)
+UNIT_TEST_CASE(ProcessorParseRegexNativeRe2Unittest, TestProcessRegexRaw)
+UNIT_TEST_CASE(ProcessorParseRegexNativeRe2Unittest, TestProcessRegexContent)
+UNIT_TEST_CASE(ProcessorParseRegexNativeRe2Unittest, TestProcessColumnar)
 
 } // namespace logtail
 
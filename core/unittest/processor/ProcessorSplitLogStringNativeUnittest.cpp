@@ -21,6 +21,7 @@
 #include "constants/TagConstants.h"
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 #include "unittest/Unittest.h"
+#include "unittest/processor/ColumnarEventsHelper.h"
 
 namespace logtail {
 
@@ -32,6 +33,7 @@ public:
     void TestProcessJson();
     void TestProcessCommon();
     void TestEnableRawContent();
+    void TestSplitToColumnar();
 
     CollectionPipelineContext mContext;
 };
@@ -40,6 +42,7 @@ UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestProcessJson)
 UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestProcessCommon)
 UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestEnableRawContent)
+UNIT_TEST_CASE(ProcessorSplitLogStringNativeUnittest, TestSplitToColumnar)
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -308,6 +311,59 @@ void ProcessorSplitLogStringNativeUnittest::TestEnableRawContent() {
     APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
 }
 
+void ProcessorSplitLogStringNativeUnittest::TestSplitToColumnar() {
+    CollectionPipelineContext columnarCtx;
+    columnarCtx.SetConfigName("project##config_0");
+    Json::Value globalConfig, extendedParams;
+    globalConfig["EnableColumnarEvents"] = true;
+    APSARA_TEST_TRUE_FATAL(columnarCtx.InitGlobalConfig(globalConfig, extendedParams));
+
+    auto addEvent = [](PipelineEventGroup& group, const std::vector<std::pair<std::string, std::string>>& contents) {
+        auto* event = group.AddLogEvent();
+        for (const auto& content : contents) {
+            event->SetContent(content.first, content.second);
+        }
+        event->SetTimestamp(12345678901, 100);
+        event->SetPosition(group.GetEvents().size() * 1000, 60);
+    };
+    auto makeGroup = [&](PipelineEventGroup& group) {
+        group.SetMetadata(EventGroupMetaKey::LOG_FILE_OFFSET_KEY, GetDefaultTagKeyString(TagKey::FILE_OFFSET_KEY));
+        addEvent(group, {{DEFAULT_CONTENT_KEY, "line1\nline2\n\nline4"}});
+        addEvent(group, {{DEFAULT_CONTENT_KEY, "line5\n"}});
+        addEvent(group, {{DEFAULT_CONTENT_KEY, "line6"}});
+    };
+    Json::Value config;
+    auto rowRes = ColumnarEventsHelper::Process<ProcessorSplitLogStringNative>(config, mContext, makeGroup, false);
+    auto columnarRes
+        = ColumnarEventsHelper::Process<ProcessorSplitLogStringNative>(config, columnarCtx, makeGroup, false);
+    APSARA_TEST_EQUAL(rowRes.first, columnarRes.first);
+    APSARA_TEST_EQUAL(rowRes.second, columnarRes.second);
+
+    // the group is split into columnar mode
+    {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        makeGroup(group);
+        ProcessorInstance processorInstance(new ProcessorSplitLogStringNative, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, columnarCtx));
+        std::vector<PipelineEventGroup> groups;
+        groups.emplace_back(std::move(group));
+        processorInstance.Process(groups);
+        APSARA_TEST_TRUE(groups[0].IsColumnar());
+        APSARA_TEST_EQUAL(6U, groups[0].GetEventsCount());
+    }
+
+    // groups with malformed events take the ordinary path
+    auto makeMalformedGroup = [&](PipelineEventGroup& group) {
+        addEvent(group, {{DEFAULT_CONTENT_KEY, "line1\nline2"}});
+        addEvent(group, {{DEFAULT_CONTENT_KEY, "line3"}, {"other", "x"}});
+    };
+    rowRes = ColumnarEventsHelper::Process<ProcessorSplitLogStringNative>(config, mContext, makeMalformedGroup, false);
+    columnarRes
+        = ColumnarEventsHelper::Process<ProcessorSplitLogStringNative>(config, columnarCtx, makeMalformedGroup, false);
+    APSARA_TEST_EQUAL(rowRes.first, columnarRes.first);
+    APSARA_TEST_EQUAL(rowRes.second, columnarRes.second);
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
@@ -245,7 +245,7 @@ void ScrapeSchedulerUnittest::TestScheduler() {
     event.SetComponent(&eventPool);
     event.ScheduleNext();
 
-    APSARA_TEST_TRUE(Timer::GetInstance()->mQueue.size() == 1);
+    APSARA_TEST_TRUE(Timer::GetInstance()->mWheel.Size() == 1);
 
     event.Cancel();
 
@@ -309,16 +309,20 @@ void ScrapeSchedulerUnittest::TestQueueIsFull() {
     event.SetFirstExecTime(now, nowScrape);
     event.ScheduleNext();
 
-    APSARA_TEST_TRUE(Timer::GetInstance()->mQueue.size() == 1);
+    APSARA_TEST_TRUE(Timer::GetInstance()->mWheel.Size() == 1);
 
-    const auto& e = Timer::GetInstance()->mQueue.top();
-    APSARA_TEST_EQUAL(now, e->GetExecTime());
-    APSARA_TEST_FALSE(e->IsValid());
-    Timer::GetInstance()->mQueue.pop();
+    auto timer = Timer::GetInstance();
+    vector<unique_ptr<TimerEvent>> events;
+    auto collect = [&events](TimerId, unique_ptr<TimerEvent>&& e) { events.emplace_back(std::move(e)); };
+    timer->mWheel.Advance(timer->ToTick(now, true), collect);
+    APSARA_TEST_EQUAL(1UL, events.size());
+    APSARA_TEST_EQUAL(now, events[0]->GetExecTime());
+    APSARA_TEST_FALSE(events[0]->IsValid());
     // queue is full, so it should schedule next after 1 second
-    APSARA_TEST_EQUAL(1UL, Timer::GetInstance()->mQueue.size());
-    const auto& next = Timer::GetInstance()->mQueue.top();
-    APSARA_TEST_EQUAL(now + std::chrono::seconds(1), next->GetExecTime());
+    APSARA_TEST_EQUAL(1UL, timer->mWheel.Size());
+    timer->mWheel.Advance(timer->ToTick(now + std::chrono::seconds(1), true), collect);
+    APSARA_TEST_EQUAL(2UL, events.size());
+    APSARA_TEST_EQUAL(now + std::chrono::seconds(1), events[1]->GetExecTime());
 }
 
 void ScrapeSchedulerUnittest::TestExactlyScrape() {
@@ -0,0 +1,121 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <thread>
+
+#include "collection_pipeline/queue/ProcessQueueManager.h"
+#include "collection_pipeline/queue/QueueKeyManager.h"
+#include "common/TimeUtil.h"
+#include "models/PipelineEventGroup.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const size_t kQueueCnt = 300;
+static const size_t kItemCnt = 300000;
+
+class ProcessQueueManagerBenchmark {
+public:
+    // all items are pushed to hotQueueCnt queues, the rest of the queues stay empty
+    void Test(const char* mode, uint32_t threadCnt, size_t hotQueueCnt);
+
+private:
+    std::vector<QueueKey> CreateQueues();
+    void DeleteQueues(const std::vector<QueueKey>& keys);
+};
+
+std::vector<QueueKey> ProcessQueueManagerBenchmark::CreateQueues() {
+    std::vector<QueueKey> keys;
+    for (size_t i = 0; i < kQueueCnt; ++i) {
+        std::string configName = "config_" + std::to_string(i);
+        CollectionPipelineContext ctx;
+        ctx.SetConfigName(configName);
+        QueueKey key = QueueKeyManager::GetInstance()->GetKey(configName);
+        ProcessQueueManager::GetInstance()->CreateOrUpdateCircularQueue(key, 0, kItemCnt, ctx);
+        ProcessQueueManager::GetInstance()->EnablePop(configName);
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+void ProcessQueueManagerBenchmark::DeleteQueues(const std::vector<QueueKey>& keys) {
+    for (auto key : keys) {
+        ProcessQueueManager::GetInstance()->DeleteQueue(key);
+    }
+}
+
+void ProcessQueueManagerBenchmark::Test(const char* mode, uint32_t threadCnt, size_t hotQueueCnt) {
+    auto keys = CreateQueues();
+    for (size_t i = 0; i < kItemCnt; ++i) {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        ProcessQueueManager::GetInstance()->PushQueue(keys[i % hotQueueCnt],
+                                                      std::make_unique<ProcessQueueItem>(std::move(group), 0));
+    }
+
+    std::atomic_size_t popped = 0;
+    std::vector<std::thread> threads;
+    uint64_t starttime = GetCurrentTimeInMilliSeconds();
+    for (uint32_t threadNo = 0; threadNo < threadCnt; ++threadNo) {
+        threads.emplace_back([threadNo, &popped]() {
+            std::unique_ptr<ProcessQueueItem> item;
+            std::string configName;
+            while (popped < kItemCnt) {
+                if (ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
+                    ++popped;
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    uint64_t timeElapsed = GetCurrentTimeInMilliSeconds() - starttime;
+    printf("%s with %u threads and %zu hot queues costs %lums, %.0f groups/s\n",
+           mode,
+           threadCnt,
+           hotQueueCnt,
+           timeElapsed,
+           timeElapsed == 0 ? 0.0 : kItemCnt * 1000.0 / timeElapsed);
+    DeleteQueues(keys);
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::ProcessQueueManagerBenchmark benchmark;
+    const uint32_t threadCnts[] = {1, 2, 4, 8, 16};
+    for (size_t hotQueueCnt : {logtail::kQueueCnt, size_t(1)}) {
+        for (uint32_t threadCnt : threadCnts) {
+            benchmark.Test("GlobalScan", threadCnt, hotQueueCnt);
+        }
+    }
+    // work stealing can not be turned off once enabled, so it is measured last
+    for (size_t hotQueueCnt : {logtail::kQueueCnt, size_t(1)}) {
+        for (uint32_t threadCnt : threadCnts) {
+            logtail::ProcessQueueManager::GetInstance()->EnableWorkStealing(threadCnt);
+            benchmark.Test("WorkStealing", threadCnt, hotQueueCnt);
+        }
+    }
+    return 0;
+}
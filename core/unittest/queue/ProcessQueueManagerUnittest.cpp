@@ -12,7 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <future>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
@@ -34,7 +38,9 @@ public:
     void TestSetQueueUpstreamAndDownStream();
     void TestPushQueue();
     void TestPopItem();
+    void TestPopItemByWorkStealing();
     void TestIsAllQueueEmpty();
+    void TestTrigger();
     void OnPipelineUpdate();
 
 protected:
@@ -43,6 +49,8 @@ protected:
     void TearDown() override {
         QueueKeyManager::GetInstance()->Clear();
         sProcessQueueManager->Clear();
+        sProcessQueueManager->mWorkStealing = false;
+        sProcessQueueManager->mThreadQueueKeys.clear();
         ExactlyOnceQueueManager::GetInstance()->Clear();
     }
 
@@ -323,6 +331,70 @@ void ProcessQueueManagerUnittest::TestPopItem() {
     APSARA_TEST_TRUE(sProcessQueueManager->mCurrentQueueIndex.second == sProcessQueueManager->mQueues[key1].first);
 }
 
+void ProcessQueueManagerUnittest::TestPopItemByWorkStealing() {
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    CollectionPipelineContext ctx;
+
+    ctx.SetConfigName("test_config_1");
+    QueueKey key1 = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key1, 1, ctx);
+    sProcessQueueManager->EnablePop("test_config_1");
+    ctx.SetConfigName("test_config_2");
+    QueueKey key2 = QueueKeyManager::GetInstance()->GetKey("test_config_2");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key2, 0, ctx);
+    sProcessQueueManager->EnablePop("test_config_2");
+
+    // items pushed before work stealing is enabled are scheduled as well
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    sProcessQueueManager->EnableWorkStealing(2);
+    APSARA_TEST_TRUE((*sProcessQueueManager->mQueues[key1].first)->IsScheduled());
+    APSARA_TEST_FALSE((*sProcessQueueManager->mQueues[key2].first)->IsScheduled());
+
+    // queues with higher priority are popped first
+    sProcessQueueManager->PushQueue(key2, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL("test_config_2", configName);
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_FALSE((*sProcessQueueManager->mQueues[key1].first)->IsScheduled());
+    APSARA_TEST_FALSE((*sProcessQueueManager->mQueues[key2].first)->IsScheduled());
+
+    // keys scheduled on other threads are stolen
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem((key1 + 1) % 2, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(key1 % 2, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(key1 % 2, item, configName));
+
+    // queues disabled to pop are scheduled again when enabled
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    sProcessQueueManager->DisablePop("test_config_1", false);
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_FALSE((*sProcessQueueManager->mQueues[key1].first)->IsScheduled());
+    sProcessQueueManager->EnablePop("test_config_1");
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+
+    // queues invalid to pop are scheduled again on feedback
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    (*sProcessQueueManager->mQueues[key1].first)->DisablePop();
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
+    (*sProcessQueueManager->mQueues[key1].first)->EnablePop();
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
+    sProcessQueueManager->Feedback(0);
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+
+    // deleted queues are skipped
+    sProcessQueueManager->PushQueue(key1, GenerateItem());
+    sProcessQueueManager->DeleteQueue(key1);
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName));
+}
+
 void ProcessQueueManagerUnittest::TestIsAllQueueEmpty() {
     CollectionPipelineContext ctx;
     ctx.SetConfigName("test_config_1");
@@ -363,6 +435,56 @@ void ProcessQueueManagerUnittest::TestIsAllQueueEmpty() {
     APSARA_TEST_TRUE(sProcessQueueManager->IsAllQueueEmpty());
 }
 
+void ProcessQueueManagerUnittest::TestTrigger() {
+    sProcessQueueManager->mValidToPop = false;
+    vector<future<bool>> results;
+    for (size_t i = 0; i < 3; ++i) {
+        results.emplace_back(async(launch::async, [] { return sProcessQueueManager->Wait(10000); }));
+    }
+    while (sProcessQueueManager->mWaitingThreadCnt.load() != 3) {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+    // a burst of pushes wakes up all idle threads
+    auto start = chrono::steady_clock::now();
+    for (size_t i = 0; i < 3; ++i) {
+        sProcessQueueManager->Trigger();
+    }
+    for (auto& res : results) {
+        APSARA_TEST_TRUE(res.get());
+    }
+    APSARA_TEST_TRUE(chrono::steady_clock::now() - start < chrono::seconds(5));
+    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mWaitingThreadCnt.load());
+
+    // a push during the scan of queues is not lost
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config_1");
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key, 0, ctx);
+    sProcessQueueManager->EnablePop("test_config_1");
+    const size_t itemCnt = 1000;
+    auto popper = async(launch::async, [itemCnt] {
+        unique_ptr<ProcessQueueItem> item;
+        string configName;
+        size_t poppedCnt = 0;
+        while (poppedCnt < itemCnt) {
+            if (sProcessQueueManager->PopItem(0, item, configName)) {
+                ++poppedCnt;
+            } else {
+                sProcessQueueManager->Wait(10000);
+            }
+        }
+    });
+    start = chrono::steady_clock::now();
+    for (size_t i = 0; i < itemCnt; ++i) {
+        while (sProcessQueueManager->PushQueue(key, GenerateItem()) != QueueStatus::OK) {
+            this_thread::yield();
+        }
+    }
+    popper.get();
+    APSARA_TEST_TRUE(chrono::steady_clock::now() - start < chrono::seconds(5));
+    sProcessQueueManager->mValidToPop = false;
+}
+
 void ProcessQueueManagerUnittest::OnPipelineUpdate() {
     CollectionPipelineContext ctx1, ctx2;
     ctx1.SetConfigName("test_config_1");
@@ -457,7 +579,9 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestSetQueueUpstreamAndDownStream)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItemByWorkStealing)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestTrigger)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
 
 } // namespace logtail
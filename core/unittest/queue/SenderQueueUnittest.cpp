@@ -12,10 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <filesystem>
+
+#include "collection_pipeline/queue/ExtraBufferSpillStore.h"
 #include "collection_pipeline/queue/SenderQueue.h"
+#include "common/Flags.h"
+#include "common/memory/PayloadBuffer.h"
 #include "unittest/Unittest.h"
 #include "unittest/queue/FeedbackInterfaceMock.h"
 
+DECLARE_FLAG_INT32(sender_queue_extra_buffer_memory_limit_mb);
+DECLARE_FLAG_INT32(sender_queue_extra_buffer_total_memory_limit_mb);
+
 using namespace std;
 
 namespace logtail {
@@ -26,6 +34,9 @@ public:
     void TestRemove();
     void TestGetAvailableItems();
     void TestMetric();
+#ifdef __linux__
+    void TestExtraBufferSpill();
+#endif
 
 protected:
     static void SetUpTestCase() {
@@ -222,6 +233,83 @@ void SenderQueueUnittest::TestMetric() {
     APSARA_TEST_EQUAL(1U, mQueue->mValidToPushFlag->GetValue());
 }
 
+#ifdef __linux__
+void SenderQueueUnittest::TestExtraBufferSpill() {
+    auto spillStore = ExtraBufferSpillStore::GetInstance();
+    INT32_FLAG(sender_queue_extra_buffer_memory_limit_mb) = 0;
+    const size_t size = string("content0").size();
+    vector<SenderQueueItem*> items;
+    for (size_t i = 0; i < sCap + 3; ++i) {
+        auto item = make_unique<SenderQueueItem>("content" + to_string(i), sDataSize, nullptr, sKey);
+        items.emplace_back(item.get());
+        APSARA_TEST_TRUE(mQueue->Push(std::move(item)));
+    }
+    APSARA_TEST_EQUAL(3U, mQueue->mExtraBuffer.size());
+    APSARA_TEST_EQUAL(3U, mQueue->mSpilledPayloads.size());
+    for (const auto& item : mQueue->mExtraBuffer) {
+        APSARA_TEST_EQUAL(0U, item->mData.size());
+    }
+    APSARA_TEST_EQUAL(3 * size, mQueue->mExtraBufferDataSizeBytes->GetValue());
+    APSARA_TEST_EQUAL(3 * size, mQueue->mExtraBufferSpilledDataSizeBytes->GetValue());
+    APSARA_TEST_EQUAL(0U, mQueue->mExtraBufferMemoryBytes);
+    APSARA_TEST_EQUAL(1U, spillStore->mSegments.size());
+
+    // spilled data is loaded back in order
+    for (size_t i = 0; i < 3; ++i) {
+        APSARA_TEST_TRUE(mQueue->Remove(items[i]));
+        vector<SenderQueueItem*> res;
+        mQueue->GetAvailableItems(res, -1);
+        APSARA_TEST_EQUAL(2U, res.size());
+        APSARA_TEST_EQUAL("content" + to_string(i + 2), string(res.back()->mData.data(), res.back()->mData.size()));
+        for (auto item : res) {
+            item->mStatus = SendingStatus::IDLE;
+        }
+    }
+    APSARA_TEST_TRUE(mQueue->mExtraBuffer.empty());
+    APSARA_TEST_TRUE(mQueue->mSpilledPayloads.empty());
+    APSARA_TEST_EQUAL(0U, mQueue->mExtraBufferSpilledDataSizeBytes->GetValue());
+    // the segment being written is kept for later spills
+    APSARA_TEST_EQUAL(1U, spillStore->mSegments.size());
+    APSARA_TEST_EQUAL(0U, spillStore->mSegments.begin()->second.mPendingCnt);
+
+    // total memory limit
+    INT32_FLAG(sender_queue_extra_buffer_memory_limit_mb) = 64;
+    INT32_FLAG(sender_queue_extra_buffer_total_memory_limit_mb) = 0;
+    mQueue->Push(GenerateItem());
+    mQueue->Push(GenerateItem());
+    APSARA_TEST_EQUAL(2U, mQueue->mExtraBuffer.size());
+    APSARA_TEST_EQUAL(2U, mQueue->mSpilledPayloads.size());
+    INT32_FLAG(sender_queue_extra_buffer_total_memory_limit_mb) = 256;
+    mQueue->Push(GenerateItem());
+    APSARA_TEST_EQUAL(3U, mQueue->mExtraBuffer.size());
+    APSARA_TEST_EQUAL(2U, mQueue->mSpilledPayloads.size());
+    // memory is charged by the capacity of the payload rather than its size
+    APSARA_TEST_EQUAL(mQueue->mExtraBuffer.back()->mData.capacity(), mQueue->mExtraBufferMemoryBytes);
+    APSARA_TEST_TRUE(mQueue->mExtraBufferMemoryBytes >= string("content").size());
+
+    // small data held by a large pooled block is charged by the block
+    INT32_FLAG(sender_queue_extra_buffer_memory_limit_mb) = 1;
+    string data = PayloadBufferPool::GetInstance()->Acquire(2 * 1024 * 1024);
+    data.assign("content");
+    mQueue->Push(make_unique<SenderQueueItem>(std::move(data), sDataSize, nullptr, sKey));
+    APSARA_TEST_EQUAL(4U, mQueue->mExtraBuffer.size());
+    APSARA_TEST_EQUAL(3U, mQueue->mSpilledPayloads.size());
+
+    // spilled data is released along with the queue
+    mQueue.reset();
+    APSARA_TEST_EQUAL(1U, spillStore->mSegments.size());
+    APSARA_TEST_EQUAL(0U, spillStore->mSegments.begin()->second.mPendingCnt);
+
+    // spilled data is removed on stop
+    spillStore->Stop();
+    APSARA_TEST_TRUE(spillStore->mSegments.empty());
+    APSARA_TEST_FALSE(filesystem::exists(spillStore->mDir));
+    SpilledPayload spilled;
+    APSARA_TEST_FALSE(spillStore->Spill(PayloadBuffer("content"), spilled));
+    spillStore->mIsStopped = false;
+}
+#endif
+
 unique_ptr<SenderQueueItem> SenderQueueUnittest::GenerateItem() {
     return make_unique<SenderQueueItem>("content", sDataSize, nullptr, sKey);
 }
@@ -230,6 +318,9 @@ UNIT_TEST_CASE(SenderQueueUnittest, TestPush)
 UNIT_TEST_CASE(SenderQueueUnittest, TestRemove)
 UNIT_TEST_CASE(SenderQueueUnittest, TestGetAvailableItems)
 UNIT_TEST_CASE(SenderQueueUnittest, TestMetric)
+#ifdef __linux__
+UNIT_TEST_CASE(SenderQueueUnittest, TestExtraBufferSpill)
+#endif
 
 } // namespace logtail
 
@@ -0,0 +1,135 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "file_server/reader/BatchFileReader.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const int kRounds = 100;
+static const std::string kLine = std::string(255, 'x') + "\n";
+
+// Append a line to each of fileCnt files on tmpfs and read the new data of all files in one batch, which is what
+// LogInput does for modify events when the files keep growing, and report the time spent on reading.
+static void Test(const std::string& dir, int fileCnt, bool enableIoUring) {
+    rlimit limit{};
+    getrlimit(RLIMIT_NOFILE, &limit);
+    // each file is opened for both writing and reading
+    rlim_t required = static_cast<rlim_t>(fileCnt) * 2 + 256;
+    if (limit.rlim_cur < required) {
+        limit.rlim_cur = std::min(required, limit.rlim_max);
+        setrlimit(RLIMIT_NOFILE, &limit);
+        if (limit.rlim_cur < required) {
+            printf("%d files: skipped, open files limit %lu is less than %lu\n",
+                   fileCnt,
+                   static_cast<unsigned long>(limit.rlim_cur),
+                   static_cast<unsigned long>(required));
+            return;
+        }
+    }
+
+    BatchFileReader reader;
+    bool useIoUring = reader.Init(enableIoUring, 256);
+    if (enableIoUring && !useIoUring) {
+        printf("%d files: io_uring is not supported, skipped\n", fileCnt);
+        return;
+    }
+
+    std::vector<int> writeFds, readFds;
+    for (int i = 0; i < fileCnt; ++i) {
+        std::string path = dir + "/" + std::to_string(i) + ".log";
+        writeFds.push_back(open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644));
+        readFds.push_back(open(path.c_str(), O_RDONLY));
+        if (writeFds.back() < 0 || readFds.back() < 0) {
+            printf("%d files: failed to open file %s, skipped\n", fileCnt, path.c_str());
+            return;
+        }
+    }
+
+    std::vector<std::string> buffers(fileCnt, std::string(4096, '\0'));
+    std::vector<FileReadRequest> requests(fileCnt);
+    std::vector<int64_t> offsets(fileCnt, 0);
+    size_t readBytes = 0;
+    std::chrono::nanoseconds cost(0);
+    for (int round = 0; round < kRounds; ++round) {
+        for (int i = 0; i < fileCnt; ++i) {
+            if (write(writeFds[i], kLine.data(), kLine.size()) < 0) {
+                printf("failed to write file\n");
+                return;
+            }
+        }
+        for (int i = 0; i < fileCnt; ++i) {
+            requests[i].fd = readFds[i];
+            requests[i].buf = &buffers[i][0];
+            requests[i].size = buffers[i].size();
+            requests[i].offset = offsets[i];
+        }
+        auto start = std::chrono::steady_clock::now();
+        reader.Read(requests);
+        cost += std::chrono::steady_clock::now() - start;
+        for (int i = 0; i < fileCnt; ++i) {
+            if (requests[i].result > 0) {
+                offsets[i] += requests[i].result;
+                readBytes += requests[i].result;
+            }
+        }
+    }
+    double seconds = std::chrono::duration<double>(cost).count();
+    printf("%d files, %s: %.2fms per batch, %.0f reads/s, %.1fMB/s\n",
+           fileCnt,
+           useIoUring ? "io_uring" : "pread",
+           seconds * 1000 / kRounds,
+           fileCnt * kRounds / seconds,
+           readBytes / seconds / 1024 / 1024);
+
+    for (int i = 0; i < fileCnt; ++i) {
+        close(writeFds[i]);
+        close(readFds[i]);
+        unlink((dir + "/" + std::to_string(i) + ".log").c_str());
+    }
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    // tmpfs keeps the benchmark away from the disk, so that the cost of system calls is measured
+    std::string dir = (argc > 1 ? argv[1] : "/dev/shm") + std::string("/batch_file_reader_benchmark");
+    mkdir(dir.c_str(), 0755);
+    for (int fileCnt : {1000, 4000}) {
+        logtail::Test(dir, fileCnt, false);
+        logtail::Test(dir, fileCnt, true);
+    }
+    rmdir(dir.c_str());
+    return 0;
+}
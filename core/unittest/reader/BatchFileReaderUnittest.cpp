@@ -0,0 +1,141 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "common/FileSystemUtil.h"
+#include "common/RuntimeUtil.h"
+#include "file_server/reader/BatchFileReader.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class BatchFileReaderUnittest : public ::testing::Test {
+public:
+    void TestReadWithPread();
+    void TestReadWithIoUring();
+    void TestFallbackAfterIoUringFailure();
+
+protected:
+    static void SetUpTestCase() {
+        sRootDir = GetProcessExecutionDir();
+        if (PATH_SEPARATOR[0] == sRootDir.back()) {
+            sRootDir.resize(sRootDir.size() - 1);
+        }
+        sRootDir += PATH_SEPARATOR + "testDataSet" + PATH_SEPARATOR + "BatchFileReaderUnittest";
+    }
+
+    void SetUp() override {
+        bfs::remove_all(sRootDir);
+        bfs::create_directories(sRootDir);
+        for (size_t i = 0; i < kFileCnt; ++i) {
+            string path = sRootDir + PATH_SEPARATOR + to_string(i) + ".log";
+            ofstream(path, ios::binary) << string(i * 10, 'a' + i % 26);
+            mFds.push_back(open(path.c_str(), O_RDONLY));
+        }
+    }
+
+    void TearDown() override {
+        for (int fd : mFds) {
+            close(fd);
+        }
+        mFds.clear();
+        bfs::remove_all(sRootDir);
+    }
+
+private:
+    void TestRead(BatchFileReader& reader);
+
+    // more than the queue depth given to Init, so that the batch is submitted in several rounds
+    static const size_t kFileCnt = 100;
+    static string sRootDir;
+
+    vector<int> mFds;
+};
+
+string BatchFileReaderUnittest::sRootDir;
+
+void BatchFileReaderUnittest::TestReadWithPread() {
+    BatchFileReader reader;
+    APSARA_TEST_FALSE(reader.Init(false, 16));
+    APSARA_TEST_FALSE(reader.IsIoUringEnabled());
+    TestRead(reader);
+}
+
+void BatchFileReaderUnittest::TestReadWithIoUring() {
+    BatchFileReader reader;
+    // io_uring may not be supported by the kernel, in which case pread is used
+    bool enabled = reader.Init(true, 16);
+    APSARA_TEST_EQUAL(enabled, reader.IsIoUringEnabled());
+    TestRead(reader);
+}
+
+void BatchFileReaderUnittest::TestFallbackAfterIoUringFailure() {
+    BatchFileReader reader;
+    if (!reader.Init(true, 16)) {
+        return;
+    }
+    // reads submitted before the failure are waited for, and the rest are read with pread
+    reader.mFailAfterSubmission = true;
+    TestRead(reader);
+    APSARA_TEST_FALSE(reader.mFailAfterSubmission);
+    APSARA_TEST_FALSE(reader.IsIoUringEnabled());
+}
+
+void BatchFileReaderUnittest::TestRead(BatchFileReader& reader) {
+    vector<string> buffers(kFileCnt + 1, string(1024, '\0'));
+    vector<FileReadRequest> requests(kFileCnt + 1);
+    for (size_t i = 0; i < kFileCnt; ++i) {
+        requests[i].fd = mFds[i];
+        requests[i].buf = &buffers[i][0];
+        requests[i].size = buffers[i].size();
+        // read from the middle of the file
+        requests[i].offset = i * 5;
+    }
+    requests[kFileCnt].fd = -1;
+    requests[kFileCnt].buf = &buffers[kFileCnt][0];
+    requests[kFileCnt].size = buffers[kFileCnt].size();
+
+    reader.Read(requests);
+    for (size_t i = 0; i < kFileCnt; ++i) {
+        APSARA_TEST_EQUAL(static_cast<int64_t>(i * 5), requests[i].result);
+        APSARA_TEST_EQUAL(string(i * 5, 'a' + i % 26), buffers[i].substr(0, requests[i].result));
+    }
+    APSARA_TEST_EQUAL(-EBADF, requests[kFileCnt].result);
+
+    // read again at the end of the files
+    for (size_t i = 0; i < kFileCnt; ++i) {
+        requests[i].offset = i * 10;
+    }
+    requests.pop_back();
+    reader.Read(requests);
+    for (size_t i = 0; i < kFileCnt; ++i) {
+        APSARA_TEST_EQUAL(0, requests[i].result);
+    }
+}
+
+UNIT_TEST_CASE(BatchFileReaderUnittest, TestReadWithPread)
+UNIT_TEST_CASE(BatchFileReaderUnittest, TestReadWithIoUring)
+UNIT_TEST_CASE(BatchFileReaderUnittest, TestFallbackAfterIoUringFailure)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,133 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "file_server/reader/FileReadCache.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileReadCacheUnittest : public ::testing::Test {
+public:
+    void TestKeepInSegment();
+    void TestPrepareBufferInNewSegment();
+    void TestAssign();
+    void TestShrinkToFit();
+
+protected:
+    void SetUp() override {
+        mCopiedBytes = make_shared<Counter>("cache_copied_bytes");
+        mCache.SetCopiedBytesCounter(mCopiedBytes);
+    }
+
+private:
+    // simulate a read of data which leaves the last partialSize bytes in the cache
+    char* Read(size_t bufferSize, const string& data, size_t partialSize) {
+        char* buffer = mCache.PrepareBuffer(bufferSize);
+        size_t cacheSize = mCache.Size();
+        memcpy(buffer + cacheSize, data.data(), data.size());
+        size_t total = cacheSize + data.size();
+        mCache.Keep(buffer + total - partialSize, partialSize);
+        return buffer;
+    }
+
+    FileReadCache mCache;
+    CounterPtr mCopiedBytes;
+};
+
+void FileReadCacheUnittest::TestKeepInSegment() {
+    char* buffer = Read(100, "line1\nli", 2);
+    APSARA_TEST_EQUAL("li", mCache.ToString());
+    APSARA_TEST_EQUAL(buffer + 6, mCache.Data());
+    auto segment = mCache.GetSegment();
+
+    // the cached data is followed by the next read in the same segment if there is room for it
+    buffer = Read(90, "ne2\nline3", 5);
+    APSARA_TEST_EQUAL(string("line2\nline3"), string(buffer, 11));
+    APSARA_TEST_EQUAL("line3", mCache.ToString());
+    APSARA_TEST_EQUAL(segment, mCache.GetSegment());
+    APSARA_TEST_EQUAL(0U, mCopiedBytes->GetValue());
+
+    // the segment is released once nothing is cached
+    Read(50, "\n", 0);
+    APSARA_TEST_TRUE(mCache.Empty());
+    APSARA_TEST_TRUE(mCache.GetSegment() == nullptr);
+}
+
+void FileReadCacheUnittest::TestPrepareBufferInNewSegment() {
+    char* oldBuffer = Read(10, "line1\nli", 2);
+    auto segment = mCache.GetSegment();
+    // no room for the next read in the segment
+    char* buffer = mCache.PrepareBuffer(100);
+    APSARA_TEST_NOT_EQUAL(segment, mCache.GetSegment());
+    APSARA_TEST_EQUAL(string("li"), string(buffer, 2));
+    APSARA_TEST_EQUAL(2U, mCopiedBytes->GetValue());
+    // the old segment is still valid for those holding it
+    APSARA_TEST_EQUAL(string("line1\nli"), string(oldBuffer, 8));
+
+    // the new segment leaves room for more reads
+    segment = mCache.GetSegment();
+    Read(100, "ne2\nline3", 5);
+    Read(100, "\nline4", 4);
+    APSARA_TEST_EQUAL("ine4", mCache.ToString());
+    APSARA_TEST_EQUAL(segment, mCache.GetSegment());
+    APSARA_TEST_EQUAL(2U, mCopiedBytes->GetValue());
+}
+
+void FileReadCacheUnittest::TestAssign() {
+    const string data = "partial";
+    mCache.Assign(data.data(), data.size());
+    APSARA_TEST_EQUAL(data, mCache.ToString());
+    APSARA_TEST_EQUAL(7U, mCopiedBytes->GetValue());
+
+    // assign from the cache itself
+    auto segment = mCache.GetSegment();
+    mCache.Assign(mCache.Data() + 1, 3);
+    APSARA_TEST_EQUAL("art", mCache.ToString());
+    APSARA_TEST_NOT_EQUAL(segment, mCache.GetSegment());
+
+    // data outside the segment is copied
+    mCache.Keep(data.data(), 4);
+    APSARA_TEST_EQUAL("part", mCache.ToString());
+    APSARA_TEST_EQUAL(14U, mCopiedBytes->GetValue());
+
+    mCache.Clear();
+    APSARA_TEST_TRUE(mCache.Empty());
+    APSARA_TEST_TRUE(mCache.GetSegment() == nullptr);
+}
+
+void FileReadCacheUnittest::TestShrinkToFit() {
+    Read(1000, "line1\nli", 2);
+    mCache.ShrinkToFit();
+    APSARA_TEST_EQUAL("li", mCache.ToString());
+    APSARA_TEST_EQUAL(3U, mCache.mCapacity);
+    APSARA_TEST_EQUAL(2U, mCopiedBytes->GetValue());
+    // nothing to do if the segment already fits
+    mCache.ShrinkToFit();
+    APSARA_TEST_EQUAL(2U, mCopiedBytes->GetValue());
+}
+
+UNIT_TEST_CASE(FileReadCacheUnittest, TestKeepInSegment)
+UNIT_TEST_CASE(FileReadCacheUnittest, TestPrepareBufferInNewSegment)
+UNIT_TEST_CASE(FileReadCacheUnittest, TestAssign)
+UNIT_TEST_CASE(FileReadCacheUnittest, TestShrinkToFit)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
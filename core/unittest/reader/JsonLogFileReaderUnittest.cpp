@@ -253,14 +253,14 @@ void JsonLogFileReaderUnittest::TestReadUTF8() {
         std::string expectedPart(expectedContent.get());
         expectedPart.resize(expectedPart.rfind(R"({"second")") - 1); // exclude tailing \n
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         // second read
         reader.ReadUTF8(logBuffer, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
         expectedPart = expectedContent.get();
         expectedPart = expectedPart.substr(expectedPart.rfind(R"({"second")"));
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.size());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.Size());
     }
 }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cstdio>
+#include <cstring>
 
 #include <fstream>
 
@@ -216,12 +217,12 @@ void LogFileReaderUnittest::TestReadGBK() {
         std::string expectedPart(expectedContent.get());
         expectedPart.resize(expectedPart.rfind("iLogtail") - 1);
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         auto lastFilePos = reader.mLastFilePos;
         // second read, end of second part cannot be determined, nothing read
         reader.ReadGBK(logBuffer, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         APSARA_TEST_EQUAL_FATAL(lastFilePos, reader.mLastFilePos);
     }
     { // read twice, single line
@@ -249,14 +250,14 @@ void LogFileReaderUnittest::TestReadGBK() {
         std::string expectedPart(expectedContent.get());
         expectedPart.resize(expectedPart.rfind("iLogtail") - 1); // -1 for \n
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         // second read, second part should be read
         reader.ReadGBK(logBuffer, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
         expectedPart = expectedContent.get();
         expectedPart = expectedPart.substr(expectedPart.rfind("iLogtail"));
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.size());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.Size());
     }
     { // empty file
         MultilineOptions multilineOpts;
@@ -310,13 +311,13 @@ void LogFileReaderUnittest::TestReadGBK() {
         APSARA_TEST_FALSE_FATAL(reader.mLastForceRead);
         reader.ReadGBK(logBuffer, 127, moreData, false); // force read, clear cache
         APSARA_TEST_TRUE_FATAL(reader.mLastForceRead);
-        APSARA_TEST_EQUAL_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_EQUAL_FATAL(reader.mCache.Size(), 0UL);
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
 
         // second read, start with \n but with other lines
         reader.ReadGBK(logBuffer, fileSize - 1, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         std::string expectedPart2(expectedContent.get() + firstReadSize + 1); // skip \n
         int64_t secondReadSize = expectedPart2.rfind("iLogtail") - 1;
         expectedPart2.resize(secondReadSize);
@@ -333,7 +334,7 @@ void LogFileReaderUnittest::TestReadGBK() {
         LogBuffer logBuffer2;
         reader.ReadGBK(logBuffer2, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
         APSARA_TEST_STREQ_FATAL(NULL, logBuffer2.rawBuffer.data());
     }
@@ -460,12 +461,12 @@ void LogFileReaderUnittest::TestReadUTF8() {
         std::string expectedPart(expectedContent.get());
         expectedPart.resize(expectedPart.rfind("iLogtail") - 1); // -1 for \n
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         auto lastFilePos = reader.mLastFilePos;
         // second read, end of second part cannot be determined, nothing read
         reader.ReadUTF8(logBuffer, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         APSARA_TEST_EQUAL_FATAL(lastFilePos, reader.mLastFilePos);
     }
     { // read twice, singleline
@@ -491,14 +492,14 @@ void LogFileReaderUnittest::TestReadUTF8() {
         std::string expectedPart(expectedContent.get());
         expectedPart.resize(expectedPart.rfind("iLogtail") - 1);
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         // second read, second part should be read
         reader.ReadUTF8(logBuffer, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
         expectedPart = expectedContent.get();
         expectedPart = expectedPart.substr(expectedPart.rfind("iLogtail"));
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
-        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.size());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader.mCache.Size());
     }
     { // empty
         MultilineOptions multilineOpts;
@@ -547,13 +548,13 @@ void LogFileReaderUnittest::TestReadUTF8() {
         APSARA_TEST_FALSE_FATAL(reader.mLastForceRead);
         reader.ReadUTF8(logBuffer, firstReadSize, moreData, false); // force read, clear cache
         APSARA_TEST_TRUE_FATAL(reader.mLastForceRead);
-        APSARA_TEST_EQUAL_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_EQUAL_FATAL(reader.mCache.Size(), 0UL);
         APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
 
         // second read, start with \n but with other lines
         reader.ReadUTF8(logBuffer, fileSize - 1, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         std::string expectedPart2(expectedContent.get() + firstReadSize + 1); // skip \n
         int64_t secondReadSize = expectedPart2.rfind("iLogtail") - 1;
         expectedPart2.resize(secondReadSize);
@@ -570,7 +571,7 @@ void LogFileReaderUnittest::TestReadUTF8() {
         LogBuffer logBuffer2;
         reader.ReadUTF8(logBuffer2, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
-        APSARA_TEST_GE_FATAL(reader.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader.mCache.Size(), 0UL);
         APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
         APSARA_TEST_STREQ_FATAL(NULL, logBuffer2.rawBuffer.data());
     }
@@ -805,7 +806,7 @@ void LogFileReaderCheckpointUnittest::TestDumpMetaToMem() {
         // first read
         reader1.ReadUTF8(logBuffer, fileSize, moreData);
         APSARA_TEST_TRUE_FATAL(moreData);
-        APSARA_TEST_GE_FATAL(reader1.mCache.size(), 0UL);
+        APSARA_TEST_GE_FATAL(reader1.mCache.Size(), 0UL);
         reader1.DumpMetaToMem(false);
         // second read
         LogFileReader reader2(logPathDir,
@@ -818,10 +819,10 @@ void LogFileReaderCheckpointUnittest::TestDumpMetaToMem() {
         reader2.InitReader(false, LogFileReader::BACKWARD_TO_BEGINNING);
         reader2.CheckFileSignatureAndOffset(true);
         APSARA_TEST_EQUAL_FATAL(reader1.mLastFilePos, reader2.mLastFilePos);
-        APSARA_TEST_EQUAL_FATAL(reader1.mCache, reader2.mCache); // cache should recoverd from checkpoint
+        APSARA_TEST_EQUAL_FATAL(reader1.mCache.ToString(), reader2.mCache.ToString()); // cache should recoverd from checkpoint
         reader2.ReadUTF8(logBuffer, fileSize, moreData);
         APSARA_TEST_FALSE_FATAL(moreData);
-        APSARA_TEST_EQUAL_FATAL(0UL, reader2.mCache.size());
+        APSARA_TEST_EQUAL_FATAL(0UL, reader2.mCache.Size());
         reader1.DumpMetaToMem(false);
     }
 }
@@ -945,6 +946,174 @@ UNIT_TEST_CASE(LogFileReaderHoleUnittest, TestReadLogHoleInTheMiddle);
 UNIT_TEST_CASE(LogFileReaderHoleUnittest, TestReadLogHoleOnTheLeft);
 UNIT_TEST_CASE(LogFileReaderHoleUnittest, TestReadLogJsonHoleOnTheRight);
 
+class LogFileReaderPrefetchUnittest : public ::testing::Test {
+public:
+    void TestReadLogWithPrefetch();
+    void TestReadLogWithShortPrefetch();
+    void TestReadLogWithOutdatedPrefetch();
+    void TestReadLogWithPartialRecord();
+
+protected:
+    static void SetUpTestCase() {
+        gRootDir = GetProcessExecutionDir();
+        gLogName = "test.log";
+        if (PATH_SEPARATOR[0] == gRootDir.at(gRootDir.size() - 1)) {
+            gRootDir.resize(gRootDir.size() - 1);
+        }
+        gRootDir += PATH_SEPARATOR + "testDataSet" + PATH_SEPARATOR + "LogFileReaderPrefetchUnittest";
+        gLogPath = gRootDir + PATH_SEPARATOR + gLogName;
+        bfs::remove_all(gRootDir);
+    }
+
+    void SetUp() override {
+        bfs::create_directories(gRootDir);
+        mReaderOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        std::ofstream(gLogPath, std::ios::binary) << "first line\nsecond line\n";
+        mBatchReader.Init(true, 8);
+    }
+    void TearDown() override { bfs::remove_all(gRootDir); }
+
+    // read the file of the reader in batch, as LogInput does
+    void Prefetch(LogFileReader& reader, size_t size) {
+        std::vector<FileReadRequest> requests(1);
+        APSARA_TEST_TRUE_FATAL(reader.PrepareRead(size, requests[0]));
+        mBatchReader.Read(requests);
+        reader.SetPrefetchResult(requests[0].result);
+    }
+
+    static std::string gRootDir;
+    static std::string gLogName;
+    static std::string gLogPath;
+
+    FileReaderOptions mReaderOpts;
+    MultilineOptions mMultilineOpts;
+    FileTagOptions mTagOpts;
+    CollectionPipelineContext mCtx;
+    BatchFileReader mBatchReader;
+};
+
+std::string LogFileReaderPrefetchUnittest::gRootDir;
+std::string LogFileReaderPrefetchUnittest::gLogName;
+std::string LogFileReaderPrefetchUnittest::gLogPath;
+
+void LogFileReaderPrefetchUnittest::TestReadLogWithPrefetch() {
+    LogFileReader reader(gRootDir,
+                         gLogName,
+                         DevInode(),
+                         std::make_pair(&mReaderOpts, &mCtx),
+                         std::make_pair(&mMultilineOpts, &mCtx),
+                         std::make_pair(&mTagOpts, &mCtx));
+    reader.UpdateReaderManual();
+    APSARA_TEST_TRUE_FATAL(reader.CheckFileSignatureAndOffset(true));
+
+    Prefetch(reader, 1024);
+    const char* prefetchedData = reader.mPrefetchedData->data;
+    // only one read can be prepared before the prefetched data is used
+    FileReadRequest request;
+    APSARA_TEST_FALSE(reader.PrepareRead(1024, request));
+
+    Event event(gRootDir, "", EVENT_MODIFY, 0);
+    LogBuffer logbuf;
+    APSARA_TEST_FALSE(reader.ReadLog(logbuf, &event));
+    APSARA_TEST_EQUAL("first line\nsecond line", logbuf.rawBuffer.to_string());
+    // the prefetched buffer is used without copy
+    APSARA_TEST_EQUAL(prefetchedData, logbuf.rawBuffer.data());
+    APSARA_TEST_TRUE(reader.mPrefetchedData == nullptr);
+}
+
+void LogFileReaderPrefetchUnittest::TestReadLogWithShortPrefetch() {
+    LogFileReader reader(gRootDir,
+                         gLogName,
+                         DevInode(),
+                         std::make_pair(&mReaderOpts, &mCtx),
+                         std::make_pair(&mMultilineOpts, &mCtx),
+                         std::make_pair(&mTagOpts, &mCtx));
+    reader.UpdateReaderManual();
+    APSARA_TEST_TRUE_FATAL(reader.CheckFileSignatureAndOffset(true));
+
+    // the rest of the file is read when the log is read
+    Prefetch(reader, 5);
+    Event event(gRootDir, "", EVENT_MODIFY, 0);
+    LogBuffer logbuf;
+    APSARA_TEST_FALSE(reader.ReadLog(logbuf, &event));
+    APSARA_TEST_EQUAL("first line\nsecond line", logbuf.rawBuffer.to_string());
+
+    // the file grows after it is prefetched
+    std::ofstream(gLogPath, std::ios::binary | std::ios::app) << "third ";
+    Prefetch(reader, 1024);
+    std::ofstream(gLogPath, std::ios::binary | std::ios::app) << "line\n";
+    APSARA_TEST_TRUE_FATAL(reader.CheckFileSignatureAndOffset(true));
+    LogBuffer logbuf2;
+    APSARA_TEST_FALSE(reader.ReadLog(logbuf2, &event));
+    APSARA_TEST_EQUAL("third line", logbuf2.rawBuffer.to_string());
+}
+
+void LogFileReaderPrefetchUnittest::TestReadLogWithOutdatedPrefetch() {
+    LogFileReader reader(gRootDir,
+                         gLogName,
+                         DevInode(),
+                         std::make_pair(&mReaderOpts, &mCtx),
+                         std::make_pair(&mMultilineOpts, &mCtx),
+                         std::make_pair(&mTagOpts, &mCtx));
+    reader.UpdateReaderManual();
+    APSARA_TEST_TRUE_FATAL(reader.CheckFileSignatureAndOffset(true));
+
+    // the reader is moved after the file is prefetched
+    Prefetch(reader, 1024);
+    reader.mLastFilePos = strlen("first line\n");
+    Event event(gRootDir, "", EVENT_MODIFY, 0);
+    LogBuffer logbuf;
+    APSARA_TEST_FALSE(reader.ReadLog(logbuf, &event));
+    APSARA_TEST_EQUAL("second line", logbuf.rawBuffer.to_string());
+
+    // prefetched data is dropped when the file is closed
+    Prefetch(reader, 1024);
+    reader.CloseFilePtr();
+    APSARA_TEST_TRUE(reader.mPrefetchedData == nullptr);
+}
+
+UNIT_TEST_CASE(LogFileReaderPrefetchUnittest, TestReadLogWithPrefetch);
+UNIT_TEST_CASE(LogFileReaderPrefetchUnittest, TestReadLogWithShortPrefetch);
+void LogFileReaderPrefetchUnittest::TestReadLogWithPartialRecord() {
+    LogFileReader reader(gRootDir,
+                         gLogName,
+                         DevInode(),
+                         std::make_pair(&mReaderOpts, &mCtx),
+                         std::make_pair(&mMultilineOpts, &mCtx),
+                         std::make_pair(&mTagOpts, &mCtx));
+    reader.UpdateReaderManual();
+    std::ofstream(gLogPath, std::ios::binary | std::ios::app) << "third";
+    APSARA_TEST_TRUE_FATAL(reader.CheckFileSignatureAndOffset(true));
+    Event event(gRootDir, "", EVENT_MODIFY, 0);
+    LogBuffer logbuf;
+    APSARA_TEST_FALSE(reader.ReadLog(logbuf, &event));
+    APSARA_TEST_EQUAL("first line\nsecond line", logbuf.rawBuffer.to_string());
+    APSARA_TEST_EQUAL("third", reader.mCache.ToString());
+
+    // the partial record is moved once to a segment with room for the following reads
+    std::ofstream(gLogPath, std::ios::binary | std::ios::app) << " li";
+    APSARA_TEST_TRUE_FATAL(reader.CheckFileSignatureAndOffset(true));
+    LogBuffer logbuf2;
+    APSARA_TEST_FALSE(reader.ReadLog(logbuf2, &event));
+    APSARA_TEST_TRUE(logbuf2.rawBuffer.empty());
+    APSARA_TEST_EQUAL("third li", reader.mCache.ToString());
+    const char* cachedData = reader.mCache.Data();
+
+    // and then read in place along with the rest of the record
+    std::ofstream(gLogPath, std::ios::binary | std::ios::app) << "ne\nfourth";
+    APSARA_TEST_TRUE_FATAL(reader.CheckFileSignatureAndOffset(true));
+    Prefetch(reader, 1024);
+    LogBuffer logbuf3;
+    APSARA_TEST_FALSE(reader.ReadLog(logbuf3, &event));
+    APSARA_TEST_EQUAL("third line", logbuf3.rawBuffer.to_string());
+    APSARA_TEST_EQUAL(cachedData, logbuf3.rawBuffer.data());
+    APSARA_TEST_EQUAL("fourth", reader.mCache.ToString());
+    APSARA_TEST_EQUAL(cachedData + strlen("third line\n"), reader.mCache.Data());
+}
+
+UNIT_TEST_CASE(LogFileReaderPrefetchUnittest, TestReadLogWithOutdatedPrefetch);
+UNIT_TEST_CASE(LogFileReaderPrefetchUnittest, TestReadLogWithPartialRecord);
+
 } // namespace logtail
 
 int main(int argc, char** argv) {
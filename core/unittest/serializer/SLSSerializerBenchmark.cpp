@@ -0,0 +1,150 @@
+// Copyright 2024 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <functional>
+
+#include "collection_pipeline/serializer/SLSSerializer.h"
+#include "common/StringTools.h"
+#include "common/TimeUtil.h"
+#include "plugin/flusher/sls/FlusherSLS.h"
+
+#ifdef ENABLE_COMPATIBLE_MODE
+extern "C" {
+#include <string.h>
+asm(".symver memcpy, memcpy@GLIBC_2.2.5");
+void* __wrap_memcpy(void* dest, const void* src, size_t n) {
+    return memcpy(dest, src, n);
+}
+}
+#endif
+
+namespace logtail {
+
+static const size_t kGroupCnt = 200;
+static const size_t kEventCnt = 1000;
+
+class SLSSerializerBenchmark {
+public:
+    SLSSerializerBenchmark() {
+        mCtx.SetConfigName("benchmark_config");
+        mFlusher.SetContext(mCtx);
+        mFlusher.CreateMetricsRecordRef(FlusherSLS::sName, "1");
+        mFlusher.CommitMetricsRecordRef();
+    }
+
+    void TestLogEvents() { Test("log", [](PipelineEventGroup& group, size_t i) { AddLogEvent(group, i); }); }
+    void TestMetricEvents() { Test("metric", [](PipelineEventGroup& group, size_t i) { AddMetricEvent(group, i); }); }
+    void TestSpanEvents() { Test("span", [](PipelineEventGroup& group, size_t i) { AddSpanEvent(group, i); }); }
+
+private:
+    // throughput is measured in one thread, i.e. MB/s per core
+    void Test(const char* type, const std::function<void(PipelineEventGroup&, size_t)>& addEvent);
+
+    static void AddLogEvent(PipelineEventGroup& group, size_t i);
+    static void AddMetricEvent(PipelineEventGroup& group, size_t i);
+    static void AddSpanEvent(PipelineEventGroup& group, size_t i);
+
+    CollectionPipelineContext mCtx;
+    FlusherSLS mFlusher;
+};
+
+void SLSSerializerBenchmark::Test(const char* type,
+                                  const std::function<void(PipelineEventGroup&, size_t)>& addEvent) {
+    std::vector<BatchedEvents> batches;
+    batches.reserve(kGroupCnt);
+    for (size_t i = 0; i < kGroupCnt; ++i) {
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+        group.SetTag(LOG_RESERVED_KEY_SOURCE, "172.16.0.1");
+        group.SetTag(LOG_RESERVED_KEY_MACHINE_UUID, "machine_uuid");
+        group.SetTag(LOG_RESERVED_KEY_PACKAGE_ID, "pack_id");
+        for (size_t j = 0; j < kEventCnt; ++j) {
+            addEvent(group, j);
+        }
+        batches.emplace_back(std::move(group.MutableEvents()),
+                             std::move(group.GetSizedTags()),
+                             std::move(group.GetSourceBuffer()),
+                             StringView(),
+                             RangeCheckpointPtr());
+    }
+
+    SLSEventGroupSerializer serializer(&mFlusher);
+    std::string res, errorMsg;
+    size_t totalSize = 0;
+    uint64_t starttime = GetCurrentTimeInMicroSeconds();
+    for (auto& batch : batches) {
+        if (!serializer.DoSerialize(std::move(batch), res, errorMsg)) {
+            printf("failed to serialize %s events: %s\n", type, errorMsg.c_str());
+            return;
+        }
+        totalSize += res.size();
+    }
+    uint64_t timeElapsed = GetCurrentTimeInMicroSeconds() - starttime;
+    printf("serialize %zu %s groups of %zu events costs %luus, %.2f MB/s\n",
+           kGroupCnt,
+           type,
+           kEventCnt,
+           timeElapsed,
+           timeElapsed == 0 ? 0.0 : totalSize / 1024.0 / 1024.0 * 1000000.0 / timeElapsed);
+}
+
+void SLSSerializerBenchmark::AddLogEvent(PipelineEventGroup& group, size_t i) {
+    auto* e = group.AddLogEvent();
+    e->SetTimestamp(1700000000 + i, 123456789);
+    e->SetContent(std::string("__path__"), std::string("/var/log/app/access.log"));
+    e->SetContent(std::string("method"), std::string("GET"));
+    e->SetContent(std::string("status"), std::string("200"));
+    e->SetContent(std::string("latency"), ToString(i % 1000));
+    e->SetContent(std::string("url"), "/api/v1/resources/" + ToString(i) + "?with=details&format=json");
+    e->SetContent(std::string("content"),
+                  "127.0.0.1 - - [15/Oct/2024:10:00:00 +0800] \"GET /api/v1/resources HTTP/1.1\" 200 " + ToString(i));
+}
+
+void SLSSerializerBenchmark::AddMetricEvent(PipelineEventGroup& group, size_t i) {
+    auto* e = group.AddMetricEvent();
+    e->SetName("http_requests_total");
+    e->SetTimestamp(1700000000 + i, 123456789);
+    e->SetTag(std::string("cluster"), std::string("cluster-1"));
+    e->SetTag(std::string("namespace"), std::string("default"));
+    e->SetTag(std::string("pod"), "pod-" + ToString(i % 100));
+    e->SetTag(std::string("method"), std::string("GET"));
+    e->SetValue<UntypedSingleValue>(static_cast<double>(i) * 1.5);
+}
+
+void SLSSerializerBenchmark::AddSpanEvent(PipelineEventGroup& group, size_t i) {
+    auto* e = group.AddSpanEvent();
+    e->SetTimestamp(1700000000 + i);
+    e->SetTraceId("5b8efff798038103d269b633813fc60c");
+    e->SetSpanId("eee19b7ec3c1b174");
+    e->SetParentSpanId("eee19b7ec3c1b173");
+    e->SetName("/api/v1/resources");
+    e->SetKind(SpanEvent::Kind::Server);
+    e->SetStatus(SpanEvent::StatusCode::Ok);
+    e->SetStartTimeNs(1700000000000000000ULL + i * 1000);
+    e->SetEndTimeNs(1700000000000000000ULL + i * 1000 + 500);
+    e->SetTag(std::string("host"), std::string("10.54.0.33"));
+    e->SetTag(std::string("rpc"), std::string("/api/v1/resources"));
+    e->SetTag(std::string("statusCode"), std::string("200"));
+    e->SetScopeTag(std::string("scope"), std::string("benchmark"));
+}
+
+} // namespace logtail
+
+int main(int argc, char* argv[]) {
+    logtail::SLSSerializerBenchmark benchmark;
+    benchmark.TestLogEvents();
+    benchmark.TestMetricEvents();
+    benchmark.TestSpanEvents();
+    return 0;
+}
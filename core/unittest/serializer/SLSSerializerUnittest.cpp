@@ -13,6 +13,9 @@
 // limitations under the License.
 
 #include "collection_pipeline/serializer/SLSSerializer.h"
+#include "common/StringTools.h"
+#include "common/compression/LZ4Compressor.h"
+#include "common/compression/ZstdCompressor.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "unittest/Unittest.h"
 
@@ -26,6 +29,8 @@ class SLSSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
     void TestSerializeEventGroupList();
+    void TestSerializeMultipleEventsWithReusedOutput();
+    void TestSerializeAndCompress();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherSLS>(); }
@@ -734,6 +739,108 @@ SLSSerializerUnittest::CreateBatchedLogEvents(bool enableNanosecond, bool withEm
     return batch;
 }
 
+void SLSSerializerUnittest::TestSerializeMultipleEventsWithReusedOutput() {
+    SLSEventGroupSerializer serializer(sFlusher.get());
+    // output is written in place, and stale data from the previous group should not be left
+    string res(1024, 'x'), errorMsg;
+    { // metric
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        auto* e = group.AddMetricEvent();
+        e->SetName("single");
+        e->SetTimestamp(1234567890);
+        e->SetTag(string("key"), string("value"));
+        e->SetValue<UntypedSingleValue>(1.5);
+        e = group.AddMetricEvent();
+        e->SetName("multi");
+        e->SetTimestamp(1234567891, 123);
+        e->SetValue<UntypedMultiDoubleValues>(e);
+        e->MutableValue<UntypedMultiDoubleValues>()->SetValue(string("value1"),
+                                                              {UntypedValueMetricType::MetricTypeGauge, 0.1});
+        e->MutableValue<UntypedMultiDoubleValues>()->SetValue(string("value2"),
+                                                              {UntypedValueMetricType::MetricTypeGauge, 0.2});
+        e = group.AddMetricEvent();
+        e->SetName("single");
+        e->SetTimestamp(1234567892);
+        e->SetTag(string("key"), string("value"));
+        e->SetValue<UntypedSingleValue>(2.5);
+        BatchedEvents batch(std::move(group.MutableEvents()),
+                            std::move(group.GetSizedTags()),
+                            std::move(group.GetSourceBuffer()),
+                            StringView(),
+                            RangeCheckpointPtr());
+        APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+        sls_logs::LogGroup logGroup;
+        APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+        APSARA_TEST_EQUAL(3, logGroup.logs_size());
+        APSARA_TEST_EQUAL("1.500000", logGroup.logs(0).contents(2).value());
+        APSARA_TEST_EQUAL(3, logGroup.logs(1).contents_size());
+        APSARA_TEST_EQUAL("1234567891000000123", logGroup.logs(1).contents(0).value());
+        APSARA_TEST_EQUAL("0.100000", logGroup.logs(1).contents(1).value());
+        APSARA_TEST_EQUAL("0.200000", logGroup.logs(1).contents(2).value());
+        APSARA_TEST_EQUAL("2.500000", logGroup.logs(2).contents(2).value());
+    }
+    { // span
+        auto batch = CreateBatchedSpanEvents();
+        APSARA_TEST_TRUE(serializer.DoSerialize(std::move(batch), res, errorMsg));
+        sls_logs::LogGroup logGroup;
+        APSARA_TEST_TRUE(logGroup.ParseFromString(res));
+        APSARA_TEST_EQUAL(1, logGroup.logs_size());
+        APSARA_TEST_EQUAL(13, logGroup.logs(0).contents_size());
+        APSARA_TEST_EQUAL("1000", logGroup.logs(0).contents(10).value());
+        APSARA_TEST_EQUAL("2000", logGroup.logs(0).contents(11).value());
+        APSARA_TEST_EQUAL("1000", logGroup.logs(0).contents(12).value());
+    }
+}
+
+void SLSSerializerUnittest::TestSerializeAndCompress() {
+    SLSEventGroupSerializer serializer(sFlusher.get());
+    auto createBatch = []() {
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+        group.SetTag(string("tag_key"), string("tag_value"));
+        // large enough to be passed to the compressor in several chunks
+        for (size_t i = 0; i < 5000; ++i) {
+            auto* e = group.AddLogEvent();
+            e->SetTimestamp(1234567890 + i);
+            e->SetContent(string("key"), "value " + ToString(i));
+            e->SetContent(string("content"), string(i % 100, 'x'));
+        }
+        return BatchedEvents(std::move(group.MutableEvents()),
+                             std::move(group.GetSizedTags()),
+                             std::move(group.GetSourceBuffer()),
+                             StringView(),
+                             RangeCheckpointPtr());
+    };
+    {
+        string expected, output, errorMsg;
+        APSARA_TEST_TRUE(serializer.DoSerialize(createBatch(), expected, errorMsg));
+
+        ZstdCompressor compressor(CompressType::ZSTD);
+        size_t rawSize = 0;
+        APSARA_TEST_TRUE(serializer.DoSerializeAndCompress(createBatch(), compressor, output, rawSize, errorMsg));
+        APSARA_TEST_EQUAL(expected.size(), rawSize);
+        string decompressed(rawSize, '\0');
+        APSARA_TEST_TRUE(compressor.UnCompress(output, decompressed, errorMsg));
+        APSARA_TEST_EQUAL(expected, decompressed);
+    }
+    {
+        // lz4 block format needs the whole input at once
+        LZ4Compressor compressor(CompressType::LZ4);
+        string output, errorMsg;
+        size_t rawSize = 0;
+        APSARA_TEST_FALSE(serializer.DoSerializeAndCompress(createBatch(), compressor, output, rawSize, errorMsg));
+    }
+    {
+        // size limit is still checked before compression
+        INT32_FLAG(max_send_log_group_size) = 0;
+        ZstdCompressor compressor(CompressType::ZSTD);
+        string output, errorMsg;
+        size_t rawSize = 0;
+        APSARA_TEST_FALSE(serializer.DoSerializeAndCompress(createBatch(), compressor, output, rawSize, errorMsg));
+        INT32_FLAG(max_send_log_group_size) = 10 * 1024 * 1024;
+    }
+}
+
 BatchedEvents SLSSerializerUnittest::CreateBatchedMetricEvents(bool enableNanosecond,
                                                                uint32_t nanoTimestamp,
                                                                bool emptyValue,
@@ -903,6 +1010,8 @@ BatchedEvents SLSSerializerUnittest::CreateBatchedSpanEvents() {
 
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroup)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroupList)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeMultipleEventsWithReusedOutput)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeAndCompress)
 
 } // namespace logtail
 
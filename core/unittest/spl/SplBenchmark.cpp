@@ -26,6 +26,7 @@
 #include "plugin/processor/ProcessorSPL.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_BOOL(enable_parse_regex_re2);
 
 using namespace logtail;
 
@@ -234,6 +235,7 @@ static void BM_RawRegex(int size, int batchSize) {
             // std::cout << "outJson: " << outJson << std::endl;
         }
 
+        std::cout << "raw regex engine: " << (BOOL_FLAG(enable_parse_regex_re2) ? "re2" : "boost") << std::endl;
         std::cout << "raw regex count: " << count << std::endl;
         std::cout << "durationTime: " << durationTime << std::endl;
         std::cout << "process: "
@@ -688,6 +690,9 @@ int main(int argc, char** argv) {
 
     BM_SplRegex(1000, 100);
     BM_RawRegex(1000, 100);
+    BOOL_FLAG(enable_parse_regex_re2) = true;
+    BM_RawRegex(1000, 100);
+    BOOL_FLAG(enable_parse_regex_re2) = false;
     BM_SplJson(1000, 100);
     BM_RawJson(1000, 100);
     BM_SplSplit(1000, 100);